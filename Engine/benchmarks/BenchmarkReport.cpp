@@ -0,0 +1,107 @@
+#include <EtFramework/stdafx.h>
+#include "BenchmarkReport.h"
+
+
+namespace et {
+namespace bench {
+
+
+//==================
+// Benchmark Report
+//==================
+
+
+//------------------------
+// BenchmarkReport::Add
+//
+void BenchmarkReport::Add(std::string const& name, size_t const entityCount, uint32 const iterations, uint64 const totalNs)
+{
+	Result result;
+	result.name = name;
+	result.entityCount = entityCount;
+	result.iterations = iterations;
+	result.totalNs = totalNs;
+
+	m_Results.emplace_back(result);
+}
+
+//------------------------
+// BenchmarkReport::Write
+//
+void BenchmarkReport::Write(std::ostream& stream, E_Format const format) const
+{
+	switch (format)
+	{
+	case E_Format::Csv:
+		WriteCsv(stream);
+		break;
+
+	case E_Format::Json:
+		WriteJson(stream);
+		break;
+
+	default:
+		ET_ASSERT(false, "unhandled benchmark report format");
+		break;
+	}
+}
+
+//---------------------------
+// BenchmarkReport::WriteCsv
+//
+// One row per result, the version and worker count are repeated so that files from different runs can be concatenated
+//
+void BenchmarkReport::WriteCsv(std::ostream& stream) const
+{
+	stream << "version,workers,benchmark,entities,iterations,total_ns,ns_per_iteration,ns_per_entity\n";
+
+	for (Result const& result : m_Results)
+	{
+		uint64 const perIteration = result.totalNs / std::max(result.iterations, 1u);
+		double const perEntity = static_cast<double>(perIteration) / static_cast<double>(std::max(result.entityCount, static_cast<size_t>(1u)));
+
+		stream << m_Version << ',' 
+			<< m_WorkerCount << ',' 
+			<< result.name << ',' 
+			<< result.entityCount << ',' 
+			<< result.iterations << ',' 
+			<< result.totalNs << ',' 
+			<< perIteration << ',' 
+			<< perEntity << '\n';
+	}
+}
+
+//----------------------------
+// BenchmarkReport::WriteJson
+//
+// benchmark names are plain identifiers, so they don't need escaping
+//
+void BenchmarkReport::WriteJson(std::ostream& stream) const
+{
+	stream << "{\n";
+	stream << "\t\"version\": \"" << m_Version << "\",\n";
+	stream << "\t\"workers\": " << m_WorkerCount << ",\n";
+	stream << "\t\"results\": [";
+
+	for (size_t resultIdx = 0u; resultIdx < m_Results.size(); ++resultIdx)
+	{
+		Result const& result = m_Results[resultIdx];
+
+		uint64 const perIteration = result.totalNs / std::max(result.iterations, 1u);
+		double const perEntity = static_cast<double>(perIteration) / static_cast<double>(std::max(result.entityCount, static_cast<size_t>(1u)));
+
+		stream << ((resultIdx == 0u) ? "\n" : ",\n");
+		stream << "\t\t{ \"benchmark\": \"" << result.name << "\""
+			<< ", \"entities\": " << result.entityCount 
+			<< ", \"iterations\": " << result.iterations 
+			<< ", \"total_ns\": " << result.totalNs 
+			<< ", \"ns_per_iteration\": " << perIteration 
+			<< ", \"ns_per_entity\": " << perEntity << " }";
+	}
+
+	stream << "\n\t]\n}\n";
+}
+
+
+} // namespace bench
+} // namespace et
@@ -0,0 +1,58 @@
+#pragma once
+
+
+namespace et {
+namespace bench {
+
+
+//-----------------
+// BenchmarkReport
+//
+// Collects timings and writes them in a machine readable format, so that results can be compared between engine versions
+//
+class BenchmarkReport final
+{
+	// definitions
+	//-------------
+public:
+	enum class E_Format : uint8
+	{
+		Csv,
+		Json
+	};
+
+	struct Result final
+	{
+		std::string name;
+		size_t entityCount = 0u;
+		uint32 iterations = 0u;
+		uint64 totalNs = 0u;
+	};
+
+	// construct destruct
+	//--------------------
+	BenchmarkReport(std::string const& version, size_t const workerCount) : m_Version(version), m_WorkerCount(workerCount) {}
+
+	// functionality
+	//---------------
+	void Add(std::string const& name, size_t const entityCount, uint32 const iterations, uint64 const totalNs);
+	void Write(std::ostream& stream, E_Format const format) const;
+
+	// utility
+	//---------
+private:
+	void WriteCsv(std::ostream& stream) const;
+	void WriteJson(std::ostream& stream) const;
+
+	// Data
+	///////
+
+	std::string const m_Version;
+	size_t const m_WorkerCount;
+
+	std::vector<Result> m_Results;
+};
+
+
+} // namespace bench
+} // namespace et
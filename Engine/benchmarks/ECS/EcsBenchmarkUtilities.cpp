@@ -0,0 +1,147 @@
+#include <EtFramework/stdafx.h>
+#include "EcsBenchmarkUtilities.h"
+
+#include <rttr/registration>
+
+
+// reflection
+//------------
+
+RTTR_REGISTRATION
+{
+	using namespace rttr;
+
+	registration::class_<BenchPosition>("bench position component");
+	registration::class_<BenchVelocity>("bench velocity component");
+	registration::class_<BenchMass>("bench mass component");
+	registration::class_<BenchHealth>("bench health component");
+	registration::class_<BenchRootTag>("bench root tag component");
+}
+
+// component registration
+//------------------------
+
+ECS_REGISTER_COMPONENT(BenchPosition);
+ECS_REGISTER_COMPONENT(BenchVelocity);
+ECS_REGISTER_COMPONENT(BenchMass);
+ECS_REGISTER_COMPONENT(BenchHealth);
+ECS_REGISTER_COMPONENT(BenchRootTag);
+
+
+// systems
+//---------
+
+static float const s_DeltaTime = 1.f / 60.f;
+
+
+//-------------------------------
+// BenchIterate1System::Process
+//
+void BenchIterate1System::Process(fw::ComponentRange<BenchView1>& range)
+{
+	for (BenchView1& view : range)
+	{
+		view.pos->x += s_DeltaTime;
+	}
+}
+
+//-------------------------------
+// BenchIterate2System::Process
+//
+void BenchIterate2System::Process(fw::ComponentRange<BenchView2>& range)
+{
+	for (BenchView2& view : range)
+	{
+		view.pos->x += view.vel->x * s_DeltaTime;
+		view.pos->y += view.vel->y * s_DeltaTime;
+		view.pos->z += view.vel->z * s_DeltaTime;
+	}
+}
+
+//-------------------------------
+// BenchIterate3System::Process
+//
+void BenchIterate3System::Process(fw::ComponentRange<BenchView3>& range)
+{
+	for (BenchView3& view : range)
+	{
+		float const scale = s_DeltaTime / view.mass->mass;
+		view.pos->x += view.vel->x * scale;
+		view.pos->y += view.vel->y * scale;
+		view.pos->z += view.vel->z * scale;
+	}
+}
+
+//-------------------------------
+// BenchIterate4System::Process
+//
+void BenchIterate4System::Process(fw::ComponentRange<BenchView4>& range)
+{
+	for (BenchView4& view : range)
+	{
+		float const scale = (view.health->health > 0.f) ? (s_DeltaTime / view.mass->mass) : 0.f;
+		view.pos->x += view.vel->x * scale;
+		view.pos->y += view.vel->y * scale;
+		view.pos->z += view.vel->z * scale;
+	}
+}
+
+//-----------------------------
+// BenchQuery2System::Process
+//
+void BenchQuery2System::Process(T_Query::Chunk const& chunk)
+{
+	BenchPosition* const pos = chunk.Get<BenchPosition>();
+	BenchVelocity const* const vel = chunk.Get<BenchVelocity>();
+
+	for (size_t idx = 0u; idx < chunk.GetCount(); ++idx)
+	{
+		pos[idx].x += vel[idx].x * s_DeltaTime;
+		pos[idx].y += vel[idx].y * s_DeltaTime;
+		pos[idx].z += vel[idx].z * s_DeltaTime;
+	}
+}
+
+//---------------------------------
+// BenchAddCommandSystem::Process
+//
+void BenchAddCommandSystem::Process(fw::ComponentRange<BenchCommandView>& range)
+{
+	fw::EcsCommandBuffer& cb = GetCommandBuffer();
+	BenchMass mass;
+	for (BenchCommandView& view : range)
+	{
+		cb.AddComponents(view.GetCurrentEntity(), mass);
+	}
+}
+
+//------------------------------------
+// BenchRemoveCommandSystem::Process
+//
+void BenchRemoveCommandSystem::Process(fw::ComponentRange<BenchMassCommandView>& range)
+{
+	fw::EcsCommandBuffer& cb = GetCommandBuffer();
+	for (BenchMassCommandView& view : range)
+	{
+		cb.RemoveComponents<BenchMass>(view.GetCurrentEntity());
+	}
+}
+
+//----------------------------
+// BenchMoverSystem::c-tor
+//
+BenchMoverSystem::BenchMoverSystem()
+{
+	DeclareDependents<fw::TransformSystem::Compute>();
+}
+
+//----------------------------
+// BenchMoverSystem::Process
+//
+void BenchMoverSystem::Process(fw::ComponentRange<BenchMoverView>& range)
+{
+	for (BenchMoverView& view : range)
+	{
+		view.transf->Translate(vec3(s_DeltaTime, 0.f, 0.f));
+	}
+}
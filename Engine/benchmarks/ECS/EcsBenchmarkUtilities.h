@@ -0,0 +1,198 @@
+#pragma once
+#include <EtFramework/ECS/ComponentRegistry.h>
+#include <EtFramework/ECS/ComponentView.h>
+#include <EtFramework/ECS/EcsController.h>
+#include <EtFramework/Components/TransformComponent.h>
+#include <EtFramework/Systems/TransformSystem.h>
+
+
+using namespace et;
+
+
+// Components
+//************
+
+struct BenchPosition final
+{
+	ECS_DECLARE_COMPONENT
+public:
+	float x = 0.f;
+	float y = 0.f;
+	float z = 0.f;
+};
+
+struct BenchVelocity final
+{
+	ECS_DECLARE_COMPONENT
+public:
+	float x = 1.f;
+	float y = 2.f;
+	float z = 3.f;
+};
+
+struct BenchMass final
+{
+	ECS_DECLARE_COMPONENT
+public:
+	float mass = 2.f;
+};
+
+struct BenchHealth final
+{
+	ECS_DECLARE_COMPONENT
+public:
+	float health = 100.f;
+};
+
+// marks entities whose transform is animated
+struct BenchRootTag final
+{
+	ECS_DECLARE_COMPONENT
+public:
+	bool unused = false;
+};
+
+
+// Views
+//*******
+
+struct BenchView1 final : public fw::ComponentView
+{
+	BenchView1() : fw::ComponentView()
+	{
+		Declare(pos);
+	}
+
+	WriteAccess<BenchPosition> pos;
+};
+
+struct BenchView2 final : public fw::ComponentView
+{
+	BenchView2() : fw::ComponentView()
+	{
+		Declare(pos);
+		Declare(vel);
+	}
+
+	WriteAccess<BenchPosition> pos;
+	ReadAccess<BenchVelocity> vel;
+};
+
+struct BenchView3 final : public fw::ComponentView
+{
+	BenchView3() : fw::ComponentView()
+	{
+		Declare(pos);
+		Declare(vel);
+		Declare(mass);
+	}
+
+	WriteAccess<BenchPosition> pos;
+	ReadAccess<BenchVelocity> vel;
+	ReadAccess<BenchMass> mass;
+};
+
+struct BenchView4 final : public fw::ComponentView
+{
+	BenchView4() : fw::ComponentView()
+	{
+		Declare(pos);
+		Declare(vel);
+		Declare(mass);
+		Declare(health);
+	}
+
+	WriteAccess<BenchPosition> pos;
+	ReadAccess<BenchVelocity> vel;
+	ReadAccess<BenchMass> mass;
+	ReadAccess<BenchHealth> health;
+};
+
+struct BenchCommandView final : public fw::ComponentView
+{
+	BenchCommandView() : fw::ComponentView()
+	{
+		Declare(pos);
+	}
+
+	ReadAccess<BenchPosition> pos;
+};
+
+struct BenchMassCommandView final : public fw::ComponentView
+{
+	BenchMassCommandView() : fw::ComponentView()
+	{
+		Declare(pos);
+		Include<BenchMass>();
+	}
+
+	ReadAccess<BenchPosition> pos;
+};
+
+struct BenchMoverView final : public fw::ComponentView
+{
+	BenchMoverView() : fw::ComponentView()
+	{
+		Declare(transf);
+		Include<BenchRootTag>();
+	}
+
+	WriteAccess<fw::TransformComponent> transf;
+};
+
+
+// Systems
+//*********
+
+class BenchIterate1System final : public fw::System<BenchIterate1System, BenchView1>
+{
+public:
+	void Process(fw::ComponentRange<BenchView1>& range) override;
+};
+
+class BenchIterate2System final : public fw::System<BenchIterate2System, BenchView2>
+{
+public:
+	void Process(fw::ComponentRange<BenchView2>& range) override;
+};
+
+class BenchIterate3System final : public fw::System<BenchIterate3System, BenchView3>
+{
+public:
+	void Process(fw::ComponentRange<BenchView3>& range) override;
+};
+
+class BenchIterate4System final : public fw::System<BenchIterate4System, BenchView4>
+{
+public:
+	void Process(fw::ComponentRange<BenchView4>& range) override;
+};
+
+// same as the two component view, but iterating a query
+class BenchQuery2System final : public fw::System<BenchQuery2System, fw::Query<fw::Write<BenchPosition>, fw::Read<BenchVelocity>>>
+{
+public:
+	void Process(T_Query::Chunk const& chunk);
+};
+
+// records a command for every entity it processes
+class BenchAddCommandSystem final : public fw::System<BenchAddCommandSystem, BenchCommandView>
+{
+public:
+	void Process(fw::ComponentRange<BenchCommandView>& range) override;
+};
+
+class BenchRemoveCommandSystem final : public fw::System<BenchRemoveCommandSystem, BenchMassCommandView>
+{
+public:
+	void Process(fw::ComponentRange<BenchMassCommandView>& range) override;
+};
+
+// moves tagged transforms so that the transform system has work to do
+class BenchMoverSystem final : public fw::System<BenchMoverSystem, BenchMoverView>
+{
+public:
+	BenchMoverSystem();
+
+	void Process(fw::ComponentRange<BenchMoverView>& range) override;
+};
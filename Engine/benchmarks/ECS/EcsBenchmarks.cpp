@@ -0,0 +1,346 @@
+#include <EtFramework/stdafx.h>
+#include "EcsBenchmarks.h"
+
+#include "EcsBenchmarkUtilities.h"
+
+#include <BenchmarkReport.h>
+
+#include <EtCore/Concurrency/WorkerPool.h>
+#include <EtCore/UpdateCycle/HighResTime.h>
+
+#include <EtFramework/ECS/EcsCommandBuffer.h>
+
+
+namespace et {
+namespace bench {
+
+
+namespace {
+
+	// so that small entity counts still run long enough to give stable timings
+	size_t const s_EntityIterationBudget = 1000000u;
+
+	// wide hierachies keep reparenting from being dominated by searches through huge child lists
+	size_t const s_ChildrenPerParent = 8u;
+
+
+	//---------------------------------
+	// GetIterationCount
+	//
+	uint32 GetIterationCount(size_t const entityCount)
+	{
+		return static_cast<uint32>(std::max(s_EntityIterationBudget / std::max(entityCount, static_cast<size_t>(1u)), static_cast<size_t>(1u)));
+	}
+
+	//---------------------------------
+	// MeasureNs
+	//
+	// Time a function in nanoseconds
+	//
+	template<typename TFunction>
+	uint64 MeasureNs(TFunction const& fn)
+	{
+		core::HighResTime const start = core::HighResTime::Now();
+		fn();
+		return core::HighResDuration::Diff(start, core::HighResTime::Now()).NanoSeconds();
+	}
+
+	//---------------------------------
+	// MeasureProcessNs
+	//
+	// Time processing all registered systems several times
+	//
+	uint64 MeasureProcessNs(fw::EcsController& ecs, uint32 const iterations)
+	{
+		ecs.Process(); // warm up, the first run schedules systems and processes every chunk
+
+		return MeasureNs([&ecs, iterations]()
+			{
+				for (uint32 it = 0u; it < iterations; ++it)
+				{
+					ecs.Process();
+				}
+			});
+	}
+
+	//---------------------------------
+	// SpawnSimulationEntities
+	//
+	// Entities with all four simulation components
+	//
+	void SpawnSimulationEntities(fw::EcsController& ecs, size_t const entityCount)
+	{
+		BenchPosition pos;
+		BenchVelocity vel;
+		BenchMass mass;
+		BenchHealth health;
+		ecs.SpawnEntities(entityCount, pos, vel, mass, health);
+	}
+
+	//---------------------------------
+	// SpawnParents
+	//
+	// Enough parents to spread the entity count over them
+	//
+	std::vector<fw::T_EntityId> SpawnParents(fw::EcsController& ecs, size_t const entityCount)
+	{
+		BenchRootTag tag;
+		return ecs.SpawnEntities(std::max(entityCount / s_ChildrenPerParent, static_cast<size_t>(1u)), tag);
+	}
+
+	//---------------------------------
+	// RegisterTransformEvents
+	//
+	// Transform components need render scene nodes like they would get in the unified scene
+	//
+	void RegisterTransformEvents(fw::EcsController& ecs)
+	{
+		ecs.RegisterOnComponentAdded(fw::T_CompEventFn<fw::TransformComponent>(fw::TransformSystem::OnComponentAdded));
+		ecs.RegisterOnComponentRemoved(fw::T_CompEventFn<fw::TransformComponent>(fw::TransformSystem::OnComponentRemoved));
+	}
+
+
+	//---------------------------------
+	// BenchEntities
+	//
+	// Adding and removing entities one by one, and adding them in bulk
+	//
+	void BenchEntities(BenchmarkReport& report, core::WorkerPool* const workerPool, size_t const entityCount)
+	{
+		fw::EcsController ecs;
+		ecs.SetWorkerPool(workerPool);
+
+		BenchPosition pos;
+		BenchVelocity vel;
+
+		std::vector<fw::T_EntityId> entities;
+		entities.reserve(entityCount);
+		report.Add("entity_add", entityCount, 1u, MeasureNs([&ecs, &entities, &pos, &vel, entityCount]()
+			{
+				for (size_t idx = 0u; idx < entityCount; ++idx)
+				{
+					entities.emplace_back(ecs.AddEntity(pos, vel));
+				}
+			}));
+
+		report.Add("entity_remove", entityCount, 1u, MeasureNs([&ecs, &entities]()
+			{
+				for (fw::T_EntityId const entity : entities)
+				{
+					ecs.RemoveEntity(entity);
+				}
+			}));
+
+		report.Add("entity_spawn_batched", entityCount, 1u, MeasureNs([&ecs, &entities, &pos, &vel, entityCount]()
+			{
+				entities = ecs.SpawnEntities(entityCount, pos, vel);
+			}));
+
+		ecs.RemoveAllEntities();
+	}
+
+	//---------------------------------
+	// BenchComponents
+	//
+	// Adding and removing components moves entities between archetypes
+	//
+	void BenchComponents(BenchmarkReport& report, core::WorkerPool* const workerPool, size_t const entityCount)
+	{
+		fw::EcsController ecs;
+		ecs.SetWorkerPool(workerPool);
+
+		BenchPosition pos;
+		BenchVelocity vel;
+		std::vector<fw::T_EntityId> const entities = ecs.SpawnEntities(entityCount, pos, vel);
+
+		BenchMass mass;
+		report.Add("component_add", entityCount, 1u, MeasureNs([&ecs, &entities, &mass]()
+			{
+				for (fw::T_EntityId const entity : entities)
+				{
+					ecs.AddComponents(entity, mass);
+				}
+			}));
+
+		report.Add("component_remove", entityCount, 1u, MeasureNs([&ecs, &entities]()
+			{
+				for (fw::T_EntityId const entity : entities)
+				{
+					ecs.RemoveComponents<BenchMass>(entity);
+				}
+			}));
+
+		ecs.RemoveAllEntities();
+	}
+
+	//---------------------------------
+	// BenchIteration
+	//
+	// Systems iterating views with one to four components, and the equivalent query
+	//
+	template<typename TSystemType>
+	void BenchIterationSystem(BenchmarkReport& report,
+		core::WorkerPool* const workerPool,
+		size_t const entityCount,
+		std::string const& name)
+	{
+		fw::EcsController ecs;
+		ecs.SetWorkerPool(workerPool);
+
+		SpawnSimulationEntities(ecs, entityCount);
+		ecs.RegisterSystem<TSystemType>();
+
+		uint32 const iterations = GetIterationCount(entityCount);
+		report.Add(name, entityCount, iterations, MeasureProcessNs(ecs, iterations));
+
+		ecs.RemoveAllEntities();
+	}
+
+	void BenchIteration(BenchmarkReport& report, core::WorkerPool* const workerPool, size_t const entityCount)
+	{
+		BenchIterationSystem<BenchIterate1System>(report, workerPool, entityCount, "iterate_view_1");
+		BenchIterationSystem<BenchIterate2System>(report, workerPool, entityCount, "iterate_view_2");
+		BenchIterationSystem<BenchIterate3System>(report, workerPool, entityCount, "iterate_view_3");
+		BenchIterationSystem<BenchIterate4System>(report, workerPool, entityCount, "iterate_view_4");
+		BenchIterationSystem<BenchQuery2System>(report, workerPool, entityCount, "iterate_query_2");
+	}
+
+	//---------------------------------
+	// BenchHierachy
+	//
+	// Reparenting within a hierachy layer only updates entity data, moving to a different layer shifts the entity within its archetype
+	//
+	void BenchHierachy(BenchmarkReport& report, core::WorkerPool* const workerPool, size_t const entityCount)
+	{
+		fw::EcsController ecs;
+		ecs.SetWorkerPool(workerPool);
+
+		std::vector<fw::T_EntityId> const parents = SpawnParents(ecs, entityCount);
+
+		BenchPosition pos;
+		BenchVelocity vel;
+
+		std::vector<fw::T_EntityId> entities;
+		entities.reserve(entityCount);
+		for (size_t idx = 0u; idx < entityCount; ++idx)
+		{
+			entities.emplace_back(ecs.AddEntityChild(parents[idx % parents.size()], pos, vel));
+		}
+
+		report.Add("hierachy_reparent_same_layer", entityCount, 1u, MeasureNs([&ecs, &entities, &parents]()
+			{
+				for (size_t idx = 0u; idx < entities.size(); ++idx)
+				{
+					ecs.ReparentEntity(entities[idx], parents[(idx + 1u) % parents.size()]);
+				}
+			}));
+
+		report.Add("hierachy_reparent_to_root", entityCount, 1u, MeasureNs([&ecs, &entities]()
+			{
+				for (fw::T_EntityId const entity : entities)
+				{
+					ecs.ReparentEntity(entity, fw::INVALID_ENTITY_ID);
+				}
+			}));
+
+		report.Add("hierachy_reparent_to_child", entityCount, 1u, MeasureNs([&ecs, &entities, &parents]()
+			{
+				for (size_t idx = 0u; idx < entities.size(); ++idx)
+				{
+					ecs.ReparentEntity(entities[idx], parents[idx % parents.size()]);
+				}
+			}));
+
+		ecs.RemoveAllEntities();
+	}
+
+	//---------------------------------
+	// BenchCommandBuffers
+	//
+	// Systems recording a structural change per entity, which are merged at the end of the process call
+	//
+	void BenchCommandBuffers(BenchmarkReport& report, core::WorkerPool* const workerPool, size_t const entityCount)
+	{
+		fw::EcsController ecs;
+		ecs.SetWorkerPool(workerPool);
+
+		BenchPosition pos;
+		BenchVelocity vel;
+		ecs.SpawnEntities(entityCount, pos, vel);
+
+		// the first process adds a mass component to every entity, the second one removes it again
+		ecs.RegisterSystem<BenchAddCommandSystem>();
+		report.Add("command_buffer_merge_add", entityCount, 1u, MeasureNs([&ecs]()
+			{
+				ecs.Process();
+			}));
+		ecs.UnregisterSystem<BenchAddCommandSystem>();
+
+		ecs.RegisterSystem<BenchRemoveCommandSystem>();
+		report.Add("command_buffer_merge_remove", entityCount, 1u, MeasureNs([&ecs]()
+			{
+				ecs.Process();
+			}));
+		ecs.UnregisterSystem<BenchRemoveCommandSystem>();
+
+		ecs.RemoveAllEntities();
+	}
+
+	//---------------------------------
+	// BenchTransformSystem
+	//
+	// Transform hierachy of roots with children, either moving every frame or static
+	//
+	void BenchTransformSystem(BenchmarkReport& report,
+		core::WorkerPool* const workerPool,
+		size_t const entityCount,
+		bool const moving,
+		std::string const& name)
+	{
+		fw::EcsController ecs;
+		ecs.SetWorkerPool(workerPool);
+		RegisterTransformEvents(ecs);
+
+		fw::TransformComponent transf;
+
+		size_t const rootCount = std::max(entityCount / s_ChildrenPerParent, static_cast<size_t>(1u));
+		BenchRootTag tag;
+		std::vector<fw::T_EntityId> const roots = ecs.SpawnEntities(rootCount, transf, tag);
+		for (size_t idx = rootCount; idx < entityCount; ++idx)
+		{
+			ecs.AddEntityChild(roots[idx % rootCount], transf);
+		}
+
+		// the mover declares the transform system as a dependent, so it needs to be registered after it
+		ecs.RegisterSystem<fw::TransformSystem::Compute>();
+		if (moving)
+		{
+			ecs.RegisterSystem<BenchMoverSystem>();
+		}
+
+		uint32 const iterations = GetIterationCount(entityCount);
+		report.Add(name, entityCount, iterations, MeasureProcessNs(ecs, iterations));
+
+		ecs.RemoveAllEntities();
+	}
+
+} // namespace
+
+
+//---------------------------------
+// RunEcsBenchmarks
+//
+void RunEcsBenchmarks(BenchmarkReport& report, core::WorkerPool* const workerPool, size_t const entityCount)
+{
+	BenchEntities(report, workerPool, entityCount);
+	BenchComponents(report, workerPool, entityCount);
+	BenchIteration(report, workerPool, entityCount);
+	BenchHierachy(report, workerPool, entityCount);
+	BenchCommandBuffers(report, workerPool, entityCount);
+	BenchTransformSystem(report, workerPool, entityCount, true, "process_transform_moving");
+	BenchTransformSystem(report, workerPool, entityCount, false, "process_transform_static");
+}
+
+
+} // namespace bench
+} // namespace et
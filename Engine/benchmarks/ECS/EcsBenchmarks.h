@@ -0,0 +1,24 @@
+#pragma once
+
+
+namespace et {
+namespace core {
+	class WorkerPool;
+}
+namespace bench {
+
+
+class BenchmarkReport;
+
+
+//---------------------------------
+// RunEcsBenchmarks
+//
+// Measures entity component system throughput for a given number of entities and adds the results to the report
+//  - a null worker pool processes systems serially
+//
+void RunEcsBenchmarks(BenchmarkReport& report, core::WorkerPool* const workerPool, size_t const entityCount);
+
+
+} // namespace bench
+} // namespace et
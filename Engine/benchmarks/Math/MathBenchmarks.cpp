@@ -0,0 +1,165 @@
+#include <EtFramework/stdafx.h>
+#include "MathBenchmarks.h"
+
+#include <BenchmarkReport.h>
+
+#include <EtCore/UpdateCycle/HighResTime.h>
+
+
+namespace et {
+namespace bench {
+
+
+namespace {
+
+	// so that small counts still run long enough to give stable timings
+	size_t const s_OperationBudget = 1000000u;
+
+
+	//---------------------------------
+	// GetIterationCount
+	//
+	uint32 GetIterationCount(size_t const count)
+	{
+		return static_cast<uint32>(std::max(s_OperationBudget / std::max(count, static_cast<size_t>(1u)), static_cast<size_t>(1u)));
+	}
+
+	//---------------------------------
+	// MeasureArrayNs
+	//
+	// Time applying an operation to every element of the input arrays several times
+	//
+	template<typename TOutput, typename TFunction>
+	uint64 MeasureArrayNs(std::vector<TOutput>& output, uint32 const iterations, TFunction const& fn)
+	{
+		core::HighResTime const start = core::HighResTime::Now();
+		for (uint32 it = 0u; it < iterations; ++it)
+		{
+			for (size_t idx = 0u; idx < output.size(); ++idx)
+			{
+				output[idx] = fn(idx);
+			}
+		}
+
+		return core::HighResDuration::Diff(start, core::HighResTime::Now()).NanoSeconds();
+	}
+
+	//---------------------------------
+	// GenMatrix
+	//
+	// Invertible transform matrices that differ per element
+	//
+	mat4 GenMatrix(size_t const idx)
+	{
+		float const f = static_cast<float>(idx % 97u);
+		return math::scale(vec3(1.f + f * 0.01f)) 
+			* math::rotate(quat(math::normalize(vec3(0.3f, 1.f, f * 0.1f)), f * 0.05f)) 
+			* math::translate(vec3(f, -f, 0.5f * f));
+	}
+
+	//---------------------------------
+	// GenQuat
+	//
+	quat GenQuat(size_t const idx)
+	{
+		float const f = static_cast<float>(idx % 89u);
+		return quat(math::normalize(vec3(f * 0.1f, 1.f, -0.4f)), f * 0.07f);
+	}
+
+} // namespace
+
+
+//---------------------------------
+// RunMathBenchmarks
+//
+void RunMathBenchmarks(BenchmarkReport& report, size_t const count)
+{
+	if (count == 0u)
+	{
+		return;
+	}
+
+	std::vector<mat4> matrices;
+	std::vector<quat> quats;
+	std::vector<vec4> vectors;
+	matrices.reserve(count);
+	quats.reserve(count);
+	vectors.reserve(count);
+	for (size_t idx = 0u; idx < count; ++idx)
+	{
+		matrices.emplace_back(GenMatrix(idx));
+		quats.emplace_back(GenQuat(idx));
+		vectors.emplace_back(static_cast<float>(idx % 13u), 1.f, -2.f, 1.f);
+	}
+
+	std::vector<mat4> outMatrices(count);
+	std::vector<quat> outQuats(count);
+	std::vector<vec4> outVectors(count);
+	std::vector<vec3> outVec3s(count);
+
+	uint32 const iterations = GetIterationCount(count);
+	size_t const last = count - 1u;
+
+	// matrix - matrix
+	report.Add("math_mat4_mul", count, iterations, MeasureArrayNs(outMatrices, iterations, [&matrices, last](size_t const idx)
+		{
+			return matrices[idx] * matrices[last - idx];
+		}));
+	report.Add("math_mat4_mul_scalar", count, iterations, MeasureArrayNs(outMatrices, iterations, [&matrices, last](size_t const idx)
+		{
+			return math::operator*<4u, 4u, float>(matrices[idx], matrices[last - idx]);
+		}));
+
+	// matrix - vector
+	report.Add("math_mat4_mul_vec4", count, iterations, MeasureArrayNs(outVectors, iterations, [&matrices, &vectors](size_t const idx)
+		{
+			return matrices[idx] * vectors[idx];
+		}));
+	report.Add("math_mat4_mul_vec4_scalar", count, iterations, MeasureArrayNs(outVectors, iterations, [&matrices, &vectors](size_t const idx)
+		{
+			return math::operator*<4u, 4u, float>(matrices[idx], vectors[idx]);
+		}));
+
+	// inverse
+	report.Add("math_mat4_inverse", count, iterations, MeasureArrayNs(outMatrices, iterations, [&matrices](size_t const idx)
+		{
+			return math::inverse(matrices[idx]);
+		}));
+	report.Add("math_mat4_inverse_scalar", count, iterations, MeasureArrayNs(outMatrices, iterations, [&matrices](size_t const idx)
+		{
+			return math::inverse<float>(matrices[idx]);
+		}));
+
+	// quaternions
+	report.Add("math_quat_mul", count, iterations, MeasureArrayNs(outQuats, iterations, [&quats, last](size_t const idx)
+		{
+			return quats[idx] * quats[last - idx];
+		}));
+	report.Add("math_quat_mul_scalar", count, iterations, MeasureArrayNs(outQuats, iterations, [&quats, last](size_t const idx)
+		{
+			return math::operator*<float>(quats[idx], quats[last - idx]);
+		}));
+
+	report.Add("math_quat_rotate", count, iterations, MeasureArrayNs(outVec3s, iterations, [&quats, &vectors](size_t const idx)
+		{
+			return quats[idx] * vectors[idx].xyz;
+		}));
+	report.Add("math_quat_rotate_scalar", count, iterations, MeasureArrayNs(outVec3s, iterations, [&quats, &vectors](size_t const idx)
+		{
+			return math::operator*<float>(quats[idx], vectors[idx].xyz);
+		}));
+
+	// normalization
+	report.Add("math_vec4_normalize", count, iterations, MeasureArrayNs(outVectors, iterations, [&vectors](size_t const idx)
+		{
+			return math::normalize(vectors[idx]);
+		}));
+	report.Add("math_vec4_normalize_scalar", count, iterations, MeasureArrayNs(outVectors, iterations, [&vectors](size_t const idx)
+		{
+			return math::normalize<4u, float>(vectors[idx]);
+		}));
+}
+
+
+} // namespace bench
+} // namespace et
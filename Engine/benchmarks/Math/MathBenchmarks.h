@@ -0,0 +1,21 @@
+#pragma once
+
+
+namespace et {
+namespace bench {
+
+
+class BenchmarkReport;
+
+
+//---------------------------------
+// RunMathBenchmarks
+//
+// Measures throughput of common 4x4 float math operations over arrays of the given size, both for the default implementation 
+//  - which uses SIMD unless ETM_NO_SIMD is defined - and for the generic scalar templates
+//
+void RunMathBenchmarks(BenchmarkReport& report, size_t const count);
+
+
+} // namespace bench
+} // namespace et
@@ -0,0 +1,136 @@
+#include <EtFramework/stdafx.h>
+
+#include <vector>
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#include "BenchmarkReport.h"
+
+#include <EtCore/FileSystem/FileUtil.h>
+#include <EtCore/Concurrency/WorkerPool.h>
+
+#include "ECS/EcsBenchmarks.h"
+#include "Math/MathBenchmarks.h"
+
+
+#ifndef ET_ENGINE_VERSION
+#	define ET_ENGINE_VERSION "unknown"
+#endif
+
+
+//---------------------------------
+// main
+//
+// Usage: ecs_benchmarks [--format csv|json] [--counts 10000,100000,1000000] [--workers N] [--out path]
+//  - zero workers processes systems serially
+//
+int main(int argc, char* argv[])
+{
+	using namespace et;
+
+	// working dir
+	if (argc > 0)
+	{
+		core::FileUtil::SetExecutablePath(argv[0]);
+	}
+	else
+	{
+		std::cerr << "main > Couldn't extract working directory from arguments, exiting!" << std::endl;
+		return 1;
+	}
+
+	bench::BenchmarkReport::E_Format format = bench::BenchmarkReport::E_Format::Csv;
+	std::vector<size_t> entityCounts({ 10000u, 100000u, 1000000u });
+	size_t workerCount = 0u;
+	std::string outPath;
+
+	for (int32 argIdx = 1; argIdx < argc; ++argIdx)
+	{
+		std::string const arg(argv[argIdx]);
+		if (argIdx + 1 >= argc)
+		{
+			std::cerr << "main > Missing value for argument '" << arg << "', exiting!" << std::endl;
+			return 2;
+		}
+
+		std::string const value(argv[++argIdx]);
+		if (arg == "--format")
+		{
+			if (value == "csv")
+			{
+				format = bench::BenchmarkReport::E_Format::Csv;
+			}
+			else if (value == "json")
+			{
+				format = bench::BenchmarkReport::E_Format::Json;
+			}
+			else
+			{
+				std::cerr << "main > Unknown format '" << value << "', exiting!" << std::endl;
+				return 3;
+			}
+		}
+		else if (arg == "--counts")
+		{
+			entityCounts.clear();
+
+			std::stringstream stream(value);
+			std::string count;
+			while (std::getline(stream, count, ','))
+			{
+				entityCounts.emplace_back(static_cast<size_t>(std::stoull(count)));
+			}
+		}
+		else if (arg == "--workers")
+		{
+			workerCount = static_cast<size_t>(std::stoull(value));
+		}
+		else if (arg == "--out")
+		{
+			outPath = value;
+		}
+		else
+		{
+			std::cerr << "main > Unknown argument '" << arg << "', exiting!" << std::endl;
+			return 4;
+		}
+	}
+
+	core::WorkerPool* workerPool = nullptr;
+	if (workerCount > 0u)
+	{
+		workerPool = new core::WorkerPool(workerCount);
+	}
+
+	bench::BenchmarkReport report(ET_ENGINE_VERSION, workerCount);
+	for (size_t const entityCount : entityCounts)
+	{
+		std::cerr << "main > Running ECS benchmarks with " << entityCount << " entities" << std::endl;
+		bench::RunEcsBenchmarks(report, workerPool, entityCount);
+
+		std::cerr << "main > Running math benchmarks with " << entityCount << " elements" << std::endl;
+		bench::RunMathBenchmarks(report, entityCount);
+	}
+
+	delete workerPool;
+
+	if (outPath.empty())
+	{
+		report.Write(std::cout, format);
+	}
+	else
+	{
+		std::ofstream file(outPath, std::ios::out | std::ios::trunc);
+		if (!file.is_open())
+		{
+			std::cerr << "main > Couldn't open output file '" << outPath << "', exiting!" << std::endl;
+			return 5;
+		}
+
+		report.Write(file, format);
+	}
+
+	return 0;
+}
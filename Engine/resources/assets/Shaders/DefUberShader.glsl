@@ -12,18 +12,18 @@
 	out vec3 Tangent;
 	out vec2 Texcoord;
 	
-	uniform mat4 model;
+	in mat4 instanceModel; // per instance transform
 	
 	void main()
 	{
 		Texcoord = texcoord;
 		
-		mat3 normMat = inverse(mat3(model));
+		mat3 normMat = inverse(mat3(instanceModel));
 		normMat = transpose(normMat);
 		Normal = normalize(normMat*normal);
 		Tangent = normalize(normMat*tangent);
 		
-		vec4 pos = model*vec4(position, 1.0);
+		vec4 pos = instanceModel*vec4(position, 1.0);
 		Position = vec3(pos.x, pos.y, pos.z);
 		gl_Position = viewProjection*pos;
 	}
@@ -0,0 +1,18 @@
+<VERTEX>
+	#version 330 core
+	
+	in vec3 position;
+	in mat4 instanceModel; // per instance transform
+	
+	uniform mat4 worldViewProj; // light view projection of the shadow cascade
+	
+	void main()
+	{
+		vec4 pos = instanceModel*vec4(position, 1.0);
+		pos = worldViewProj *pos;
+		gl_Position = pos;
+	}
+</VERTEX>
+<FRAGMENT>
+	#disable
+</FRAGMENT>
\ No newline at end of file
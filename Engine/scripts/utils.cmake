@@ -203,6 +203,11 @@ function(target_definitions)
 	 else() 
 		add_definitions(-DET_ARCH_X32)
 	endif()
+
+	# math
+	if(ETM_NO_SIMD)
+		add_definitions(-DETM_NO_SIMD)
+	endif()
 endfunction(target_definitions)
 
 
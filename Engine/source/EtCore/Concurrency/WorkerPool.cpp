@@ -0,0 +1,158 @@
+#include "stdafx.h"
+#include "WorkerPool.h"
+
+
+namespace et {
+namespace core {
+
+
+//=============
+// Worker Pool
+//=============
+
+
+//--------------------------------------
+// WorkerPool::GetDefaultWorkerCount
+//
+// One thread per hardware core, leaving a core for the thread that pushes jobs
+//
+size_t WorkerPool::GetDefaultWorkerCount()
+{
+	size_t const hardwareThreads = static_cast<size_t>(std::thread::hardware_concurrency());
+	return (hardwareThreads > 1u) ? (hardwareThreads - 1u) : 0u;
+}
+
+//-------------------
+// WorkerPool::c-tor
+//
+WorkerPool::WorkerPool()
+	: WorkerPool(GetDefaultWorkerCount())
+{ }
+
+//-------------------
+// WorkerPool::c-tor
+//
+// A worker count of zero is valid, in that case jobs only execute while a thread waits on them
+//
+WorkerPool::WorkerPool(size_t const workerCount)
+{
+	m_Workers.reserve(workerCount);
+	for (size_t idx = 0u; idx < workerCount; ++idx)
+	{
+		m_Workers.emplace_back(&WorkerPool::WorkerLoop, this);
+	}
+}
+
+//-------------------
+// WorkerPool::d-tor
+//
+// Workers finish the jobs that are still queued before joining
+//
+WorkerPool::~WorkerPool()
+{
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		m_IsRunning = false;
+	}
+
+	m_QueueCondition.notify_all();
+
+	for (std::thread& worker : m_Workers)
+	{
+		worker.join();
+	}
+
+	ET_ASSERT(m_Queue.empty());
+}
+
+//------------------
+// WorkerPool::Push
+//
+// Queue a job for execution - the group is considered done once all of its jobs have finished
+//
+void WorkerPool::Push(T_Job const& job, JobGroup& group)
+{
+	group.m_Pending.fetch_add(1u, std::memory_order_relaxed);
+
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		m_Queue.emplace_back(job, &group);
+	}
+
+	m_QueueCondition.notify_one();
+}
+
+//------------------
+// WorkerPool::Wait
+//
+// Block until all jobs in the group finished, executing queued jobs in the meantime
+//
+void WorkerPool::Wait(JobGroup& group)
+{
+	while (!group.IsDone())
+	{
+		if (!TryExecuteJob())
+		{
+			std::this_thread::yield();
+		}
+	}
+}
+
+//------------------------
+// WorkerPool::WorkerLoop
+//
+// Entry point of worker threads - sleep until jobs get queued
+//
+void WorkerPool::WorkerLoop()
+{
+	for (;;)
+	{
+		std::unique_lock<std::mutex> lock(m_Mutex);
+		m_QueueCondition.wait(lock, [this]() { return (!m_IsRunning || !m_Queue.empty()); });
+
+		if (m_Queue.empty()) // only happens once we stop running
+		{
+			return;
+		}
+
+		QueuedJob queued = std::move(m_Queue.front());
+		m_Queue.pop_front();
+		lock.unlock();
+
+		ExecuteJob(queued);
+	}
+}
+
+//---------------------------
+// WorkerPool::TryExecuteJob
+//
+// Execute the oldest job on the calling thread, returns false if there was nothing to do
+//
+bool WorkerPool::TryExecuteJob()
+{
+	std::unique_lock<std::mutex> lock(m_Mutex);
+	if (m_Queue.empty())
+	{
+		return false;
+	}
+
+	QueuedJob queued = std::move(m_Queue.front());
+	m_Queue.pop_front();
+	lock.unlock();
+
+	ExecuteJob(queued);
+	return true;
+}
+
+//------------------------
+// WorkerPool::ExecuteJob
+//
+void WorkerPool::ExecuteJob(QueuedJob& queued)
+{
+	queued.job();
+	queued.group->m_Pending.fetch_sub(1u, std::memory_order_acq_rel);
+}
+
+
+} // namespace core
+} // namespace et
@@ -0,0 +1,99 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+
+namespace et {
+namespace core {
+
+
+//---------------------------------
+// WorkerPool
+//
+// Fixed set of threads that execute jobs pushed from any thread
+//  - a thread waiting on a job group takes part in executing queued jobs, so jobs may safely push and wait on nested jobs
+//
+class WorkerPool final
+{
+	// definitions
+	//-------------
+public:
+	typedef std::function<void()> T_Job;
+
+	//---------------------------------
+	// WorkerPool::JobGroup
+	//
+	// Counts jobs that haven't finished executing yet, so that a caller can wait for a batch of work
+	//
+	class JobGroup final
+	{
+		friend class WorkerPool;
+
+	public:
+		JobGroup() = default;
+		JobGroup(JobGroup const&) = delete;
+		void operator=(JobGroup const&) = delete;
+
+		bool IsDone() const { return (m_Pending.load(std::memory_order_acquire) == 0u); }
+
+	private:
+		std::atomic<size_t> m_Pending{ 0u };
+	};
+
+private:
+	struct QueuedJob final
+	{
+		QueuedJob(T_Job const& fn, JobGroup* const grp) : job(fn), group(grp) {}
+
+		T_Job job;
+		JobGroup* group = nullptr;
+	};
+
+	// static
+	//--------
+public:
+	static size_t GetDefaultWorkerCount();
+
+	// construct destruct
+	//--------------------
+	WorkerPool();
+	WorkerPool(size_t const workerCount);
+	~WorkerPool();
+
+	WorkerPool(WorkerPool const&) = delete;
+	void operator=(WorkerPool const&) = delete;
+
+	// accessors
+	//-----------
+	size_t GetWorkerCount() const { return m_Workers.size(); }
+
+	// functionality
+	//---------------
+	void Push(T_Job const& job, JobGroup& group);
+	void Wait(JobGroup& group);
+
+	// utility
+	//---------
+private:
+	void WorkerLoop();
+	bool TryExecuteJob();
+	static void ExecuteJob(QueuedJob& queued);
+
+	// Data
+	///////
+
+	std::vector<std::thread> m_Workers;
+
+	std::deque<QueuedJob> m_Queue;
+	std::mutex m_Mutex;
+	std::condition_variable m_QueueCondition;
+	bool m_IsRunning = true;
+};
+
+
+} // namespace core
+} // namespace et
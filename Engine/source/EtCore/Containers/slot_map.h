@@ -142,6 +142,9 @@ public:
 	std::pair<iterator, id_type> insert(TType const& value) { return insert_impl(value); }
 	std::pair<iterator, id_type> insert(TType&& moving_value) { return insert_impl(std::move(moving_value)); }
 
+	// add count copies of an element in one go, appending their new IDs to the list
+	void insert(size_type const count, TType const& value, std::vector<id_type>& ids);
+
 	// remove an element from the map
 	void erase(id_type const id);
 	iterator erase(iterator const it); // return an iterator to the next element
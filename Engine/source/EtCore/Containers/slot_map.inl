@@ -151,10 +151,12 @@ typename slot_map<TType>::const_iterator slot_map<TType>::get_iterator(id_type c
 //--------------------
 // slot_map::is_valid
 //
+// Erased IDs are part of the free list, so their index can still point into the data - the reverse mapping tells them apart
+//
 template <class TType>
 bool slot_map<TType>::is_valid(id_type const id) const
 {
-	return (id < m_Indices.size()) && (m_Indices[id] < m_Data.size());
+	return (id < m_Indices.size()) && (m_Indices[id] < m_Data.size()) && (m_IndexPositions[m_Indices[id]] == id);
 }
 
 
@@ -313,6 +315,23 @@ typename slot_map<TType>::size_type slot_map<TType>::capacity() const
 // functionality
 //////////////////
 
+//--------------------
+// slot_map::insert
+//
+// Reserves space for all elements before inserting them
+//
+template <class TType>
+void slot_map<TType>::insert(size_type const count, TType const& value, std::vector<id_type>& ids)
+{
+	reserve(size() + count);
+	ids.reserve(ids.size() + static_cast<size_t>(count));
+
+	for (size_type idx = 0u; idx < count; ++idx)
+	{
+		ids.push_back(insert_impl(TType(value)).second);
+	}
+}
+
 //--------------------
 // slot_map::erase
 //
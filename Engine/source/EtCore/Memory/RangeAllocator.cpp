@@ -0,0 +1,102 @@
+#include "stdafx.h"
+#include "RangeAllocator.h"
+
+
+namespace et {
+namespace core {
+
+
+//=================
+// Range Allocator
+//=================
+
+
+//---------------------------------
+// RangeAllocator::Allocate
+//
+// Reuse the first released range that is large enough, or append a new range at the end
+//
+size_t RangeAllocator::Allocate(size_t const size)
+{
+	ET_ASSERT(size > 0u);
+
+	size_t offset = s_InvalidOffset;
+
+	auto const freeIt = std::find_if(m_FreeRanges.begin(), m_FreeRanges.end(), [size](Range const& freeRange)
+		{
+			return (freeRange.size >= size);
+		});
+
+	if (freeIt != m_FreeRanges.cend())
+	{
+		offset = freeIt->offset;
+
+		freeIt->offset += size;
+		freeIt->size -= size;
+		if (freeIt->size == 0u)
+		{
+			m_FreeRanges.erase(freeIt);
+		}
+	}
+	else if (size <= m_Capacity - m_End)
+	{
+		offset = m_End;
+		m_End += size;
+	}
+	else
+	{
+		return s_InvalidOffset;
+	}
+
+	m_AllocatedSize += size;
+	return offset;
+}
+
+//---------------------------------
+// RangeAllocator::Release
+//
+// Make a range available again, the size must match the size it was allocated with
+//
+void RangeAllocator::Release(size_t const offset, size_t const size)
+{
+	ET_ASSERT(offset + size <= m_End);
+	ET_ASSERT(m_AllocatedSize >= size);
+
+	m_AllocatedSize -= size;
+
+	// insert sorted and merge with neighbours
+	auto rangeIt = std::lower_bound(m_FreeRanges.begin(), m_FreeRanges.end(), offset, [](Range const& freeRange, size_t const rangeOffset)
+		{
+			return (freeRange.offset < rangeOffset);
+		});
+
+	rangeIt = m_FreeRanges.insert(rangeIt, Range{ offset, size });
+
+	auto const afterIt = rangeIt + 1;
+	if ((afterIt != m_FreeRanges.end()) && (rangeIt->offset + rangeIt->size == afterIt->offset))
+	{
+		rangeIt->size += afterIt->size;
+		m_FreeRanges.erase(afterIt);
+	}
+
+	if (rangeIt != m_FreeRanges.begin())
+	{
+		auto const beforeIt = rangeIt - 1;
+		if (beforeIt->offset + beforeIt->size == rangeIt->offset)
+		{
+			beforeIt->size += rangeIt->size;
+			rangeIt = m_FreeRanges.erase(rangeIt) - 1;
+		}
+	}
+
+	// free space at the end is given back so that later allocations can grow into it
+	if (rangeIt->offset + rangeIt->size == m_End)
+	{
+		m_End = rangeIt->offset;
+		m_FreeRanges.erase(rangeIt);
+	}
+}
+
+
+} // namespace core
+} // namespace et
@@ -0,0 +1,62 @@
+#pragma once
+
+
+namespace et {
+namespace core {
+
+
+//---------------------------------
+// RangeAllocator
+//
+// Hands out ranges within a linear address space, such as a GPU buffer, without owning any memory itself
+//  - released ranges are merged with their neighbours and reused first fit, otherwise ranges are appended at the end
+//  - sizes are not aligned, so callers that need aligned offsets should round all sizes up to the alignment
+//
+class RangeAllocator final
+{
+	// definitions
+	//-------------
+public:
+	static constexpr size_t s_InvalidOffset = std::numeric_limits<size_t>::max();
+
+private:
+	//---------------------------------
+	// RangeAllocator::Range
+	//
+	struct Range
+	{
+		size_t offset;
+		size_t size;
+	};
+
+	// construct destruct
+	//--------------------
+public:
+	RangeAllocator(size_t const capacity = std::numeric_limits<size_t>::max()) : m_Capacity(capacity) {}
+
+	// functionality
+	//---------------
+	size_t Allocate(size_t const size); // returns s_InvalidOffset if the range doesn't fit
+	void Release(size_t const offset, size_t const size);
+
+	// accessors
+	//-----------
+	size_t GetCapacity() const { return m_Capacity; }
+	size_t GetEnd() const { return m_End; } // end of the last allocated range
+	size_t GetAllocatedSize() const { return m_AllocatedSize; }
+	bool IsEmpty() const { return (m_AllocatedSize == 0u); }
+
+	// Data
+	///////
+private:
+
+	size_t m_Capacity;
+	size_t m_End = 0u;
+	size_t m_AllocatedSize = 0u;
+
+	std::vector<Range> m_FreeRanges; // sorted by offset, all of them before m_End
+};
+
+
+} // namespace core
+} // namespace et
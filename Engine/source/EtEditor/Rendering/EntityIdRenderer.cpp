@@ -278,7 +278,11 @@ void EntityIdRenderer::DrawEntity(fw::T_EntityId const entity, render::Camera co
 		api->BindVertexArray(surface->GetVertexArray());
 		m_Shader->Upload("model"_hash, transfComp.GetWorld());
 
-		api->DrawElements(E_DrawMode::Triangles, static_cast<uint32>(mesh->GetIndexCount()), mesh->GetIndexDataType(), 0);
+		api->DrawElementsBaseVertex(E_DrawMode::Triangles,
+			static_cast<uint32>(mesh->GetIndexCount()),
+			mesh->GetIndexDataType(),
+			reinterpret_cast<void const*>(static_cast<uintptr_t>(mesh->GetIndexOffset())),
+			mesh->GetBaseVertex());
 	}
 }
 
@@ -182,6 +182,7 @@ void SceneViewport::Init(EditorBase* const editor, Gtk::Frame* const parent)
 
 	// create a scene renderer for the viewport
 	m_SceneRenderer = new render::ShadedSceneRenderer(&(fw::UnifiedScene::Instance().GetRenderScene()));
+	m_SceneRenderer->SetWorkerPool(&(fw::UnifiedScene::Instance().GetWorkerPool()));
 	m_Viewport->SetRenderer(m_SceneRenderer);
 
 	m_Editor->RegisterListener(this);
@@ -78,19 +78,27 @@ public:
 	bool HasTranslationChanged() const { return (m_TransformChanged & E_TransformChanged::Translation); }
 	bool HasRotationChanged() const { return (m_TransformChanged & E_TransformChanged::Rotation); }
 	bool HasScaleChanged() const { return (m_TransformChanged & E_TransformChanged::Scale); }
-	bool HasTransformChanged() const { return (m_TransformChanged != E_TransformChanged::None); }
+	bool HasTransformChanged() const { return (m_TransformChanged != E_TransformChanged::None); } // local changes the transform system hasn't applied yet
+
+	bool HasWorldChangedSince(T_ChangeVersion const version) const { return (m_WorldVersion > version); }
 
 	// Data
 	///////
 
 private:
-	vec3 m_Position;
-	vec3 m_WorldPosition;
+	// the transform system reads the change state and local transform of every entity, so they are kept together at the start
+	T_TransformChanged m_TransformChanged = E_TransformChanged::None;
+	T_ChangeVersion m_WorldVersion = 0u; // system run in which the world transform was last updated
 
 	quat m_Rotation;
-	quat m_WorldRotation;
-
+	vec3 m_Position;
 	vec3 m_Scale = vec3(1.f);
+
+	// world data is only written for entities that changed
+	core::T_SlotId m_NodeId = core::INVALID_SLOT_ID;
+
+	vec3 m_WorldPosition;
+	quat m_WorldRotation;
 	vec3 m_WorldScale = vec3(1.f);
 
 	vec3 m_Forward = vec3::FORWARD;
@@ -98,9 +106,6 @@ private:
 	vec3 m_Right = vec3::RIGHT;
 
 	mat4 m_WorldTransform;
-
-	T_TransformChanged m_TransformChanged = E_TransformChanged::None;
-	core::T_SlotId m_NodeId = core::INVALID_SLOT_ID;
 };
 
 
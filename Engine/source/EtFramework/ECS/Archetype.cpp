@@ -15,9 +15,13 @@ namespace fw {
 // Archetype::c-tor
 //
 // Generate component pools and an index list for the provided signature
+//  - the pools are laid out so that every chunk contains the same number of entities, with each components array starting on a cache line
 //
-Archetype::Archetype(ComponentSignature const& sig) 
+Archetype::Archetype(ComponentSignature const& sig, ChunkPool& chunkPool) 
 	: m_Signature(sig)
+	, m_SignatureId(sig.GenId())
+	, m_Types(sig.GetTypes())
+	, m_ChunkPool(chunkPool)
 {
 	// fill the mapping vector so there is a value for each type index in the signature
 	T_CompTypeIdx const max = m_Signature.GetMaxComponentType();
@@ -26,15 +30,52 @@ Archetype::Archetype(ComponentSignature const& sig)
 		m_Mapping = std::vector<T_CompTypeIdx>(max + 1u, INVALID_COMP_TYPE_IDX);
 	}
 
+	T_CompTypeList const& types = m_Types;
+	if (types.empty())
+	{
+		return; // entities without components don't need any storage
+	}
+
+	// figure out how many entities fit into a chunk, leaving space for padding between the component arrays
+	size_t entitySize = 0u;
+	for (T_CompTypeIdx const compType : types)
+	{
+		entitySize += ComponentRegistry::Instance().GetSize(compType);
+	}
+
+	size_t const padding = (types.size() - 1u) * (ChunkPool::s_Alignment - 1u);
+	ET_ASSERT(entitySize + padding <= ChunkPool::s_ChunkSize, "components of an entity don't fit into a single chunk");
+
+	m_ChunkCapacity = (ChunkPool::s_ChunkSize - padding) / entitySize;
+	m_LayerStash.resize(entitySize + padding); // same padding as in chunks, so that the stashed components are aligned
+	m_PoolVersions.resize(types.size(), 0u);
+
 	// we will add a pool for each type in the signature
-	m_ComponentPools.reserve(m_Signature.GetTypes().size());
+	m_ComponentPools.reserve(types.size());
 
 	// create pools and direct the mapping vector to those pools
 	T_CompTypeIdx mappingIdx = 0u;
-	for (T_CompTypeIdx const compType : m_Signature.GetTypes())
+	size_t chunkOffset = 0u;
+	for (T_CompTypeIdx const compType : types)
 	{
-		m_ComponentPools.emplace_back(compType);
+		m_ComponentPools.emplace_back(compType, m_Chunks, chunkOffset, m_ChunkCapacity);
 		m_Mapping[compType] = mappingIdx++;
+
+		chunkOffset += m_ChunkCapacity * ComponentRegistry::Instance().GetSize(compType);
+		chunkOffset = (chunkOffset + ChunkPool::s_Alignment - 1u) & ~(ChunkPool::s_Alignment - 1u);
+	}
+}
+
+//-------------------
+// Archetype::d-tor
+//
+// Return chunks to the pool
+//
+Archetype::~Archetype()
+{
+	for (uint8* const chunk : m_Chunks)
+	{
+		m_ChunkPool.Free(chunk);
 	}
 }
 
@@ -84,71 +125,520 @@ T_EntityId Archetype::GetEntity(size_t const idx) const
 	return m_Entities[idx];
 }
 
+//--------------------------
+// Archetype::GetLayerBegin
+//
+size_t Archetype::GetLayerBegin(size_t const layer) const
+{
+	if (layer == 0u)
+	{
+		return 0u;
+	}
+
+	if (layer > m_LayerEnds.size())
+	{
+		return m_Entities.size();
+	}
+
+	return m_LayerEnds[layer - 1u];
+}
+
+//------------------------
+// Archetype::GetLayerEnd
+//
+size_t Archetype::GetLayerEnd(size_t const layer) const
+{
+	if (layer >= m_LayerEnds.size())
+	{
+		return m_Entities.size();
+	}
+
+	return m_LayerEnds[layer];
+}
+
+//---------------------
+// Archetype::GetLayer
+//
+// Hierachy layer of the entity stored at an index
+//
+uint8 Archetype::GetLayer(size_t const idx) const
+{
+	ET_ASSERT(idx < m_Entities.size());
+
+	return static_cast<uint8>(std::upper_bound(m_LayerEnds.cbegin(), m_LayerEnds.cend(), idx) - m_LayerEnds.cbegin());
+}
+
+//----------------------------
+// Archetype::GetChunkVersion
+//
+T_ChangeVersion Archetype::GetChunkVersion(T_CompTypeIdx const compType, size_t const chunkIdx) const
+{
+	ET_ASSERT(HasComponent(compType));
+	ET_ASSERT(chunkIdx < m_Chunks.size());
+
+	return m_ChunkVersions[(chunkIdx * m_ComponentPools.size()) + m_Mapping[compType]];
+}
+
+//-------------------------
+// Archetype::GetVersion
+//
+// The version at which a component type was last written to in any chunk
+//
+T_ChangeVersion Archetype::GetVersion(T_CompTypeIdx const compType) const
+{
+	ET_ASSERT(HasComponent(compType));
+
+	return m_PoolVersions[m_Mapping[compType]];
+}
+
+//------------------------
+// Archetype::GetAddEdge
+//
+// The archetype an entity ends up in when the component type is added to it
+//
+Archetype* Archetype::GetAddEdge(T_CompTypeIdx const compType) const
+{
+	if (compType >= m_AddEdges.size())
+	{
+		return nullptr;
+	}
+
+	return m_AddEdges[compType];
+}
+
+//--------------------------
+// Archetype::GetRemoveEdge
+//
+// The archetype an entity ends up in when the component type is removed from it
+//
+Archetype* Archetype::GetRemoveEdge(T_CompTypeIdx const compType) const
+{
+	if (compType >= m_RemoveEdges.size())
+	{
+		return nullptr;
+	}
+
+	return m_RemoveEdges[compType];
+}
+
 //----------------------
 // Archetype::AddEntity
 //
-// Add an entity and all related components to an archetype
+// Add an entity and all related components to a hierachy layer of the archetype
 //  - returns the index within the archetype which the entity occupies
 //
 // #todo: we might want to simply assume that the components are sorted by signature to add their data for performance reasons
 //
-size_t Archetype::AddEntity(T_EntityId const entity, std::vector<RawComponentPtr> const& components)
+size_t Archetype::AddEntity(T_EntityId const entity, 
+	std::vector<RawComponentPtr> const& components, 
+	uint8 const layer, 
+	T_IndexList* const moved)
 {
 	ET_ASSERT(m_Signature.MatchesComponentsUnsorted(components));
 
+	size_t const idx = OpenGap(layer, 1u, moved);
+	m_Entities[idx] = entity;
+
 	for (RawComponentPtr const& component : components)
 	{
-		m_ComponentPools[m_Mapping[component.typeIdx]].Append(component.data);
+		m_ComponentPools[m_Mapping[component.typeIdx]].Construct(idx, component.data);
 	}
 
-	size_t const idx = m_Entities.size();
-	m_Entities.emplace_back(entity);
 	return idx;
 }
 
+//------------------------
+// Archetype::AddEntities
+//
+// Add a batch of entities that all start with copies of the same components
+//  - returns the index of the first entity, the others follow consecutively
+//
+size_t Archetype::AddEntities(T_EntityId const* const entities, 
+	size_t const count, 
+	std::vector<RawComponentPtr> const& components, 
+	uint8 const layer, 
+	T_IndexList* const moved)
+{
+	ET_ASSERT(m_Signature.MatchesComponentsUnsorted(components));
+
+	size_t const firstIdx = OpenGap(layer, count, moved);
+	std::copy(entities, entities + count, m_Entities.begin() + firstIdx);
+
+	for (RawComponentPtr const& component : components)
+	{
+		m_ComponentPools[m_Mapping[component.typeIdx]].ConstructCopies(firstIdx, count, component.data);
+	}
+
+	return firstIdx;
+}
+
 //-------------------------
 // Archetype::RemoveEntity
 //
 // Remove all the component data for an entity from the archetype - returns the entity id that was placed in the current index
 //
-T_EntityId Archetype::RemoveEntity(size_t const idx)
+T_EntityId Archetype::RemoveEntity(size_t const idx, T_IndexList* const moved)
 {
 	ET_ASSERT(idx < m_Entities.size());
 
 	for (ComponentPool& pool : m_ComponentPools)
 	{
-		pool.Erase(idx);
+		pool.Destroy(idx);
 	}
 
-	if (m_Entities.size() == 1u)
+	return CloseGap(idx, moved);
+}
+
+//-------------------------
+// Archetype::Clear
+//
+void Archetype::Clear()
+{
+	for (ComponentPool& pool : m_ComponentPools)
 	{
-		m_Entities.clear();
+		pool.Clear();
 	}
-	else
+
+	m_Entities.clear();
+	m_LayerEnds.clear();
+
+	ReleaseEmptyChunks();
+}
+
+//---------------------------
+// Archetype::RelocateEntity
+//
+// Move an entity from another archetype into this one - the source needs to call RemoveRelocatedEntity afterwards
+//  - components that both archetypes have are taken from the source, trivially relocatable ones are simply memcopied
+//  - the added components need to cover the types the source archetype doesn't have
+//
+size_t Archetype::RelocateEntity(T_EntityId const entity, 
+	Archetype& source, 
+	size_t const sourceIdx, 
+	std::vector<RawComponentPtr> const& addedComponents, 
+	uint8 const layer, 
+	T_IndexList* const moved)
+{
+	ET_ASSERT(m_ComponentPools.size() <= source.m_ComponentPools.size() + addedComponents.size());
+	ET_ASSERT(&source != this);
+
+	size_t const idx = OpenGap(layer, 1u, moved);
+	m_Entities[idx] = entity;
+
+	ComponentRegistry const& registry = ComponentRegistry::Instance();
+	for (ComponentPool& pool : m_ComponentPools)
+	{
+		T_CompTypeIdx const compType = pool.GetType();
+		if (source.HasComponent(compType))
+		{
+			void const* const data = source.GetPool(compType).At(sourceIdx);
+			if (registry.IsTriviallyRelocatable(compType))
+			{
+				pool.ConstructRelocated(idx, data);
+			}
+			else
+			{
+				pool.Construct(idx, data);
+			}
+		}
+	}
+
+	for (RawComponentPtr const& component : addedComponents)
+	{
+		ET_ASSERT(!source.HasComponent(component.typeIdx));
+		m_ComponentPools[m_Mapping[component.typeIdx]].Construct(idx, component.data);
+	}
+
+	return idx;
+}
+
+//----------------------------------
+// Archetype::RemoveRelocatedEntity
+//
+// Remove an entity after it was relocated to the destination archetype, without destroying the components that were memcopied
+//  - returns the entity id that was placed in the current index, same as RemoveEntity
+//
+T_EntityId Archetype::RemoveRelocatedEntity(size_t const idx, Archetype const& destination, T_IndexList* const moved)
+{
+	ET_ASSERT(idx < m_Entities.size());
+
+	ComponentRegistry const& registry = ComponentRegistry::Instance();
+	for (ComponentPool& pool : m_ComponentPools)
 	{
-		m_Entities[idx] = m_Entities[m_Entities.size() - 1];
-		m_Entities.pop_back();
+		T_CompTypeIdx const compType = pool.GetType();
+		if (!(destination.HasComponent(compType) && registry.IsTriviallyRelocatable(compType)))
+		{
+			pool.Destroy(idx);
+		}
 	}
 
-	if (m_Entities.size() == idx)
+	return CloseGap(idx, moved);
+}
+
+//------------------------
+// Archetype::ChangeLayer
+//
+// Move an entity into a different hierachy layer of the same archetype - returns its new index
+//  - the components are moved out of the way while the layers are shifted, trivially relocatable ones by memcpy
+//
+size_t Archetype::ChangeLayer(size_t const idx, uint8 const layer, T_IndexList* const moved)
+{
+	if (GetLayer(idx) == layer)
+	{
+		return idx;
+	}
+
+	T_EntityId const entity = m_Entities[idx];
+
+	size_t stashOffset = 0u;
+	for (ComponentPool& pool : m_ComponentPools)
+	{
+		pool.MoveOut(idx, m_LayerStash.data() + stashOffset);
+		stashOffset = GetNextStashOffset(stashOffset, pool.GetType());
+	}
+
+	CloseGap(idx, moved);
+	size_t const newIdx = OpenGap(layer, 1u, moved);
+
+	m_Entities[newIdx] = entity;
+
+	stashOffset = 0u;
+	for (ComponentPool& pool : m_ComponentPools)
+	{
+		pool.MoveIn(newIdx, m_LayerStash.data() + stashOffset);
+		stashOffset = GetNextStashOffset(stashOffset, pool.GetType());
+	}
+
+	return newIdx;
+}
+
+//-----------------------------
+// Archetype::MarkChunkChanged
+//
+// Record that the data of a component type in the chunk was (potentially) written to
+//
+void Archetype::MarkChunkChanged(T_CompTypeIdx const compType, size_t const chunkIdx, T_ChangeVersion const version)
+{
+	ET_ASSERT(HasComponent(compType));
+	ET_ASSERT(chunkIdx < m_Chunks.size());
+
+	m_ChunkVersions[(chunkIdx * m_ComponentPools.size()) + m_Mapping[compType]] = version;
+
+	T_ChangeVersion& poolVersion = m_PoolVersions[m_Mapping[compType]];
+	poolVersion = std::max(poolVersion, version);
+}
+
+//------------------------------
+// Archetype::MarkEntityChanged
+//
+// Used when entities are added, or moved into a new index
+//
+void Archetype::MarkEntityChanged(size_t const idx, T_ChangeVersion const version)
+{
+	ET_ASSERT(idx < m_Entities.size());
+
+	if (m_ComponentPools.empty())
+	{
+		return;
+	}
+
+	size_t const firstVersion = (idx / m_ChunkCapacity) * m_ComponentPools.size();
+	std::fill(m_ChunkVersions.begin() + firstVersion, m_ChunkVersions.begin() + firstVersion + m_ComponentPools.size(), version);
+
+	for (T_ChangeVersion& poolVersion : m_PoolVersions)
+	{
+		poolVersion = std::max(poolVersion, version);
+	}
+}
+
+//------------------------
+// Archetype::SetAddEdge
+//
+void Archetype::SetAddEdge(T_CompTypeIdx const compType, Archetype* const destination)
+{
+	ET_ASSERT(!HasComponent(compType));
+	ET_ASSERT(destination->HasComponent(compType));
+
+	if (compType >= m_AddEdges.size())
+	{
+		m_AddEdges.resize(compType + 1u, nullptr);
+	}
+
+	m_AddEdges[compType] = destination;
+}
+
+//---------------------------
+// Archetype::SetRemoveEdge
+//
+void Archetype::SetRemoveEdge(T_CompTypeIdx const compType, Archetype* const destination)
+{
+	ET_ASSERT(HasComponent(compType));
+	ET_ASSERT(!destination->HasComponent(compType));
+
+	if (compType >= m_RemoveEdges.size())
+	{
+		m_RemoveEdges.resize(compType + 1u, nullptr);
+	}
+
+	m_RemoveEdges[compType] = destination;
+}
+
+//--------------------------
+// Archetype::ReserveChunks
+//
+// Allocate chunks until there is space for the entity count
+//
+void Archetype::ReserveChunks(size_t const entityCount)
+{
+	if (m_ComponentPools.empty())
+	{
+		return;
+	}
+
+	while (m_Chunks.size() * m_ChunkCapacity < entityCount)
+	{
+		m_Chunks.push_back(m_ChunkPool.Allocate());
+	}
+
+	m_ChunkVersions.resize(m_Chunks.size() * m_ComponentPools.size(), 0u);
+}
+
+//--------------------
+// Archetype::OpenGap
+//
+// Make space for entities at the end of a hierachy layer - returns the first index of the gap, which has uninitialized components
+//  - every layer above is shifted up by moving its first entities past its end, so only min(count, layerSize) entities move per layer
+//
+size_t Archetype::OpenGap(uint8 const layer, size_t const count, T_IndexList* const moved)
+{
+	size_t const size = m_Entities.size();
+
+	ReserveChunks(size + count);
+	m_Entities.resize(size + count, INVALID_ENTITY_ID);
+	for (ComponentPool& pool : m_ComponentPools)
+	{
+		pool.Expand(count);
+	}
+
+	while (m_LayerEnds.size() <= static_cast<size_t>(layer))
+	{
+		m_LayerEnds.emplace_back(size);
+	}
+
+	// the gap starts out at the end of the top layer and moves down to the target layer
+	size_t gapBegin = size;
+	for (size_t layerIdx = m_LayerEnds.size() - 1u; layerIdx > static_cast<size_t>(layer); --layerIdx)
+	{
+		size_t const begin = m_LayerEnds[layerIdx - 1u];
+		size_t const end = m_LayerEnds[layerIdx];
+		size_t const moveCount = std::min(count, end - begin);
+
+		for (size_t moveIdx = 0u; moveIdx < moveCount; ++moveIdx)
+		{
+			MoveEntityData(begin + moveIdx, end + count - moveCount + moveIdx, moved);
+		}
+
+		m_LayerEnds[layerIdx] += count;
+		gapBegin = begin;
+	}
+
+	m_LayerEnds[layer] += count;
+	return gapBegin;
+}
+
+//---------------------
+// Archetype::CloseGap
+//
+// Remove an index whose components were already destroyed or relocated, by moving the last entity of each layer above into the hole
+//  - returns the entity id that was placed in the index
+//
+T_EntityId Archetype::CloseGap(size_t const idx, T_IndexList* const moved)
+{
+	ET_ASSERT(idx < m_Entities.size());
+
+	size_t hole = idx;
+	for (size_t layerIdx = static_cast<size_t>(GetLayer(idx)); layerIdx < m_LayerEnds.size(); ++layerIdx)
+	{
+		size_t const last = m_LayerEnds[layerIdx] - 1u;
+		if (last != hole)
+		{
+			MoveEntityData(last, hole, moved);
+		}
+
+		hole = last;
+		--m_LayerEnds[layerIdx];
+	}
+
+	ET_ASSERT(hole == m_Entities.size() - 1u);
+	for (ComponentPool& pool : m_ComponentPools)
+	{
+		pool.PopBack();
+	}
+
+	m_Entities.pop_back();
+
+	// trailing empty layers are dropped so that the layer count reflects the deepest entity
+	while (!m_LayerEnds.empty() && (m_LayerEnds.back() == GetLayerBegin(m_LayerEnds.size() - 1u)))
+	{
+		m_LayerEnds.pop_back();
+	}
+
+	ReleaseEmptyChunks();
+
+	if (idx >= m_Entities.size())
 	{
 		return INVALID_ENTITY_ID;
 	}
-	
+
 	return m_Entities[idx];
 }
 
-//-------------------------
-// Archetype::Clear
+//---------------------------
+// Archetype::MoveEntityData
 //
-void Archetype::Clear()
+// Move the entity id and components from one index to another, leaving the source uninitialized
+//
+void Archetype::MoveEntityData(size_t const from, size_t const to, T_IndexList* const moved)
 {
 	for (ComponentPool& pool : m_ComponentPools)
 	{
-		pool.Clear();
+		pool.Move(from, to);
 	}
 
-	m_Entities.clear();
+	m_Entities[to] = m_Entities[from];
+
+	if (moved != nullptr)
+	{
+		moved->emplace_back(to);
+	}
+}
+
+//-------------------------------
+// Archetype::ReleaseEmptyChunks
+//
+// Return chunks at the end that no longer contain any entities to the pool
+//
+void Archetype::ReleaseEmptyChunks()
+{
+	while (!m_Chunks.empty() && (m_Entities.size() <= (m_Chunks.size() - 1u) * m_ChunkCapacity))
+	{
+		m_ChunkPool.Free(m_Chunks.back());
+		m_Chunks.pop_back();
+	}
+
+	m_ChunkVersions.resize(m_Chunks.size() * m_ComponentPools.size());
+}
+
+
+//-------------------------------
+// Archetype::GetNextStashOffset
+//
+// Offset of the component following compType in the layer stash, aligned the same way as component arrays in a chunk
+//
+size_t Archetype::GetNextStashOffset(size_t const offset, T_CompTypeIdx const compType)
+{
+	size_t const end = offset + ComponentRegistry::Instance().GetSize(compType);
+	return (end + ChunkPool::s_Alignment - 1u) & ~(ChunkPool::s_Alignment - 1u);
 }
 
 
@@ -1,4 +1,5 @@
 #pragma once
+#include "ChunkPool.h"
 #include "ComponentPool.h"
 #include "ComponentSignature.h"
 #include "EntityFwd.h"
@@ -12,33 +13,96 @@ namespace fw {
 // Archetype
 //
 // Contains a specific set of components for entities that match the given signature
+//  - component data lives in chunks from the chunk pool, each chunk holds an aligned array per component type for the same range of entities
+//  - entities are sorted by hierachy layer, so that iterating layer by layer processes parents before their children
 //
 class Archetype final
 {
+public:
+	typedef std::vector<size_t> T_IndexList; // indices whose entity changed while inserting or removing, so the owner can update its lookup
+
 	// construct destruct
 	//--------------------
 public:
-	Archetype(ComponentSignature const& sig);
+	Archetype(ComponentSignature const& sig, ChunkPool& chunkPool);
+	~Archetype();
+
+	Archetype(Archetype const&) = delete;
+	void operator=(Archetype const&) = delete;
 
 	// accessors
 	//-----------
 	bool HasComponent(T_CompTypeIdx const compType) const;
 	ComponentSignature const& GetSignature() const { return m_Signature; }
+	T_Hash GetSignatureId() const { return m_SignatureId; }
+	T_CompTypeList const& GetTypes() const { return m_Types; }
 
 	size_t GetSize() const { return m_Entities.size(); }
+	size_t GetChunkCapacity() const { return m_ChunkCapacity; } // entities per chunk
+	size_t GetChunkCount() const { return m_Chunks.size(); }
 
 	ComponentPool& GetPool(T_CompTypeIdx const typeIdx);
 	ComponentPool const& GetPool(T_CompTypeIdx const typeIdx) const;
 	std::vector<ComponentPool>& GetPools() { return m_ComponentPools; }
 
 	T_EntityId GetEntity(size_t const idx) const;
+	std::vector<T_EntityId> const& GetEntities() const { return m_Entities; }
+
+	// entities of a hierachy layer are stored in the index range [begin, end), layers past the count are empty
+	size_t GetLayerCount() const { return m_LayerEnds.size(); }
+	size_t GetLayerBegin(size_t const layer) const;
+	size_t GetLayerEnd(size_t const layer) const;
+	uint8 GetLayer(size_t const idx) const;
+
+	// the version at which a component type was last written to in a chunk
+	T_ChangeVersion GetChunkVersion(T_CompTypeIdx const compType, size_t const chunkIdx) const;
+	T_ChangeVersion GetVersion(T_CompTypeIdx const compType) const; // latest of all chunks
+
+	// cached transitions to other archetypes, nullptr if the transition wasn't made yet
+	Archetype* GetAddEdge(T_CompTypeIdx const compType) const;
+	Archetype* GetRemoveEdge(T_CompTypeIdx const compType) const;
 
 	// functionality
 	//---------------
-	size_t AddEntity(T_EntityId const entity, std::vector<RawComponentPtr> const& components);
-	T_EntityId RemoveEntity(size_t const idx);
+	// inserting into or removing from a layer shifts one entity per layer above it, their new indices are appended to the moved list
+	size_t AddEntity(T_EntityId const entity, 
+		std::vector<RawComponentPtr> const& components, 
+		uint8 const layer = 0u, 
+		T_IndexList* const moved = nullptr);
+	size_t AddEntities(T_EntityId const* const entities, 
+		size_t const count, 
+		std::vector<RawComponentPtr> const& components, 
+		uint8 const layer = 0u, 
+		T_IndexList* const moved = nullptr);
+	T_EntityId RemoveEntity(size_t const idx, T_IndexList* const moved = nullptr);
 	void Clear();
 
+	size_t RelocateEntity(T_EntityId const entity, 
+		Archetype& source, 
+		size_t const sourceIdx, 
+		std::vector<RawComponentPtr> const& addedComponents, 
+		uint8 const layer = 0u, 
+		T_IndexList* const moved = nullptr);
+	T_EntityId RemoveRelocatedEntity(size_t const idx, Archetype const& destination, T_IndexList* const moved = nullptr);
+
+	size_t ChangeLayer(size_t const idx, uint8 const layer, T_IndexList* const moved = nullptr);
+
+	void MarkChunkChanged(T_CompTypeIdx const compType, size_t const chunkIdx, T_ChangeVersion const version);
+	void MarkEntityChanged(size_t const idx, T_ChangeVersion const version); // all component types in the entities chunk
+
+	void SetAddEdge(T_CompTypeIdx const compType, Archetype* const destination);
+	void SetRemoveEdge(T_CompTypeIdx const compType, Archetype* const destination);
+
+	// utility
+	//---------
+private:
+	void ReserveChunks(size_t const entityCount);
+	size_t OpenGap(uint8 const layer, size_t const count, T_IndexList* const moved);
+	T_EntityId CloseGap(size_t const idx, T_IndexList* const moved);
+	void MoveEntityData(size_t const from, size_t const to, T_IndexList* const moved);
+	void ReleaseEmptyChunks();
+	static size_t GetNextStashOffset(size_t const offset, T_CompTypeIdx const compType);
+
 	// Data
 	///////
 
@@ -47,8 +111,22 @@ private:
 
 	std::vector<ComponentPool> m_ComponentPools;
 	ComponentSignature const m_Signature; 
+	T_Hash const m_SignatureId; // cached, so that archetypes can be ordered by something other than their address
+	T_CompTypeList const m_Types; // sorted list of the types in the signature, for iteration
+
+	ChunkPool& m_ChunkPool;
+	std::vector<uint8*> m_Chunks;
+	size_t m_ChunkCapacity = 0u;
+	std::vector<T_ChangeVersion> m_ChunkVersions; // per chunk, one version for each component pool
+	std::vector<T_ChangeVersion> m_PoolVersions; // latest chunk version of each component pool
 
 	std::vector<T_EntityId> m_Entities; // map back into the controllers entity list, can also act as component count
+	std::vector<size_t> m_LayerEnds; // exclusive end index of each hierachy layer
+	std::vector<uint8> m_LayerStash; // holds the components of an entity while it changes layers
+
+	// indexed by component type
+	std::vector<Archetype*> m_AddEdges;
+	std::vector<Archetype*> m_RemoveEdges;
 };
 
 
@@ -0,0 +1,67 @@
+#include "stdafx.h"
+#include "ChunkPool.h"
+
+
+namespace et {
+namespace fw {
+
+
+//============
+// Chunk Pool
+//============
+
+
+//------------------
+// ChunkPool::d-tor
+//
+// All chunks should have been returned by their archetypes at this point
+//
+ChunkPool::~ChunkPool()
+{
+	ET_ASSERT(m_FreeChunks.size() == m_Allocations.size(), "%u chunks are still in use", static_cast<uint32>(m_Allocations.size() - m_FreeChunks.size()));
+
+	for (uint8* const allocation : m_Allocations)
+	{
+		delete[] allocation;
+	}
+}
+
+//---------------------
+// ChunkPool::Allocate
+//
+// Reuse a previously freed chunk if possible, otherwise allocate a new one
+//
+uint8* ChunkPool::Allocate()
+{
+	if (!m_FreeChunks.empty())
+	{
+		uint8* const chunk = m_FreeChunks.back();
+		m_FreeChunks.pop_back();
+		return chunk;
+	}
+
+	// overallocate so that we can align the start of the chunk
+	uint8* const allocation = new uint8[s_ChunkSize + s_Alignment - 1u];
+	m_Allocations.push_back(allocation);
+
+	uintptr_t const address = reinterpret_cast<uintptr_t>(allocation);
+	uintptr_t const aligned = (address + s_Alignment - 1u) & ~static_cast<uintptr_t>(s_Alignment - 1u);
+	return allocation + (aligned - address);
+}
+
+//-----------------
+// ChunkPool::Free
+//
+// Return a chunk to the pool so that it can be handed out again
+//
+void ChunkPool::Free(uint8* const chunk)
+{
+	ET_ASSERT(chunk != nullptr);
+	ET_ASSERT(m_FreeChunks.size() < m_Allocations.size());
+
+	m_FreeChunks.push_back(chunk);
+}
+
+
+} // namespace fw
+} // namespace et
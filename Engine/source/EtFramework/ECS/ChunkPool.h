@@ -0,0 +1,50 @@
+#pragma once
+
+
+namespace et {
+namespace fw {
+
+
+//---------------
+// ChunkPool
+//
+// Hands out fixed size, cache line aligned memory blocks that archetypes store their component data in
+//  - chunks that are returned are recycled instead of being freed, so spawning and destroying entities doesn't hit the system allocator
+//
+class ChunkPool final
+{
+	// definitions
+	//-------------
+public:
+	static constexpr size_t s_ChunkSize = 16u * 1024u;
+	static constexpr size_t s_Alignment = 64u; // cache line size
+
+	// construct destruct
+	//--------------------
+	ChunkPool() = default;
+	~ChunkPool();
+
+	ChunkPool(ChunkPool const&) = delete;
+	void operator=(ChunkPool const&) = delete;
+
+	// accessors
+	//-----------
+	size_t GetAllocatedCount() const { return m_Allocations.size(); }
+	size_t GetFreeCount() const { return m_FreeChunks.size(); }
+
+	// functionality
+	//---------------
+	uint8* Allocate();
+	void Free(uint8* const chunk);
+
+	// Data
+	///////
+
+private:
+	std::vector<uint8*> m_Allocations; // unaligned memory as returned by new
+	std::vector<uint8*> m_FreeChunks;
+};
+
+
+} // namespace fw
+} // namespace et
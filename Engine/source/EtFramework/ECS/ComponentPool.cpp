@@ -11,6 +11,22 @@ namespace fw {
 //================
 
 
+//----------------------
+// ComponentPool::c-tor
+//
+ComponentPool::ComponentPool(T_CompTypeIdx const typeIdx, std::vector<uint8*> const& chunks, size_t const chunkOffset, size_t const chunkCapacity)
+	: m_ComponentType(typeIdx)
+	, m_TypeSize(ComponentRegistry::Instance().GetSize(typeIdx))
+	, m_IsTriviallyRelocatable(ComponentRegistry::Instance().IsTriviallyRelocatable(typeIdx))
+	, m_Relocate(ComponentRegistry::Instance().GetRelocate(typeIdx))
+	, m_Chunks(chunks)
+	, m_ChunkOffset(chunkOffset)
+	, m_ChunkCapacity(chunkCapacity)
+{
+	ET_ASSERT(m_TypeSize != 0u);
+	ET_ASSERT(m_ChunkCapacity != 0u);
+}
+
 //--------------------
 // ComponentPool::At
 //
@@ -18,10 +34,9 @@ namespace fw {
 //
 void* ComponentPool::At(size_t const idx)
 {
-	size_t const byteIdx = idx * ComponentRegistry::Instance().GetSize(m_ComponentType);
-	ET_ASSERT(byteIdx < m_Buffer.size());
+	ET_ASSERT(idx < m_Size);
 
-	return &m_Buffer[byteIdx];
+	return m_Chunks[idx / m_ChunkCapacity] + m_ChunkOffset + ((idx % m_ChunkCapacity) * m_TypeSize);
 }
 
 //--------------------
@@ -31,77 +46,148 @@ void* ComponentPool::At(size_t const idx)
 //
 void const* ComponentPool::At(size_t const idx) const
 {
-	size_t const byteIdx = idx * ComponentRegistry::Instance().GetSize(m_ComponentType);
-	ET_ASSERT(byteIdx < m_Buffer.size());
+	ET_ASSERT(idx < m_Size);
 
-	return &m_Buffer[byteIdx];
+	return m_Chunks[idx / m_ChunkCapacity] + m_ChunkOffset + ((idx % m_ChunkCapacity) * m_TypeSize);
 }
 
-//------------------------
-// ComponentPool::GetSize
+//----------------------
+// ComponentPool::Clear
 //
-// count of components being stored
+void ComponentPool::Clear()
+{
+	m_Size = 0u;
+}
+
+//-----------------------
+// ComponentPool::Expand
 //
-size_t ComponentPool::GetSize() const
+// Grow the pool without constructing components in the new slots
+//
+void ComponentPool::Expand(size_t const count)
 {
-	size_t const typeSize = ComponentRegistry::Instance().GetSize(m_ComponentType);
-	ET_ASSERT(typeSize != 0u);
-	return m_Buffer.size() / typeSize;
+	ET_ASSERT(m_Size + count <= m_Chunks.size() * m_ChunkCapacity, "the archetype didn't allocate chunks for the new components");
+
+	m_Size += count;
 }
 
-//------------------------
-// ComponentPool::Append
+//--------------------------
+// ComponentPool::Construct
 //
-// Add an component to the end of the buffer (without knowing its static type data)
+// Call the copy constructor on an uninitialized slot
 //
-void ComponentPool::Append(void const* const componentData)
+void ComponentPool::Construct(size_t const idx, void const* const componentData)
 {
-	size_t const typeSize = ComponentRegistry::Instance().GetSize(m_ComponentType);
-	size_t const byteIdx = m_Buffer.size();
-
-	// add space in the buffer so we can create our new component
-	m_Buffer.resize(byteIdx + typeSize);
-	
-	// call the copy constructor on the component in our new memory location
-	ComponentRegistry::Instance().GetCopyAssign(m_ComponentType)(componentData, static_cast<void*>(&m_Buffer[byteIdx]));
+	ComponentRegistry::Instance().GetCopyAssign(m_ComponentType)(componentData, At(idx));
 }
 
-//------------------------
-// ComponentPool::Erase
+//-----------------------------------
+// ComponentPool::ConstructRelocated
 //
-// Swaps the content with the last component and removes the last element from the list
+// Copy the memory of a component into an uninitialized slot, ownership of the component moves to this pool
 //
-void ComponentPool::Erase(size_t const idx)
+void ComponentPool::ConstructRelocated(size_t const idx, void const* const componentData)
 {
-	size_t const typeSize = ComponentRegistry::Instance().GetSize(m_ComponentType);
-	size_t const byteIdx = idx * typeSize;
+	ET_ASSERT(ComponentRegistry::Instance().IsTriviallyRelocatable(m_ComponentType));
 
-	ET_ASSERT(byteIdx < m_Buffer.size()); // ensure we are not out of range
+	memcpy(At(idx), componentData, m_TypeSize);
+}
 
-	// call the destructor on the component we are erasing
-	ComponentRegistry::Instance().GetDestructor(m_ComponentType)(static_cast<void const*>(m_Buffer.data() + byteIdx));
+//--------------------------------
+// ComponentPool::ConstructCopies
+//
+// Trivially copyable components can simply be memcopied
+//
+void ComponentPool::ConstructCopies(size_t const idx, size_t const count, void const* const componentData)
+{
+	ET_ASSERT(idx + count <= m_Size);
 
-	if (m_Buffer.size() == typeSize) // only one element is left so we can just clear all data in the buffer
+	ComponentRegistry const& registry = ComponentRegistry::Instance();
+	if (registry.IsTriviallyRelocatable(m_ComponentType))
+	{
+		for (size_t copyIdx = idx; copyIdx < idx + count; ++copyIdx)
+		{
+			memcpy(At(copyIdx), componentData, m_TypeSize);
+		}
+	}
+	else
 	{
-		m_Buffer.clear();
-		return;
+		auto const copyAssign = registry.GetCopyAssign(m_ComponentType);
+		for (size_t copyIdx = idx; copyIdx < idx + count; ++copyIdx)
+		{
+			copyAssign(componentData, At(copyIdx));
+		}
 	}
+}
 
-	size_t const lastIdx = m_Buffer.size() - typeSize;
+//---------------------
+// ComponentPool::Move
+//
+// Move a component into an uninitialized slot - the source slot is left uninitialized
+//
+void ComponentPool::Move(size_t const from, size_t const to)
+{
+	ET_ASSERT(from != to);
 
-	// copy the last element into the position of the element to erase
-	memcpy(m_Buffer.data() + byteIdx, m_Buffer.data() + lastIdx, typeSize);
+	Relocate(At(from), At(to));
+}
 
-	// 'pop_back' last component
-	m_Buffer.resize(m_Buffer.size() - typeSize);
+//------------------------
+// ComponentPool::MoveOut
+//
+// Move a component into uninitialized memory with space for it, the slot is left uninitialized
+//
+void ComponentPool::MoveOut(size_t const idx, void* const target)
+{
+	Relocate(At(idx), target);
 }
 
-//----------------------
-// ComponentPool::Clear
+//-----------------------
+// ComponentPool::MoveIn
 //
-void ComponentPool::Clear()
+// Move a component that was moved out back into an uninitialized slot
+//
+void ComponentPool::MoveIn(size_t const idx, void* const source)
+{
+	Relocate(source, At(idx));
+}
+
+//------------------------
+// ComponentPool::Destroy
+//
+// Call the destructor without removing the slot
+//
+void ComponentPool::Destroy(size_t const idx)
+{
+	ComponentRegistry::Instance().GetDestructor(m_ComponentType)(static_cast<void const*>(At(idx)));
+}
+
+//------------------------
+// ComponentPool::PopBack
+//
+void ComponentPool::PopBack()
+{
+	ET_ASSERT(m_Size > 0u);
+
+	--m_Size;
+}
+
+
+//-------------------------
+// ComponentPool::Relocate
+//
+// Trivially relocatable components are memcopied, others are move constructed and the source is destroyed
+//
+void ComponentPool::Relocate(void* const source, void* const target) const
 {
-	m_Buffer.clear();
+	if (m_IsTriviallyRelocatable)
+	{
+		memcpy(target, source, m_TypeSize);
+	}
+	else
+	{
+		m_Relocate(source, target);
+	}
 }
 
 
@@ -10,13 +10,15 @@ namespace fw {
 // ComponentPool
 //
 // Contains a dynamic list of components of a certain type, with the actual type being erased
+//  - components are stored in fixed size chunks that are shared with the other pools of an archetype, each pool occupying a range within a chunk
+//  - the chunks are owned by the archetype, which also ensures there is enough space before anything is appended
 //
 class ComponentPool final
 {
 	// construct destruct
 	//--------------------
 public:
-	ComponentPool(T_CompTypeIdx const typeIdx) : m_ComponentType(typeIdx) {}
+	ComponentPool(T_CompTypeIdx const typeIdx, std::vector<uint8*> const& chunks, size_t const chunkOffset, size_t const chunkCapacity);
 
 	// accessors
 	//-----------
@@ -28,24 +30,43 @@ public:
 	void* At(size_t const idx);
 	void const* At(size_t const idx) const;
 
-	size_t GetSize() const;
+	size_t GetSize() const { return m_Size; }
 	T_CompTypeIdx GetType() const { return m_ComponentType; }
 
 	// functionality
 	//---------------
-	template<typename TComponentType, typename std::enable_if_t<!std::is_pointer<TComponentType>::value>* = 0>
-	void Append(TComponentType const& component); // add to back
-	void Append(void const* const componentData);
-
-	void Erase(size_t const idx); // swap with last element and pop_back
 	void Clear();
 
+	// slots between Expand and Construct, or after Move and Destroy, are uninitialized - the archetype keeps entities sorted within the pools
+	void Expand(size_t const count); // grow without constructing anything
+	void Construct(size_t const idx, void const* const componentData);
+	void ConstructRelocated(size_t const idx, void const* const componentData); // memcpy only, the source must not be destroyed afterwards
+	void ConstructCopies(size_t const idx, size_t const count, void const* const componentData);
+	void Move(size_t const from, size_t const to); // the component now lives at the destination
+	void MoveOut(size_t const idx, void* const target); // relocate into memory outside of the pool
+	void MoveIn(size_t const idx, void* const source); // relocate from memory outside of the pool, the source is left uninitialized
+	void Destroy(size_t const idx);
+	void PopBack(); // shrink without destroying the last component
+
+	// utility
+	//---------
+private:
+	void Relocate(void* const source, void* const target) const;
+
 	// Data
 	///////
 
 private:
 	T_CompTypeIdx const m_ComponentType;
-	std::vector<uint8> m_Buffer;
+	size_t const m_TypeSize;
+	bool const m_IsTriviallyRelocatable;
+	ComponentRegistry::T_CompRelocate const m_Relocate;
+
+	std::vector<uint8*> const& m_Chunks;
+	size_t const m_ChunkOffset; // byte offset of this pools components within each chunk
+	size_t const m_ChunkCapacity; // components per chunk
+
+	size_t m_Size = 0u;
 };
 
 
@@ -34,18 +34,6 @@ TComponentType const& ComponentPool::Get(size_t const idx) const
 	return *static_cast<TComponentType const*>(At(idx));
 }
 
-//------------------------
-// ComponentPool::Append
-//
-// Add an component to the end of the buffer
-//
-template<typename TComponentType, typename std::enable_if_t<!std::is_pointer<TComponentType>::value>*>
-void ComponentPool::Append(TComponentType const& component)
-{
-	ET_ASSERT(TComponentType::GetTypeIndex() == m_ComponentType);
-	Append(&component);
-}
-
 
 } // namespace fw
 } // namespace et
@@ -82,6 +82,30 @@ ComponentRegistry::T_CompDestructor ComponentRegistry::GetFullDestructor(T_CompT
 	return m_ComponentTypes[idx].fullDestructor;
 }
 
+//---------------------------------------
+// ComponentRegistry::GetRelocate
+//
+// Function that move constructs a component into a block of memory and destroys the source
+//
+ComponentRegistry::T_CompRelocate ComponentRegistry::GetRelocate(T_CompTypeIdx const idx) const
+{
+	ET_ASSERT(static_cast<size_t>(idx) < m_ComponentTypes.size());
+
+	return m_ComponentTypes[idx].relocate;
+}
+
+//-----------------------------------------
+// ComponentRegistry::IsTriviallyRelocatable
+//
+// Whether the component can be moved to a new memory location with memcpy, without calling its copy constructor and destructor
+//
+bool ComponentRegistry::IsTriviallyRelocatable(T_CompTypeIdx const idx) const
+{
+	ET_ASSERT(static_cast<size_t>(idx) < m_ComponentTypes.size());
+
+	return m_ComponentTypes[idx].isTriviallyRelocatable;
+}
+
 //-------------------------------
 // ComponentRegistry::GetTypeIdx
 //
@@ -21,9 +21,12 @@ class ComponentRegistry
 {
 	// definitions
 	//-------------
+public:
 	typedef void (*T_CompCopyAssign)(void const* const, void* const); // source, target
 	typedef void (*T_CompDestructor)(void const* const);
+	typedef void (*T_CompRelocate)(void* const, void* const); // source, target - the source is destroyed afterwards
 
+private:
 	struct ComponentTypeInfo
 	{
 	public:
@@ -34,6 +37,8 @@ class ComponentRegistry
 		T_CompCopyAssign copyAssign = nullptr;
 		T_CompDestructor destructor = nullptr;
 		T_CompDestructor fullDestructor = nullptr;
+		T_CompRelocate relocate = nullptr;
+		bool isTriviallyRelocatable = false; // can be moved with memcpy instead of copy constructing and destroying
 	};
 
 public:
@@ -65,6 +70,8 @@ public:
 	T_CompCopyAssign GetCopyAssign(T_CompTypeIdx const idx) const;
 	T_CompDestructor GetDestructor(T_CompTypeIdx const idx) const;
 	T_CompDestructor GetFullDestructor(T_CompTypeIdx const idx) const;
+	T_CompRelocate GetRelocate(T_CompTypeIdx const idx) const;
+	bool IsTriviallyRelocatable(T_CompTypeIdx const idx) const;
 
 	T_CompTypeIdx GetTypeIdx(rttr::type const& type) const;
 
@@ -36,6 +36,15 @@ T_CompTypeIdx ComponentRegistry::Register()
 		delete static_cast<TComponentType const*>(lhs);
 	};
 
+	ti.relocate = [](void* const source, void* const target) -> void
+	{
+		TComponentType* const sourceComp = static_cast<TComponentType*>(source);
+		new (static_cast<TComponentType*>(target)) TComponentType(std::move(*sourceComp));
+		sourceComp->~TComponentType();
+	};
+
+	ti.isTriviallyRelocatable = std::is_trivially_copyable<TComponentType>::value;
+
 	// ensure we only register components once
 	ET_ASSERT(GetTypeIdx(ti.type) == s_InvalidTypeIdx, "Component '%s' was already registered!", ti.type.get_name().data());
 
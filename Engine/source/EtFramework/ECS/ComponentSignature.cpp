@@ -17,9 +17,11 @@ namespace fw {
 // construct from type list
 //
 ComponentSignature::ComponentSignature(T_CompTypeList const& types)
-	: m_Impl(types)
 {
-	std::sort(m_Impl.begin(), m_Impl.end());
+	for (T_CompTypeIdx const type : types)
+	{
+		Add(type);
+	}
 }
 
 //---------------------------
@@ -31,10 +33,87 @@ ComponentSignature::ComponentSignature(std::vector<RawComponentPtr> const& compo
 {
 	for (RawComponentPtr const& comp : components)
 	{
-		m_Impl.push_back(comp.typeIdx);
+		Add(comp.typeIdx);
 	}
+}
+
+//-------------------------
+// ComponentSignature::Add
+//
+void ComponentSignature::Add(T_CompTypeIdx const type)
+{
+	ET_ASSERT(type != INVALID_COMP_TYPE_IDX);
+
+	size_t const wordIdx = static_cast<size_t>(type) / s_BitsPerWord;
+	T_Word const bit = static_cast<T_Word>(1u) << (static_cast<size_t>(type) % s_BitsPerWord);
+
+	T_Word* word = nullptr;
+	if (wordIdx < s_InlineWordCount)
+	{
+		word = &m_Words[wordIdx];
+	}
+	else
+	{
+		size_t const overflowIdx = wordIdx - s_InlineWordCount;
+		if (overflowIdx >= m_Overflow.size())
+		{
+			m_Overflow.resize(overflowIdx + 1u, 0u);
+		}
 
-	std::sort(m_Impl.begin(), m_Impl.end());
+		word = &m_Overflow[overflowIdx];
+	}
+
+	if ((*word & bit) == 0u)
+	{
+		*word |= bit;
+		++m_Size;
+	}
+}
+
+//----------------------------
+// ComponentSignature::Remove
+//
+void ComponentSignature::Remove(T_CompTypeIdx const type)
+{
+	size_t const wordIdx = static_cast<size_t>(type) / s_BitsPerWord;
+	if (wordIdx >= GetWordCount())
+	{
+		return;
+	}
+
+	T_Word const bit = static_cast<T_Word>(1u) << (static_cast<size_t>(type) % s_BitsPerWord);
+	T_Word& word = (wordIdx < s_InlineWordCount) ? m_Words[wordIdx] : m_Overflow[wordIdx - s_InlineWordCount];
+
+	if ((word & bit) != 0u)
+	{
+		word &= ~bit;
+		--m_Size;
+	}
+}
+
+//------------------------------
+// ComponentSignature::GetTypes
+//
+// Expand the bitset into a list, which is sorted by nature of iterating the bits in order
+//
+T_CompTypeList ComponentSignature::GetTypes() const
+{
+	T_CompTypeList ret;
+	ret.reserve(m_Size);
+
+	for (size_t wordIdx = 0u; wordIdx < GetWordCount(); ++wordIdx)
+	{
+		T_Word word = GetWord(wordIdx);
+		for (size_t bitIdx = 0u; word != 0u; ++bitIdx, word >>= 1u)
+		{
+			if ((word & 1u) != 0u)
+			{
+				ret.push_back(static_cast<T_CompTypeIdx>(wordIdx * s_BitsPerWord + bitIdx));
+			}
+		}
+	}
+
+	return ret;
 }
 
 //-----------------------------------------
@@ -42,12 +121,35 @@ ComponentSignature::ComponentSignature(std::vector<RawComponentPtr> const& compo
 //
 T_CompTypeIdx ComponentSignature::GetMaxComponentType() const
 {
-	if (m_Impl.size() == 0u)
+	for (size_t wordIdx = GetWordCount(); wordIdx > 0u; --wordIdx)
 	{
-		return INVALID_COMP_TYPE_IDX;
+		T_Word const word = GetWord(wordIdx - 1u);
+		if (word == 0u)
+		{
+			continue;
+		}
+
+		size_t bitIdx = s_BitsPerWord - 1u;
+		while ((word & (static_cast<T_Word>(1u) << bitIdx)) == 0u)
+		{
+			--bitIdx;
+		}
+
+		return static_cast<T_CompTypeIdx>((wordIdx - 1u) * s_BitsPerWord + bitIdx);
 	}
 
-	return m_Impl[m_Impl.size() - 1];
+	return INVALID_COMP_TYPE_IDX;
+}
+
+//-------------------------
+// ComponentSignature::Has
+//
+bool ComponentSignature::Has(T_CompTypeIdx const type) const
+{
+	size_t const wordIdx = static_cast<size_t>(type) / s_BitsPerWord;
+	T_Word const bit = static_cast<T_Word>(1u) << (static_cast<size_t>(type) % s_BitsPerWord);
+
+	return (GetWord(wordIdx) & bit) != 0u;
 }
 
 //-----------------------------------------------
@@ -55,14 +157,14 @@ T_CompTypeIdx ComponentSignature::GetMaxComponentType() const
 //
 bool ComponentSignature::MatchesComponentsUnsorted(std::vector<RawComponentPtr> const& list) const
 {
-	if (m_Impl.size() != list.size())
+	if (m_Size != list.size())
 	{
 		return false;
 	}
 
 	for (RawComponentPtr const& data : list)
 	{
-		if (std::find(m_Impl.cbegin(), m_Impl.cend(), data.typeIdx) == m_Impl.cend())
+		if (!Has(data.typeIdx))
 		{
 			return false;
 		}
@@ -74,37 +176,29 @@ bool ComponentSignature::MatchesComponentsUnsorted(std::vector<RawComponentPtr>
 //--------------------------------
 // ComponentSignature::Contains
 //
+// Subset test, every bit set in the other signature must be set in ours
+//
 bool ComponentSignature::Contains(ComponentSignature const& other) const
 {
-	if (other.GetSize() > m_Impl.size()) // there is definitly a type in the other signature that we don't have
+	if (other.GetSize() > m_Size) // there is definitly a type in the other signature that we don't have
 	{
 		return false;
 	}
 
-	T_CompTypeList const& otherTypes = other.GetTypes();
-
-	// since both lists are sorted we can just iterate linearly over the smaller list and our inner list at the same time
-	size_t idx = 0;
-	for (T_CompTypeIdx const otherType : otherTypes) 
+	for (size_t wordIdx = 0u; wordIdx < s_InlineWordCount; ++wordIdx)
 	{
-		T_CompTypeIdx thisType = INVALID_COMP_TYPE_IDX; // iterate our inner list until we find the matching component
-		do
+		if ((other.m_Words[wordIdx] & ~m_Words[wordIdx]) != 0u)
 		{
-			if (idx >= m_Impl.size()) // if we reach the end of our list the comparison failed
-			{
-				return false;
-			}
-
-			thisType = m_Impl[idx];
-
-			if (thisType > otherType) // if our type is larger, the matching type won't be found as both lists are sorted
-			{
-				return false;
-			}
+			return false;
+		}
+	}
 
-			++idx;
-		} 
-		while (thisType != otherType);
+	for (size_t overflowIdx = 0u; overflowIdx < other.m_Overflow.size(); ++overflowIdx)
+	{
+		if ((other.m_Overflow[overflowIdx] & ~GetWord(s_InlineWordCount + overflowIdx)) != 0u)
+		{
+			return false;
+		}
 	}
 
 	return true;
@@ -113,9 +207,45 @@ bool ComponentSignature::Contains(ComponentSignature const& other) const
 //----------------------------
 // ComponentSignature::GenId
 //
+// Mix the words into a hash, skipping empty words so that unused overflow doesn't change the result
+//
 T_Hash ComponentSignature::GenId() const
 {
-	return GetDataHash(reinterpret_cast<uint8 const*>(m_Impl.data()), m_Impl.size() * sizeof(T_CompTypeIdx));
+	uint64 hash = 14695981039346656037u;
+	for (size_t wordIdx = 0u; wordIdx < GetWordCount(); ++wordIdx)
+	{
+		T_Word const word = GetWord(wordIdx);
+		if (word == 0u)
+		{
+			continue;
+		}
+
+		// splitmix64 finalizer on the word tagged with its position
+		uint64 mixed = word ^ (static_cast<uint64>(wordIdx + 1u) * 0x9E3779B97F4A7C15u);
+		mixed = (mixed ^ (mixed >> 30u)) * 0xBF58476D1CE4E5B9u;
+		mixed = (mixed ^ (mixed >> 27u)) * 0x94D049BB133111EBu;
+		mixed ^= (mixed >> 31u);
+
+		hash = (hash ^ mixed) * 1099511628211u;
+	}
+
+	return static_cast<T_Hash>(hash ^ (hash >> 32u));
+}
+
+//-----------------------------
+// ComponentSignature::GetWord
+//
+// Words beyond the stored range are empty
+//
+ComponentSignature::T_Word ComponentSignature::GetWord(size_t const wordIdx) const
+{
+	if (wordIdx < s_InlineWordCount)
+	{
+		return m_Words[wordIdx];
+	}
+
+	size_t const overflowIdx = wordIdx - s_InlineWordCount;
+	return (overflowIdx < m_Overflow.size()) ? m_Overflow[overflowIdx] : 0u;
 }
 
 //-------------------------------
@@ -123,7 +253,26 @@ T_Hash ComponentSignature::GenId() const
 //
 bool operator==(ComponentSignature const& lhs, ComponentSignature const& rhs)
 {
-	return std::equal(lhs.GetTypes().cbegin(), lhs.GetTypes().cend(), rhs.GetTypes().cbegin());
+	if (lhs.GetSize() != rhs.GetSize())
+	{
+		return false;
+	}
+
+	size_t const wordCount = std::max(lhs.GetWordCount(), rhs.GetWordCount());
+	for (size_t wordIdx = 0u; wordIdx < wordCount; ++wordIdx)
+	{
+		if (lhs.GetWord(wordIdx) != rhs.GetWord(wordIdx))
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+bool operator!=(ComponentSignature const& lhs, ComponentSignature const& rhs)
+{
+	return !(lhs == rhs);
 }
 
 
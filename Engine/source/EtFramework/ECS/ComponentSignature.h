@@ -11,40 +11,66 @@ namespace fw {
 // ComponentSignature
 //
 // Identifier for a component composition
+//  - stored as a bitset with one bit per registered component type, so matching and hashing works on whole words
+//  - type indices beyond the inline range spill into a heap allocated overflow, which only very large registries need
 //
 class ComponentSignature final
 {
+	// definitions
+	//-------------
+public:
+	typedef uint64 T_Word;
+
+	static constexpr size_t s_BitsPerWord = sizeof(T_Word) * 8u;
+	static constexpr size_t s_InlineWordCount = 4u; // 256 component types fit without touching the heap
+	static constexpr size_t s_InlineTypeCount = s_InlineWordCount * s_BitsPerWord;
+
 	// construct destruct
 	//--------------------
-public:
+	ComponentSignature() = default;
 	ComponentSignature(T_CompTypeList const& types);
 	ComponentSignature(std::vector<RawComponentPtr> const& components);
 
+	// modifiers
+	//-----------
+	void Add(T_CompTypeIdx const type);
+	void Remove(T_CompTypeIdx const type);
+
 	// accessors
 	//-----------    
-	T_CompTypeList const& GetTypes() const { return m_Impl; }
-	size_t GetSize() const { return m_Impl.size(); }
+	T_CompTypeList GetTypes() const; // sorted
+	size_t GetSize() const { return m_Size; }
 	T_CompTypeIdx GetMaxComponentType() const;
+	bool Has(T_CompTypeIdx const type) const;
 	bool MatchesComponentsUnsorted(std::vector<RawComponentPtr> const& list) const;
 	bool Contains(ComponentSignature const& other) const;
 	T_Hash GenId() const;
 
+	size_t GetWordCount() const { return s_InlineWordCount + m_Overflow.size(); }
+	T_Word GetWord(size_t const wordIdx) const;
+
 	// Data
 	///////
 
 private:
-	T_CompTypeList m_Impl;
+	T_Word m_Words[s_InlineWordCount] = {};
+	std::vector<T_Word> m_Overflow;
+	size_t m_Size = 0u;
 };
 
 
 // comparison
 bool operator == (ComponentSignature const& lhs, ComponentSignature const& rhs);
+bool operator != (ComponentSignature const& lhs, ComponentSignature const& rhs);
 
 
 // generation
 template<typename... Args>
-ComponentSignature GenSignature() { return ComponentSignature(GenCompTypeList<Args...>()); }
+ComponentSignature GenSignature();
 
 
 } // namespace fw
 } // namespace et
+
+
+#include "ComponentSignature.inl"
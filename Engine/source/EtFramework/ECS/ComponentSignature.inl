@@ -0,0 +1,55 @@
+#pragma once
+
+
+namespace et {
+namespace fw {
+
+
+namespace detail {
+
+	//-----------------------------
+	// SignatureAdder
+	//
+	// implements a recursive variadic template which sets the bits for the component types in the template parameters
+	//
+	template <typename... Args>
+	struct SignatureAdder;
+
+	template<typename TComponentType>
+	struct SignatureAdder<TComponentType>
+	{
+		static void Call(ComponentSignature& sig)
+		{
+			sig.Add(TComponentType::GetTypeIndex());
+		}
+	};
+
+	template<typename TComponentType, typename... Args>
+	struct SignatureAdder<TComponentType, Args...>
+	{
+		static void Call(ComponentSignature& sig)
+		{
+			sig.Add(TComponentType::GetTypeIndex());
+			SignatureAdder<Args...>::Call(sig);
+		}
+	};
+
+} // namespace detail
+
+
+//-----------------------------
+// GenSignature
+//
+// Generate a signature from component types without going through a type list
+//
+template<typename... Args>
+ComponentSignature GenSignature()
+{
+	ComponentSignature ret;
+	detail::SignatureAdder<Args...>::Call(ret);
+	return ret;
+}
+
+
+} // namespace fw
+} // namespace et
@@ -45,6 +45,16 @@ void ComponentView::Init(BaseComponentRange* const range)
 		access.currentElement = static_cast<uint8*>(m_Range->m_Archetype->GetPool(access.typeIdx).At(m_Range->m_Offset));
 	}
 
+	size_t const chunkCapacity = m_Range->m_Archetype->GetChunkCapacity();
+	if (chunkCapacity > 0u)
+	{
+		m_ChunkEnd = chunkCapacity - (m_Range->m_Offset % chunkCapacity);
+	}
+	else
+	{
+		m_ChunkEnd = std::numeric_limits<size_t>::max(); // no component storage
+	}
+
 	// set the ecs controllers for accessors outside the current entity
 	for (EcsController const** controllerPtr : m_ControllerPtrs)
 	{
@@ -84,14 +94,59 @@ T_CompTypeList ComponentView::GetTypeList() const
 	return ret;
 }
 
-//---------------------
-// ComponentView::Next
+//------------------------------
+// ComponentView::GetAccessList
 //
-// Increment component pointers
+// How we access each component type - reading other entities components counts as read access
+//  - included types are not listed, as their data isn't touched
+//
+T_CompAccessList ComponentView::GetAccessList() const
+{
+	T_CompAccessList ret;
+
+	auto addAccess = [&ret](T_CompTypeIdx const typeIdx, E_ComponentAccess const access)
+		{
+			auto const foundIt = std::find_if(ret.begin(), ret.end(), [typeIdx](ComponentAccess const& existing)
+				{
+					return (existing.typeIdx == typeIdx);
+				});
+
+			if (foundIt == ret.cend())
+			{
+				ret.emplace_back(typeIdx, access);
+			}
+			else if (access == E_ComponentAccess::ReadWrite)
+			{
+				foundIt->access = access;
+			}
+		};
+
+	for (Accessor const& access : m_Accessors)
+	{
+		addAccess(access.typeIdx, access.read ? E_ComponentAccess::Read : E_ComponentAccess::ReadWrite);
+	}
+
+	for (Accessor const& access : m_ParentAccessors)
+	{
+		addAccess(access.typeIdx, E_ComponentAccess::Read);
+	}
+
+	for (T_CompTypeIdx const typeIdx : m_EntityReads)
+	{
+		addAccess(typeIdx, E_ComponentAccess::Read);
+	}
+
+	return ret;
+}
+
+//---------------------------------
+// ComponentView::GetCurrentEntity
+//
+// ID of the entity the view currently points to
 //
 T_EntityId ComponentView::GetCurrentEntity() const
 {
-	return m_Range->m_Archetype->GetEntity(m_Current);
+	return m_Range->m_Archetype->GetEntity(m_Current + m_Range->m_Offset);
 }
 
 //---------------------
@@ -108,9 +163,22 @@ bool ComponentView::Next()
 	}
 
 	// components in our entity
-	for (Accessor& access : m_Accessors)
+	if (m_Current == m_ChunkEnd)
+	{
+		// component arrays are not contiguous across chunks
+		for (Accessor& access : m_Accessors)
+		{
+			access.currentElement = static_cast<uint8*>(m_Range->m_Archetype->GetPool(access.typeIdx).At(m_Range->m_Offset + m_Current));
+		}
+
+		m_ChunkEnd += m_Range->m_Archetype->GetChunkCapacity();
+	}
+	else
 	{
-		access.currentElement += ComponentRegistry::Instance().GetSize(access.typeIdx);
+		for (Accessor& access : m_Accessors)
+		{
+			access.currentElement += ComponentRegistry::Instance().GetSize(access.typeIdx);
+		}
 	}
 
 	CalcParentPointers();
@@ -21,6 +21,21 @@ enum class E_ComponentAccess : uint8
 	Undefined
 };
 
+//---------------
+// ComponentAccess
+//
+// How a view accesses a component type, used to find out which systems can run at the same time
+//
+struct ComponentAccess final
+{
+	ComponentAccess(T_CompTypeIdx const type, E_ComponentAccess const acc) : typeIdx(type), access(acc) {}
+
+	T_CompTypeIdx typeIdx = INVALID_COMP_TYPE_IDX;
+	E_ComponentAccess access = E_ComponentAccess::Undefined;
+};
+
+typedef std::vector<ComponentAccess> T_CompAccessList;
+
 
 //-------------------
 // ComponentView
@@ -129,6 +144,7 @@ public:
 	//-----------
 	bool IsEnd() const;
 	T_CompTypeList GetTypeList() const;
+	T_CompAccessList GetAccessList() const;
 	T_EntityId GetCurrentEntity() const;
 
 	// functionality
@@ -162,8 +178,10 @@ private:
 	std::vector<Accessor> m_Accessors;
 	std::vector<Accessor> m_ParentAccessors;
 	std::vector<EcsController const**> m_ControllerPtrs;
+	T_CompTypeList m_EntityReads;
 	T_CompTypeList m_Includes;
 	size_t m_Current = 0u;
+	size_t m_ChunkEnd = 0u; // index at which the accessors need to jump to the next chunk
 	BaseComponentRange* m_Range = nullptr;
 };
 
@@ -172,6 +190,10 @@ private:
 template<typename TViewType>
 ComponentSignature SignatureFromView();
 
+// list how a view accesses component data
+template<typename TViewType>
+T_CompAccessList AccessFromView();
+
 
 } // namespace fw
 } // namespace et
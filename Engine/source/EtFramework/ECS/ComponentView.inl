@@ -52,6 +52,7 @@ template<typename TComponentType>
 void ComponentView::Declare(EntityRead<TComponentType>& read)
 {
 	m_ControllerPtrs.emplace_back(&read.m_Ecs);
+	m_EntityReads.emplace_back(TComponentType::GetTypeIndex());
 }
 
 //-------------------------
@@ -79,6 +80,16 @@ ComponentSignature SignatureFromView()
 	return ComponentSignature(temp.GetTypeList());
 }
 
+//-------------------
+// AccessFromView
+//
+template<typename TViewType>
+T_CompAccessList AccessFromView()
+{
+	TViewType temp;
+	return temp.GetAccessList();
+}
+
 
 } // namespace fw
 } // namespace et
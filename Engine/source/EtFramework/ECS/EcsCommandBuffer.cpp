@@ -21,20 +21,9 @@ namespace fw {
 //
 EcsCommandBuffer::~EcsCommandBuffer()
 {
-	ET_ASSERT(m_ReparentEntities.empty(), "deleting command buffer before it was merged!");
-	ET_ASSERT(m_RemoveEntities.empty(), "deleting command buffer before it was merged!");
-	ET_ASSERT(m_AddComponents.empty(), "deleting command buffer before it was merged!");
-	ET_ASSERT(m_RemoveComponents.empty(), "deleting command buffer before it was merged!");
+	ET_ASSERT(m_Blocks.empty(), "deleting command buffer before it was merged!");
 	
-	for (std::pair<T_EntityId const, AddBuffer>& addPair : m_AddComponents)
-	{
-		for (RawComponentPtr const& ptr : addPair.second.components)
-		{
-			// match malloc with free - hence we don't use the full destructor
-			ComponentRegistry::Instance().GetDestructor(ptr.typeIdx)(ptr.data);
-			free(ptr.data);
-		}
-	}
+	Reset();
 }
 
 
@@ -90,12 +79,9 @@ T_EntityId EcsCommandBuffer::DuplicateEntity(T_EntityId const dupe)
 //
 void EcsCommandBuffer::ReparentEntity(T_EntityId const entity, T_EntityId const newParent)
 {
-	ET_ASSERT(std::find_if(m_ReparentEntities.cbegin(), m_ReparentEntities.cend(), [entity](std::pair<T_EntityId, T_EntityId> const& pair)
-		{
-			return (entity == pair.first);
-		}) == m_ReparentEntities.cend(), "Entity was already queued for reparenting!");
+	ET_ASSERT(!IsQueued(E_Command::Reparent, entity), "Entity was already queued for reparenting!");
 
-	m_ReparentEntities.emplace_back(entity, newParent);
+	WriteCommand(E_Command::Reparent, entity, 0u)->parent = newParent;
 }
 
 //----------------------------------
@@ -103,31 +89,38 @@ void EcsCommandBuffer::ReparentEntity(T_EntityId const entity, T_EntityId const
 //
 void EcsCommandBuffer::RemoveEntity(T_EntityId const entity)
 {
-	ET_ASSERT(std::find(m_RemoveEntities.cbegin(), m_RemoveEntities.cend(), entity) == m_RemoveEntities.cend(), "It's like beating a dead horse!");
+	ET_ASSERT(!IsQueued(E_Command::RemoveEntity, entity), "It's like beating a dead horse!");
 
-	m_RemoveEntities.emplace_back(entity);
+	WriteCommand(E_Command::RemoveEntity, entity, 0u);
 }
 
 
 // modify component content
 ////////////////////////////
 
+//--------------------------------
+// EcsCommandBuffer::AddComponent
+//
+// Copy the component into the command stream
+//
+void EcsCommandBuffer::AddComponent(T_EntityId const entity, RawComponentPtr const& component)
+{
+	ComponentRegistry const& registry = ComponentRegistry::Instance();
+
+	CommandHeader* const header = WriteCommand(E_Command::AddComponent, entity, registry.GetSize(component.typeIdx));
+	header->typeIdx = component.typeIdx;
+
+	registry.GetCopyAssign(component.typeIdx)(component.data, GetPayload(header));
+}
+
 //------------------------------------
 // EcsCommandBuffer::AddComponentList
 //
 void EcsCommandBuffer::AddComponentList(T_EntityId const entity, std::vector<RawComponentPtr> const& components)
 {
-	// get the component pointer buffer for the entity
-	auto buffer = m_AddComponents.emplace(entity, AddBuffer()).first;
-	
-	// add components to buffer
 	for (RawComponentPtr const& comp : components)
 	{
-		// copy construct the component pointer
-		RawComponentPtr copy(comp.typeIdx, malloc(ComponentRegistry::Instance().GetSize(comp.typeIdx)));
-		ComponentRegistry::Instance().GetCopyAssign(comp.typeIdx)(comp.data, copy.data);
-
-		buffer->second.components.push_back(copy);
+		AddComponent(entity, comp);
 	}
 }
 
@@ -136,13 +129,9 @@ void EcsCommandBuffer::AddComponentList(T_EntityId const entity, std::vector<Raw
 //
 void EcsCommandBuffer::RemoveComponentTypes(T_EntityId const entity, T_CompTypeList const& componentTypes)
 {
-	// get the component type buffer for the entity
-	auto buffer = m_RemoveComponents.emplace(entity, T_CompTypeList()).first;
-
-	// add components to remove to the buffer
 	for (T_CompTypeIdx const compType : componentTypes)
 	{
-		buffer->second.push_back(compType);
+		WriteCommand(E_Command::RemoveComponent, entity, 0u)->typeIdx = compType;
 	}
 }
 
@@ -151,10 +140,7 @@ void EcsCommandBuffer::RemoveComponentTypes(T_EntityId const entity, T_CompTypeL
 //
 void EcsCommandBuffer::OnMerge(T_EntityId const entity, T_OnMergeFn& fn)
 {
-	// get the component pointer buffer for the entity
-	auto buffer = m_AddComponents.emplace(entity, AddBuffer()).first;
-
-	buffer->second.callbacks.emplace_back(fn);
+	new(GetPayload(WriteCommand(E_Command::OnMerge, entity, sizeof(T_OnMergeFn)))) T_OnMergeFn(fn);
 }
 
 
@@ -170,51 +156,320 @@ void EcsCommandBuffer::Merge()
 {
 	ET_ASSERT(m_Controller != nullptr);
 
-	// reparent entities
-	for (std::pair<T_EntityId, T_EntityId> const repPair : m_ReparentEntities)
+	if (m_Blocks.empty())
 	{
-		m_Controller->ReparentEntity(repPair.first, repPair.second);
+		return;
 	}
 
-	m_ReparentEntities.clear();
+	// reparent entities
+	for (Block const& block : m_Blocks)
+	{
+		for (size_t offset = 0u; offset < block.size;)
+		{
+			CommandHeader* const header = reinterpret_cast<CommandHeader*>(block.data + offset);
+			if (header->command == E_Command::Reparent)
+			{
+				m_Controller->ReparentEntity(header->entity, header->parent);
+			}
+
+			offset += header->size;
+		}
+	}
 
-	// remove components
-	for (std::pair<T_EntityId, T_CompTypeList> const& remComps : m_RemoveComponents)
+	// remove components - all types removed from an entity are gathered so that it only changes archetype once
+	m_SortEntries.clear();
+	uint32 order = 0u;
+	for (Block const& block : m_Blocks)
 	{
-		m_Controller->RemoveComponents(remComps.first, remComps.second);
+		for (size_t offset = 0u; offset < block.size; ++order)
+		{
+			CommandHeader* const header = reinterpret_cast<CommandHeader*>(block.data + offset);
+			if (header->command == E_Command::RemoveComponent)
+			{
+				m_SortEntries.push_back(MakeSortEntry(header, order));
+			}
+
+			offset += header->size;
+		}
 	}
 
-	m_RemoveComponents.clear();
+	SortCommands(m_SortEntries);
 
-	// add components
-	for (std::pair<T_EntityId const, AddBuffer>& addComps : m_AddComponents)
+	for (size_t entryIdx = 0u; entryIdx < m_SortEntries.size();)
 	{
-		m_Controller->AddComponents(addComps.first, std::vector<RawComponentPtr>(addComps.second.components));
+		T_EntityId const entity = m_SortEntries[entryIdx].entity;
 
-		// callbacks
-		for (T_OnMergeFn& fn : addComps.second.callbacks)
+		m_MergeTypes.clear();
+		for (; (entryIdx < m_SortEntries.size()) && (m_SortEntries[entryIdx].entity == entity); ++entryIdx)
 		{
-			fn(*m_Controller, addComps.first);
+			m_MergeTypes.push_back(m_SortEntries[entryIdx].command->typeIdx);
 		}
 
-		// delete the components in the buffer as they have now been copied into the ECS
-		for (RawComponentPtr const& ptr : addComps.second.components)
+		m_Controller->RemoveComponents(entity, m_MergeTypes);
+	}
+
+	// add components, component data is copied out of the stream into the archetypes
+	m_SortEntries.clear();
+	order = 0u;
+	for (Block const& block : m_Blocks)
+	{
+		for (size_t offset = 0u; offset < block.size; ++order)
 		{
-			// match malloc with free - hence we don't use the full destructor
-			ComponentRegistry::Instance().GetDestructor(ptr.typeIdx)(ptr.data);
-			free(ptr.data);
+			CommandHeader* const header = reinterpret_cast<CommandHeader*>(block.data + offset);
+			if ((header->command == E_Command::AddComponent) || (header->command == E_Command::OnMerge))
+			{
+				m_SortEntries.push_back(MakeSortEntry(header, order));
+			}
+
+			offset += header->size;
 		}
 	}
 
-	m_AddComponents.clear();
+	SortCommands(m_SortEntries);
+
+	for (size_t entryIdx = 0u; entryIdx < m_SortEntries.size();)
+	{
+		T_EntityId const entity = m_SortEntries[entryIdx].entity;
+		size_t const entityBegin = entryIdx;
+
+		m_MergeComponents.clear();
+		for (; (entryIdx < m_SortEntries.size()) && (m_SortEntries[entryIdx].entity == entity); ++entryIdx)
+		{
+			CommandHeader* const header = m_SortEntries[entryIdx].command;
+			if (header->command == E_Command::AddComponent)
+			{
+				m_MergeComponents.emplace_back(header->typeIdx, GetPayload(header));
+			}
+		}
+
+		m_Controller->AddComponents(entity, m_MergeComponents);
+
+		// callbacks, in the order they were recorded
+		for (size_t cbIdx = entityBegin; cbIdx < entryIdx; ++cbIdx)
+		{
+			CommandHeader* const header = m_SortEntries[cbIdx].command;
+			if (header->command == E_Command::OnMerge)
+			{
+				(*static_cast<T_OnMergeFn*>(GetPayload(header)))(*m_Controller, entity);
+			}
+		}
+	}
 
 	// remove entities
-	for (T_EntityId const remEnt : m_RemoveEntities)
+	m_SortEntries.clear();
+	order = 0u;
+	for (Block const& block : m_Blocks)
+	{
+		for (size_t offset = 0u; offset < block.size; ++order)
+		{
+			CommandHeader* const header = reinterpret_cast<CommandHeader*>(block.data + offset);
+			if (header->command == E_Command::RemoveEntity)
+			{
+				m_SortEntries.push_back(SortEntry{ 0u, header->entity, order, header });
+			}
+
+			offset += header->size;
+		}
+	}
+
+	DedupeRemovals(m_SortEntries);
+
+	for (SortEntry const& entry : m_SortEntries)
+	{
+		m_Controller->RemoveEntity(entry.entity);
+	}
+
+	Reset();
+}
+
+
+// utility
+///////////
+
+//--------------------------------
+// EcsCommandBuffer::WriteCommand
+//
+// Reserve space for a command and its payload at the end of the stream
+//
+EcsCommandBuffer::CommandHeader* EcsCommandBuffer::WriteCommand(E_Command const command, T_EntityId const entity, size_t const payloadSize)
+{
+	size_t size = sizeof(CommandHeader);
+	if (payloadSize > 0u)
+	{
+		size = s_PayloadOffset + payloadSize;
+	}
+
+	// keep the next header aligned too
+	size = (size + s_PayloadAlignment - 1u) & ~(s_PayloadAlignment - 1u);
+	ET_ASSERT(size <= ChunkPool::s_ChunkSize, "component too large to be recorded in a command buffer");
+
+	if (m_Blocks.empty() || (m_Blocks.back().size + size > ChunkPool::s_ChunkSize))
 	{
-		m_Controller->RemoveEntity(remEnt);
+		m_Blocks.push_back(Block{ m_BlockPool.Allocate(), 0u });
+	}
+
+	Block& block = m_Blocks.back();
+	CommandHeader* const header = reinterpret_cast<CommandHeader*>(block.data + block.size);
+	block.size += size;
+
+	header->command = command;
+	header->typeIdx = INVALID_COMP_TYPE_IDX;
+	header->size = static_cast<uint32>(size);
+	header->entity = entity;
+	header->parent = INVALID_ENTITY_ID;
+
+	return header;
+}
+
+//----------------------------
+// EcsCommandBuffer::IsQueued
+//
+// Linear search through the stream, for validation only
+//
+bool EcsCommandBuffer::IsQueued(E_Command const command, T_EntityId const entity) const
+{
+	for (Block const& block : m_Blocks)
+	{
+		for (size_t offset = 0u; offset < block.size;)
+		{
+			CommandHeader const* const header = reinterpret_cast<CommandHeader const*>(block.data + offset);
+			if ((header->command == command) && (header->entity == entity))
+			{
+				return true;
+			}
+
+			offset += header->size;
+		}
+	}
+
+	return false;
+}
+
+//----------------------------------
+// EcsCommandBuffer::DedupeRemovals
+//
+// Entities are removed along with their children, so removals of entities that are queued more than once, or whose ancestors
+// are queued too, would reach entities that no longer exist. Those are dropped before anything is removed, the rest stays in recording order
+//
+void EcsCommandBuffer::DedupeRemovals(std::vector<SortEntry>& entries) const
+{
+	auto const compareEntity = [](SortEntry const& lhs, SortEntry const& rhs)
+		{
+			return lhs.entity < rhs.entity;
+		};
+
+	std::sort(entries.begin(), entries.end(), [](SortEntry const& lhs, SortEntry const& rhs)
+		{
+			return (lhs.entity != rhs.entity) ? (lhs.entity < rhs.entity) : (lhs.order < rhs.order);
+		});
+
+	entries.erase(std::unique(entries.begin(), entries.end(), [](SortEntry const& lhs, SortEntry const& rhs)
+		{
+			return lhs.entity == rhs.entity;
+		}), entries.end());
+
+	// mark entries with a queued ancestor while all entities are still around
+	for (SortEntry& entry : entries)
+	{
+		for (T_EntityId ancestor = m_Controller->GetParent(entry.entity); ancestor != INVALID_ENTITY_ID; ancestor = m_Controller->GetParent(ancestor))
+		{
+			SortEntry const key{ 0u, ancestor, 0u, nullptr };
+			if (std::binary_search(entries.cbegin(), entries.cend(), key, compareEntity))
+			{
+				entry.command = nullptr;
+				break;
+			}
+		}
+	}
+
+	entries.erase(std::remove_if(entries.begin(), entries.end(), [](SortEntry const& entry)
+		{
+			return (entry.command == nullptr);
+		}), entries.end());
+
+	std::sort(entries.begin(), entries.end(), [](SortEntry const& lhs, SortEntry const& rhs)
+		{
+			return lhs.order < rhs.order;
+		});
+}
+
+//---------------------------------
+// EcsCommandBuffer::MakeSortEntry
+//
+EcsCommandBuffer::SortEntry EcsCommandBuffer::MakeSortEntry(CommandHeader* const header, uint32 const order) const
+{
+	Archetype const* const archetype = m_Controller->GetArchetype(header->entity);
+	T_Hash const signature = (archetype != nullptr) ? archetype->GetSignatureId() : 0u;
+
+	return SortEntry{ signature, header->entity, order, header };
+}
+
+//--------------------------------
+// EcsCommandBuffer::SortCommands
+//
+// Group commands by archetype so entities with the same layout are moved together, and by entity so each entity is only moved once
+//  - the key only depends on signatures, entity IDs and recording order, so the merge order is the same from run to run
+//  - commands for the same entity stay in recording order
+//
+void EcsCommandBuffer::SortCommands(std::vector<SortEntry>& entries) const
+{
+	std::sort(entries.begin(), entries.end(), [](SortEntry const& lhs, SortEntry const& rhs)
+		{
+			if (lhs.signature != rhs.signature)
+			{
+				return lhs.signature < rhs.signature;
+			}
+
+			if (lhs.entity != rhs.entity)
+			{
+				return lhs.entity < rhs.entity;
+			}
+
+			return lhs.order < rhs.order;
+		});
+}
+
+//----------------------------------
+// EcsCommandBuffer::DestroyPayload
+//
+void EcsCommandBuffer::DestroyPayload(CommandHeader* const header)
+{
+	switch (header->command)
+	{
+	case E_Command::AddComponent:
+		// the memory belongs to the stream, hence we don't use the full destructor
+		ComponentRegistry::Instance().GetDestructor(header->typeIdx)(GetPayload(header));
+		break;
+
+	case E_Command::OnMerge:
+		static_cast<T_OnMergeFn*>(GetPayload(header))->~T_OnMergeFn();
+		break;
+
+	default:
+		break;
+	}
+}
+
+//-------------------------
+// EcsCommandBuffer::Reset
+//
+// Destroy everything that is left in the stream and return the blocks to the pool
+//
+void EcsCommandBuffer::Reset()
+{
+	for (Block const& block : m_Blocks)
+	{
+		for (size_t offset = 0u; offset < block.size;)
+		{
+			CommandHeader* const header = reinterpret_cast<CommandHeader*>(block.data + offset);
+			DestroyPayload(header);
+			offset += header->size;
+		}
+
+		m_BlockPool.Free(block.data);
 	}
 
-	m_RemoveEntities.clear();
+	m_Blocks.clear();
 }
 
 
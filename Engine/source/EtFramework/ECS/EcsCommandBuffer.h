@@ -1,4 +1,5 @@
 #pragma once
+#include "ChunkPool.h"
 #include "ComponentRegistry.h"
 #include "RawComponentPointer.h"
 
@@ -8,6 +9,7 @@ namespace fw {
 
 
 class EcsController;
+class Archetype;
 
 
 //------------------
@@ -15,14 +17,16 @@ class EcsController;
 //
 // Queues modifications to the ECS in a concurrency friendly way, so that systems can modify the entity layout
 //  - components added to the buffer cannot be used until the buffer is merged with the ECS
+//  - commands are written linearly into pooled memory blocks, with component data and callbacks stored inline,
+//		so recording doesn't hash or allocate once the buffer has warmed up
 //
 //  - Merge order:
 //		- Create new empty entities immediately, including duplications, but queue duplicate components for later addition
 //
-//		- Reparent entities
-//		- Remove Components
-//		- Add Components - callbacks for entities with events
-//		- Remove entities
+//		- Reparent entities - in recording order
+//		- Remove Components - sorted by archetype signature and entity, so each entity only moves once
+//		- Add Components - sorted likewise, callbacks for entities with events
+//		- Remove entities - in recording order, removals that are covered by another one are skipped
 //
 class EcsCommandBuffer final
 {
@@ -32,12 +36,44 @@ public:
 	typedef std::function<void(EcsController&, T_EntityId const)> T_OnMergeFn;
 
 private:
-	struct AddBuffer
+	enum class E_Command : uint8
 	{
-		std::vector<RawComponentPtr> components;
-		std::vector<T_OnMergeFn> callbacks;
+		Reparent,
+		RemoveComponent,
+		AddComponent,
+		OnMerge,
+		RemoveEntity
 	};
 
+	// start of every command in the stream, optionally followed by a payload
+	struct CommandHeader final
+	{
+		E_Command command;
+		T_CompTypeIdx typeIdx; // component commands
+		uint32 size; // header and payload, offset to the next command
+		T_EntityId entity;
+		T_EntityId parent; // reparent commands
+	};
+
+	// memory block of the command stream
+	struct Block final
+	{
+		uint8* data;
+		size_t size;
+	};
+
+	// command reference for sorting at merge time, the key doesn't depend on memory addresses so that merging is deterministic
+	struct SortEntry final
+	{
+		T_Hash signature; // of the entities archetype
+		T_EntityId entity;
+		uint32 order; // within the stream
+		CommandHeader* command;
+	};
+
+	static constexpr size_t s_PayloadAlignment = 16u; // enough for any component type, including SIMD vectors
+	static constexpr size_t s_PayloadOffset = (sizeof(CommandHeader) + s_PayloadAlignment - 1u) & ~(s_PayloadAlignment - 1u);
+
 	friend class SystemBase;
 
 	// construct destruct
@@ -65,6 +101,7 @@ public:
 	//--------------------------
 	template<typename TComponentType, typename... Args>
 	void AddComponents(T_EntityId const entity, TComponentType& component1, Args... args);
+	void AddComponent(T_EntityId const entity, RawComponentPtr const& component);
 	void AddComponentList(T_EntityId const entity, std::vector<RawComponentPtr> const& components);
 
 	template<typename TComponentType, typename... Args>
@@ -81,16 +118,31 @@ private:
 	void SetController(EcsController* const ecs) { m_Controller = ecs; }
 	void Merge();
 
+	// utility
+	//---------
+	CommandHeader* WriteCommand(E_Command const command, T_EntityId const entity, size_t const payloadSize);
+	static void* GetPayload(CommandHeader* const header) { return reinterpret_cast<uint8*>(header) + s_PayloadOffset; }
+
+	bool IsQueued(E_Command const command, T_EntityId const entity) const;
+
+	SortEntry MakeSortEntry(CommandHeader* const header, uint32 const order) const;
+	void SortCommands(std::vector<SortEntry>& entries) const;
+	void DedupeRemovals(std::vector<SortEntry>& entries) const;
+	void DestroyPayload(CommandHeader* const header);
+	void Reset();
+
 	// Data
 	///////
 
 	EcsController* m_Controller = nullptr;
 
-	std::vector<std::pair<T_EntityId, T_EntityId>> m_ReparentEntities; // [to reparent, new parent]
-	std::vector<T_EntityId> m_RemoveEntities;
+	ChunkPool m_BlockPool; // blocks are recycled after merging
+	std::vector<Block> m_Blocks; // the command stream, in recording order
 
-	std::unordered_map<T_EntityId, AddBuffer> m_AddComponents;
-	std::unordered_map<T_EntityId, T_CompTypeList> m_RemoveComponents;
+	// reused between merges
+	std::vector<SortEntry> m_SortEntries;
+	std::vector<RawComponentPtr> m_MergeComponents;
+	T_CompTypeList m_MergeTypes;
 };
 
 
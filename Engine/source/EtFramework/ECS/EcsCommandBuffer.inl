@@ -10,21 +10,19 @@ namespace detail {
 	//-------------------------------
 	// EcsCommandBuffer::AddToBuffer
 	//
-	// variadic template recursively adds components to a raw component pointer list and finally add the list to the buffer
-	// adding the components in the last recursion call prevents components from going out of scope for some reason
+	// variadic template recursively copies components into the buffer
 	//
 	template<typename TComponentType>
-	void AddToBuffer(EcsCommandBuffer& buffer, T_EntityId const entity, std::vector<RawComponentPtr>& list, TComponentType& component)
+	void AddToBuffer(EcsCommandBuffer& buffer, T_EntityId const entity, TComponentType& component)
 	{
-		list.emplace_back(MakeRawComponent(component));
-		buffer.AddComponentList(entity, list);
+		buffer.AddComponent(entity, MakeRawComponent(component));
 	}
 
 	template<typename TComponentType, typename... Args>
-	void AddToBuffer(EcsCommandBuffer& buffer, T_EntityId const entity, std::vector<RawComponentPtr>& list, TComponentType& component1, Args... args)
+	void AddToBuffer(EcsCommandBuffer& buffer, T_EntityId const entity, TComponentType& component1, Args... args)
 	{
-		list.emplace_back(MakeRawComponent(component1));
-		AddToBuffer(buffer, entity, list, args...);
+		buffer.AddComponent(entity, MakeRawComponent(component1));
+		AddToBuffer(buffer, entity, args...);
 	}
 
 }
@@ -44,8 +42,7 @@ namespace detail {
 template<typename TComponentType, typename... Args>
 void EcsCommandBuffer::AddComponents(T_EntityId const entity, TComponentType& component1, Args... args)
 {
-	std::vector<RawComponentPtr> list;
-	detail::AddToBuffer(*this, entity, list, component1, args...);
+	detail::AddToBuffer(*this, entity, component1, args...);
 }
 
 //------------------------------------
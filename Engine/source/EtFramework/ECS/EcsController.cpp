@@ -9,6 +9,58 @@ namespace et {
 namespace fw {
 
 
+//=================================
+// ECS Controller Registered System
+//=================================
+
+
+//-------------------------------------------------
+// EcsController::RegisteredSystem::ConflictsWith
+//
+// Systems conflict if they access the same component type or resource while at least one of them writes to it
+//
+bool EcsController::RegisteredSystem::ConflictsWith(RegisteredSystem const& other) const
+{
+	if (system->IsExclusive() || other.system->IsExclusive())
+	{
+		return true;
+	}
+
+	auto const writesAccessed = [](SystemBase const* const writer, SystemBase const* const accessor)
+		{
+			for (rttr::type::type_id const resource : writer->GetResourceWrites())
+			{
+				if ((std::find(accessor->GetResourceWrites().cbegin(), accessor->GetResourceWrites().cend(), resource) != accessor->GetResourceWrites().cend())
+					|| (std::find(accessor->GetResourceReads().cbegin(), accessor->GetResourceReads().cend(), resource) != accessor->GetResourceReads().cend()))
+				{
+					return true;
+				}
+			}
+
+			return false;
+		};
+
+	if (writesAccessed(system, other.system) || writesAccessed(other.system, system))
+	{
+		return true;
+	}
+
+	for (ComponentAccess const& compAccess : access)
+	{
+		for (ComponentAccess const& otherAccess : other.access)
+		{
+			if ((compAccess.typeIdx == otherAccess.typeIdx) 
+				&& ((compAccess.access == E_ComponentAccess::ReadWrite) || (otherAccess.access == E_ComponentAccess::ReadWrite)))
+			{
+				return true;
+			}
+		}
+	}
+
+	return false;
+}
+
+
 //================
 // ECS Controller
 //================
@@ -30,12 +82,9 @@ EcsController::EcsController()
 EcsController::~EcsController()
 {
 	// delete archetypes
-	for (ArchetypeContainer& container : m_HierachyLevels)
+	for (std::pair<T_Hash const, Archetype*>& arch : m_Archetypes)
 	{
-		for (std::pair<T_Hash const, Archetype*>& arch : container.archetypes)
-		{
-			delete arch.second;
-		}
+		delete arch.second;
 	}
 
 	// delete systems
@@ -102,8 +151,10 @@ T_EntityId EcsController::AddEntityBatched(T_EntityId const parent, std::vector<
 	}
 
 	// find the archetype for the new component list
-	ent.first->archetype = FindOrCreateArchetype(ComponentSignature(components), ent.first->layer);
-	ent.first->index = ent.first->archetype->AddEntity(ent.second, components);
+	ent.first->archetype = FindOrCreateArchetype(ComponentSignature(components));
+	ent.first->index = ent.first->archetype->AddEntity(ent.second, components, ent.first->layer, &m_MovedIndices);
+	ent.first->archetype->MarkEntityChanged(ent.first->index, m_ChangeVersion);
+	UpdateMovedEntities(ent.first->archetype);
 
 	// emit events for the added components
 	std::vector<RawComponentPtr> addedComponents;
@@ -121,6 +172,67 @@ T_EntityId EcsController::AddEntityBatched(T_EntityId const parent, std::vector<
 	return ent.second;
 }
 
+//-------------------------------------
+// EcsController::SpawnEntitiesBatched
+//
+// Add count entities that start out with copies of the same components
+//  - ids, archetype space and component copies are allocated in one go, and events are fired once for the whole batch
+//
+std::vector<T_EntityId> EcsController::SpawnEntitiesBatched(T_EntityId const parent, size_t const count, std::vector<RawComponentPtr> const& components)
+{
+	std::vector<T_EntityId> entities;
+	if (count == 0u)
+	{
+		return entities;
+	}
+
+	// all entities share the same hierachy and archetype
+	EntityData data;
+	if (parent != INVALID_ENTITY_ID)
+	{
+		data.parent = parent;
+		data.layer = m_Entities[parent].layer + 1u;
+	}
+
+	data.archetype = FindOrCreateArchetype(ComponentSignature(components));
+
+	m_Entities.insert(static_cast<core::slot_map<EntityData>::size_type>(count), data, entities);
+
+	size_t const firstIdx = data.archetype->AddEntities(entities.data(), count, components, data.layer, &m_MovedIndices);
+	for (size_t idx = 0u; idx < count; ++idx)
+	{
+		m_Entities[entities[idx]].index = firstIdx + idx;
+	}
+
+	UpdateMovedEntities(data.archetype);
+
+	if (parent != INVALID_ENTITY_ID)
+	{
+		std::vector<T_EntityId>& children = m_Entities[parent].children;
+		children.insert(children.end(), entities.cbegin(), entities.cend());
+	}
+
+	// mark every chunk the batch was added to
+	size_t const chunkCapacity = data.archetype->GetChunkCapacity();
+	if (chunkCapacity > 0u)
+	{
+		for (size_t idx = firstIdx; idx < firstIdx + count; idx = ((idx / chunkCapacity) + 1u) * chunkCapacity)
+		{
+			data.archetype->MarkEntityChanged(idx, m_ChangeVersion);
+		}
+	}
+
+	// emit events for the added components and entities
+	for (T_CompTypeIdx const compType : data.archetype->GetTypes())
+	{
+		m_ComponentEvents[compType].Notify(detail::E_EcsEvent::Added, new detail::ComponentEventData(this, compType, entities.data(), count));
+	}
+
+	m_EntityEvents.Notify(detail::E_EcsEvent::Added, new detail::EntityEventData(this, entities.data(), count));
+
+	return entities;
+}
+
 //---------------------------------------------
 // EcsController::DuplicateEntityAddComponents
 //
@@ -155,8 +267,10 @@ T_EntityId EcsController::DuplicateEntityAddComponents(T_EntityId const dupe, st
 	}
 
 	// find the archetype for the new component list
-	ent.first->archetype = FindOrCreateArchetype(ComponentSignature(currentComponents), ent.first->layer);
-	ent.first->index = ent.first->archetype->AddEntity(ent.second, currentComponents);
+	ent.first->archetype = FindOrCreateArchetype(ComponentSignature(currentComponents));
+	ent.first->index = ent.first->archetype->AddEntity(ent.second, currentComponents, ent.first->layer, &m_MovedIndices);
+	ent.first->archetype->MarkEntityChanged(ent.first->index, m_ChangeVersion);
+	UpdateMovedEntities(ent.first->archetype);
 
 	// emit events for the added components
 	std::vector<RawComponentPtr> addedComponents;
@@ -188,10 +302,9 @@ void EcsController::ReparentEntity(T_EntityId const entity, T_EntityId const new
 	// remove from current parent
 	RemoveEntityFromParent(entity, ent.parent);
 
-	std::vector<RawComponentPtr> components;
-	T_CompTypeList compTypes = GetComponentsAndTypes(ent, components);
-
 	// add to new parent, and get new layer
+	uint8 const prevLayer = ent.layer;
+
 	ent.parent = newParent;
 	if (ent.parent != INVALID_ENTITY_ID)
 	{
@@ -205,12 +318,19 @@ void EcsController::ReparentEntity(T_EntityId const entity, T_EntityId const new
 		ent.layer = 0u;
 	}
 
-	// #todo: handle cases in which the hierachy level didn't change
-	// the archetype will have the same signature but reside on a new hierachy layer
-	MoveArchetype(entity, ent, compTypes, components);
+	if (ent.layer == prevLayer)
+	{
+		return; // neither this entity nor its children need to move
+	}
 
-	// recursively reparent children to match hierachy layers
-	for (T_EntityId const childId : ent.children)
+	// the entity stays in its archetype, but moves to the range of its new hierachy layer
+	ent.index = ent.archetype->ChangeLayer(ent.index, ent.layer, &m_MovedIndices);
+	ent.archetype->MarkEntityChanged(ent.index, m_ChangeVersion);
+	UpdateMovedEntities(ent.archetype);
+
+	// recursively reparent children to match hierachy layers - reparenting modifies our child list so we iterate a copy
+	std::vector<T_EntityId> const children = ent.children;
+	for (T_EntityId const childId : children)
 	{
 		ReparentEntity(childId, entity);
 	}
@@ -262,31 +382,22 @@ void EcsController::RemoveAllEntities()
 	if (m_EntityEvents.GetListenerCount() > 0u) // ensure its worth iterating
 	{
 		std::vector<T_EntityId> const& entities = GetEntities();
-		for (T_EntityId const entity : entities)
-		{
-			m_EntityEvents.Notify(detail::E_EcsEvent::Removed, new detail::EntityEventData(this, entity));
-		}
+		m_EntityEvents.Notify(detail::E_EcsEvent::Removed, new detail::EntityEventData(this, entities.data(), entities.size()));
 	}
 
 	// emit remove events for components
-	for (ArchetypeContainer& level : m_HierachyLevels)
+	for (std::pair<T_Hash const, Archetype*>& arch : m_Archetypes)
 	{
-		for (std::pair<T_Hash const, Archetype*>& arch : level.archetypes)
+		if (arch.second->GetSize() > 0u) // ensure its worth iterating
 		{
-			size_t const entityCount = arch.second->GetSize();
-			if (entityCount > 0u) // ensure its worth iterating
+			std::vector<T_EntityId> const entities = arch.second->GetEntities(); // copied in case a callback changes the archetype
+			for (T_CompTypeIdx const compType : arch.second->GetTypes())
 			{
-				for (ComponentPool& pool : arch.second->GetPools())
+				detail::T_ComponentEventDispatcher& events = m_ComponentEvents[compType];
+
+				if (events.GetListenerCount() > 0u) // ensure its worth iterating
 				{
-					detail::T_ComponentEventDispatcher& events = m_ComponentEvents[pool.GetType()];
-
-					if (events.GetListenerCount() > 0u) // ensure its worth iterating
-					{
-						for (size_t idx = 0u; idx < entityCount; ++idx)
-						{
-							events.Notify(detail::E_EcsEvent::Removed, new detail::ComponentEventData(this, pool.At(idx), arch.second->GetEntity(idx)));
-						}
-					}
+					events.Notify(detail::E_EcsEvent::Removed, new detail::ComponentEventData(this, compType, entities.data(), entities.size()));
 				}
 			}
 		}
@@ -296,12 +407,9 @@ void EcsController::RemoveAllEntities()
 	m_Entities.clear();
 
 	// remove components
-	for (ArchetypeContainer& level : m_HierachyLevels)
+	for (std::pair<T_Hash const, Archetype*>& arch : m_Archetypes)
 	{
-		for (std::pair<T_Hash const, Archetype*>& arch : level.archetypes)
-		{
-			arch.second->Clear();
-		}
+		arch.second->Clear();
 	}
 }
 
@@ -316,20 +424,21 @@ void EcsController::RemoveAllEntities()
 //
 void EcsController::AddComponents(T_EntityId const entity, std::vector<RawComponentPtr>& components)
 {
+	if (components.empty())
+	{
+		return;
+	}
+
 	// get referred entity
 	EntityData& ent = m_Entities[entity];
 
-	std::vector<RawComponentPtr> currentComponents;
-	T_CompTypeList compTypes = GetComponentsAndTypes(ent, currentComponents);
-
-	// add the new components
+	T_CompTypeList addedTypes;
 	for (RawComponentPtr const& comp : components)
 	{
-		compTypes.emplace_back(comp.typeIdx);
-		currentComponents.emplace_back(comp);
+		addedTypes.emplace_back(comp.typeIdx);
 	}
 
-	MoveArchetype(entity, ent, compTypes, currentComponents);
+	RelocateEntity(entity, ent, GetArchetypeWithAdded(ent.archetype, addedTypes), components);
 
 	// reassign the component pointers and emit component add events
 	for (RawComponentPtr& comp : components)
@@ -346,43 +455,22 @@ void EcsController::AddComponents(T_EntityId const entity, std::vector<RawCompon
 //
 void EcsController::RemoveComponents(T_EntityId const entity, T_CompTypeList const& componentTypes)
 {
+	if (componentTypes.empty())
+	{
+		return;
+	}
+
 	// get referred entity
 	EntityData& ent = m_Entities[entity];
 
-	std::vector<RawComponentPtr> currentComponents;
-	T_CompTypeList compTypes = GetComponentsAndTypes(ent, currentComponents);
-
-	// remove the components and emit events for them
+	// emit events for the components while they still exist
 	for (T_CompTypeIdx const comp : componentTypes)
 	{
-		if (compTypes.size() == 1u)
-		{
-			ET_ASSERT(compTypes[0u] == comp);
-			compTypes.clear();
-
-			ET_ASSERT(currentComponents.size() == 1u);
-			ET_ASSERT(currentComponents[0u].typeIdx == comp);
-			m_ComponentEvents[comp].Notify(detail::E_EcsEvent::Removed, new detail::ComponentEventData(this, currentComponents[0u].data, entity));
-			currentComponents.clear();
-		}
-		else
-		{
-			auto const foundType = std::find(compTypes.begin(), compTypes.end(), comp);
-			ET_ASSERT(foundType != compTypes.cend());
-
-			size_t const idx = foundType - compTypes.cbegin();
-			ET_ASSERT(compTypes[idx] == currentComponents[idx].typeIdx);
-
-			compTypes[idx] = compTypes[compTypes.size() - 1];
-			compTypes.pop_back();
-
-			m_ComponentEvents[comp].Notify(detail::E_EcsEvent::Removed, new detail::ComponentEventData(this, currentComponents[idx].data, entity));
-			currentComponents[idx] = currentComponents[currentComponents.size() - 1];
-			currentComponents.pop_back();
-		}
+		ET_ASSERT(ent.archetype->HasComponent(comp));
+		m_ComponentEvents[comp].Notify(detail::E_EcsEvent::Removed, new detail::ComponentEventData(this, ent.archetype->GetPool(comp).At(ent.index), entity));
 	}
 
-	MoveArchetype(entity, ent, compTypes, currentComponents);
+	RelocateEntity(entity, ent, GetArchetypeWithRemoved(ent.archetype, componentTypes), std::vector<RawComponentPtr>());
 }
 
 
@@ -398,7 +486,16 @@ T_EntityEventId EcsController::RegisterOnEntityAdded(T_EntityEventFn& fn)
 		[this, fn](detail::T_EcsEvent const flags, detail::EntityEventData const* const evnt) -> void
 		{
 			ET_UNUSED(flags);
-			fn(*evnt->controller, evnt->entity);
+			for (size_t idx = 0u; idx < evnt->GetCount(); ++idx)
+			{
+				T_EntityId const entity = evnt->GetEntity(idx);
+				if (evnt->IsBatch() && !m_Entities.is_valid(entity))
+				{
+					continue; // an earlier callback removed it
+				}
+
+				fn(*evnt->controller, entity);
+			}
 		}));
 }
 
@@ -411,7 +508,16 @@ T_EntityEventId EcsController::RegisterOnEntityRemoved(T_EntityEventFn& fn)
 		[this, fn](detail::T_EcsEvent const flags, detail::EntityEventData const* const evnt) -> void
 		{
 			ET_UNUSED(flags);
-			fn(*evnt->controller, evnt->entity);
+			for (size_t idx = 0u; idx < evnt->GetCount(); ++idx)
+			{
+				T_EntityId const entity = evnt->GetEntity(idx);
+				if (evnt->IsBatch() && !m_Entities.is_valid(entity))
+				{
+					continue; // an earlier callback removed it
+				}
+
+				fn(*evnt->controller, entity);
+			}
 		}));
 }
 
@@ -433,25 +539,49 @@ void EcsController::UnregisterEntityEvent(T_EntityEventId& callbackId)
 // EcsController::Process
 //
 // Update all systems according to their implicit schedule
+//  - with a worker pool the systems of each stage run at the same time, commands are merged in schedule order once the stage completes
 //
 void EcsController::Process()
 {
-	for (RegisteredSystem* const sys : m_Schedule)
+	if (m_WorkerPool == nullptr)
 	{
-		sys->system->SetCommandController(this);
+		for (RegisteredSystem* const sys : m_Schedule)
+		{
+			sys->system->BeginRun(++m_ChangeVersion);
+			ProcessSystem(sys);
+
+			++m_ChangeVersion; // merged changes are newer than anything the system wrote
+			sys->system->MergeCommands();
+		}
 
-		for (RegisteredSystem::ArchetypeLayer& layer : sys->matchingArchetypes)
+		return;
+	}
+
+	for (SystemStage& stage : m_Stages)
+	{
+		for (RegisteredSystem* const sys : stage.systems)
 		{
-			for (Archetype* const arch : layer.archetypes)
-			{
-				if (arch->GetSize() > 0u)
-				{
-					sys->system->RootProcess(this, arch, 0u, arch->GetSize());
-				}
-			}
+			sys->system->BeginRun(++m_ChangeVersion);
+		}
+
+		core::WorkerPool::JobGroup stageJobs;
+
+		// the calling thread takes the first system so it doesn't idle
+		for (size_t sysIdx = 1u; sysIdx < stage.systems.size(); ++sysIdx)
+		{
+			RegisteredSystem* const sys = stage.systems[sysIdx];
+			m_WorkerPool->Push([this, sys]() { ProcessSystem(sys); }, stageJobs);
 		}
 
-		sys->system->MergeCommands();
+		ProcessSystem(stage.systems[0u]);
+		m_WorkerPool->Wait(stageJobs);
+
+		// structural changes can only be applied while no system iterates the archetypes
+		++m_ChangeVersion;
+		for (RegisteredSystem* const sys : stage.systems)
+		{
+			sys->system->MergeCommands();
+		}
 	}
 }
 
@@ -488,7 +618,7 @@ std::vector<T_EntityId> const& EcsController::GetChildren(T_EntityId const entit
 //
 std::vector<T_CompTypeIdx> const& EcsController::GetComponentTypes(T_EntityId const entity) const
 {
-	return m_Entities[entity].archetype->GetSignature().GetTypes();
+	return m_Entities[entity].archetype->GetTypes();
 }
 
 //-----------------------------
@@ -506,6 +636,9 @@ void* EcsController::GetComponentData(T_EntityId const entity, T_CompTypeIdx con
 {
 	EntityData& ent = m_Entities[entity];
 
+	// non const access is assumed to write
+	ent.archetype->MarkChunkChanged(compType, ent.index / ent.archetype->GetChunkCapacity(), m_ChangeVersion);
+
 	return ent.archetype->GetPool(compType).At(ent.index);
 }
 
@@ -528,22 +661,15 @@ void const* EcsController::GetComponentData(T_EntityId const entity, T_CompTypeI
 //
 // Get the associated archetype or create a new one
 //
-Archetype* EcsController::FindOrCreateArchetype(ComponentSignature const& sig, uint8 const layer)
+Archetype* EcsController::FindOrCreateArchetype(ComponentSignature const& sig)
 {
 	T_Hash const sigId = sig.GenId();
 
-	// ensure we have an archetype container for the hierachy layer we are on
-	while (m_HierachyLevels.size() <= static_cast<size_t>(layer))
-	{
-		m_HierachyLevels.emplace_back(ArchetypeContainer());
-	}
-
 	// find or create
-	ArchetypeContainer& cont = m_HierachyLevels[layer];
-	auto foundA = cont.archetypes.find(sigId);
-	if (foundA == cont.archetypes.cend())
+	auto foundA = m_Archetypes.find(sigId);
+	if (foundA == m_Archetypes.cend())
 	{
-		auto res = cont.archetypes.emplace(sigId, new Archetype(sig));
+		auto res = m_Archetypes.emplace(sigId, new Archetype(sig, m_ChunkPool));
 		ET_ASSERT(res.second == true);
 		foundA = res.first;
 
@@ -552,33 +678,98 @@ Archetype* EcsController::FindOrCreateArchetype(ComponentSignature const& sig, u
 		{
 			if (foundA->second->GetSignature().Contains(sys->signature))
 			{
-				while (sys->matchingArchetypes.size() <= static_cast<size_t>(layer)) // ensure we have enough layers
-				{
-					sys->matchingArchetypes.push_back(RegisteredSystem::ArchetypeLayer());
-				}
-
-				sys->matchingArchetypes[layer].archetypes.push_back(foundA->second);
+				sys->matchingArchetypes.push_back(foundA->second);
 			}
 		}
 	}
 
+	ET_ASSERT(foundA->second->GetSignature() == sig, "archetype signature hash collision!");
 	return foundA->second;
 }
 
-//------------------------------
-// EcsController::MoveArchetype
+//---------------------------------------
+// EcsController::GetArchetypeWithAdded
 //
-// Move an entities component data to the correct archetype
+// Find the archetype an entity moves to when adding components - single component transitions are cached on the archetypes
 //
-void EcsController::MoveArchetype(T_EntityId const entId, EntityData& ent, T_CompTypeList const& compTypes, std::vector<RawComponentPtr> const& components)
+Archetype* EcsController::GetArchetypeWithAdded(Archetype* const archetype, T_CompTypeList const& addedTypes)
 {
-	// find the archetype for the new component list
-	Archetype* const nextA = FindOrCreateArchetype(ComponentSignature(compTypes), ent.layer);
+	if (addedTypes.size() == 1u)
+	{
+		Archetype* const edge = archetype->GetAddEdge(addedTypes[0u]);
+		if (edge != nullptr)
+		{
+			return edge;
+		}
+	}
+
+	ComponentSignature sig = archetype->GetSignature();
+	for (T_CompTypeIdx const compType : addedTypes)
+	{
+		ET_ASSERT(!sig.Has(compType), "entity already has a component of this type");
+		sig.Add(compType);
+	}
 
-	// add our entity to the next archetype
-	size_t const nextIdx = nextA->AddEntity(entId, components);
+	Archetype* const nextA = FindOrCreateArchetype(sig);
 
-	RemoveEntityFromArchetype(ent);
+	if (addedTypes.size() == 1u)
+	{
+		archetype->SetAddEdge(addedTypes[0u], nextA);
+		nextA->SetRemoveEdge(addedTypes[0u], archetype);
+	}
+
+	return nextA;
+}
+
+//-----------------------------------------
+// EcsController::GetArchetypeWithRemoved
+//
+// Find the archetype an entity moves to when removing components - single component transitions are cached on the archetypes
+//
+Archetype* EcsController::GetArchetypeWithRemoved(Archetype* const archetype, T_CompTypeList const& removedTypes)
+{
+	if (removedTypes.size() == 1u)
+	{
+		Archetype* const edge = archetype->GetRemoveEdge(removedTypes[0u]);
+		if (edge != nullptr)
+		{
+			return edge;
+		}
+	}
+
+	ComponentSignature sig = archetype->GetSignature();
+	for (T_CompTypeIdx const compType : removedTypes)
+	{
+		sig.Remove(compType);
+	}
+
+	Archetype* const nextA = FindOrCreateArchetype(sig);
+
+	if (removedTypes.size() == 1u)
+	{
+		archetype->SetRemoveEdge(removedTypes[0u], nextA);
+		nextA->SetAddEdge(removedTypes[0u], archetype);
+	}
+
+	return nextA;
+}
+
+//-------------------------------
+// EcsController::RelocateEntity
+//
+// Move an entity to another archetype, taking its existing components with it and adding new ones
+//  - trivially relocatable components are memcopied rather than copy constructed and destroyed
+//
+void EcsController::RelocateEntity(T_EntityId const entId, EntityData& ent, Archetype* const nextA, std::vector<RawComponentPtr> const& addedComponents)
+{
+	ET_ASSERT(nextA != ent.archetype);
+
+	size_t const nextIdx = nextA->RelocateEntity(entId, *ent.archetype, ent.index, addedComponents, ent.layer, &m_MovedIndices);
+	nextA->MarkEntityChanged(nextIdx, m_ChangeVersion);
+	UpdateMovedEntities(nextA);
+
+	ent.archetype->RemoveRelocatedEntity(ent.index, *nextA, &m_MovedIndices);
+	UpdateMovedEntities(ent.archetype);
 
 	// reassign the current entity
 	ent.archetype = nextA;
@@ -592,11 +783,27 @@ void EcsController::MoveArchetype(T_EntityId const entId, EntityData& ent, T_Com
 //
 void EcsController::RemoveEntityFromArchetype(EntityData& ent)
 {
-	T_EntityId const changedEnt = ent.archetype->RemoveEntity(ent.index);
-	if (changedEnt != INVALID_ENTITY_ID) // since the archetype will swap, we need to reassign the index of the entity that was swapped in
+	ent.archetype->RemoveEntity(ent.index, &m_MovedIndices);
+	UpdateMovedEntities(ent.archetype);
+}
+
+//------------------------------------
+// EcsController::UpdateMovedEntities
+//
+// Since archetypes shift entities around to keep their layers sorted, we need to reassign the indices of the entities that moved
+//
+void EcsController::UpdateMovedEntities(Archetype* const archetype)
+{
+	for (size_t const idx : m_MovedIndices)
 	{
-		m_Entities[changedEnt].index = ent.index;
+		if (idx < archetype->GetSize()) // entities can be moved to slots that are removed afterwards
+		{
+			m_Entities[archetype->GetEntity(idx)].index = idx;
+			archetype->MarkEntityChanged(idx, m_ChangeVersion);
+		}
 	}
+
+	m_MovedIndices.clear();
 }
 
 //--------------------------------------
@@ -604,7 +811,7 @@ void EcsController::RemoveEntityFromArchetype(EntityData& ent)
 //
 T_CompTypeList EcsController::GetComponentsAndTypes(EntityData& ent, std::vector<RawComponentPtr>& components)
 {
-	T_CompTypeList compTypes = ent.archetype->GetSignature().GetTypes();
+	T_CompTypeList compTypes = ent.archetype->GetTypes();
 	for (T_CompTypeIdx const type : compTypes)
 	{
 		components.emplace_back(type, ent.archetype->GetPool(type).At(ent.index));
@@ -640,6 +847,22 @@ void EcsController::RemoveEntityFromParent(T_EntityId const entity, T_EntityId c
 	}
 }
 
+//----------------------------------
+// EcsController::FindComponentData
+//
+// Same as GetComponentData, but returns nullptr if the entity or its component doesn't exist (anymore)
+//
+void* EcsController::FindComponentData(T_EntityId const entity, T_CompTypeIdx const compType)
+{
+	EntityData const* const ent = m_Entities.at(entity);
+	if ((ent == nullptr) || (ent->archetype == nullptr) || !ent->archetype->HasComponent(compType))
+	{
+		return nullptr;
+	}
+
+	return GetComponentData(entity, compType);
+}
+
 //---------------------------------------
 // EcsController::RegisterSystemInternal
 //
@@ -648,6 +871,27 @@ void EcsController::RegisterSystemInternal(SystemBase* const sys)
 	// create registered system
 	RegisteredSystem* const registered = new RegisteredSystem(sys);
 
+#if ET_CT_IS_ENABLED(ET_CT_ASSERT)
+	// change filters can only check component types the system matches, or reads from the parent
+	for (T_CompTypeIdx const compType : sys->GetChangeFilter())
+	{
+		ET_ASSERT(registered->signature.Has(compType));
+	}
+
+	auto const isAccessed = [registered](T_CompTypeIdx const compType)
+		{
+			return std::find_if(registered->access.cbegin(), registered->access.cend(), [compType](ComponentAccess const& compAccess)
+				{
+					return (compAccess.typeIdx == compType);
+				}) != registered->access.cend();
+		};
+
+	for (T_CompTypeIdx const compType : sys->GetParentChangeFilter())
+	{
+		ET_ASSERT(isAccessed(compType));
+	}
+#endif
+
 	// add to dependencies
 	for (RegisteredSystem* const other : m_Systems)
 	{
@@ -663,20 +907,11 @@ void EcsController::RegisterSystemInternal(SystemBase* const sys)
 	}
 
 	// add existing archetypes
-	for (uint8 layer = 0u; layer < static_cast<uint8>(m_HierachyLevels.size()); ++layer)
+	for (std::pair<T_Hash const, Archetype*>& arch : m_Archetypes)
 	{
-		for (std::pair<T_Hash const, Archetype*>& arch : m_HierachyLevels[layer].archetypes)
+		if (arch.second->GetSignature().Contains(registered->signature))
 		{
-			// go layer wise to ensure correct hierachy dependency resolution
-			if (arch.second->GetSignature().Contains(registered->signature))
-			{
-				while (registered->matchingArchetypes.size() <= static_cast<size_t>(layer)) // ensure we have enough layers
-				{
-					registered->matchingArchetypes.push_back(RegisteredSystem::ArchetypeLayer());
-				}
-
-				registered->matchingArchetypes[layer].archetypes.push_back(arch.second);
-			}
+			registered->matchingArchetypes.push_back(arch.second);
 		}
 	}
 
@@ -754,6 +989,8 @@ void EcsController::RecalculateSystemSchedule()
 	{
 		TopologicalSort(sys);
 	}
+
+	CalculateSystemStages();
 }
 
 //------------------------------------------
@@ -778,6 +1015,269 @@ void EcsController::TopologicalSort(RegisteredSystem* const sys)
 	}
 }
 
+//--------------------------------------
+// EcsController::CalculateSystemStages
+//
+// Turn the schedule into a job graph - a system is placed in the stage after the latest system it depends on or conflicts with
+//  - conflicting systems keep the order of the serial schedule, so parallel processing produces the same results
+//
+void EcsController::CalculateSystemStages()
+{
+	m_Stages.clear();
+
+	for (size_t schedIdx = 0u; schedIdx < m_Schedule.size(); ++schedIdx)
+	{
+		RegisteredSystem* const sys = m_Schedule[schedIdx];
+		sys->stage = 0u;
+
+		// as the schedule is topologically sorted, all dependencies have been assigned a stage already
+		for (RegisteredSystem const* const dep : sys->dependencies)
+		{
+			sys->stage = std::max(sys->stage, dep->stage + 1u);
+		}
+
+		for (size_t prevIdx = 0u; prevIdx < schedIdx; ++prevIdx)
+		{
+			RegisteredSystem const* const prev = m_Schedule[prevIdx];
+			if (sys->ConflictsWith(*prev))
+			{
+				sys->stage = std::max(sys->stage, prev->stage + 1u);
+			}
+		}
+
+		while (m_Stages.size() <= sys->stage)
+		{
+			m_Stages.push_back(SystemStage());
+		}
+
+		m_Stages[sys->stage].systems.emplace_back(sys);
+	}
+}
+
+//------------------------------
+// EcsController::ProcessSystem
+//
+// Run a system over all archetypes it matches - doesn't merge the command buffer
+//  - with a worker pool, parallel chunk systems split the archetypes into ranges of at most chunkSize entities that are processed as jobs
+//  - layers are processed one after another so that parents are always done before their children
+//  - each range records into its own command buffer, which are merged by range index for deterministic results
+//
+void EcsController::ProcessSystem(RegisteredSystem* const sys)
+{
+	sys->system->SetCommandController(this);
+
+	size_t const chunkSize = sys->system->GetChunkSize();
+	bool const isChunked = ((m_WorkerPool != nullptr) && (chunkSize > 0u));
+	size_t const maxCount = isChunked ? chunkSize : std::numeric_limits<size_t>::max();
+
+	size_t layerCount = 0u;
+	for (Archetype const* const arch : sys->matchingArchetypes)
+	{
+		layerCount = std::max(layerCount, arch->GetLayerCount());
+	}
+
+	std::vector<ProcessRange> ranges;
+	size_t rangeIdx = 0u;
+	for (size_t layer = 0u; layer < layerCount; ++layer)
+	{
+		// gather per layer, so that change filters see what the system wrote to the parent layer
+		ranges.clear();
+		bool const checkParents = HaveParentFilterTypesChanged(*sys);
+		for (Archetype* const arch : sys->matchingArchetypes)
+		{
+			GatherProcessRanges(*sys, *arch, arch->GetLayerBegin(layer), arch->GetLayerEnd(layer), maxCount, checkParents, ranges);
+		}
+
+		if (!isChunked)
+		{
+			for (ProcessRange const& range : ranges)
+			{
+				sys->system->RootProcess(this, range.archetype, range.offset, range.count);
+			}
+
+			continue;
+		}
+
+		sys->system->PrepareChunkCommandBuffers(rangeIdx + ranges.size());
+
+		core::WorkerPool::JobGroup layerJobs;
+		for (ProcessRange const& range : ranges)
+		{
+			m_WorkerPool->Push([this, sys, range, rangeIdx]()
+				{
+					sys->system->ProcessChunk(this, range.archetype, range.offset, range.count, rangeIdx);
+				}, layerJobs);
+
+			++rangeIdx;
+		}
+
+		m_WorkerPool->Wait(layerJobs);
+	}
+}
+
+//------------------------------------
+// EcsController::GatherProcessRanges
+//
+// Add the ranges within [begin, end) of an archetype a system needs to process, of at most maxCount entities each
+//  - storage chunks that don't pass the systems change filter are skipped
+//  - chunks that will be processed are marked as changed for all types the system writes to
+//  - a chunk shared by two hierachy layers is filtered by its versions as a whole, so it may be processed conservatively
+//
+void EcsController::GatherProcessRanges(RegisteredSystem const& sys, 
+	Archetype& arch, 
+	size_t const begin, 
+	size_t const end, 
+	size_t const maxCount, 
+	bool const checkParents,
+	std::vector<ProcessRange>& ranges)
+{
+	if (begin >= end)
+	{
+		return;
+	}
+
+	// archetypes without component data have no chunks and can't be filtered
+	bool const hasChunks = (arch.GetChunkCount() > 0u);
+	size_t const chunkCapacity = hasChunks ? arch.GetChunkCapacity() : end;
+	bool const isFiltered = hasChunks && !(sys.system->GetChangeFilter().empty() && sys.system->GetParentChangeFilter().empty());
+
+	size_t rangeBegin = begin;
+	size_t rangeEnd = begin;
+	auto const addRanges = [&arch, maxCount, &ranges, &rangeBegin, &rangeEnd]()
+		{
+			while (rangeBegin < rangeEnd)
+			{
+				size_t const count = std::min(maxCount, rangeEnd - rangeBegin);
+				ranges.push_back(ProcessRange{ &arch, rangeBegin, count });
+				rangeBegin += count;
+			}
+		};
+
+	for (size_t chunkIdx = begin / chunkCapacity; chunkIdx * chunkCapacity < end; ++chunkIdx)
+	{
+		size_t const chunkBegin = std::max(chunkIdx * chunkCapacity, begin);
+		size_t const chunkEnd = std::min((chunkIdx + 1u) * chunkCapacity, end);
+
+		if (isFiltered && !PassesChangeFilter(sys, arch, chunkIdx, chunkBegin, chunkEnd, checkParents))
+		{
+			addRanges();
+			rangeBegin = chunkEnd;
+			rangeEnd = chunkEnd;
+			continue;
+		}
+
+		if (hasChunks)
+		{
+			for (ComponentAccess const& compAccess : sys.access)
+			{
+				if (compAccess.access == E_ComponentAccess::ReadWrite)
+				{
+					arch.MarkChunkChanged(compAccess.typeIdx, chunkIdx, sys.system->GetChangeVersion());
+				}
+			}
+		}
+
+		rangeEnd = chunkEnd; // contiguous chunks are merged into the same range
+	}
+
+	addRanges();
+}
+
+//-----------------------------------
+// EcsController::PassesChangeFilter
+//
+// Whether a storage chunk was written to since the system last ran, or the parent of one of its entities was (for the parent filter)
+//  - parents are only looked up if checkParents is set, which it isn't if no chunk with a filtered type changed at all
+//  - siblings tend to be stored next to each other, so each parent chunk is only tested once in a row
+//
+bool EcsController::PassesChangeFilter(RegisteredSystem const& sys, 
+	Archetype const& arch, 
+	size_t const chunkIdx, 
+	size_t const begin, 
+	size_t const end,
+	bool const checkParents) const
+{
+	T_ChangeVersion const lastVersion = sys.system->GetLastChangeVersion();
+
+	for (T_CompTypeIdx const compType : sys.system->GetChangeFilter())
+	{
+		if (arch.GetChunkVersion(compType, chunkIdx) > lastVersion)
+		{
+			return true;
+		}
+	}
+
+	if (!checkParents)
+	{
+		return false;
+	}
+
+	T_CompTypeList const& parentFilter = sys.system->GetParentChangeFilter();
+
+	Archetype const* lastArch = nullptr;
+	size_t lastChunk = 0u;
+	for (size_t idx = begin; idx < end; ++idx)
+	{
+		EntityData const& ent = m_Entities[arch.GetEntity(idx)];
+		if (ent.parent == INVALID_ENTITY_ID)
+		{
+			continue;
+		}
+
+		EntityData const& parent = m_Entities[ent.parent];
+		if (parent.archetype->GetChunkCount() == 0u)
+		{
+			continue; // no components to filter by
+		}
+
+		size_t const parentChunk = parent.index / parent.archetype->GetChunkCapacity();
+		if ((parent.archetype == lastArch) && (parentChunk == lastChunk))
+		{
+			continue;
+		}
+
+		lastArch = parent.archetype;
+		lastChunk = parentChunk;
+
+		for (T_CompTypeIdx const compType : parentFilter)
+		{
+			if (parent.archetype->HasComponent(compType) && (parent.archetype->GetChunkVersion(compType, parentChunk) > lastVersion))
+			{
+				return true;
+			}
+		}
+	}
+
+	return false;
+}
+
+//---------------------------------------------
+// EcsController::HaveParentFilterTypesChanged
+//
+// Whether any chunk with a type in the systems parent filter was written to since it last ran, if not no parents need to be looked up
+//
+bool EcsController::HaveParentFilterTypesChanged(RegisteredSystem const& sys) const
+{
+	T_CompTypeList const& parentFilter = sys.system->GetParentChangeFilter();
+	if (parentFilter.empty())
+	{
+		return false;
+	}
+
+	T_ChangeVersion const lastVersion = sys.system->GetLastChangeVersion();
+	for (auto const& archEl : m_Archetypes)
+	{
+		for (T_CompTypeIdx const compType : parentFilter)
+		{
+			if (archEl.second->HasComponent(compType) && (archEl.second->GetVersion(compType) > lastVersion))
+			{
+				return true;
+			}
+		}
+	}
+
+	return false;
+}
 
 } // namespace fw
 } // namespace et
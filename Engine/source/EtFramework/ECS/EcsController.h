@@ -6,6 +6,8 @@
 #include "System.h"
 #include "Archetype.h"
 
+#include <EtCore/Concurrency/WorkerPool.h>
+
 
 namespace et {
 namespace fw {
@@ -30,31 +32,41 @@ class EcsController final
 		size_t index = 0u;
 	};
 
-	struct ArchetypeContainer final
-	{
-		std::unordered_map<T_Hash, Archetype*> archetypes;
-	};
-
 	struct RegisteredSystem final
 	{
-		struct ArchetypeLayer
-		{
-			std::vector<Archetype*> archetypes;
-		};
+		RegisteredSystem(SystemBase* const sys) : system(sys), signature(sys->GetSignature()), access(sys->GetAccess()) {} 
 
-		RegisteredSystem(SystemBase* const sys) : system(sys), signature(sys->GetSignature()) {} 
+		bool ConflictsWith(RegisteredSystem const& other) const;
 
 		// system
 		SystemBase* system;
 		ComponentSignature signature;
+		T_CompAccessList access;
 
 		// for topological sort
 		std::vector<RegisteredSystem*> dependencies;
 		bool visited = false;
 		bool scheduled = false;
 
-		// component combinations to iterate
-		std::vector<ArchetypeLayer> matchingArchetypes;
+		// for parallel execution
+		size_t stage = 0u;
+
+		// component combinations to iterate, layer by layer
+		std::vector<Archetype*> matchingArchetypes;
+	};
+
+	// systems that don't depend on or conflict with each other, so they can be processed at the same time
+	struct SystemStage final
+	{
+		std::vector<RegisteredSystem*> systems;
+	};
+
+	// part of an archetype a system processes in one go
+	struct ProcessRange final
+	{
+		Archetype* archetype;
+		size_t offset;
+		size_t count;
 	};
 
 	// construct destruct
@@ -77,6 +89,12 @@ public:
 	template<typename TComponentType, typename... Args>
 	T_EntityId AddEntityChild(T_EntityId const parent, TComponentType& component1, Args... args);
 
+	// many entities with copies of the same components, which is a lot faster than adding them one by one
+	std::vector<T_EntityId> SpawnEntitiesBatched(T_EntityId const parent, size_t const count, std::vector<RawComponentPtr> const& components);
+
+	template<typename TComponentType, typename... Args>
+	std::vector<T_EntityId> SpawnEntities(size_t const count, TComponentType& component1, Args... args);
+
 	T_EntityId DuplicateEntityAddComponents(T_EntityId const dupe, std::vector<RawComponentPtr> const& components);
 
 	template<typename TComponentType, typename... Args>
@@ -111,6 +129,7 @@ public:
 
 	// systems
 	void Process(); 
+	void SetWorkerPool(core::WorkerPool* const pool) { m_WorkerPool = pool; } // process non conflicting systems in parallel, nullptr for serial processing
 
 	template<typename TSystemType, typename... Args>
 	void RegisterSystem(Args... args);
@@ -129,6 +148,7 @@ public:
 	bool HasParent(T_EntityId const entity) const;
 	T_EntityId GetParent(T_EntityId const entity) const;
 	std::vector<T_EntityId> const& GetChildren(T_EntityId const entity) const;
+	Archetype const* GetArchetype(T_EntityId const entity) const { return m_Entities[entity].archetype; }
 
 	// components
 	T_CompTypeList const& GetComponentTypes(T_EntityId const entity) const;
@@ -149,34 +169,64 @@ public:
 	template<typename TSystemType>
 	bool IsSystemRegistered() const;
 
+	core::WorkerPool* GetWorkerPool() const { return m_WorkerPool; }
+
 	// utility
 	//---------
 private:
-	Archetype* FindOrCreateArchetype(ComponentSignature const& sig, uint8 const layer);
-	void MoveArchetype(T_EntityId const entId, EntityData& ent, T_CompTypeList const& compTypes, std::vector<RawComponentPtr> const& components);
+	Archetype* FindOrCreateArchetype(ComponentSignature const& sig);
+	Archetype* GetArchetypeWithAdded(Archetype* const archetype, T_CompTypeList const& addedTypes);
+	Archetype* GetArchetypeWithRemoved(Archetype* const archetype, T_CompTypeList const& removedTypes);
+	void RelocateEntity(T_EntityId const entId, EntityData& ent, Archetype* const nextA, std::vector<RawComponentPtr> const& addedComponents);
 	void RemoveEntityFromArchetype(EntityData& ent);
+	void UpdateMovedEntities(Archetype* const archetype);
 	T_CompTypeList GetComponentsAndTypes(EntityData& ent, std::vector<RawComponentPtr>& components);
 
 	void RemoveEntityFromParent(T_EntityId const entity, T_EntityId const parent);
+	void* FindComponentData(T_EntityId const entity, T_CompTypeIdx const compType);
 
 	void RegisterSystemInternal(SystemBase* const sys);
 	void UnregisterSystemInternal(T_SystemType const sysType);
 
 	void RecalculateSystemSchedule();
 	void TopologicalSort(RegisteredSystem* const sys);
+	void CalculateSystemStages();
+
+	void ProcessSystem(RegisteredSystem* const sys);
+	void GatherProcessRanges(RegisteredSystem const& sys, 
+		Archetype& arch, 
+		size_t const begin, 
+		size_t const end, 
+		size_t const maxCount, 
+		bool const checkParents,
+		std::vector<ProcessRange>& ranges);
+	bool PassesChangeFilter(RegisteredSystem const& sys,
+		Archetype const& arch,
+		size_t const chunkIdx,
+		size_t const begin,
+		size_t const end,
+		bool const checkParents) const;
+	bool HaveParentFilterTypesChanged(RegisteredSystem const& sys) const;
 
 	// Data
 	///////
 
 	core::slot_map<EntityData> m_Entities;
 
-	std::vector<ArchetypeContainer> m_HierachyLevels;
+	ChunkPool m_ChunkPool; // component storage for all archetypes
+	std::unordered_map<T_Hash, Archetype*> m_Archetypes; // one per signature, entities are sorted by hierachy layer within them
+	Archetype::T_IndexList m_MovedIndices; // scratch list for entities that were moved within an archetype
 
 	std::vector<detail::T_ComponentEventDispatcher> m_ComponentEvents;
 	detail::T_EntityEventDispatcher m_EntityEvents;
 
 	std::vector<RegisteredSystem*> m_Systems; // system ownership
 	std::vector<RegisteredSystem*> m_Schedule; // for iteration
+	std::vector<SystemStage> m_Stages; // for parallel iteration
+
+	T_ChangeVersion m_ChangeVersion = 1u; // every system run gets a new version, writes outside of systems use the current one
+
+	core::WorkerPool* m_WorkerPool = nullptr;
 };
 
 
@@ -73,6 +73,18 @@ T_EntityId EcsController::AddEntityChild(T_EntityId const parent, TComponentType
 	return detail::AddToEcs(*this, parent, components, component1, args...);
 }
 
+//------------------------------
+// EcsController::SpawnEntities
+//
+template<typename TComponentType, typename... Args>
+std::vector<T_EntityId> EcsController::SpawnEntities(size_t const count, TComponentType& component1, Args... args)
+{
+	std::vector<RawComponentPtr> components;
+	detail::GenCompPtrList(components, component1, args...);
+
+	return SpawnEntitiesBatched(INVALID_ENTITY_ID, count, components);
+}
+
 //--------------------------------
 // EcsController::DuplicateEntity
 //
@@ -114,7 +126,15 @@ T_CompEventId EcsController::RegisterOnComponentAdded(T_CompEventFn<TComponentTy
 		[this, fn](detail::T_EcsEvent const flags, detail::ComponentEventData const* const evnt) -> void
 		{
 			ET_UNUSED(flags);
-			fn(*evnt->controller, *static_cast<TComponentType*>(evnt->component), evnt->entity);
+			for (size_t idx = 0u; idx < evnt->GetCount(); ++idx)
+			{
+				T_EntityId const entity = evnt->GetEntity(idx);
+				void* const component = evnt->IsBatch() ? FindComponentData(entity, evnt->compType) : evnt->component;
+				if (component != nullptr) // an earlier callback may have removed it
+				{
+					fn(*evnt->controller, *static_cast<TComponentType*>(component), entity);
+				}
+			}
 		}));
 }
 
@@ -130,7 +150,15 @@ T_CompEventId EcsController::RegisterOnComponentRemoved(T_CompEventFn<TComponent
 		[this, fn](detail::T_EcsEvent const flags, detail::ComponentEventData const* const evnt) -> void
 		{
 			ET_UNUSED(flags);
-			fn(*evnt->controller, *static_cast<TComponentType*>(evnt->component), evnt->entity);
+			for (size_t idx = 0u; idx < evnt->GetCount(); ++idx)
+			{
+				T_EntityId const entity = evnt->GetEntity(idx);
+				void* const component = evnt->IsBatch() ? FindComponentData(entity, evnt->compType) : evnt->component;
+				if (component != nullptr) // an earlier callback may have removed it
+				{
+					fn(*evnt->controller, *static_cast<TComponentType*>(component), entity);
+				}
+			}
 		}));
 }
 
@@ -218,14 +246,40 @@ template<typename TViewType>
 void EcsController::ProcessViewOneShot(T_OneShotProcess<TViewType> const& processFn)
 {
 	ComponentSignature const signature = SignatureFromView<TViewType>();
-	for (ArchetypeContainer& hierarchyLevel : m_HierachyLevels)
+	T_CompAccessList const access = AccessFromView<TViewType>();
+
+	std::vector<Archetype*> archetypes;
+	size_t layerCount = 0u;
+	for (std::pair<T_Hash const, Archetype*>& arch : m_Archetypes)
+	{
+		if ((arch.second->GetSize() > 0u) && arch.second->GetSignature().Contains(signature))
+		{
+			for (ComponentAccess const& compAccess : access)
+			{
+				if (compAccess.access == E_ComponentAccess::ReadWrite)
+				{
+					for (size_t chunkIdx = 0u; chunkIdx < arch.second->GetChunkCount(); ++chunkIdx)
+					{
+						arch.second->MarkChunkChanged(compAccess.typeIdx, chunkIdx, m_ChangeVersion);
+					}
+				}
+			}
+
+			archetypes.emplace_back(arch.second);
+			layerCount = std::max(layerCount, arch.second->GetLayerCount());
+		}
+	}
+
+	// go layer wise to ensure correct hierachy dependency resolution
+	for (size_t layer = 0u; layer < layerCount; ++layer)
 	{
-		for (std::pair<T_Hash const, Archetype*>& arch : hierarchyLevel.archetypes)
+		for (Archetype* const arch : archetypes)
 		{
-			// go layer wise to ensure correct hierachy dependency resolution
-			if ((arch.second->GetSize() > 0u) && arch.second->GetSignature().Contains(signature))
+			size_t const begin = arch->GetLayerBegin(layer);
+			size_t const end = arch->GetLayerEnd(layer);
+			if (begin < end)
 			{
-				processFn(ComponentRange<TViewType>(this, arch.second, 0u, arch.second->GetSize()));
+				processFn(ComponentRange<TViewType>(this, arch, begin, end - begin));
 			}
 		}
 	}
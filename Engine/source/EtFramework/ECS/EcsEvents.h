@@ -1,4 +1,5 @@
 #pragma once
+#include "ComponentPool.h"
 #include "EntityFwd.h"
 
 #include <EtCore/Util/GenericEventDispatcher.h>
@@ -40,16 +41,30 @@ enum E_EcsEvent : T_EcsEvent
 //---------------------------
 // ComponentEventData
 //
+// Either a single component, or a batch of components of the same type
+//  - batched components are looked up by entity when they are handled, as callbacks may move them by changing the entities structure
+//
 struct ComponentEventData
 {
 public:
 	ComponentEventData(EcsController* const ecsController, void* const comp, T_EntityId const e) 
 		: controller(ecsController), component(comp), entity(e) {}
+	ComponentEventData(EcsController* const ecsController, T_CompTypeIdx const type, T_EntityId const* const ents, size_t const count)
+		: controller(ecsController), compType(type), entities(ents), entityCount(count) {}
 	virtual ~ComponentEventData() = default;
 
+	bool IsBatch() const { return (entities != nullptr); }
+	size_t GetCount() const { return IsBatch() ? entityCount : 1u; }
+	T_EntityId GetEntity(size_t const idx) const { return IsBatch() ? entities[idx] : entity; }
+
 	EcsController* controller = nullptr;
 	void* component = nullptr;
 	T_EntityId entity = INVALID_ENTITY_ID;
+
+	// batches
+	T_CompTypeIdx compType = INVALID_COMP_TYPE_IDX;
+	T_EntityId const* entities = nullptr;
+	size_t entityCount = 0u;
 };
 
 typedef core::GenericEventDispatcher<T_EcsEvent, ComponentEventData> T_ComponentEventDispatcher;
@@ -68,10 +83,20 @@ struct EntityEventData
 public:
 	EntityEventData(EcsController* const ecsController, T_EntityId const e)
 		: controller(ecsController), entity(e) {}
+	EntityEventData(EcsController* const ecsController, T_EntityId const* const ents, size_t const count)
+		: controller(ecsController), entities(ents), entityCount(count) {}
 	virtual ~EntityEventData() = default;
 
+	bool IsBatch() const { return (entities != nullptr); }
+	size_t GetCount() const { return IsBatch() ? entityCount : 1u; }
+	T_EntityId GetEntity(size_t const idx) const { return IsBatch() ? entities[idx] : entity; }
+
 	EcsController* controller = nullptr;
 	T_EntityId entity = INVALID_ENTITY_ID;
+
+	// batches
+	T_EntityId const* entities = nullptr;
+	size_t entityCount = 0u;
 };
 
 typedef core::GenericEventDispatcher<T_EcsEvent, EntityEventData> T_EntityEventDispatcher;
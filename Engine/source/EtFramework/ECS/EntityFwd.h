@@ -9,6 +9,8 @@ namespace fw {
 typedef core::T_SlotId T_EntityId;
 static constexpr T_EntityId INVALID_ENTITY_ID = core::INVALID_SLOT_ID;
 
+typedef uint64 T_ChangeVersion; // increases with every system run, component data written with a higher version than a systems last run changed since then
+
 
 } // namespace fw
 } // namespace et
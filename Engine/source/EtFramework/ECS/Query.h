@@ -0,0 +1,118 @@
+#pragma once
+#include "Archetype.h"
+#include "ComponentView.h"
+
+#include <tuple>
+
+
+namespace et {
+namespace fw {
+
+
+//-------------------
+// Read
+//
+// Read only component array in a query
+//
+template<typename TComponentType>
+struct Read final
+{
+	typedef TComponentType T_Component;
+	typedef TComponentType const* T_Pointer;
+
+	static constexpr E_ComponentAccess GetAccess() { return E_ComponentAccess::Read; }
+};
+
+//-------------------
+// Write
+//
+// Writable component array in a query
+//
+template<typename TComponentType>
+struct Write final
+{
+	typedef TComponentType T_Component;
+	typedef TComponentType* T_Pointer;
+
+	static constexpr E_ComponentAccess GetAccess() { return E_ComponentAccess::ReadWrite; }
+};
+
+
+namespace detail {
+
+	//-----------------------------
+	// QueryAccessType
+	//
+	// Finds the access declaration for a component type in a query, fails to compile if the query doesn't contain it
+	//
+	template<typename TComponentType, typename... TAccessTypes>
+	struct QueryAccessType;
+
+	template<typename TAccessType>
+	struct FoundQueryAccessType
+	{
+		typedef TAccessType T_Type;
+	};
+
+	template<typename TComponentType, typename TAccessType, typename... TAccessTypes>
+	struct QueryAccessType<TComponentType, TAccessType, TAccessTypes...> 
+		: std::conditional<std::is_same<TComponentType, typename TAccessType::T_Component>::value,
+			FoundQueryAccessType<TAccessType>,
+			QueryAccessType<TComponentType, TAccessTypes...>>::type
+	{ };
+
+} // namespace detail
+
+
+//---------------
+// Query
+//
+// Compile time list of the component types a system accesses, as an alternative to a component view:
+//  - Query<Write<TransformComponent>, Read<LightComponent>>
+//  - instead of a view per entity, systems get raw component arrays for each archetype chunk, which the compiler can vectorize
+//  - parent and entity reads are not supported, use a ComponentView for those
+//
+template<typename... TAccessTypes>
+class Query final
+{
+	static_assert(sizeof...(TAccessTypes) > 0u, "queries need to access at least one component type");
+
+	// definitions
+	//-------------
+public:
+
+	//---------------
+	// Query::Chunk
+	//
+	// Contiguous component arrays for a range of entities within a single archetype chunk
+	//
+	class Chunk final
+	{
+	public:
+		Chunk(Archetype& archetype, size_t const offset, size_t const count);
+
+		size_t GetCount() const { return m_Count; }
+		T_EntityId const* GetEntities() const { return m_Entities; }
+
+		// TComponentType* for written types, TComponentType const* for read types
+		template<typename TComponentType>
+		typename detail::QueryAccessType<TComponentType, TAccessTypes...>::T_Type::T_Pointer Get() const;
+
+	private:
+		std::tuple<typename TAccessTypes::T_Pointer...> m_Data;
+		T_EntityId const* m_Entities = nullptr;
+		size_t m_Count = 0u;
+	};
+
+	// static
+	//--------
+	static ComponentSignature GetSignature();
+	static T_CompAccessList GetAccess();
+};
+
+
+} // namespace fw
+} // namespace et
+
+
+#include "Query.inl"
@@ -0,0 +1,64 @@
+#pragma once
+
+
+namespace et {
+namespace fw {
+
+
+//=============
+// Query Chunk
+//=============
+
+
+//---------------------
+// Query::Chunk::c-tor
+//
+// The range must not cross chunk boundaries, as component arrays are only contiguous within a chunk
+//
+template<typename... TAccessTypes>
+Query<TAccessTypes...>::Chunk::Chunk(Archetype& archetype, size_t const offset, size_t const count)
+	: m_Data(static_cast<typename TAccessTypes::T_Pointer>(archetype.GetPool(TAccessTypes::T_Component::GetTypeIndex()).At(offset))...)
+	, m_Entities(archetype.GetEntities().data() + offset)
+	, m_Count(count)
+{
+	ET_ASSERT(offset + count <= archetype.GetSize());
+	ET_ASSERT((offset / archetype.GetChunkCapacity()) == ((offset + count - 1u) / archetype.GetChunkCapacity()));
+}
+
+//-------------------
+// Query::Chunk::Get
+//
+template<typename... TAccessTypes>
+template<typename TComponentType>
+typename detail::QueryAccessType<TComponentType, TAccessTypes...>::T_Type::T_Pointer Query<TAccessTypes...>::Chunk::Get() const
+{
+	return std::get<typename detail::QueryAccessType<TComponentType, TAccessTypes...>::T_Type::T_Pointer>(m_Data);
+}
+
+
+//=======
+// Query
+//=======
+
+
+//---------------------
+// Query::GetSignature
+//
+template<typename... TAccessTypes>
+ComponentSignature Query<TAccessTypes...>::GetSignature()
+{
+	return ComponentSignature(GenCompTypeList<typename TAccessTypes::T_Component...>());
+}
+
+//------------------
+// Query::GetAccess
+//
+template<typename... TAccessTypes>
+T_CompAccessList Query<TAccessTypes...>::GetAccess()
+{
+	return T_CompAccessList({ ComponentAccess(TAccessTypes::T_Component::GetTypeIndex(), TAccessTypes::GetAccess())... });
+}
+
+
+} // namespace fw
+} // namespace et
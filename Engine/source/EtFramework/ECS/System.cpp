@@ -0,0 +1,125 @@
+#include "stdafx.h"
+#include "System.h"
+
+
+namespace et {
+namespace fw {
+
+
+//=============
+// System Base
+//=============
+
+
+// static
+thread_local SystemBase const* SystemBase::s_ChunkSystem = nullptr;
+thread_local EcsCommandBuffer* SystemBase::s_ChunkCommandBuffer = nullptr;
+
+
+//-------------------
+// SystemBase::d-tor
+//
+SystemBase::~SystemBase()
+{
+	for (EcsCommandBuffer* const buffer : m_ChunkCommandBuffers)
+	{
+		delete buffer;
+	}
+}
+
+//----------------------------------
+// SystemBase::SetCommandController
+//
+void SystemBase::SetCommandController(EcsController* const ecs)
+{
+	m_CommandBuffer.SetController(ecs);
+
+	for (EcsCommandBuffer* const buffer : m_ChunkCommandBuffers)
+	{
+		buffer->SetController(ecs);
+	}
+}
+
+//---------------------------
+// SystemBase::MergeCommands
+//
+// Chunk buffers are merged by chunk index, so the result doesn't depend on which worker finished first
+//
+void SystemBase::MergeCommands()
+{
+	m_CommandBuffer.Merge();
+
+	for (EcsCommandBuffer* const buffer : m_ChunkCommandBuffers)
+	{
+		buffer->Merge();
+	}
+}
+
+//----------------------
+// SystemBase::BeginRun
+//
+// Called by the controller before the system processes, the previous version tells us which data changed since
+//
+void SystemBase::BeginRun(T_ChangeVersion const version)
+{
+	ET_ASSERT(version > m_ChangeVersion);
+
+	m_LastChangeVersion = m_ChangeVersion;
+	m_ChangeVersion = version;
+}
+
+//----------------------------------------
+// SystemBase::PrepareChunkCommandBuffers
+//
+// Ensure there is a command buffer for every chunk before chunks get dispatched
+//
+void SystemBase::PrepareChunkCommandBuffers(size_t const chunkCount)
+{
+	while (m_ChunkCommandBuffers.size() < chunkCount)
+	{
+		m_ChunkCommandBuffers.push_back(new EcsCommandBuffer());
+		m_ChunkCommandBuffers.back()->SetController(m_CommandBuffer.m_Controller);
+	}
+}
+
+//--------------------------
+// SystemBase::ProcessChunk
+//
+// Process a range of an archetype while directing commands into the buffer of that chunk
+//
+void SystemBase::ProcessChunk(EcsController* const controller, 
+	Archetype* const archetype, 
+	size_t const offset, 
+	size_t const count, 
+	size_t const chunkIdx)
+{
+	ET_ASSERT(chunkIdx < m_ChunkCommandBuffers.size());
+
+	// the thread may be executing a chunk of another system while it waits for jobs, so restore the previous buffer after
+	SystemBase const* const prevSystem = s_ChunkSystem;
+	EcsCommandBuffer* const prevBuffer = s_ChunkCommandBuffer;
+	s_ChunkSystem = this;
+	s_ChunkCommandBuffer = m_ChunkCommandBuffers[chunkIdx];
+
+	RootProcess(controller, archetype, offset, count);
+
+	s_ChunkSystem = prevSystem;
+	s_ChunkCommandBuffer = prevBuffer;
+}
+
+//------------------------------
+// SystemBase::GetCommandBuffer
+//
+EcsCommandBuffer& SystemBase::GetCommandBuffer()
+{
+	if (s_ChunkSystem == this)
+	{
+		return *s_ChunkCommandBuffer;
+	}
+
+	return m_CommandBuffer;
+}
+
+
+} // namespace fw
+} // namespace et
@@ -1,7 +1,9 @@
 #pragma once
 #include "ComponentRegistry.h"
 #include "ComponentRange.h"
+#include "ComponentView.h"
 #include "EcsCommandBuffer.h"
+#include "Query.h"
 
 #include <rttr/type.h>
 
@@ -26,31 +28,52 @@ typedef std::vector<rttr::type::type_id> T_DependencyList;
 //
 class SystemBase
 {
+	// definitions
+	//-------------
+public:
+	static constexpr size_t s_DefaultChunkSize = 1024u;
+
 	// construct destruct
 	//--------------------
-public:
 	SystemBase() = default;
-	virtual ~SystemBase() = default;
+	virtual ~SystemBase();
 
 	// interface
 	//-----------
 	virtual T_SystemType GetTypeId() const = 0;
 	virtual ComponentSignature GetSignature() const = 0;
+	virtual T_CompAccessList GetAccess() const = 0;
 
 	// the important one
 	virtual void RootProcess(EcsController* const controller, Archetype* const archetype, size_t const offset, size_t const count) = 0; 
 
 	// functionality
 	//---------------
-	void SetCommandController(EcsController* const ecs) { m_CommandBuffer.SetController(ecs); }
-	void MergeCommands() { m_CommandBuffer.Merge(); }
+	void SetCommandController(EcsController* const ecs);
+	void MergeCommands();
+
+	void BeginRun(T_ChangeVersion const version);
+
+	void PrepareChunkCommandBuffers(size_t const chunkCount);
+	void ProcessChunk(EcsController* const controller, Archetype* const archetype, size_t const offset, size_t const count, size_t const chunkIdx);
 
 	// accessors
 	//-----------
 	T_DependencyList const& GetDependencies() const { return m_Dependencies; }
 	T_DependencyList const& GetDependents() const { return m_Dependents; }
+	bool IsExclusive() const { return m_IsExclusive; }
+	T_DependencyList const& GetResourceReads() const { return m_ResourceReads; }
+	T_DependencyList const& GetResourceWrites() const { return m_ResourceWrites; }
+	size_t GetChunkSize() const { return m_ChunkSize; }
 
-	EcsCommandBuffer& GetCommandBuffer() { return m_CommandBuffer; }
+	T_CompTypeList const& GetChangeFilter() const { return m_ChangeFilter; }
+	T_CompTypeList const& GetParentChangeFilter() const { return m_ParentChangeFilter; }
+
+	// component data written to with a version higher than the last one changed since this system last ran
+	T_ChangeVersion GetChangeVersion() const { return m_ChangeVersion; }
+	T_ChangeVersion GetLastChangeVersion() const { return m_LastChangeVersion; }
+
+	EcsCommandBuffer& GetCommandBuffer(); // while processing a chunk this returns the chunks buffer
 
 	// utility - use these in system constructor
 	//-------------------------------------------
@@ -60,14 +83,47 @@ protected:
 	template<typename... Args>
 	void DeclareDependents();
 
+	// the system touches state outside of its view (for instance creating entities immediately), so it can't run alongside other systems
+	void DeclareExclusive() { m_IsExclusive = true; }
+
+	// shared state outside of the ECS, identified by type - a system writing to a resource doesn't run alongside others that access it
+	template<typename... Args>
+	void DeclareResourceRead();
+	template<typename... Args>
+	void DeclareResourceWrite();
+
+	// large archetypes are split into ranges that are processed on worker threads, Process needs to be safe to call concurrently
+	void DeclareParallelChunks(size_t const chunkSize = s_DefaultChunkSize) { m_ChunkSize = chunkSize; }
+
+	// skip chunks in which none of the listed components were written to since the last run - the types need to be part of the view
+	template<typename... Args>
+	void DeclareChangeFilter();
+	// also process chunks in which the parent of any entity had one of the listed components written to
+	template<typename... Args>
+	void DeclareParentChangeFilter();
+
 	// Data
 	///////
 
 	EcsCommandBuffer m_CommandBuffer;
 
 private:
+	static thread_local SystemBase const* s_ChunkSystem;
+	static thread_local EcsCommandBuffer* s_ChunkCommandBuffer;
+
+	std::vector<EcsCommandBuffer*> m_ChunkCommandBuffers; // merged in chunk order after the main buffer
+	size_t m_ChunkSize = 0u; // 0 -> no chunking
+
 	T_DependencyList m_Dependencies;
 	T_DependencyList m_Dependents;
+	bool m_IsExclusive = false;
+	T_DependencyList m_ResourceReads;
+	T_DependencyList m_ResourceWrites;
+
+	T_CompTypeList m_ChangeFilter;
+	T_CompTypeList m_ParentChangeFilter;
+	T_ChangeVersion m_ChangeVersion = 0u;
+	T_ChangeVersion m_LastChangeVersion = 0u;
 };
 
 
@@ -90,6 +146,7 @@ public:
 	//--------------------------------------
 	T_SystemType GetTypeId() const override;
 	ComponentSignature GetSignature() const override;
+	T_CompAccessList GetAccess() const override;
 
 	void RootProcess(EcsController* const controller, Archetype* const archetype, size_t const offset, size_t const count) override;
 
@@ -99,6 +156,36 @@ public:
 };
 
 
+//---------------
+// System
+//
+// Systems iterating a Query get raw component arrays for every archetype chunk instead of a view per entity:
+//  class MySystem : public System<MySystem, Query<Write<A>, Read<B>>>
+//  - the derived class implements void Process(T_Query::Chunk const& chunk), which is called through CRTP rather than virtual dispatch
+//
+template <class TSystemType, typename... TAccessTypes>
+class System<TSystemType, Query<TAccessTypes...>> : public SystemBase
+{
+	// definitions
+	//-------------
+public:
+	typedef Query<TAccessTypes...> T_Query;
+
+	// construct destruct
+	//--------------------
+	System() : SystemBase() {}
+	virtual ~System() = default;
+
+	// System Base interface implementation
+	//--------------------------------------
+	T_SystemType GetTypeId() const override;
+	ComponentSignature GetSignature() const override;
+	T_CompAccessList GetAccess() const override;
+
+	void RootProcess(EcsController* const controller, Archetype* const archetype, size_t const offset, size_t const count) override;
+};
+
+
 // for running a "system" once
 template <typename TViewType>
 using T_OneShotProcess = std::function<void(ComponentRange<TViewType>&)>;
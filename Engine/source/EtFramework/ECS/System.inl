@@ -15,7 +15,7 @@ namespace detail {
 	//-----------------------------
 	// SystemTypeListAdder
 	//
-	// implements a recursive variadic template which adds the type IDs of systems in the template parameters
+	// implements a recursive variadic template which adds the type IDs of systems (or resources) in the template parameters
 	//
 	template <typename... Args>
 	struct SystemTypeListAdder;
@@ -63,6 +63,48 @@ void SystemBase::DeclareDependents()
 	detail::SystemTypeListAdder<Args...>::Call(m_Dependents);
 }
 
+//---------------------------------
+// SystemBase::DeclareResourceRead
+//
+// Lists shared state outside of the ECS that the system reads from
+//
+template<typename... Args>
+void SystemBase::DeclareResourceRead()
+{
+	detail::SystemTypeListAdder<Args...>::Call(m_ResourceReads);
+}
+
+//---------------------------------
+// SystemBase::DeclareResourceWrite
+//
+// Lists shared state outside of the ECS that the system modifies
+//
+template<typename... Args>
+void SystemBase::DeclareResourceWrite()
+{
+	detail::SystemTypeListAdder<Args...>::Call(m_ResourceWrites);
+}
+
+//---------------------------------
+// SystemBase::DeclareChangeFilter
+//
+template<typename... Args>
+void SystemBase::DeclareChangeFilter()
+{
+	T_CompTypeList const types = GenCompTypeList<Args...>();
+	m_ChangeFilter.insert(m_ChangeFilter.end(), types.cbegin(), types.cend());
+}
+
+//---------------------------------------
+// SystemBase::DeclareParentChangeFilter
+//
+template<typename... Args>
+void SystemBase::DeclareParentChangeFilter()
+{
+	T_CompTypeList const types = GenCompTypeList<Args...>();
+	m_ParentChangeFilter.insert(m_ParentChangeFilter.end(), types.cbegin(), types.cend());
+}
+
 
 //========
 // System
@@ -87,6 +129,15 @@ ComponentSignature fw::System<TSystemType, TViewType>::GetSignature() const
 	return SignatureFromView<TViewType>();
 }
 
+//------------------
+// System::GetAccess
+//
+template <class TSystemType, typename TViewType>
+T_CompAccessList fw::System<TSystemType, TViewType>::GetAccess() const
+{
+	return AccessFromView<TViewType>();
+}
+
 //---------------------
 // System::RootProcess
 //
@@ -97,7 +148,66 @@ void System<TSystemType, TViewType>::RootProcess(EcsController* const control, A
 {
 	Process(ComponentRange<TViewType>(control, archetype, offset, count));
 }
-	
+
+
+//==============
+// Query System
+//==============
+
+
+//-------------------
+// System::GetTypeId
+//
+template <class TSystemType, typename... TAccessTypes>
+T_SystemType System<TSystemType, Query<TAccessTypes...>>::GetTypeId() const
+{
+	return rttr::type::get<TSystemType>().get_id();
+}
+
+//---------------------
+// System::GetSignature
+//
+template <class TSystemType, typename... TAccessTypes>
+ComponentSignature System<TSystemType, Query<TAccessTypes...>>::GetSignature() const
+{
+	return T_Query::GetSignature();
+}
+
+//------------------
+// System::GetAccess
+//
+template <class TSystemType, typename... TAccessTypes>
+T_CompAccessList System<TSystemType, Query<TAccessTypes...>>::GetAccess() const
+{
+	return T_Query::GetAccess();
+}
+
+//---------------------
+// System::RootProcess
+//
+// Split the range at chunk boundaries, so that the derived system gets contiguous arrays
+//
+template <class TSystemType, typename... TAccessTypes>
+void System<TSystemType, Query<TAccessTypes...>>::RootProcess(EcsController* const controller, 
+	Archetype* const archetype, 
+	size_t const offset, 
+	size_t const count)
+{
+	ET_UNUSED(controller);
+
+	size_t const chunkCapacity = archetype->GetChunkCapacity();
+	size_t const end = offset + count;
+	for (size_t chunkBegin = offset; chunkBegin < end;)
+	{
+		size_t const chunkEnd = std::min(end, ((chunkBegin / chunkCapacity) + 1u) * chunkCapacity);
+
+		typename T_Query::Chunk const chunk(*archetype, chunkBegin, chunkEnd - chunkBegin);
+		static_cast<TSystemType*>(this)->Process(chunk);
+
+		chunkBegin = chunkEnd;
+	}
+}
+
 
 } // namespace fw
 } // namespace et
@@ -57,6 +57,9 @@ void UnifiedScene::Init()
 		m_RenderScene.AddExtension(UniquePtr<render::I_SceneExtension>::StaticCast(std::move(guiExt)));
 	}
 
+	// systems without conflicting component access are processed in parallel
+	m_Scene.SetWorkerPool(&m_WorkerPool);
+
 	// component init / deinint
 	m_Scene.RegisterOnComponentAdded(T_CompEventFn<TransformComponent>(TransformSystem::OnComponentAdded));
 	m_Scene.RegisterOnComponentRemoved(T_CompEventFn<TransformComponent>(TransformSystem::OnComponentRemoved));
@@ -90,7 +93,6 @@ void UnifiedScene::Init()
 	m_Scene.RegisterSystem<TransformSystem::Compute>();
 	m_Scene.RegisterSystem<AudioSourceSystem::Translate>();
 	m_Scene.RegisterSystem<CameraSyncSystem>();
-	m_Scene.RegisterSystem<TransformSystem::Reset>();
 	m_Scene.RegisterSystem<AudioSourceSystem::State>();
 	m_Scene.RegisterSystem<AudioListenerSystem>();
 	m_Scene.RegisterSystem<PlanetCameraLinkSystem>();
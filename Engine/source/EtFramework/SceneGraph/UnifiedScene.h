@@ -2,6 +2,7 @@
 #include "SceneEvents.h"
 #include "SceneDescriptor.h"
 
+#include <EtCore/Concurrency/WorkerPool.h>
 #include <EtCore/UpdateCycle/Context.h>
 #include <EtCore/UpdateCycle/Tickable.h>
 
@@ -63,6 +64,7 @@ public:
 	bool IsSceneLoaded() const { return m_IsSceneLoaded; }
 	core::HashString GetSceneId() const { return m_CurrentScene; }
 	EcsController& GetEcs() { return m_Scene; }
+	core::WorkerPool& GetWorkerPool() { return m_WorkerPool; }
 
 	T_EntityId GetActiveCamera() const { return m_ActiveCamera; }
 	T_EntityId GetAudioListener() const { return m_AudioListener; }
@@ -85,6 +87,7 @@ private:
 	core::HashString m_CurrentScene;
 	bool m_IsSceneLoaded = false;
 
+	core::WorkerPool m_WorkerPool;
 	EcsController m_Scene;
 
 	core::BaseContext m_Context;
@@ -26,6 +26,7 @@ namespace fw {
 AudioListenerSystem::AudioListenerSystem()
 {
 	DeclareDependencies<TransformSystem::Compute>(); // update lights after updating transforms, though we don't need to wait for flags to update
+	DeclareResourceWrite<AudioManager>(); // the openAL context and its error state
 }
 
 //------------------------------
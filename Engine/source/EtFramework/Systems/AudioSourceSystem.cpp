@@ -95,10 +95,9 @@ AudioSourceSystem::Translate::Translate()
 {
 	DeclareDependencies<TransformSystem::Compute>(); // the rigid body system may update transformations
 
-	// run before the transform components reset so we only update position data for audio sources that moved
-	DeclareDependents<TransformSystem::Reset>(); 
-
 	DeclareDependents<AudioSourceSystem::State>();
+
+	DeclareResourceWrite<AudioManager>(); // the openAL context and its error state
 }
 
 //---------------------------------------
@@ -136,7 +135,7 @@ void AudioSourceSystem::Translate::Process(ComponentRange<AudioSourceSystem::Tra
 		}
 
 		// 3D source position, rotation, direction
-		if (view.transf->HasTransformChanged())
+		if (view.transf->HasWorldChangedSince(GetLastChangeVersion()))
 		{
 			vec3 const pos = ALvec3(view.transf->GetWorldPosition());
 			alSource3f(view.source->m_Source, AL_POSITION, pos.x, pos.y, pos.z);
@@ -160,6 +159,14 @@ void AudioSourceSystem::Translate::Process(ComponentRange<AudioSourceSystem::Tra
 	}
 }
 
+//----------------------------------
+// AudioSourceSystem::State::c-tor
+//
+AudioSourceSystem::State::State()
+{
+	DeclareResourceWrite<AudioManager>(); // the openAL context and its error state
+}
+
 //------------------------------------
 // AudioSourceSystem::State::Process
 //
@@ -72,7 +72,7 @@ public:
 	class State final : public fw::System<State, StateView>
 	{
 	public:
-		State() = default;
+		State();
 
 		void Process(ComponentRange<StateView>& range) override;
 	};
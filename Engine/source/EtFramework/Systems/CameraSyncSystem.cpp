@@ -22,6 +22,7 @@ namespace fw {
 CameraSyncSystem::CameraSyncSystem()
 {
 	DeclareDependencies<TransformSystem::Compute>(); // update cameras after updating transforms, though we don't need to wait for flags to update
+	DeclareResourceWrite<render::Scene>();
 }
 
 //-----------------------------------
@@ -23,6 +23,7 @@ namespace fw {
 LightSystem::LightSystem()
 {
 	DeclareDependencies<TransformSystem::Compute>(); // update lights after updating transforms, though we don't need to wait for flags to update
+	DeclareResourceWrite<render::Scene>();
 }
 
 //-----------------------------------
@@ -58,22 +59,23 @@ void LightSystem::OnComponentRemoved(EcsController& controller, LightComponent&
 //
 // Extract light colors
 //
-void LightSystem::Process(ComponentRange<LightSystemView>& range) 
+void LightSystem::Process(T_Query::Chunk const& chunk) 
 {
 	render::Scene& renderScene = UnifiedScene::Instance().GetRenderScene();
 
-	for (LightSystemView& view : range)
+	LightComponent* const lights = chunk.Get<LightComponent>();
+	for (size_t idx = 0u; idx < chunk.GetCount(); ++idx)
 	{
-		if (view.light->m_ColorChanged)
+		LightComponent& light = lights[idx];
+		if (light.m_ColorChanged)
 		{
-			vec3 const col = view.light->m_Color * view.light->m_Brightness;
-			renderScene.UpdateLightColor(view.light->m_LightId, col);
+			vec3 const col = light.m_Color * light.m_Brightness;
+			renderScene.UpdateLightColor(light.m_LightId, col);
 
-			view.light->m_ColorChanged = false;
+			light.m_ColorChanged = false;
 		}
 	}
 }
 
-
 } // namespace fw
 } // namespace et
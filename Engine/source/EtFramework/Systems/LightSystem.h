@@ -1,7 +1,6 @@
 #pragma once
 #include <EtFramework/Components/LightComponent.h>
 
-#include <EtFramework/ECS/ComponentView.h>
 #include <EtFramework/ECS/EcsController.h>
 
 
@@ -9,27 +8,12 @@ namespace et {
 namespace fw {
 
 
-//------------------
-// LightSystemView
-//
-// Data required for the transform system to operate
-//
-struct LightSystemView final : public ComponentView
-{
-	LightSystemView() : ComponentView()
-	{
-		Declare(light);
-	}
-
-	WriteAccess<LightComponent> light;
-};
-
 //-------------
 // LightSystem
 //
 // Extracts light colors into the rendering scene representation
 //
-class LightSystem final : public fw::System<LightSystem, LightSystemView>
+class LightSystem final : public fw::System<LightSystem, Query<Write<LightComponent>>>
 {
 public:
 	LightSystem();
@@ -37,7 +21,7 @@ public:
 	static void OnComponentAdded(EcsController& controller, LightComponent& component, T_EntityId const entity);
 	static void OnComponentRemoved(EcsController& controller, LightComponent& component, T_EntityId const entity);
 
-	void Process(ComponentRange<LightSystemView>& range) override;
+	void Process(T_Query::Chunk const& chunk);
 };
 
 
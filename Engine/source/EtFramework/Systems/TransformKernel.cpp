@@ -0,0 +1,299 @@
+#include "stdafx.h"
+#include "TransformKernel.h"
+
+#include <EtMath/Simd.h>
+
+
+namespace et {
+namespace fw {
+
+
+namespace {
+
+	// lane wise operations, so that the kernel is written once for every register width
+	//------------------------------------------------------------------------------------
+
+#if ETM_SIMD_AVX
+
+	typedef __m256 T_Lanes;
+	size_t const s_LaneCount = 8u;
+
+	inline T_Lanes LaneLoad(float const* const data) { return _mm256_load_ps(data); }
+	inline T_Lanes LaneSet(float const value) { return _mm256_set1_ps(value); }
+	inline T_Lanes LaneAdd(T_Lanes const lhs, T_Lanes const rhs) { return _mm256_add_ps(lhs, rhs); }
+	inline T_Lanes LaneSub(T_Lanes const lhs, T_Lanes const rhs) { return _mm256_sub_ps(lhs, rhs); }
+	inline T_Lanes LaneMul(T_Lanes const lhs, T_Lanes const rhs) { return _mm256_mul_ps(lhs, rhs); }
+	inline void LaneStore(float* const data, T_Lanes const lanes) { _mm256_store_ps(data, lanes); }
+
+	//---------------------------------
+	// StoreRow
+	//
+	// Transpose the columns of one row into the matrices of each lane, one 128 bit half at a time
+	//
+	inline void StoreRow(mat4* const out, uint8 const row, T_Lanes const col0, T_Lanes const col1, T_Lanes const col2, T_Lanes const col3)
+	{
+		__m128 lo0 = _mm256_castps256_ps128(col0);
+		__m128 lo1 = _mm256_castps256_ps128(col1);
+		__m128 lo2 = _mm256_castps256_ps128(col2);
+		__m128 lo3 = _mm256_castps256_ps128(col3);
+		_MM_TRANSPOSE4_PS(lo0, lo1, lo2, lo3);
+
+		__m128 hi0 = _mm256_extractf128_ps(col0, 1);
+		__m128 hi1 = _mm256_extractf128_ps(col1, 1);
+		__m128 hi2 = _mm256_extractf128_ps(col2, 1);
+		__m128 hi3 = _mm256_extractf128_ps(col3, 1);
+		_MM_TRANSPOSE4_PS(hi0, hi1, hi2, hi3);
+
+		_mm_storeu_ps(out[0].data[row], lo0);
+		_mm_storeu_ps(out[1].data[row], lo1);
+		_mm_storeu_ps(out[2].data[row], lo2);
+		_mm_storeu_ps(out[3].data[row], lo3);
+		_mm_storeu_ps(out[4].data[row], hi0);
+		_mm_storeu_ps(out[5].data[row], hi1);
+		_mm_storeu_ps(out[6].data[row], hi2);
+		_mm_storeu_ps(out[7].data[row], hi3);
+	}
+
+#elif ETM_SIMD_SSE
+
+	typedef __m128 T_Lanes;
+	size_t const s_LaneCount = 4u;
+
+	inline T_Lanes LaneLoad(float const* const data) { return _mm_load_ps(data); }
+	inline T_Lanes LaneSet(float const value) { return _mm_set1_ps(value); }
+	inline T_Lanes LaneAdd(T_Lanes const lhs, T_Lanes const rhs) { return _mm_add_ps(lhs, rhs); }
+	inline T_Lanes LaneSub(T_Lanes const lhs, T_Lanes const rhs) { return _mm_sub_ps(lhs, rhs); }
+	inline T_Lanes LaneMul(T_Lanes const lhs, T_Lanes const rhs) { return _mm_mul_ps(lhs, rhs); }
+	inline void LaneStore(float* const data, T_Lanes const lanes) { _mm_store_ps(data, lanes); }
+
+	//---------------------------------
+	// StoreRow
+	//
+	// Transpose the columns of one row into the matrices of each lane
+	//
+	inline void StoreRow(mat4* const out, uint8 const row, T_Lanes col0, T_Lanes col1, T_Lanes col2, T_Lanes col3)
+	{
+		_MM_TRANSPOSE4_PS(col0, col1, col2, col3);
+
+		_mm_storeu_ps(out[0].data[row], col0);
+		_mm_storeu_ps(out[1].data[row], col1);
+		_mm_storeu_ps(out[2].data[row], col2);
+		_mm_storeu_ps(out[3].data[row], col3);
+	}
+
+#else
+
+	typedef float T_Lanes;
+	size_t const s_LaneCount = 1u;
+
+	inline T_Lanes LaneLoad(float const* const data) { return *data; }
+	inline T_Lanes LaneSet(float const value) { return value; }
+	inline T_Lanes LaneAdd(T_Lanes const lhs, T_Lanes const rhs) { return lhs + rhs; }
+	inline T_Lanes LaneSub(T_Lanes const lhs, T_Lanes const rhs) { return lhs - rhs; }
+	inline T_Lanes LaneMul(T_Lanes const lhs, T_Lanes const rhs) { return lhs * rhs; }
+	inline void LaneStore(float* const data, T_Lanes const lanes) { *data = lanes; }
+
+	//---------------------------------
+	// StoreRow
+	//
+	inline void StoreRow(mat4* const out, uint8 const row, T_Lanes const col0, T_Lanes const col1, T_Lanes const col2, T_Lanes const col3)
+	{
+		out->data[row][0] = col0;
+		out->data[row][1] = col1;
+		out->data[row][2] = col2;
+		out->data[row][3] = col3;
+	}
+
+#endif
+
+	static_assert(TransformKernel::s_Capacity % s_LaneCount == 0u, "transform kernel capacity must be a multiple of the lane count");
+
+	//---------------------------------
+	// StoreVec3
+	//
+	// Write the vector of each lane to the output array
+	//
+	inline void StoreVec3(vec3* const out, T_Lanes const x, T_Lanes const y, T_Lanes const z)
+	{
+		alignas(32) float xs[s_LaneCount];
+		alignas(32) float ys[s_LaneCount];
+		alignas(32) float zs[s_LaneCount];
+		LaneStore(xs, x);
+		LaneStore(ys, y);
+		LaneStore(zs, z);
+
+		for (size_t lane = 0u; lane < s_LaneCount; ++lane)
+		{
+			out[lane].x = xs[lane];
+			out[lane].y = ys[lane];
+			out[lane].z = zs[lane];
+		}
+	}
+
+} // namespace
+
+
+//=====================
+// Transform Kernel
+//=====================
+
+
+//---------------------------------
+// TransformKernel::Add
+//
+void TransformKernel::Add(vec3 const& position, quat const& rotation, vec3 const& scale)
+{
+	ET_ASSERT(m_Count < s_Capacity);
+
+	m_PosX[m_Count] = position.x;
+	m_PosY[m_Count] = position.y;
+	m_PosZ[m_Count] = position.z;
+
+	m_RotX[m_Count] = rotation.x;
+	m_RotY[m_Count] = rotation.y;
+	m_RotZ[m_Count] = rotation.z;
+	m_RotW[m_Count] = rotation.w;
+
+	m_ScaleX[m_Count] = scale.x;
+	m_ScaleY[m_Count] = scale.y;
+	m_ScaleZ[m_Count] = scale.z;
+
+	++m_Count;
+}
+
+//---------------------------------
+// TransformKernel::SetRotation
+//
+// Allows computing orientations from a different rotation than the one the matrix was built from, such as the world rotation
+//
+void TransformKernel::SetRotation(size_t const idx, quat const& rotation)
+{
+	ET_ASSERT(idx < m_Count);
+
+	m_RotX[idx] = rotation.x;
+	m_RotY[idx] = rotation.y;
+	m_RotZ[idx] = rotation.z;
+	m_RotW[idx] = rotation.w;
+}
+
+//---------------------------------
+// TransformKernel::ComputeMatrices
+//
+// Same result as math::scale(s) * math::rotate(r) * math::translate(p)
+//  - the output array needs space for s_Capacity matrices, as the remaining lanes of the last iteration are written too
+//
+void TransformKernel::ComputeMatrices(mat4* const outMatrices)
+{
+	PadLanes();
+
+	T_Lanes const zero = LaneSet(0.f);
+	T_Lanes const one = LaneSet(1.f);
+	T_Lanes const two = LaneSet(2.f);
+
+	for (size_t idx = 0u; idx < m_Count; idx += s_LaneCount)
+	{
+		T_Lanes const x = LaneLoad(m_RotX + idx);
+		T_Lanes const y = LaneLoad(m_RotY + idx);
+		T_Lanes const z = LaneLoad(m_RotZ + idx);
+		T_Lanes const w = LaneLoad(m_RotW + idx);
+
+		// doubled products shared by the rotation matrix elements
+		T_Lanes const x2 = LaneMul(two, x);
+		T_Lanes const y2 = LaneMul(two, y);
+		T_Lanes const z2 = LaneMul(two, z);
+
+		T_Lanes const xx = LaneMul(x2, x);
+		T_Lanes const yy = LaneMul(y2, y);
+		T_Lanes const zz = LaneMul(z2, z);
+		T_Lanes const xy = LaneMul(x2, y);
+		T_Lanes const xz = LaneMul(x2, z);
+		T_Lanes const yz = LaneMul(y2, z);
+		T_Lanes const wx = LaneMul(x2, w);
+		T_Lanes const wy = LaneMul(y2, w);
+		T_Lanes const wz = LaneMul(z2, w);
+
+		// scaling multiplies the rotation rows, translation is the last row
+		T_Lanes const sx = LaneLoad(m_ScaleX + idx);
+		T_Lanes const sy = LaneLoad(m_ScaleY + idx);
+		T_Lanes const sz = LaneLoad(m_ScaleZ + idx);
+
+		mat4* const out = outMatrices + idx;
+		StoreRow(out, 0u, LaneMul(sx, LaneSub(LaneSub(one, yy), zz)), LaneMul(sx, LaneAdd(xy, wz)), LaneMul(sx, LaneSub(xz, wy)), zero);
+		StoreRow(out, 1u, LaneMul(sy, LaneSub(xy, wz)), LaneMul(sy, LaneSub(LaneSub(one, xx), zz)), LaneMul(sy, LaneAdd(yz, wx)), zero);
+		StoreRow(out, 2u, LaneMul(sz, LaneAdd(xz, wy)), LaneMul(sz, LaneSub(yz, wx)), LaneMul(sz, LaneSub(LaneSub(one, xx), yy)), zero);
+		StoreRow(out, 3u, LaneLoad(m_PosX + idx), LaneLoad(m_PosY + idx), LaneLoad(m_PosZ + idx), one);
+	}
+}
+
+//-------------------------------------
+// TransformKernel::ComputeOrientations
+//
+// Same result as rotating vec3::FORWARD and vec3::RIGHT by each rotation, with up being their cross product
+//  - the output arrays need space for s_Capacity vectors
+//
+void TransformKernel::ComputeOrientations(vec3* const outForward, vec3* const outRight, vec3* const outUp)
+{
+	PadLanes();
+
+	T_Lanes const one = LaneSet(1.f);
+	T_Lanes const two = LaneSet(2.f);
+
+	for (size_t idx = 0u; idx < m_Count; idx += s_LaneCount)
+	{
+		T_Lanes const x = LaneLoad(m_RotX + idx);
+		T_Lanes const y = LaneLoad(m_RotY + idx);
+		T_Lanes const z = LaneLoad(m_RotZ + idx);
+		T_Lanes const w = LaneLoad(m_RotW + idx);
+
+		T_Lanes const x2 = LaneMul(two, x);
+		T_Lanes const y2 = LaneMul(two, y);
+		T_Lanes const z2 = LaneMul(two, z);
+
+		// (2w*w - 1) * v + 2 * (dot(q.v, v) * q.v + w * cross(q.v, v)) with v along the z and x axis
+		T_Lanes const ww = LaneSub(LaneMul(LaneMul(two, w), w), one);
+
+		T_Lanes const fwdX = LaneAdd(LaneMul(x2, z), LaneMul(y2, w));
+		T_Lanes const fwdY = LaneSub(LaneMul(y2, z), LaneMul(x2, w));
+		T_Lanes const fwdZ = LaneAdd(ww, LaneMul(z2, z));
+
+		T_Lanes const rightX = LaneAdd(ww, LaneMul(x2, x));
+		T_Lanes const rightY = LaneAdd(LaneMul(x2, y), LaneMul(z2, w));
+		T_Lanes const rightZ = LaneSub(LaneMul(x2, z), LaneMul(y2, w));
+
+		StoreVec3(outForward + idx, fwdX, fwdY, fwdZ);
+		StoreVec3(outRight + idx, rightX, rightY, rightZ);
+		StoreVec3(outUp + idx,
+			LaneSub(LaneMul(fwdY, rightZ), LaneMul(fwdZ, rightY)),
+			LaneSub(LaneMul(fwdZ, rightX), LaneMul(fwdX, rightZ)),
+			LaneSub(LaneMul(fwdX, rightY), LaneMul(fwdY, rightX)));
+	}
+}
+
+//---------------------------------
+// TransformKernel::PadLanes
+//
+// Identity transforms for the unused lanes of the last iteration, so that they don't operate on uninitialized values
+//
+void TransformKernel::PadLanes()
+{
+	size_t const end = std::min(((m_Count + s_LaneCount - 1u) / s_LaneCount) * s_LaneCount, s_Capacity);
+	for (size_t idx = m_Count; idx < end; ++idx)
+	{
+		m_PosX[idx] = 0.f;
+		m_PosY[idx] = 0.f;
+		m_PosZ[idx] = 0.f;
+
+		m_RotX[idx] = 0.f;
+		m_RotY[idx] = 0.f;
+		m_RotZ[idx] = 0.f;
+		m_RotW[idx] = 1.f;
+
+		m_ScaleX[idx] = 1.f;
+		m_ScaleY[idx] = 1.f;
+		m_ScaleZ[idx] = 1.f;
+	}
+}
+
+
+} // namespace fw
+} // namespace et
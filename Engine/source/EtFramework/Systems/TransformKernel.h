@@ -0,0 +1,63 @@
+#pragma once
+
+
+namespace et {
+namespace fw {
+
+
+//-----------------
+// TransformKernel
+//
+// Batch of transforms stored as structures of arrays, from which local matrices and orientation vectors are computed several at a time
+//  - 8 transforms per iteration with AVX, 4 with SSE and one at a time if the math library doesn't use SIMD
+//
+class TransformKernel final
+{
+public:
+	static constexpr size_t s_Capacity = 64u; // transforms per batch, a multiple of the widest SIMD register
+
+	// construct destruct
+	//--------------------
+	TransformKernel() = default;
+
+	// functionality
+	//---------------
+	void Clear() { m_Count = 0u; }
+	void Add(vec3 const& position, quat const& rotation, vec3 const& scale);
+	void SetRotation(size_t const idx, quat const& rotation);
+
+	void ComputeMatrices(mat4* const outMatrices); // scale * rotate * translate
+	void ComputeOrientations(vec3* const outForward, vec3* const outRight, vec3* const outUp); // from the current rotations
+
+	// accessors
+	//-----------
+	size_t GetCount() const { return m_Count; }
+	bool IsFull() const { return m_Count == s_Capacity; }
+
+	// utility
+	//---------
+private:
+	void PadLanes();
+
+	// Data
+	///////
+
+	alignas(32) float m_PosX[s_Capacity];
+	alignas(32) float m_PosY[s_Capacity];
+	alignas(32) float m_PosZ[s_Capacity];
+
+	alignas(32) float m_RotX[s_Capacity];
+	alignas(32) float m_RotY[s_Capacity];
+	alignas(32) float m_RotZ[s_Capacity];
+	alignas(32) float m_RotW[s_Capacity];
+
+	alignas(32) float m_ScaleX[s_Capacity];
+	alignas(32) float m_ScaleY[s_Capacity];
+	alignas(32) float m_ScaleZ[s_Capacity];
+
+	size_t m_Count = 0u;
+};
+
+
+} // namespace fw
+} // namespace et
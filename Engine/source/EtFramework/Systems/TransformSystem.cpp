@@ -50,72 +50,124 @@ TransformSystem::Compute::Compute()
 {
 	DeclareDependencies<RigidBodySystem>(); // the rigid body system may update transformations
 
-	DeclareDependents<TransformSystem::Reset>();
+	// only chunks with modified transforms, or whose parents world transforms were updated need processing
+	DeclareChangeFilter<TransformComponent>();
+	DeclareParentChangeFilter<TransformComponent>();
+
+	DeclareResourceWrite<render::Scene>(); // node transforms
+
+	// entities only write their own transform and render scene node, and parents are on the previous layer which is done by the time a layer runs
+	DeclareParallelChunks(s_RangeSize);
 }
 
 //-----------------------------------
 // TransformSystem::Compute::Process
 //
 // Update transforms
+//  - changed transforms are gathered into a kernel that computes their local matrices several at a time
 //
 void TransformSystem::Compute::Process(ComponentRange<TransformSystem::ComputeView>& range) 
 {
 	render::Scene& renderScene = UnifiedScene::Instance().GetRenderScene();
 
+	TransformKernel kernel;
+	TransformComponent* transforms[s_BatchSize];
+	TransformComponent const* parents[s_BatchSize];
+
 	for (ComputeView& view : range)
 	{
 		// if neither this component nor the parent component has an updated transform, we don't need to recalculate anything
-		if (!view.transf->HasTransformChanged() && (!view.parent.IsValid() || !view.parent->HasTransformChanged()))
+		if (!view.transf->HasTransformChanged() && (!view.parent.IsValid() || !view.parent->HasWorldChangedSince(GetLastChangeVersion())))
 		{
 			continue;
 		}
 
-		// this is the local matrix
-		view.transf->m_WorldTransform = math::scale(view.transf->m_Scale) 
-			* math::rotate(view.transf->m_Rotation) 
-			* math::translate(view.transf->m_Position);
+		transforms[kernel.GetCount()] = &view.transf;
+		parents[kernel.GetCount()] = &view.parent;
+		kernel.Add(view.transf->m_Position, view.transf->m_Rotation, view.transf->m_Scale);
 
-		if (view.parent.IsValid())
+		if (kernel.IsFull())
+		{
+			ProcessBatch(kernel, transforms, parents, renderScene);
+			kernel.Clear();
+		}
+	}
+
+	ProcessBatch(kernel, transforms, parents, renderScene);
+}
+
+//----------------------------------------
+// TransformSystem::Compute::ProcessBatch
+//
+// Apply the parent transforms to the local matrices of a batch, and write the results into the components and the render scene
+//
+void TransformSystem::Compute::ProcessBatch(TransformKernel& kernel,
+	TransformComponent* const* const transforms,
+	TransformComponent const* const* const parents,
+	render::Scene& renderScene)
+{
+	size_t const count = kernel.GetCount();
+	if (count == 0u)
+	{
+		return;
+	}
+
+	render::T_NodeId nodes[s_BatchSize];
+	mat4 matrices[s_BatchSize];
+
+	// this is the local matrix
+	kernel.ComputeMatrices(matrices);
+
+	for (size_t idx = 0u; idx < count; ++idx)
+	{
+		TransformComponent& transf = *transforms[idx];
+		TransformComponent const* const parent = parents[idx];
+
+		if (parent != nullptr)
 		{
 			// transform based on parent matrix
-			view.transf->m_WorldTransform = view.transf->m_WorldTransform * view.parent->m_WorldTransform;
+			transf.m_WorldTransform = matrices[idx] * parent->m_WorldTransform;
 
 			// update world variables
-			view.transf->m_WorldPosition = (view.parent->m_WorldTransform * vec4(view.transf->m_Position, 0)).xyz;
-			view.transf->m_WorldRotation = view.parent->GetWorldRotation() * view.transf->m_WorldRotation;
-			view.transf->m_WorldScale = view.parent->GetWorldScale() * view.transf->m_Scale;
+			transf.m_WorldPosition = (parent->m_WorldTransform * vec4(transf.m_Position, 0)).xyz;
+			transf.m_WorldRotation = parent->GetWorldRotation() * transf.m_WorldRotation;
+			transf.m_WorldScale = parent->GetWorldScale() * transf.m_Scale;
 		}
 		else
 		{
-			view.transf->m_WorldPosition = view.transf->m_Position;
-			view.transf->m_WorldRotation = view.transf->m_Rotation;
-			view.transf->m_WorldScale = view.transf->m_Scale;
+			transf.m_WorldTransform = matrices[idx];
+
+			transf.m_WorldPosition = transf.m_Position;
+			transf.m_WorldRotation = transf.m_Rotation;
+			transf.m_WorldScale = transf.m_Scale;
 		}
 
-		// orientation helpers
-		view.transf->m_Forward = view.transf->m_WorldRotation * vec3::FORWARD;
-		view.transf->m_Right = view.transf->m_WorldRotation * vec3::RIGHT;
-		view.transf->m_Up = math::cross(view.transf->m_Forward, view.transf->m_Right);
+		// orientation helpers are based on the world rotation
+		kernel.SetRotation(idx, transf.m_WorldRotation);
 
-		// update in the rendering scene
-		renderScene.UpdateNode(view.transf->m_NodeId, view.transf->m_WorldTransform);
+		// queue the update for the rendering scene
+		nodes[idx] = transf.m_NodeId;
+		matrices[idx] = transf.m_WorldTransform;
 
-		// since we changed our transform we need to set the transform changed flags so that the change trickles down to children
-		view.transf->m_TransformChanged = TransformComponent::E_TransformChanged::All;
+		// local changes are applied, the world version lets the change trickle down to children
+		transf.m_TransformChanged = TransformComponent::E_TransformChanged::None;
+		transf.m_WorldVersion = GetChangeVersion();
 	}
-}
 
-//---------------------------------
-// TransformSystem::Reset::Process
-//
-// Reset dirty flag
-//
-void TransformSystem::Reset::Process(ComponentRange<TransformSystem::ResetView>& range) 
-{
-	for (ResetView& view : range)
+	vec3 forward[s_BatchSize];
+	vec3 right[s_BatchSize];
+	vec3 up[s_BatchSize];
+	kernel.ComputeOrientations(forward, right, up);
+
+	for (size_t idx = 0u; idx < count; ++idx)
 	{
-		view.transf->m_TransformChanged = TransformComponent::E_TransformChanged::None;
+		TransformComponent& transf = *transforms[idx];
+		transf.m_Forward = forward[idx];
+		transf.m_Right = right[idx];
+		transf.m_Up = up[idx];
 	}
+
+	renderScene.UpdateNodes(nodes, matrices, count);
 }
 
 
@@ -1,4 +1,6 @@
 #pragma once
+#include "TransformKernel.h"
+
 #include <EtFramework/Components/TransformComponent.h>
 
 #include <EtFramework/ECS/ComponentView.h>
@@ -6,6 +8,10 @@
 
 
 namespace et {
+namespace render {
+	class Scene;
+}
+
 namespace fw {
 
 
@@ -13,7 +19,9 @@ namespace fw {
 // TransformSystem
 //
 // Updates transform component world locations respecting the entity hierachy
-//  - runs in two phases (compute -> reset) in order to skip unchanged components while respecting hierachy needs
+//  - chunk change versions skip unchanged transforms, world versions let children and other systems know which world transforms moved
+//  - hierachy layers are processed one after another, each split into ranges that run on the worker pool in parallel
+//  - changed transforms are gathered into batches, for which matrices and orientations are computed with SIMD
 //
 class TransformSystem final
 {
@@ -44,34 +52,18 @@ public:
 	class Compute final : public fw::System<Compute, ComputeView>
 	{
 	public:
+		static constexpr size_t s_RangeSize = 256u; // entities per parallel job within a layer
+		static constexpr size_t s_BatchSize = TransformKernel::s_Capacity; // transforms computed and written to the render scene at once
+
 		Compute();
 
 		void Process(ComponentRange<ComputeView>& range) override;
-	};
-
-
-	//---------------------------------
-	// Reset
-	//
-	// Resets dirty flags
-	//
-
-	struct ResetView final : public ComponentView
-	{
-		ResetView() : ComponentView()
-		{
-			Declare(transf);
-		}
-
-		WriteAccess<TransformComponent> transf;
-	};
-
-	class Reset final : public fw::System<Reset, ResetView>
-	{
-	public:
-		Reset() = default;
 
-		void Process(ComponentRange<ResetView>& range) override;
+	private:
+		void ProcessBatch(TransformKernel& kernel, 
+			TransformComponent* const* const transforms, 
+			TransformComponent const* const* const parents, 
+			render::Scene& renderScene);
 	};
 };
 
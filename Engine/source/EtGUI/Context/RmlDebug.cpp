@@ -149,7 +149,7 @@ void RmlDebug::ShowRenderingUI()
 	ImGui::SetNextItemOpen(true);
 	if (ImGui::CollapsingHeader("Rendering"))
 	{
-		ImGui::Text("Immediate geometry buffer size: %u", m_Renderer->m_VertexBufferSize + m_Renderer->m_IndexBufferSize);
+		ImGui::Text("Geometry stream size per frame: " ET_FMT_SIZET, m_Renderer->m_Stream.GetFrameSize());
 
 		if (ImGui::TreeNode(FS("Compiled Geometries: " ET_FMT_SIZET, m_Renderer->m_Geometries.size()).c_str()))
 		{
@@ -158,9 +158,9 @@ void RmlDebug::ShowRenderingUI()
 				RmlRenderer::Geometry const& geo = geoPair.second;
 				if (ImGui::TreeNode(FS("["ET_FMT_SIZET"] - %s", static_cast<size_t>(geoPair.first), (geo.m_Font != nullptr) ? "Font" : "Generic").c_str()))
 				{
-					ImGui::Text("vertices: %i", geo.m_NumVertices);
-					ImGui::Text("indices: %i", geo.m_NumIndices);
-					ImGui::Text("instances: %u", geo.m_InstanceCount);
+					ImGui::Text("vertices: " ET_FMT_SIZET, (geo.m_Font != nullptr) ? geo.m_TextVertices.size() : geo.m_Vertices.size());
+					ImGui::Text("indices: " ET_FMT_SIZET, geo.m_Indices.size());
+					ImGui::Text("layers: " ET_FMT_SIZET, geo.m_Layers.size());
 
 					if ((geo.m_Texture != nullptr) && (geo.m_Texture != m_Renderer->m_EmptyWhiteTex2x2))
 					{
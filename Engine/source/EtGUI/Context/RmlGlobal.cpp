@@ -137,6 +137,16 @@ void RmlGlobal::SetRIView(ivec2 const dim, mat4 const& viewProj)
 	m_Renderer.SetView(dim, viewProj);
 }
 
+//----------------------------------
+// RmlGlobal::EndRIContext
+//
+// Should be called after a context is rendered
+//
+void RmlGlobal::EndRIContext()
+{
+	m_Renderer.EndContext();
+}
+
 
 #if ET_CT_IS_ENABLED(ET_CT_RML_DEBUGGER)
 //----------------------------------
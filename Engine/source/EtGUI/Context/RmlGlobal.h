@@ -53,6 +53,7 @@ public:
 	void SetGraphicsContext(Ptr<render::I_GraphicsContextApi> const graphicsContext);
 	void SetRIShader(AssetPtr<render::ShaderData> const shader, AssetPtr<render::ShaderData> const textShader);
 	void SetRIView(ivec2 const dim, mat4 const& viewProj);
+	void EndRIContext();
 
 
 #if ET_CT_IS_ENABLED(ET_CT_RML_DEBUGGER)
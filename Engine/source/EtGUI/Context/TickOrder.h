@@ -14,6 +14,7 @@ enum class E_TickOrder : uint32
 {
 	TICK_GuiDebug,
 	TICK_GuiExtension,
+	TICK_GuiRenderer,
 
 	COUNT
 };
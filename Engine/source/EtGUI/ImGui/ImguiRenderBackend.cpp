@@ -80,6 +80,7 @@ void ImguiRenderBackend::Render(ImDrawData* const drawData)
 	// recreate the VAO every frame to allow multiple graphics api contexts
 	render::T_ArrayLoc vertexArrayObject = api->CreateVertexArray();
 	SetupRenderState(drawData, fbScale, vertexArrayObject);
+	render::T_BufferLoc linkedBuffer = m_Stream.GetBuffer();
 
 	// project scissor / clipping rectangles into framebuffer space
 	vec2 const clipOffset(drawData->DisplayPos);
@@ -90,35 +91,28 @@ void ImguiRenderBackend::Render(ImDrawData* const drawData)
 	{
 		ImDrawList const* const cmdList = drawData->CmdLists[n];
 
-		// Upload vertex/index buffers
-		int64 const vbSize = static_cast<int64>(cmdList->VtxBuffer.Size) * sizeof(ImDrawVert);
-		void const* vtxData = reinterpret_cast<void const*>(cmdList->VtxBuffer.Data);
-		if (vbSize > m_VertexBufferSize)
+		// write vertices and indices into a single allocation, so that they can't end up in different buffers
+		size_t const vbSize = static_cast<size_t>(cmdList->VtxBuffer.Size) * sizeof(ImDrawVert);
+		size_t const ibSize = static_cast<size_t>(cmdList->IdxBuffer.Size) * sizeof(ImDrawIdx);
+		if ((vbSize == 0u) || (ibSize == 0u))
 		{
-			m_VertexBufferSize = vbSize;
-			api->SetBufferData(render::E_BufferType::Vertex, vbSize, vtxData, render::E_UsageHint::Stream);
-		}
-		else
-		{
-			void* const p = api->MapBuffer(render::E_BufferType::Vertex, render::E_AccessMode::Write);
-			memcpy(p, vtxData, static_cast<size_t>(vbSize));
-			api->UnmapBuffer(render::E_BufferType::Vertex);
+			continue;
 		}
 
-		int64 const ibSize = static_cast<int64>(cmdList->IdxBuffer.Size) * sizeof(ImDrawIdx);
-		void const* idxData = reinterpret_cast<void const*>(cmdList->IdxBuffer.Data);
-		if (ibSize > m_IndexBufferSize)
-		{
-			m_IndexBufferSize = ibSize;
-			api->SetBufferData(render::E_BufferType::Index, ibSize, idxData, render::E_UsageHint::Stream);
-		}
-		else
+		size_t const offset = m_Stream.Allocate(vbSize + ibSize, sizeof(ImDrawVert));
+		m_Stream.Write(offset, cmdList->VtxBuffer.Data, vbSize);
+		m_Stream.Write(offset + vbSize, cmdList->IdxBuffer.Data, ibSize);
+
+		// the stream may have moved to a new buffer if it ran out of space
+		if (m_Stream.GetBuffer() != linkedBuffer)
 		{
-			void* const p = api->MapBuffer(render::E_BufferType::Index, render::E_AccessMode::Write);
-			memcpy(p, idxData, static_cast<size_t>(ibSize));
-			api->UnmapBuffer(render::E_BufferType::Index);
+			SetupRenderState(drawData, fbScale, vertexArrayObject);
+			linkedBuffer = m_Stream.GetBuffer();
 		}
 
+		int32 const baseVertex = static_cast<int32>(offset / sizeof(ImDrawVert));
+		size_t const indexOffset = offset + vbSize;
+
 		// execute commands
 		for (int32 cmdIdx = 0; cmdIdx < cmdList->CmdBuffer.Size; cmdIdx++)
 		{
@@ -150,10 +144,11 @@ void ImguiRenderBackend::Render(ImDrawData* const drawData)
 
 				// bind texture, draw
 				m_Shader->Upload("uTexture"_hash, pcmd->GetTexID());
-				api->DrawElements(render::E_DrawMode::Triangles,
+				api->DrawElementsBaseVertex(render::E_DrawMode::Triangles,
 					pcmd->ElemCount,
 					sizeof(ImDrawIdx) == 2 ? render::E_DataType::UShort : render::E_DataType::UInt,
-					(void*)static_cast<intptr_t>(pcmd->IdxOffset * sizeof(ImDrawIdx)));
+					reinterpret_cast<void const*>(static_cast<uintptr_t>(indexOffset + pcmd->IdxOffset * sizeof(ImDrawIdx))),
+					baseVertex + static_cast<int32>(pcmd->VtxOffset));
 			}
 		}
 	}
@@ -166,6 +161,8 @@ void ImguiRenderBackend::Render(ImDrawData* const drawData)
 	api->SetScissorEnabled(false);
 	api->SetBlendEnabled(false);
 
+	m_Stream.EndFrame();
+
 	api->DebugPopGroup();
 }
 
@@ -174,12 +171,9 @@ void ImguiRenderBackend::Render(ImDrawData* const drawData)
 //
 bool ImguiRenderBackend::CreateDeviceObjects()
 {
-	render::I_GraphicsContextApi* const api = render::ContextHolder::GetRenderContext();
-
 	m_Shader = core::ResourceManager::Instance()->GetAssetData<render::ShaderData>(core::HashString("Shaders/PostGenericUi.glsl"));
 
-	m_VertexBuffer = api->CreateBuffer();
-	m_IndexBuffer = api->CreateBuffer();
+	m_Stream.Init(s_InitialStreamSize);
 
 	CreateFontsTexture();
 
@@ -191,16 +185,9 @@ bool ImguiRenderBackend::CreateDeviceObjects()
 //
 void ImguiRenderBackend::DestroyDeviceObjects()
 {
-	render::I_GraphicsContextApi* const api = render::ContextHolder::GetRenderContext();
-
-	if (m_VertexBuffer != 0u)
-	{
-		api->DeleteBuffer(m_VertexBuffer);
-	}
-
-	if (m_IndexBuffer != 0u)
+	if (m_Stream.GetBuffer() != 0u)
 	{
-		api->DeleteBuffer(m_IndexBuffer);
+		m_Stream.Deinit();
 	}
 
 	m_Shader = nullptr;
@@ -245,8 +232,8 @@ void ImguiRenderBackend::SetupRenderState(ImDrawData* const drawData, ivec2 cons
 	// vertex array setup
 	api->BindVertexArray(vao);
 
-	api->BindBuffer(render::E_BufferType::Vertex, m_VertexBuffer);
-	api->BindBuffer(render::E_BufferType::Index, m_IndexBuffer);
+	api->BindBuffer(render::E_BufferType::Vertex, m_Stream.GetBuffer());
+	api->BindBuffer(render::E_BufferType::Index, m_Stream.GetBuffer());
 
 	api->SetVertexAttributeArrayEnabled(0, true);
 	api->SetVertexAttributeArrayEnabled(1, true);
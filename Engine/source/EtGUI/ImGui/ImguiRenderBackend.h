@@ -5,6 +5,7 @@
 
 #include <EtRendering/GraphicsTypes/Shader.h>
 #include <EtRendering/GraphicsTypes/TextureData.h>
+#include <EtRendering/GraphicsTypes/StreamingBuffer.h>
 
 
 namespace et {
@@ -18,6 +19,10 @@ namespace gui {
 //
 class ImguiRenderBackend final 
 {
+	// definitions
+	//-------------
+	static constexpr size_t s_InitialStreamSize = 256u * 1024u; // per frame
+
 	// static functionality
 	//----------------------
 public:
@@ -53,11 +58,7 @@ private:
 	UniquePtr<render::TextureData> m_FontTexture;
 	AssetPtr<render::ShaderData> m_Shader;
 
-	render::T_BufferLoc m_VertexBuffer = 0u;
-	render::T_BufferLoc m_IndexBuffer = 0u;
-
-	int64 m_VertexBufferSize = 0;
-	int64 m_IndexBufferSize = 0;
+	render::StreamingBuffer m_Stream; // vertices and indices of all command lists
 };
 
 
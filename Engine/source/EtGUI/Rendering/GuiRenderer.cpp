@@ -61,6 +61,7 @@ void GuiRenderer::RenderContext(render::T_FbLoc const targetFb, ContextRenderTar
 	// render context elements
 	api->DebugPushGroup("Overlay Context");
 	context.Render();
+	m_RmlGlobal->EndRIContext();
 	api->DebugPopGroup();
 
 	api->SetPolygonMode(render::E_FaceCullMode::FrontBack, render::E_PolygonMode::Fill);
@@ -108,6 +109,7 @@ void GuiRenderer::RenderWorldContext(render::T_FbLoc const targetFb,
 
 	api->DebugPushGroup("Context elements");
 	context.Render();
+	m_RmlGlobal->EndRIContext();
 	api->DebugPopGroup();
 
 	api->SetPolygonMode(render::E_FaceCullMode::FrontBack, render::E_PolygonMode::Fill);
@@ -6,6 +6,7 @@
 #include <EtRendering/GlobalRenderingSystems/GlobalRenderingSystems.h>
 
 #include <EtGUI/Context/RmlUtil.h>
+#include <EtGUI/Context/TickOrder.h>
 
 
 namespace et {
@@ -26,6 +27,7 @@ Rml::TextureHandle const RmlRenderer::s_InvalidTexture = 0u;
 //
 RmlRenderer::RmlRenderer() 
 	: Rml::RenderInterface()
+	, core::I_Tickable(static_cast<uint32>(E_TickOrder::TICK_GuiRenderer))
 {
 	m_GeneratedParameters.minFilter = render::E_TextureFilterMode::Linear;
 	m_GeneratedParameters.magFilter = render::E_TextureFilterMode::Linear;
@@ -41,24 +43,14 @@ RmlRenderer::RmlRenderer()
 		});
 	m_EmptyWhiteTex2x2 = GenTextureInternal(reinterpret_cast<void const*>(emptyTexData.data()), ivec2(2));
 
-	// immediate vertex buffer
+	// stream for batched geometry
 	render::I_GraphicsContextApi* const api = render::ContextHolder::GetRenderContext();
 
 	m_VertexArray = api->CreateVertexArray();
-	api->BindVertexArray(m_VertexArray);
-
-	m_VertexBuffer = api->CreateBuffer();
-	api->BindBuffer(render::E_BufferType::Vertex, m_VertexBuffer);
-	api->SetBufferData(render::E_BufferType::Vertex, m_VertexBufferSize, nullptr, render::E_UsageHint::Dynamic);
-
-	SetGenericInputLayout(api);
+	m_TextVertexArray = api->CreateVertexArray();
+	m_Stream.Init(s_InitialStreamSize);
 
-	m_IndexBuffer = api->CreateBuffer();
-	api->BindBuffer(render::E_BufferType::Vertex, m_IndexBuffer);
-	api->SetBufferData(render::E_BufferType::Vertex, m_IndexBufferSize, nullptr, render::E_UsageHint::Dynamic);
-
-	api->BindBuffer(render::E_BufferType::Vertex, 0);
-	api->BindVertexArray(0);
+	LinkStreamVertexArrays(api);
 }
 
 //-------------------------------------
@@ -68,9 +60,74 @@ RmlRenderer::~RmlRenderer()
 {
 	render::I_GraphicsContextApi* const api = render::ContextHolder::GetRenderContext();
 
-	api->DeleteBuffer(m_IndexBuffer);
-	api->DeleteBuffer(m_VertexBuffer);
 	api->DeleteVertexArray(m_VertexArray);
+	api->DeleteVertexArray(m_TextVertexArray);
+}
+
+//-------------------------------------
+// RmlRenderer::Batch::IsCompatible
+//
+// Whether geometry with the given texture (and text layers if it is text) can be added to the batch
+//
+bool RmlRenderer::Batch::IsCompatible(Ptr<render::TextureData const> const texture, std::vector<TextLayer> const* const layers) const
+{
+	if ((m_Texture != texture) || (m_IsText != (layers != nullptr)))
+	{
+		return false;
+	}
+
+	if (!m_IsText)
+	{
+		return true;
+	}
+
+	if (m_Layers.size() != layers->size())
+	{
+		return false;
+	}
+
+	for (size_t layerIdx = 0u; layerIdx < m_Layers.size(); ++layerIdx)
+	{
+		TextLayer const& lhs = m_Layers[layerIdx];
+		TextLayer const& rhs = (*layers)[layerIdx];
+		if (!(math::nearEqualsV(lhs.m_Offset, rhs.m_Offset)
+			&& math::nearEqualsV(lhs.m_Color, rhs.m_Color)
+			&& math::nearEquals(lhs.m_SdfThreshold, rhs.m_SdfThreshold)
+			&& math::nearEquals(lhs.m_MinThreshold, rhs.m_MinThreshold)
+			&& (lhs.m_IsBlurred == rhs.m_IsBlurred)))
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+//-------------------------------------
+// RmlRenderer::Batch::Clear
+//
+// Keeps the capacity of the containers, so that batching doesn't allocate once it has warmed up
+//
+void RmlRenderer::Batch::Clear()
+{
+	m_Texture = nullptr;
+	m_IsText = false;
+
+	m_Vertices.clear();
+	m_TextVertices.clear();
+	m_Indices.clear();
+	m_Layers.clear();
+}
+
+//-------------------------------------
+// RmlRenderer::ShaderUniforms::Resolve
+//
+void RmlRenderer::ShaderUniforms::Resolve(render::ShaderData const* const shader)
+{
+	m_Translation = shader->GetUniformHandle("uTranslation"_hash);
+	m_Transform = shader->GetUniformHandle("uTransform"_hash);
+	m_Texture = shader->GetUniformHandle("uTexture"_hash);
+	m_UseAntiAliasing = shader->GetUniformHandle("uUseAntiAliasing"_hash, false);
 }
 
 //-------------------------------------
@@ -80,6 +137,31 @@ void RmlRenderer::SetShader(AssetPtr<render::ShaderData> const& shader, AssetPtr
 {
 	m_Shader = shader;
 	m_TextShader = textShader;
+
+	m_ShaderUniforms.Resolve(m_Shader.get());
+	m_TextShaderUniforms.Resolve(m_TextShader.get());
+}
+
+//-------------------------------------
+// RmlRenderInterface::EndContext
+//
+// Called once a context is rendered, draws the remaining batch before the render target is blitted
+//
+void RmlRenderer::EndContext()
+{
+	FlushBatch();
+}
+
+//-------------------------------------
+// RmlRenderInterface::OnTick
+//
+// Ticks happen before any viewport renders, so this fences the geometry of all contexts drawn in the last frame at once
+//  - doing this per context would stall on the GPU every frame as soon as there are more contexts than stream regions
+//
+void RmlRenderer::OnTick()
+{
+	ET_ASSERT(m_Batch.IsEmpty());
+	m_Stream.EndFrame();
 }
 
 
@@ -97,68 +179,25 @@ void RmlRenderer::RenderGeometry(Rml::Vertex* vertices,
 	Rml::TextureHandle textureHandle,
 	Rml::Vector2f const& translation)
 {
-	// predraw scissor / stencil region
-	//----------------------------------
-	SetupScissorRectangle();
-
-	// update vertex and index buffers
-	//---------------------------------
-	m_GraphicsContext->BindVertexArray(m_VertexArray);
-
-	m_GraphicsContext->BindBuffer(render::E_BufferType::Vertex, m_VertexBuffer);
-	int64 const vbSize = sizeof(Rml::Vertex) * static_cast<int64>(numVertices);
-	if (vbSize > m_VertexBufferSize)
-	{
-		m_VertexBufferSize = vbSize;
-		m_GraphicsContext->SetBufferData(render::E_BufferType::Vertex, vbSize, reinterpret_cast<void const*>(vertices), render::E_UsageHint::Dynamic);
-	}
-	else
-	{
-		void* p = m_GraphicsContext->MapBuffer(render::E_BufferType::Vertex, render::E_AccessMode::Write);
-		memcpy(p, vertices, static_cast<size_t>(vbSize));
-		m_GraphicsContext->UnmapBuffer(render::E_BufferType::Vertex);
-	}
-
-	m_GraphicsContext->BindBuffer(render::E_BufferType::Vertex, 0u);
-
-	m_GraphicsContext->BindBuffer(render::E_BufferType::Index, m_IndexBuffer);
-	int64 const ibSize = sizeof(int32) * static_cast<int64>(numIndices);
-	if (ibSize > m_IndexBufferSize)
-	{
-		m_IndexBufferSize = ibSize;
-		m_GraphicsContext->SetBufferData(render::E_BufferType::Index, ibSize, reinterpret_cast<void const*>(indices), render::E_UsageHint::Dynamic);
-	}
-	else
-	{
-		void* p = m_GraphicsContext->MapBuffer(render::E_BufferType::Index, render::E_AccessMode::Write);
-		memcpy(p, indices, static_cast<size_t>(ibSize));
-		m_GraphicsContext->UnmapBuffer(render::E_BufferType::Index);
-	}
-
-	// setup shading parameters and draw
-	//-----------------------------------
-	m_GraphicsContext->SetShader(m_Shader.get());
-
-	m_Shader->Upload("uTranslation"_hash, vec2(translation.x, translation.y));
-	m_Shader->Upload("uTransform"_hash, m_CurrentTransform);
-
+	Ptr<render::TextureData const> texture = m_EmptyWhiteTex2x2;
 	if (textureHandle != 0u)
 	{
 		T_Textures::iterator const foundIt = m_Textures.find(textureHandle);
 		ET_ASSERT(foundIt != m_Textures.cend());
 
-		m_Shader->Upload("uTexture"_hash, static_cast<render::TextureData const*>(foundIt->second.Get().Get()));
+		texture = foundIt->second.Get();
 	}
-	else
+
+	BeginBatch(texture, nullptr);
+
+	size_t const baseVertex = m_Batch.m_Vertices.size();
+	for (int32 vertIdx = 0; vertIdx < numVertices; ++vertIdx)
 	{
-		m_Shader->Upload("uTexture"_hash, static_cast<render::TextureData const*>(m_EmptyWhiteTex2x2.Get()));
+		m_Batch.m_Vertices.push_back(vertices[vertIdx]);
+		m_Batch.m_Vertices.back().position += translation;
 	}
 
-	m_GraphicsContext->DrawElements(render::E_DrawMode::Triangles, static_cast<uint32>(numIndices), render::E_DataType::UInt, 0);
-
-	// done
-	//------
-	m_GraphicsContext->BindVertexArray(0u);
+	AppendIndices(reinterpret_cast<uint32 const*>(indices), static_cast<size_t>(numIndices), baseVertex);
 }
 
 //-------------------------------------
@@ -197,66 +236,37 @@ Rml::CompiledGeometryHandle RmlRenderer::CompileGeometry(Rml::Vertex* vertices,
 		geometry.m_Texture = m_EmptyWhiteTex2x2;
 	}
 
-	// create a new vertex array and input layout with vertex and index buffers
-	//--------------------------------------------------------------------------
-	geometry.m_VertexArray = m_GraphicsContext->CreateVertexArray();
-	m_GraphicsContext->BindVertexArray(geometry.m_VertexArray);
-
-	// index buffer is the same for generic and text geometry
-	geometry.m_NumIndices = numIndices;
-	int64 const iBufferSize = static_cast<int64>(geometry.m_NumIndices * sizeof(uint32));
-
-	geometry.m_IndexBuffer = m_GraphicsContext->CreateBuffer();
-	m_GraphicsContext->BindBuffer(render::E_BufferType::Index, geometry.m_IndexBuffer);
-	m_GraphicsContext->SetBufferData(render::E_BufferType::Index, iBufferSize, reinterpret_cast<void const*>(indices), render::E_UsageHint::Static);
+	// geometry is kept on the CPU so that it can be batched
+	//------------------------------------------------------
+	// index data is the same for generic and text geometry
+	geometry.m_Indices.resize(static_cast<size_t>(numIndices));
+	memcpy(geometry.m_Indices.data(), indices, geometry.m_Indices.size() * sizeof(uint32));
 
 	// the vertex data needs to be treated differently depending on if it's generic or for text
-	geometry.m_VertexBuffer = m_GraphicsContext->CreateBuffer();
-	m_GraphicsContext->BindBuffer(render::E_BufferType::Vertex, geometry.m_VertexBuffer);
-
 	if (geometry.m_Font == nullptr)
 	{
-		geometry.m_NumVertices = numVertices;
-
-		int32 const vertSize = sizeof(Rml::Vertex);
-		int64 const vBufferSize = static_cast<int64>(geometry.m_NumVertices * vertSize);
-		m_GraphicsContext->SetBufferData(render::E_BufferType::Vertex, vBufferSize, reinterpret_cast<void const*>(vertices), render::E_UsageHint::Static);
-
-		SetGenericInputLayout(m_GraphicsContext.Get());
+		geometry.m_Vertices.assign(vertices, vertices + numVertices);
 	}
 	else
 	{
 		// reconvert stored geometry data from how it was packed into Rml::Vertices in the font engine interface
 		int32 const numChars = numIndices / 6;
 		ET_ASSERT(numChars * 6 == numIndices);
-		geometry.m_NumVertices = numChars * 4;
 
 		uint8 const* dataPtr = reinterpret_cast<uint8 const*>(vertices);
 		FontParameters const& fontParams = *reinterpret_cast<FontParameters const*>(dataPtr);
 		dataPtr += FontParameters::GetVCount() * sizeof(Rml::Vertex);
 
-		// vertex buffer
-		int32 const vertSize = sizeof(TextVertex);
-		int64 const bufferSize = static_cast<int64>(geometry.m_NumVertices * vertSize);
-		m_GraphicsContext->SetBufferData(render::E_BufferType::Vertex, bufferSize, reinterpret_cast<void const*>(dataPtr), render::E_UsageHint::Static);
-
-		m_GraphicsContext->SetVertexAttributeArrayEnabled(0, true);
-		m_GraphicsContext->SetVertexAttributeArrayEnabled(1, true);
-		m_GraphicsContext->SetVertexAttributeArrayEnabled(2, true);
-
-		m_GraphicsContext->DefineVertexAttributePointer(0, 2, render::E_DataType::Float, false, vertSize, offsetof(TextVertex, m_Position));
-		m_GraphicsContext->DefineVertexAttributePointer(1, 2, render::E_DataType::Float, false, vertSize, offsetof(TextVertex, m_TexCoord));
-		m_GraphicsContext->DefineVertexAttribIPointer(2, 1, render::E_DataType::UByte, vertSize, offsetof(TextVertex, m_Channel));
+		geometry.m_TextVertices.resize(static_cast<size_t>(numChars * 4));
+		memcpy(geometry.m_TextVertices.data(), dataPtr, geometry.m_TextVertices.size() * sizeof(TextVertex));
 
-		// setup instance buffer
+		// one instance per layer
 		ET_ASSERT(fontParams.m_LayerCount > 0u);
-		geometry.m_InstanceCount = static_cast<uint64>(fontParams.m_LayerCount);
-		std::vector<TextLayer> layerInstances;
-		layerInstances.reserve(fontParams.m_LayerCount);
+		geometry.m_Layers.reserve(fontParams.m_LayerCount);
 		for (size_t layerIdx = 0u; layerIdx < fontParams.m_LayerCount; ++layerIdx)
 		{
-			layerInstances.push_back(fontParams.m_Layers.Get()[layerIdx]);
-			TextLayer& inst = layerInstances.back();
+			geometry.m_Layers.push_back(fontParams.m_Layers.Get()[layerIdx]);
+			TextLayer& inst = geometry.m_Layers.back();
 			if (layerIdx == fontParams.m_MainLayerIdx)
 			{
 				inst.m_Color = fontParams.m_MainLayerColor;
@@ -265,40 +275,16 @@ Rml::CompiledGeometryHandle RmlRenderer::CompileGeometry(Rml::Vertex* vertices,
 			inst.m_SdfThreshold = math::Clamp01(inst.m_SdfThreshold + fontParams.m_SdfThreshold);
 			inst.m_MinThreshold = math::Clamp01(inst.m_MinThreshold + fontParams.m_SdfThreshold);
 		}
-
-		geometry.m_VertexBufferInstances = m_GraphicsContext->CreateBuffer();
-		m_GraphicsContext->BindBuffer(render::E_BufferType::Vertex, geometry.m_VertexBufferInstances);
-		m_GraphicsContext->SetBufferData(render::E_BufferType::Vertex,
-			layerInstances.size() * sizeof(TextLayer),
-			layerInstances.data(),
-			render::E_UsageHint::Static);
-
-		m_GraphicsContext->SetVertexAttributeArrayEnabled(3, true);
-		m_GraphicsContext->SetVertexAttributeArrayEnabled(4, true);
-		m_GraphicsContext->SetVertexAttributeArrayEnabled(5, true);
-		m_GraphicsContext->SetVertexAttributeArrayEnabled(6, true);
-		m_GraphicsContext->SetVertexAttributeArrayEnabled(7, true);
-		m_GraphicsContext->DefineVertexAttributePointer(3, 2, render::E_DataType::Float, false, sizeof(TextLayer), offsetof(TextLayer, m_Offset));
-		m_GraphicsContext->DefineVertexAttributePointer(4, 4, render::E_DataType::Float, false, sizeof(TextLayer), offsetof(TextLayer, m_Color));
-		m_GraphicsContext->DefineVertexAttributePointer(5, 1, render::E_DataType::Float, false, sizeof(TextLayer), offsetof(TextLayer, m_SdfThreshold));
-		m_GraphicsContext->DefineVertexAttributePointer(6, 1, render::E_DataType::Float, false, sizeof(TextLayer), offsetof(TextLayer, m_MinThreshold));
-		m_GraphicsContext->DefineVertexAttribIPointer(7, 1, render::E_DataType::UByte, sizeof(TextLayer), offsetof(TextLayer, m_IsBlurred));
-		m_GraphicsContext->DefineVertexAttribDivisor(3, 1);
-		m_GraphicsContext->DefineVertexAttribDivisor(4, 1);
-		m_GraphicsContext->DefineVertexAttribDivisor(5, 1);
-		m_GraphicsContext->DefineVertexAttribDivisor(6, 1);
-		m_GraphicsContext->DefineVertexAttribDivisor(7, 1);
 	}
 
-	// done
-	m_GraphicsContext->BindVertexArray(0u);
-
 	return m_LastGeometryHandle;
 }
 
 //--------------------------------------------
 // RmlRenderInterface::RenderCompiledGeometry
 //
+// Adds the geometry to the current batch, which is only drawn once the render state changes
+//
 void RmlRenderer::RenderCompiledGeometry(Rml::CompiledGeometryHandle geometry, Rml::Vector2f const& translation)
 {
 	// the geometry in question
@@ -307,42 +293,36 @@ void RmlRenderer::RenderCompiledGeometry(Rml::CompiledGeometryHandle geometry, R
 
 	Geometry const& geo = foundIt->second;
 
-	// scissor rectangle
-	SetupScissorRectangle();
-
-	// what to draw
-	m_GraphicsContext->BindVertexArray(geo.m_VertexArray); // this should be unbound at the end of rendering a context
-
-	// update shader parameters - shader should already be set
-	render::ShaderData const* shader = nullptr;
+	// text and generic geometry use different vertex layouts
+	size_t baseVertex;
 	if (geo.m_Font != nullptr)
 	{
-		shader = m_TextShader.get();
-	}
-	else
-	{
-		shader = m_Shader.get();
-	}
+		BeginBatch(geo.m_Texture, &geo.m_Layers);
 
-	ET_ASSERT(shader != nullptr);
-	m_GraphicsContext->SetShader(shader);
+		vec2 const offset(translation.x, translation.y);
 
-	shader->Upload("uTranslation"_hash, vec2(translation.x, translation.y));
-	shader->Upload("uTransform"_hash, m_CurrentTransform);
-	shader->Upload("uTexture"_hash, geo.m_Texture.Get());
-
-	// draw differently depending on if we are handling text or not
-	if (geo.m_Font != nullptr)
-	{
-		//shader->Upload("uSdfSize"_hash, geo.m_Font->GetSdfSize());
-		shader->Upload("uUseAntiAliasing"_hash, true);
+		baseVertex = m_Batch.m_TextVertices.size();
+		for (TextVertex const& vert : geo.m_TextVertices)
+		{
+			m_Batch.m_TextVertices.push_back(vert);
 
-		m_GraphicsContext->DrawElementsInstanced(render::E_DrawMode::Triangles, geo.m_NumIndices, render::E_DataType::UInt, 0, geo.m_InstanceCount);
+			TextVertex& added = m_Batch.m_TextVertices.back();
+			added.m_Position = added.m_Position + offset;
+		}
 	}
 	else
 	{
-		m_GraphicsContext->DrawElements(render::E_DrawMode::Triangles, geo.m_NumIndices, render::E_DataType::UInt, 0);
+		BeginBatch(geo.m_Texture, nullptr);
+
+		baseVertex = m_Batch.m_Vertices.size();
+		for (Rml::Vertex const& vert : geo.m_Vertices)
+		{
+			m_Batch.m_Vertices.push_back(vert);
+			m_Batch.m_Vertices.back().position += translation;
+		}
 	}
+
+	AppendIndices(geo.m_Indices.data(), geo.m_Indices.size(), baseVertex);
 }
 
 //---------------------------------------------
@@ -350,20 +330,8 @@ void RmlRenderer::RenderCompiledGeometry(Rml::CompiledGeometryHandle geometry, R
 //
 void RmlRenderer::ReleaseCompiledGeometry(Rml::CompiledGeometryHandle geometry)
 {
-	T_Geometries::iterator const foundIt = m_Geometries.find(geometry);
-	ET_ASSERT(foundIt != m_Geometries.cend());
-
-	Geometry& geo = foundIt->second;
-	if (geo.m_Font != nullptr)
-	{
-		m_GraphicsContext->DeleteBuffer(geo.m_VertexBufferInstances);
-	}
-
-	m_GraphicsContext->DeleteBuffer(geo.m_VertexBuffer);
-	m_GraphicsContext->DeleteBuffer(geo.m_IndexBuffer);
-	m_GraphicsContext->DeleteVertexArray(geo.m_VertexArray);
-
-	m_Geometries.erase(foundIt);
+	size_t const erased = m_Geometries.erase(geometry);
+	ET_ASSERT(erased == 1u);
 }
 
 //-----------------------------------------
@@ -373,6 +341,11 @@ void RmlRenderer::ReleaseCompiledGeometry(Rml::CompiledGeometryHandle geometry)
 //
 void RmlRenderer::EnableScissorRegion(bool enable)
 {
+	if (enable != m_IsScissorEnabled)
+	{
+		FlushBatch();
+	}
+
 	m_IsScissorEnabled = enable;
 }
 
@@ -383,8 +356,17 @@ void RmlRenderer::EnableScissorRegion(bool enable)
 //
 void RmlRenderer::SetScissorRegion(int32 x, int32 y, int32 width, int32 height)
 {
-	m_ScissorPos = ivec2(x, y);
-	m_ScissorSize = ivec2(width, height);
+	ivec2 const pos(x, y);
+	ivec2 const size(width, height);
+
+	// the region only affects batched geometry while scissoring is enabled
+	if (m_IsScissorEnabled && !(math::nearEqualsV(pos, m_ScissorPos) && math::nearEqualsV(size, m_ScissorSize)))
+	{
+		FlushBatch();
+	}
+
+	m_ScissorPos = pos;
+	m_ScissorSize = size;
 }
 
 //---------------------------------
@@ -440,6 +422,8 @@ bool RmlRenderer::GenerateTexture(Rml::TextureHandle& textureHandle, Rml::byte c
 //
 void RmlRenderer::ReleaseTexture(Rml::TextureHandle textureHandle)
 {
+	FlushBatch(); // the batch might still reference the texture
+
 	size_t const erased = m_Textures.erase(textureHandle);
 	ET_ASSERT(erased == 1u);
 }
@@ -449,18 +433,21 @@ void RmlRenderer::ReleaseTexture(Rml::TextureHandle textureHandle)
 //
 void RmlRenderer::SetTransform(Rml::Matrix4f const* transform)
 {
+	mat4 newTransform;
 	if (transform != nullptr)
 	{
-		memcpy(reinterpret_cast<void *>(&m_CurrentTransform.data), reinterpret_cast<void const*>(transform->data()), sizeof(float) * 16);
+		memcpy(reinterpret_cast<void *>(&newTransform.data), reinterpret_cast<void const*>(transform->data()), sizeof(float) * 16);
 		// might need to transpose after
-
-		m_HasTransform = true;
 	}
-	else
+
+	bool const hasTransform = (transform != nullptr);
+	if ((hasTransform != m_HasTransform) || !math::nearEqualsM(newTransform, m_CurrentTransform))
 	{
-		m_CurrentTransform = mat4();
-		m_HasTransform = false;
+		FlushBatch();
 	}
+
+	m_CurrentTransform = newTransform;
+	m_HasTransform = hasTransform;
 }
 
 //----------------------------------------
@@ -490,6 +477,63 @@ void RmlRenderer::SetGenericInputLayout(render::I_GraphicsContextApi* const api)
 	api->DefineVertexAttributePointer(2, 2, render::E_DataType::Float, false, sizeof(Rml::Vertex), offsetof(Rml::Vertex, tex_coord));
 }
 
+//-------------------------------------------
+// RmlRenderInterface::SetTextInputLayout
+//
+// Per vertex glyph data, and per instance text layers
+//
+void RmlRenderer::SetTextInputLayout(render::I_GraphicsContextApi* const api) const
+{
+	int32 const vertSize = sizeof(TextVertex);
+
+	api->SetVertexAttributeArrayEnabled(0, true);
+	api->SetVertexAttributeArrayEnabled(1, true);
+	api->SetVertexAttributeArrayEnabled(2, true);
+
+	api->DefineVertexAttributePointer(0, 2, render::E_DataType::Float, false, vertSize, offsetof(TextVertex, m_Position));
+	api->DefineVertexAttributePointer(1, 2, render::E_DataType::Float, false, vertSize, offsetof(TextVertex, m_TexCoord));
+	api->DefineVertexAttribIPointer(2, 1, render::E_DataType::UByte, vertSize, offsetof(TextVertex, m_Channel));
+
+	api->SetVertexAttributeArrayEnabled(3, true);
+	api->SetVertexAttributeArrayEnabled(4, true);
+	api->SetVertexAttributeArrayEnabled(5, true);
+	api->SetVertexAttributeArrayEnabled(6, true);
+	api->SetVertexAttributeArrayEnabled(7, true);
+	api->DefineVertexAttributePointer(3, 2, render::E_DataType::Float, false, sizeof(TextLayer), offsetof(TextLayer, m_Offset));
+	api->DefineVertexAttributePointer(4, 4, render::E_DataType::Float, false, sizeof(TextLayer), offsetof(TextLayer, m_Color));
+	api->DefineVertexAttributePointer(5, 1, render::E_DataType::Float, false, sizeof(TextLayer), offsetof(TextLayer, m_SdfThreshold));
+	api->DefineVertexAttributePointer(6, 1, render::E_DataType::Float, false, sizeof(TextLayer), offsetof(TextLayer, m_MinThreshold));
+	api->DefineVertexAttribIPointer(7, 1, render::E_DataType::UByte, sizeof(TextLayer), offsetof(TextLayer, m_IsBlurred));
+	api->DefineVertexAttribDivisor(3, 1);
+	api->DefineVertexAttribDivisor(4, 1);
+	api->DefineVertexAttribDivisor(5, 1);
+	api->DefineVertexAttribDivisor(6, 1);
+	api->DefineVertexAttribDivisor(7, 1);
+}
+
+//--------------------------------------------
+// RmlRenderInterface::LinkStreamVertexArrays
+//
+// Point the generic and text vertex arrays to the current stream buffer, which holds vertex, index and instance data
+//
+void RmlRenderer::LinkStreamVertexArrays(render::I_GraphicsContextApi* const api)
+{
+	api->BindBuffer(render::E_BufferType::Vertex, m_Stream.GetBuffer());
+
+	api->BindVertexArray(m_VertexArray);
+	api->BindBuffer(render::E_BufferType::Index, m_Stream.GetBuffer());
+	SetGenericInputLayout(api);
+
+	api->BindVertexArray(m_TextVertexArray);
+	api->BindBuffer(render::E_BufferType::Index, m_Stream.GetBuffer());
+	SetTextInputLayout(api);
+
+	api->BindBuffer(render::E_BufferType::Vertex, 0);
+	api->BindVertexArray(0);
+
+	m_LinkedBuffer = m_Stream.GetBuffer();
+}
+
 //-------------------------------------------
 // RmlRenderInterface::SetupScissorRectangle
 //
@@ -524,6 +568,8 @@ void RmlRenderer::SetupScissorRectangle()
 				if (m_NullShader == nullptr)
 				{
 					m_NullShader = render::RenderingSystems::Instance()->GetNullMaterial()->GetShaderAsset();
+					m_NullModel = m_NullShader->GetUniformHandle("model"_hash);
+					m_NullWorldViewProj = m_NullShader->GetUniformHandle("worldViewProj"_hash);
 				}
 
 				m_GraphicsContext->SetShader(m_NullShader.get());
@@ -531,9 +577,9 @@ void RmlRenderer::SetupScissorRectangle()
 				mat4 quadTransform = math::translate(vec3(1.f, 1.f, 0.f)) * math::scale(vec3(0.5f, 0.5f, 1.f)) * // move to 0/0/0
 					math::scale(vec3(math::vecCast<float>(m_ScissorSize), 0.f)) * math::translate(vec3(math::vecCast<float>(m_ScissorPos), 0.f)); // rec 
 				quadTransform = quadTransform * m_CurrentTransform; // apply transform to scissor rectangle
-				m_NullShader->Upload("model"_hash, quadTransform);
+				m_NullShader->Upload(m_NullModel, quadTransform);
 
-				m_NullShader->Upload("worldViewProj"_hash, m_ViewProj); // convert from UI to screen coordinates and perform vertical flip
+				m_NullShader->Upload(m_NullWorldViewProj, m_ViewProj); // convert from UI to screen coordinates and perform vertical flip
 
 				render::RenderingSystems::Instance()->GetPrimitiveRenderer().Draw<render::primitives::Quad>();
 
@@ -558,6 +604,134 @@ void RmlRenderer::SetupScissorRectangle()
 }
 
 
+//--------------------------------
+// RmlRenderInterface::BeginBatch
+//
+// Draw the current batch if the incoming geometry can't be merged into it
+//
+void RmlRenderer::BeginBatch(Ptr<render::TextureData const> const texture, std::vector<TextLayer> const* const layers)
+{
+	if (!(m_Batch.IsEmpty() || m_Batch.IsCompatible(texture, layers)))
+	{
+		FlushBatch();
+	}
+
+	if (m_Batch.IsEmpty())
+	{
+		m_Batch.m_Texture = texture;
+		m_Batch.m_IsText = (layers != nullptr);
+		if (m_Batch.m_IsText)
+		{
+			m_Batch.m_Layers = *layers;
+		}
+	}
+}
+
+//-----------------------------------
+// RmlRenderInterface::AppendIndices
+//
+void RmlRenderer::AppendIndices(uint32 const* const indices, size_t const count, size_t const baseVertex)
+{
+	uint32 const offset = static_cast<uint32>(baseVertex);
+	for (size_t idx = 0u; idx < count; ++idx)
+	{
+		m_Batch.m_Indices.push_back(indices[idx] + offset);
+	}
+}
+
+//--------------------------------
+// RmlRenderInterface::FlushBatch
+//
+// Stream the batch and draw it with a single call, using the scissor and transform state it was gathered with
+//
+void RmlRenderer::FlushBatch()
+{
+	if (m_Batch.IsEmpty())
+	{
+		return;
+	}
+
+	// predraw scissor / stencil region
+	//----------------------------------
+	SetupScissorRectangle();
+
+	// stream everything in a single allocation, so that it ends up in the same buffer if the stream has to grow
+	//-----------------------------------------------------------------------------------------------------------
+	size_t const vertSize = m_Batch.m_IsText ? sizeof(TextVertex) : sizeof(Rml::Vertex);
+	size_t const vbSize = vertSize * (m_Batch.m_IsText ? m_Batch.m_TextVertices.size() : m_Batch.m_Vertices.size());
+	size_t const ibSize = sizeof(uint32) * m_Batch.m_Indices.size();
+
+	// instance data is addressed in multiples of its stride from the start of the buffer, so leave space to align it
+	size_t const layerSize = sizeof(TextLayer) * m_Batch.m_Layers.size();
+	size_t const layerPadding = m_Batch.m_IsText ? sizeof(TextLayer) : 0u;
+
+	size_t const offset = m_Stream.Allocate(vbSize + ibSize + layerPadding + layerSize, vertSize); // usable as a base vertex
+	size_t const indexOffset = offset + vbSize;
+
+	if (m_Batch.m_IsText)
+	{
+		m_Stream.Write(offset, m_Batch.m_TextVertices.data(), vbSize);
+	}
+	else
+	{
+		m_Stream.Write(offset, m_Batch.m_Vertices.data(), vbSize);
+	}
+
+	m_Stream.Write(indexOffset, m_Batch.m_Indices.data(), ibSize);
+
+	if (m_Stream.GetBuffer() != m_LinkedBuffer)
+	{
+		LinkStreamVertexArrays(m_GraphicsContext.Get());
+	}
+
+	// setup shading parameters and draw
+	//-----------------------------------
+	render::ShaderData const* const shader = m_Batch.m_IsText ? m_TextShader.get() : m_Shader.get();
+	ShaderUniforms const& uniforms = m_Batch.m_IsText ? m_TextShaderUniforms : m_ShaderUniforms;
+
+	ET_ASSERT(shader != nullptr);
+	m_GraphicsContext->SetShader(shader);
+
+	shader->Upload(uniforms.m_Translation, vec2()); // already applied to the vertices
+	shader->Upload(uniforms.m_Transform, m_CurrentTransform);
+	shader->Upload(uniforms.m_Texture, m_Batch.m_Texture.Get());
+
+	void const* const indices = reinterpret_cast<void const*>(static_cast<uintptr_t>(indexOffset));
+	int32 const baseVertex = static_cast<int32>(offset / vertSize);
+
+	if (m_Batch.m_IsText)
+	{
+		size_t const layerOffset = ((indexOffset + ibSize + sizeof(TextLayer) - 1u) / sizeof(TextLayer)) * sizeof(TextLayer);
+		m_Stream.Write(layerOffset, m_Batch.m_Layers.data(), layerSize);
+
+		shader->Upload(uniforms.m_UseAntiAliasing, true);
+
+		m_GraphicsContext->BindVertexArray(m_TextVertexArray);
+		m_GraphicsContext->DrawElementsInstancedBaseVertexBaseInstance(render::E_DrawMode::Triangles,
+			static_cast<uint32>(m_Batch.m_Indices.size()),
+			render::E_DataType::UInt,
+			indices,
+			static_cast<uint32>(m_Batch.m_Layers.size()),
+			baseVertex,
+			static_cast<uint32>(layerOffset / sizeof(TextLayer)));
+	}
+	else
+	{
+		m_GraphicsContext->BindVertexArray(m_VertexArray);
+		m_GraphicsContext->DrawElementsBaseVertex(render::E_DrawMode::Triangles,
+			static_cast<uint32>(m_Batch.m_Indices.size()),
+			render::E_DataType::UInt,
+			indices,
+			baseVertex);
+	}
+
+	// done
+	//------
+	m_GraphicsContext->BindVertexArray(0u);
+	m_Batch.Clear();
+}
+
+
 } // namespace gui
 } // namespace et
 
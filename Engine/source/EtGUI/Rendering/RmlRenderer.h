@@ -4,10 +4,12 @@
 #include <imconfig.h>
 
 #include <EtCore/Content/AssetPointer.h>
+#include <EtCore/UpdateCycle/Tickable.h>
 
 #include <EtRendering/GraphicsContext/GraphicsTypes.h>
 #include <EtRendering/GraphicsTypes/TextureData.h>
 #include <EtRendering/GraphicsTypes/Shader.h>
+#include <EtRendering/GraphicsTypes/StreamingBuffer.h>
 
 #include <EtGUI/Fonts/SdfFont.h>
 #include <EtGUI/Fonts/FontParameters.h>
@@ -21,8 +23,9 @@ namespace gui {
 // RmlRenderInterface
 //
 // Implementation of RmlUi's render interface
+//  - batches are drawn per context, but the geometry stream only advances once per frame on tick
 //
-class RmlRenderer final : public Rml::RenderInterface
+class RmlRenderer final : public Rml::RenderInterface, public core::I_Tickable
 {
 	// definitions
 	//-------------
@@ -31,14 +34,11 @@ class RmlRenderer final : public Rml::RenderInterface
 	{
 		Geometry() = default;
 
-		render::T_ArrayLoc m_VertexArray = 0u;
-		render::T_BufferLoc m_IndexBuffer = 0u;
-		render::T_BufferLoc m_VertexBuffer = 0u;
-		render::T_BufferLoc m_VertexBufferInstances = 0u;
-
-		int32 m_NumVertices = 0;
-		int32 m_NumIndices = 0;
-		uint32 m_InstanceCount = 1u;
+		// kept on the CPU, as geometry is translated and merged into a batch every time it is rendered
+		std::vector<Rml::Vertex> m_Vertices; // generic geometry only
+		std::vector<TextVertex> m_TextVertices; // text geometry only
+		std::vector<uint32> m_Indices;
+		std::vector<TextLayer> m_Layers; // text geometry only, each layer is drawn as an instance
 
 		Ptr<render::TextureData const> m_Texture;
 		AssetPtr<SdfFont> m_Font;
@@ -84,6 +84,43 @@ class RmlRenderer final : public Rml::RenderInterface
 
 	typedef std::unordered_map<Rml::TextureHandle, Texture> T_Textures;
 
+	//---------------------------------
+	// RmlRenderer::ShaderUniforms
+	//
+	// Uniforms uploaded for every draw, resolved once when a shader is set
+	//
+	struct ShaderUniforms final
+	{
+		void Resolve(render::ShaderData const* const shader);
+
+		render::UniformHandle m_Translation;
+		render::UniformHandle m_Transform;
+		render::UniformHandle m_Texture;
+		render::UniformHandle m_UseAntiAliasing; // text shader only
+	};
+
+	//---------------------------------
+	// RmlRenderer::Batch
+	//
+	// Consecutive geometry with the same texture, scissor and transform state, which is drawn with a single call
+	//
+	struct Batch final
+	{
+		bool IsEmpty() const { return m_Indices.empty(); }
+		bool IsCompatible(Ptr<render::TextureData const> const texture, std::vector<TextLayer> const* const layers) const;
+		void Clear();
+
+		Ptr<render::TextureData const> m_Texture;
+		bool m_IsText = false;
+
+		std::vector<Rml::Vertex> m_Vertices; // translation is already applied
+		std::vector<TextVertex> m_TextVertices;
+		std::vector<uint32> m_Indices; // relative to the first vertex of the batch
+		std::vector<TextLayer> m_Layers; // shared by all text in the batch
+	};
+
+	static constexpr size_t s_InitialStreamSize = 256u * 1024u; // bytes per frame for batched geometry
+
 #if ET_CT_IS_ENABLED(ET_CT_IMGUI)
 	friend class RmlDebug;
 #endif
@@ -99,6 +136,9 @@ public:
 	void SetGraphicsContext(Ptr<render::I_GraphicsContextApi> const graphicsContext) { m_GraphicsContext = graphicsContext; }
 	void SetShader(AssetPtr<render::ShaderData> const& shader, AssetPtr<render::ShaderData> const& textShader);
 	void SetView(ivec2 const dim, mat4 const& viewProj) { m_ViewDimensions = dim; m_ViewProj = viewProj; }
+	void EndContext();
+
+	void OnTick() override;
 
 	// interface implementation
 	//--------------------------
@@ -137,8 +177,14 @@ public:
 private:
 	UniquePtr<render::TextureData> GenTextureInternal(void const* data, ivec2 dimensions);
 	void SetGenericInputLayout(render::I_GraphicsContextApi* const api) const;
+	void SetTextInputLayout(render::I_GraphicsContextApi* const api) const;
+	void LinkStreamVertexArrays(render::I_GraphicsContextApi* const api);
 	void SetupScissorRectangle();
 
+	void BeginBatch(Ptr<render::TextureData const> const texture, std::vector<TextLayer> const* const layers);
+	void AppendIndices(uint32 const* const indices, size_t const count, size_t const baseVertex);
+	void FlushBatch();
+
 
 	// Data
 	///////
@@ -153,16 +199,22 @@ private:
 	AssetPtr<render::ShaderData> m_TextShader;
 	AssetPtr<render::ShaderData> m_NullShader;
 
+	ShaderUniforms m_ShaderUniforms;
+	ShaderUniforms m_TextShaderUniforms;
+	render::UniformHandle m_NullModel;
+	render::UniformHandle m_NullWorldViewProj;
+
 	// compiled geometries
 	T_Geometries m_Geometries;
 	Rml::CompiledGeometryHandle m_LastGeometryHandle = s_InvalidGeometry;
 
-	// immediate geometry
+	// batched geometry - vertices, indices and text layers are streamed into the same buffer
+	Batch m_Batch;
+
 	render::T_ArrayLoc m_VertexArray = 0;
-	int64 m_VertexBufferSize = 50;
-	render::T_BufferLoc m_VertexBuffer = 0;
-	int64 m_IndexBufferSize = 50;
-	render::T_BufferLoc m_IndexBuffer = 0;
+	render::T_ArrayLoc m_TextVertexArray = 0;
+	render::StreamingBuffer m_Stream;
+	render::T_BufferLoc m_LinkedBuffer = 0; // stream buffer the vertex arrays read from
 
 	// textures
 	T_Textures m_Textures;
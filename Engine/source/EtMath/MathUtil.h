@@ -1,4 +1,5 @@
 #pragma once
+#include "Simd.h"
 
 #include <cstdint>
 #include <cassert>
@@ -90,8 +90,8 @@ matrix<m, n, T> operator*( const matrix<m, n, T>& lhs, const T rhs );
 //operations
 //**********
 
-template <unsigned int m, unsigned int n, class T>
-matrix<m, n, T> transpose(const matrix<m, n, T>& mat);
+template <uint8 m, uint8 n, class T>
+matrix<n, m, T> transpose(const matrix<m, n, T>& mat);
 
 //special cases
 
@@ -122,6 +122,16 @@ T const* valuePtr( matrix<m, n, T> const& mat );
 template<unsigned int m, unsigned int n, typename T>
 T* valuePtr( matrix<m, n, T>& mat );
 
+//SIMD overloads
+//**************
+//non template overloads are preferred over the generic versions when the backend is enabled
+#if ETM_SIMD_SSE
+inline matrix<4, 4, float> operator*(const matrix<4, 4, float>& lhs, const matrix<4, 4, float>& rhs);
+inline vector<4, float> operator*(const matrix<4, 4, float>& lhs, const vector<4, float>& rhs);
+inline matrix<4, 4, float> transpose(const matrix<4, 4, float>& mat);
+inline matrix<4, 4, float> inverse(const matrix<4, 4, float>& mat);
+#endif
+
 
 } //namespace math
 
@@ -200,8 +200,8 @@ operator*(const matrix<m, n, T>& lhs, const T rhs)
 //====================
 
 
-template <unsigned int m, unsigned int n, class T>
-inline matrix<m, n, T> transpose(const matrix<m, n, T>& mat)
+template <uint8 m, uint8 n, class T>
+inline matrix<n, m, T> transpose(const matrix<m, n, T>& mat)
 {
 	matrix<n, m, T> result;
 
@@ -359,5 +359,177 @@ T* valuePtr(matrix<m, n, T>& mat)
 }
 
 
+
+//====================
+// SIMD
+//====================
+
+
+#if ETM_SIMD_SSE
+
+//each result row is the sum of the rhs rows, weighted by the lhs row - same summation order as the generic version
+inline matrix<4, 4, float> operator*(const matrix<4, 4, float>& lhs, const matrix<4, 4, float>& rhs)
+{
+	matrix<4, 4, float> result(uninitialized);
+
+	__m128 const rhs0 = _mm_loadu_ps(rhs.data[0]);
+	__m128 const rhs1 = _mm_loadu_ps(rhs.data[1]);
+	__m128 const rhs2 = _mm_loadu_ps(rhs.data[2]);
+	__m128 const rhs3 = _mm_loadu_ps(rhs.data[3]);
+
+#if ETM_SIMD_AVX
+	//two rows at once, with the rhs rows duplicated into both lanes
+	__m256 const rhs00 = _mm256_insertf128_ps(_mm256_castps128_ps256(rhs0), rhs0, 1);
+	__m256 const rhs11 = _mm256_insertf128_ps(_mm256_castps128_ps256(rhs1), rhs1, 1);
+	__m256 const rhs22 = _mm256_insertf128_ps(_mm256_castps128_ps256(rhs2), rhs2, 1);
+	__m256 const rhs33 = _mm256_insertf128_ps(_mm256_castps128_ps256(rhs3), rhs3, 1);
+
+	for (uint8 rowIdx = 0; rowIdx < 4; rowIdx += 2)
+	{
+		__m256 const lhsRows = _mm256_loadu_ps(lhs.data[rowIdx]);
+
+		__m256 row = _mm256_mul_ps(_mm256_shuffle_ps(lhsRows, lhsRows, _MM_SHUFFLE(0, 0, 0, 0)), rhs00);
+		row = _mm256_add_ps(row, _mm256_mul_ps(_mm256_shuffle_ps(lhsRows, lhsRows, _MM_SHUFFLE(1, 1, 1, 1)), rhs11));
+		row = _mm256_add_ps(row, _mm256_mul_ps(_mm256_shuffle_ps(lhsRows, lhsRows, _MM_SHUFFLE(2, 2, 2, 2)), rhs22));
+		row = _mm256_add_ps(row, _mm256_mul_ps(_mm256_shuffle_ps(lhsRows, lhsRows, _MM_SHUFFLE(3, 3, 3, 3)), rhs33));
+
+		_mm256_storeu_ps(result.data[rowIdx], row);
+	}
+#else
+	for (uint8 rowIdx = 0; rowIdx < 4; ++rowIdx)
+	{
+		__m128 row = _mm_mul_ps(_mm_set1_ps(lhs.data[rowIdx][0]), rhs0);
+		row = _mm_add_ps(row, _mm_mul_ps(_mm_set1_ps(lhs.data[rowIdx][1]), rhs1));
+		row = _mm_add_ps(row, _mm_mul_ps(_mm_set1_ps(lhs.data[rowIdx][2]), rhs2));
+		row = _mm_add_ps(row, _mm_mul_ps(_mm_set1_ps(lhs.data[rowIdx][3]), rhs3));
+
+		_mm_storeu_ps(result.data[rowIdx], row);
+	}
+#endif
+
+	return result;
+}
+
+//column major convention -> the result is the sum of the matrix rows weighted by the vector components
+inline vector<4, float> operator*(const matrix<4, 4, float>& lhs, const vector<4, float>& rhs)
+{
+	__m128 result = _mm_mul_ps(_mm_loadu_ps(lhs.data[0]), _mm_set1_ps(rhs.x));
+	result = _mm_add_ps(result, _mm_mul_ps(_mm_loadu_ps(lhs.data[1]), _mm_set1_ps(rhs.y)));
+	result = _mm_add_ps(result, _mm_mul_ps(_mm_loadu_ps(lhs.data[2]), _mm_set1_ps(rhs.z)));
+	result = _mm_add_ps(result, _mm_mul_ps(_mm_loadu_ps(lhs.data[3]), _mm_set1_ps(rhs.w)));
+
+	vector<4, float> ret;
+	_mm_storeu_ps(ret.data.data(), result);
+	return ret;
+}
+
+inline matrix<4, 4, float> transpose(const matrix<4, 4, float>& mat)
+{
+	__m128 row0 = _mm_loadu_ps(mat.data[0]);
+	__m128 row1 = _mm_loadu_ps(mat.data[1]);
+	__m128 row2 = _mm_loadu_ps(mat.data[2]);
+	__m128 row3 = _mm_loadu_ps(mat.data[3]);
+
+	_MM_TRANSPOSE4_PS(row0, row1, row2, row3);
+
+	matrix<4, 4, float> result(uninitialized);
+	_mm_storeu_ps(result.data[0], row0);
+	_mm_storeu_ps(result.data[1], row1);
+	_mm_storeu_ps(result.data[2], row2);
+	_mm_storeu_ps(result.data[3], row3);
+	return result;
+}
+
+namespace detail {
+
+//2x2 matrices packed into a single register as | 0 1 |
+//                                              | 2 3 |
+
+//A * B
+inline __m128 Mat2Mul(__m128 const lhs, __m128 const rhs)
+{
+	return _mm_add_ps(_mm_mul_ps(lhs, _mm_shuffle_ps(rhs, rhs, _MM_SHUFFLE(3, 0, 3, 0))),
+		_mm_mul_ps(_mm_shuffle_ps(lhs, lhs, _MM_SHUFFLE(2, 3, 0, 1)), _mm_shuffle_ps(rhs, rhs, _MM_SHUFFLE(1, 2, 1, 2))));
+}
+
+//adjugate(A) * B
+inline __m128 Mat2AdjMul(__m128 const lhs, __m128 const rhs)
+{
+	return _mm_sub_ps(_mm_mul_ps(_mm_shuffle_ps(lhs, lhs, _MM_SHUFFLE(0, 0, 3, 3)), rhs),
+		_mm_mul_ps(_mm_shuffle_ps(lhs, lhs, _MM_SHUFFLE(2, 2, 1, 1)), _mm_shuffle_ps(rhs, rhs, _MM_SHUFFLE(1, 0, 3, 2))));
+}
+
+//A * adjugate(B)
+inline __m128 Mat2MulAdj(__m128 const lhs, __m128 const rhs)
+{
+	return _mm_sub_ps(_mm_mul_ps(lhs, _mm_shuffle_ps(rhs, rhs, _MM_SHUFFLE(0, 3, 0, 3))),
+		_mm_mul_ps(_mm_shuffle_ps(lhs, lhs, _MM_SHUFFLE(2, 3, 0, 1)), _mm_shuffle_ps(rhs, rhs, _MM_SHUFFLE(1, 2, 1, 2))));
+}
+
+} // namespace detail
+
+//blockwise inversion using 2x2 sub matrices
+//  | A B |           1    | X Y |
+//  | C D | ^ -1  = ----- * | Z W |
+//                   |M|
+//the inverse doesn't depend on the storage order, so the same code works for our row vector layout
+inline matrix<4, 4, float> inverse(const matrix<4, 4, float>& mat)
+{
+	__m128 const row0 = _mm_loadu_ps(mat.data[0]);
+	__m128 const row1 = _mm_loadu_ps(mat.data[1]);
+	__m128 const row2 = _mm_loadu_ps(mat.data[2]);
+	__m128 const row3 = _mm_loadu_ps(mat.data[3]);
+
+	//sub matrices
+	__m128 const A = _mm_movelh_ps(row0, row1);
+	__m128 const B = _mm_movehl_ps(row1, row0);
+	__m128 const C = _mm_movelh_ps(row2, row3);
+	__m128 const D = _mm_movehl_ps(row3, row2);
+
+	//determinants of the sub matrices as (|A|, |B|, |C|, |D|)
+	__m128 const detSub = _mm_sub_ps(
+		_mm_mul_ps(_mm_shuffle_ps(row0, row2, _MM_SHUFFLE(2, 0, 2, 0)), _mm_shuffle_ps(row1, row3, _MM_SHUFFLE(3, 1, 3, 1))),
+		_mm_mul_ps(_mm_shuffle_ps(row0, row2, _MM_SHUFFLE(3, 1, 3, 1)), _mm_shuffle_ps(row1, row3, _MM_SHUFFLE(2, 0, 2, 0))));
+	__m128 const detA = _mm_shuffle_ps(detSub, detSub, _MM_SHUFFLE(0, 0, 0, 0));
+	__m128 const detB = _mm_shuffle_ps(detSub, detSub, _MM_SHUFFLE(1, 1, 1, 1));
+	__m128 const detC = _mm_shuffle_ps(detSub, detSub, _MM_SHUFFLE(2, 2, 2, 2));
+	__m128 const detD = _mm_shuffle_ps(detSub, detSub, _MM_SHUFFLE(3, 3, 3, 3));
+
+	__m128 const adjDC = detail::Mat2AdjMul(D, C);
+	__m128 const adjAB = detail::Mat2AdjMul(A, B);
+
+	//adjugates of the result blocks
+	__m128 X = _mm_sub_ps(_mm_mul_ps(detD, A), detail::Mat2Mul(B, adjDC));
+	__m128 W = _mm_sub_ps(_mm_mul_ps(detA, D), detail::Mat2Mul(C, adjAB));
+	__m128 Y = _mm_sub_ps(_mm_mul_ps(detB, C), detail::Mat2MulAdj(D, adjAB));
+	__m128 Z = _mm_sub_ps(_mm_mul_ps(detC, B), detail::Mat2MulAdj(A, adjDC));
+
+	//|M| = |A|*|D| + |B|*|C| - trace(adjugate(A)B * adjugate(D)C)
+	__m128 trace = _mm_mul_ps(adjAB, _mm_shuffle_ps(adjDC, adjDC, _MM_SHUFFLE(3, 1, 2, 0)));
+	trace = _mm_add_ps(trace, _mm_shuffle_ps(trace, trace, _MM_SHUFFLE(2, 3, 0, 1)));
+	trace = _mm_add_ps(trace, _mm_shuffle_ps(trace, trace, _MM_SHUFFLE(1, 0, 3, 2)));
+
+	__m128 const detM = _mm_sub_ps(_mm_add_ps(_mm_mul_ps(detA, detD), _mm_mul_ps(detB, detC)), trace);
+
+	//like the generic version we don't check for a zero determinant
+	__m128 const rcpDetM = _mm_div_ps(_mm_setr_ps(1.f, -1.f, -1.f, 1.f), detM);
+
+	X = _mm_mul_ps(X, rcpDetM);
+	Y = _mm_mul_ps(Y, rcpDetM);
+	Z = _mm_mul_ps(Z, rcpDetM);
+	W = _mm_mul_ps(W, rcpDetM);
+
+	//apply the adjugate shuffle while storing the blocks
+	matrix<4, 4, float> result(uninitialized);
+	_mm_storeu_ps(result.data[0], _mm_shuffle_ps(X, Y, _MM_SHUFFLE(1, 3, 1, 3)));
+	_mm_storeu_ps(result.data[1], _mm_shuffle_ps(X, Y, _MM_SHUFFLE(0, 2, 0, 2)));
+	_mm_storeu_ps(result.data[2], _mm_shuffle_ps(Z, W, _MM_SHUFFLE(1, 3, 1, 3)));
+	_mm_storeu_ps(result.data[3], _mm_shuffle_ps(Z, W, _MM_SHUFFLE(0, 2, 0, 2)));
+	return result;
+}
+
+#endif // ETM_SIMD_SSE
+
+
 } // namespace math
 } // namespace et
\ No newline at end of file
@@ -81,6 +81,15 @@ quaternion<T> inverseSafe(const quaternion<T>& q);
 template <class T>
 std::ostream& operator<<( std::ostream& os, math::quaternion<T>& vec);
 
+//SIMD overloads
+//**************
+//non template overloads are preferred over the generic versions when the backend is enabled
+//normalization goes through the vec4 overload
+#if ETM_SIMD_SSE
+inline quaternion<float> operator*(const quaternion<float>& lhs, const quaternion<float>& rhs);
+inline vector<3, float> operator*(const quaternion<float>& q, const vector<3, float>& vec);
+#endif
+
 
 } // namespace math
 
@@ -231,5 +231,59 @@ std::ostream& operator<<(std::ostream& os, quaternion<T>& vec)
 	return os << vec.ToString();
 }
 
+
+//====================
+// SIMD
+//====================
+
+
+#if ETM_SIMD_SSE
+
+//Grassman product as lhs.w * rhs plus the lhs vector components times shuffled and sign flipped rhs components
+inline quaternion<float> operator*(const quaternion<float>& lhs, const quaternion<float>& rhs)
+{
+	__m128 const r = _mm_loadu_ps(rhs.data.data());
+
+	__m128 result = _mm_mul_ps(_mm_set1_ps(lhs.w), r);
+	result = _mm_add_ps(result, _mm_mul_ps(_mm_set1_ps(lhs.x),
+		_mm_mul_ps(_mm_shuffle_ps(r, r, _MM_SHUFFLE(0, 1, 2, 3)), _mm_setr_ps(1.f, -1.f, 1.f, -1.f))));
+	result = _mm_add_ps(result, _mm_mul_ps(_mm_set1_ps(lhs.y),
+		_mm_mul_ps(_mm_shuffle_ps(r, r, _MM_SHUFFLE(1, 0, 3, 2)), _mm_setr_ps(1.f, 1.f, -1.f, -1.f))));
+	result = _mm_add_ps(result, _mm_mul_ps(_mm_set1_ps(lhs.z),
+		_mm_mul_ps(_mm_shuffle_ps(r, r, _MM_SHUFFLE(2, 3, 0, 1)), _mm_setr_ps(-1.f, 1.f, 1.f, -1.f))));
+
+	quaternion<float> ret;
+	_mm_storeu_ps(ret.data.data(), result);
+	return ret;
+}
+
+//same formula as the generic version, the w lane of the vector is zero so it doesn't contribute to the dot and cross products
+inline vector<3, float> operator*(const quaternion<float>& q, const vector<3, float>& vec)
+{
+	__m128 const qv = _mm_loadu_ps(q.data.data());
+	__m128 const qw = _mm_set1_ps(q.w);
+	__m128 const v = _mm_setr_ps(vec.x, vec.y, vec.z, 0.f);
+
+	__m128 const qvW = _mm_mul_ps(qv, _mm_setr_ps(1.f, 1.f, 1.f, 0.f));
+	__m128 dot = _mm_mul_ps(qvW, v);
+	dot = _mm_add_ps(dot, _mm_shuffle_ps(dot, dot, _MM_SHUFFLE(2, 3, 0, 1)));
+	dot = _mm_add_ps(dot, _mm_shuffle_ps(dot, dot, _MM_SHUFFLE(1, 0, 3, 2)));
+
+	__m128 const cross = _mm_sub_ps(
+		_mm_mul_ps(_mm_shuffle_ps(qvW, qvW, _MM_SHUFFLE(3, 0, 2, 1)), _mm_shuffle_ps(v, v, _MM_SHUFFLE(3, 1, 0, 2))),
+		_mm_mul_ps(_mm_shuffle_ps(qvW, qvW, _MM_SHUFFLE(3, 1, 0, 2)), _mm_shuffle_ps(v, v, _MM_SHUFFLE(3, 0, 2, 1))));
+
+	__m128 const two = _mm_set1_ps(2.f);
+	__m128 result = _mm_mul_ps(_mm_sub_ps(_mm_mul_ps(two, _mm_mul_ps(qw, qw)), _mm_set1_ps(1.f)), v);
+	result = _mm_add_ps(result, _mm_mul_ps(two, _mm_add_ps(_mm_mul_ps(dot, qvW), _mm_mul_ps(qw, cross))));
+
+	float out[4];
+	_mm_storeu_ps(out, result);
+	return vector<3, float>(out[0], out[1], out[2]);
+}
+
+#endif // ETM_SIMD_SSE
+
+
 } // namespace math
 } // namespace et
\ No newline at end of file
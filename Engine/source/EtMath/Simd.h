@@ -0,0 +1,23 @@
+#pragma once
+
+
+// compile time switch for the SIMD implementations of float vec4, mat4 and quat operations
+//  - SSE2 is part of every x64 target, AVX is used when the compiler targets it (/arch:AVX or -mavx)
+//  - define ETM_NO_SIMD to fall back to the generic scalar templates, for example to compare results or on other architectures
+#if !defined(ETM_NO_SIMD) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2)))
+#	define ETM_SIMD_SSE 1
+#else
+#	define ETM_SIMD_SSE 0
+#endif
+
+#if ETM_SIMD_SSE && defined(__AVX__)
+#	define ETM_SIMD_AVX 1
+#else
+#	define ETM_SIMD_AVX 0
+#endif
+
+#if ETM_SIMD_AVX
+#	include <immintrin.h>
+#elif ETM_SIMD_SSE
+#	include <emmintrin.h>
+#endif
@@ -362,6 +362,13 @@ T angleFastAxis(const vector<3, T>& lhs, const vector<3, T>& rhs, vector<3, T> &
 template<class T>
 T angleSafeAxis(const vector<3, T>& lhs, const vector<3, T>& rhs, vector<3, T> &outAxis);
 
+//SIMD overloads
+//**************
+//non template overloads are preferred over the generic versions when the backend is enabled
+#if ETM_SIMD_SSE
+inline vector<4, float> normalize(const vector<4, float>& vec);
+#endif
+
 
 } // namespace math
 
@@ -686,5 +686,30 @@ T angleSafeAxis(const vector<3, T>& lhs, const vector<3, T>& rhs, vector<3, T> &
 }
 
 
+
+//====================
+// SIMD
+//====================
+
+
+#if ETM_SIMD_SSE
+
+inline vector<4, float> normalize(const vector<4, float>& vec)
+{
+	__m128 const v = _mm_loadu_ps(vec.data.data());
+
+	// dot product broadcast to all lanes
+	__m128 lenSq = _mm_mul_ps(v, v);
+	lenSq = _mm_add_ps(lenSq, _mm_shuffle_ps(lenSq, lenSq, _MM_SHUFFLE(2, 3, 0, 1)));
+	lenSq = _mm_add_ps(lenSq, _mm_shuffle_ps(lenSq, lenSq, _MM_SHUFFLE(1, 0, 3, 2)));
+
+	vector<4, float> result;
+	_mm_storeu_ps(result.data.data(), _mm_div_ps(v, _mm_sqrt_ps(lenSq)));
+	return result;
+}
+
+#endif // ETM_SIMD_SSE
+
+
 } // namespace math
 } // namespace et
\ No newline at end of file
@@ -27,7 +27,6 @@ DebugRenderer::~DebugRenderer()
 	I_GraphicsContextApi* const api = ContextHolder::GetRenderContext();
 
 	api->DeleteVertexArray(m_VAO);
-	api->DeleteBuffer(m_VBO);
 	m_Lines.clear();
 	m_MetaData.clear();
 }
@@ -45,25 +44,9 @@ void DebugRenderer::Initialize()
 
 	//Generate buffers and arrays
 	m_VAO = api->CreateVertexArray();
-	m_VBO = api->CreateBuffer();
+	m_Stream.Init(s_InitialStreamSize);
 
-	//bind
-	api->BindVertexArray(m_VAO);
-	api->BindBuffer(E_BufferType::Vertex, m_VBO);
-
-	//set data and attributes
-	api->SetBufferData(E_BufferType::Vertex, m_BufferSize, nullptr, E_UsageHint::Dynamic);
-
-	//input layout
-	api->SetVertexAttributeArrayEnabled(0, true);
-	api->SetVertexAttributeArrayEnabled(1, true);
-
-	api->DefineVertexAttributePointer(0, 3, E_DataType::Float, false, sizeof(LineVertex), offsetof(LineVertex, pos));
-	api->DefineVertexAttributePointer(1, 4, E_DataType::Float, false, sizeof(LineVertex), offsetof(LineVertex, col));
-
-	//unbind
-	api->BindBuffer(E_BufferType::Vertex, 0);
-	api->BindVertexArray(0);
+	LinkVertexArray();
 }
 
 
@@ -226,13 +209,13 @@ void DebugRenderer::DrawGrid(Camera const& camera, float pixelSpacingRad)
 	{
 		meta.start = m_MetaData[m_MetaData.size() - 1].start + m_MetaData[m_MetaData.size() - 1].size;
 	}
-	meta.size = (uint32)normalLines.size() * sizeof(LineVertex);
+	meta.size = (uint32)normalLines.size();
 	m_MetaData.push_back(meta);
 	m_Lines.insert(m_Lines.end(), normalLines.begin(), normalLines.end());
 
 	meta.thickness = thicknessHigher;
 	meta.start += meta.size;
-	meta.size = (uint32)thickLines.size() * sizeof(LineVertex);
+	meta.size = (uint32)thickLines.size();
 	m_MetaData.push_back(meta);
 	m_Lines.insert(m_Lines.end(), thickLines.begin(), thickLines.end());
 }
@@ -252,7 +235,7 @@ void DebugRenderer::Draw(Camera const& camera)
 	api->SetShader(m_Shader.get());
 	m_Shader->Upload("uViewProj"_hash, camera.GetViewProj());
 
-	UpdateBuffer();
+	uint32 const firstVertex = UpdateBuffer();
 
 	api->SetBlendEnabled(true);
 	api->SetBlendEquation(E_BlendEquation::Add);
@@ -261,13 +244,15 @@ void DebugRenderer::Draw(Camera const& camera)
 	for (const auto& meta : m_MetaData)
 	{
 		api->SetLineWidth(meta.thickness);
-		api->DrawArrays(E_DrawMode::Lines, meta.start, meta.size);
+		api->DrawArrays(E_DrawMode::Lines, firstVertex + meta.start, meta.size);
 	}
 
 	api->BindVertexArray(0);
 
 	api->SetBlendEnabled(false);
 
+	m_Stream.EndFrame();
+
 	m_Lines.clear();
 	m_MetaData.clear();
 }
@@ -275,35 +260,50 @@ void DebugRenderer::Draw(Camera const& camera)
 //-----------------------------
 // DebugRenderer::UpdateBuffer
 //
-void DebugRenderer::UpdateBuffer()
+// Write this frames lines into the stream buffer and bind the vertex array that reads from it
+//
+uint32 DebugRenderer::UpdateBuffer()
 {
-	I_GraphicsContextApi* const api = ContextHolder::GetRenderContext();
+	size_t const size = m_Lines.size() * sizeof(LineVertex);
+	size_t const offset = m_Stream.Allocate(size, sizeof(LineVertex));
+	m_Stream.Write(offset, m_Lines.data(), size);
 
-	//Bind Object vertex array
-	api->BindVertexArray(m_VAO);
+	// the stream may have moved to a larger buffer
+	if (m_Stream.GetBuffer() != m_LinkedBuffer)
+	{
+		LinkVertexArray();
+	}
 
-	//Send the vertex buffer again
-	api->BindBuffer(E_BufferType::Vertex, m_VBO);
+	ContextHolder::GetRenderContext()->BindVertexArray(m_VAO);
 
-	bool bufferResize = m_Lines.size() * sizeof(LineVertex) > m_BufferSize;
-	if (!m_VBO || bufferResize) //first creation or resize
-	{
-		if (bufferResize)
-		{
-			m_BufferSize = (uint32)m_Lines.size() * sizeof(LineVertex);
-		}
+	return static_cast<uint32>(offset / sizeof(LineVertex));
+}
 
-		api->SetBufferData(E_BufferType::Vertex, m_BufferSize, m_Lines.data(), E_UsageHint::Dynamic);
-	}
-	else
-	{
-		void* p = api->MapBuffer(E_BufferType::Vertex, E_AccessMode::Write);
-		memcpy(p, m_Lines.data(), sizeof(LineVertex)*m_Lines.size());
-		api->UnmapBuffer(E_BufferType::Vertex);
-	}
+//--------------------------------
+// DebugRenderer::LinkVertexArray
+//
+// Point the input layout to the current stream buffer
+//
+void DebugRenderer::LinkVertexArray()
+{
+	I_GraphicsContextApi* const api = ContextHolder::GetRenderContext();
 
+	//bind
+	api->BindVertexArray(m_VAO);
+	api->BindBuffer(E_BufferType::Vertex, m_Stream.GetBuffer());
 
+	//input layout
+	api->SetVertexAttributeArrayEnabled(0, true);
+	api->SetVertexAttributeArrayEnabled(1, true);
+
+	api->DefineVertexAttributePointer(0, 3, E_DataType::Float, false, sizeof(LineVertex), offsetof(LineVertex, pos));
+	api->DefineVertexAttributePointer(1, 4, E_DataType::Float, false, sizeof(LineVertex), offsetof(LineVertex, col));
+
+	//unbind
 	api->BindBuffer(E_BufferType::Vertex, 0);
+	api->BindVertexArray(0);
+
+	m_LinkedBuffer = m_Stream.GetBuffer();
 }
 
 //------------------------------
@@ -320,7 +320,7 @@ void DebugRenderer::CheckMetaData(float thickness)
 			m_MetaData[m_MetaData.size() - 1].start = m_MetaData[m_MetaData.size() - 2].start + m_MetaData[m_MetaData.size() - 2].size;
 		}
 	}
-	m_MetaData[m_MetaData.size() - 1].size += sizeof(LineVertex) * 2;
+	m_MetaData[m_MetaData.size() - 1].size += 2;
 }
 
 
@@ -5,6 +5,8 @@
 
 #include <EtCore/Content/AssetPointer.h>
 
+#include <EtRendering/GraphicsTypes/StreamingBuffer.h>
+
 
 namespace et {
 namespace render {
@@ -22,9 +24,6 @@ class DebugRenderer final
 {
 	// definitions
 	//-------------
-private:
-	friend class ShadedSceneRenderer;
-
 	struct LineVertex
 	{
 		LineVertex(vec3 p, vec4 c) :pos(p), col(c) {}
@@ -34,12 +33,15 @@ private:
 	struct LineMetaData
 	{
 		float thickness = 1;
-		uint32 start = 0;
+		uint32 start = 0; // in vertices
 		uint32 size = 0;
 	};
 
+	static constexpr size_t s_InitialStreamSize = 64u * 1024u; // bytes per frame
+
 	// contruct destruct
 	//-------------------
+public:
 	DebugRenderer() = default;
 	~DebugRenderer();
 
@@ -47,18 +49,18 @@ private:
 
 	// functionality
 	//---------------
-public:
 	void DrawLine(vec3 start, vec3 end, vec4 col = vec4(1), float thickness = 1);
 	void DrawLine(vec3 start, vec4 startCol, vec3 end, vec4 endCol, float thickness = 1);
 
 	void DrawGrid(Camera const& camera, float pixelSpacingRad = math::radians(75));
 
-private:
 	void Draw(Camera const& camera); // actually render to GPU
 
 	// utility
 	//---------
-	void UpdateBuffer();
+private:
+	uint32 UpdateBuffer(); // returns the first vertex
+	void LinkVertexArray();
 	void CheckMetaData(float thickness);
 
 
@@ -67,9 +69,9 @@ private:
 
 	//Linebuffer
 	std::vector<LineVertex> m_Lines;
-	uint32 m_BufferSize = 0;
+	StreamingBuffer m_Stream;
 	T_ArrayLoc m_VAO = 0;
-	T_BufferLoc m_VBO = 0;
+	T_BufferLoc m_LinkedBuffer = 0; // stream buffer the VAO reads from
 
 	//Metadata
 	std::vector<LineMetaData> m_MetaData;
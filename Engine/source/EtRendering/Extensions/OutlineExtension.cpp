@@ -39,11 +39,12 @@ void OutlineExtension::AddMesh(AssetPtr<MeshData> const mesh, render::T_NodeId c
 
 	// get the VAO of our mesh associated with the color material
 	T_ArrayLoc const vao = mesh->GetSurface(RenderingSystems::Instance()->GetColorMaterial())->GetVertexArray();
+	size_t const indexOffset = mesh->GetIndexOffset();
 
-	// try finding an existing mesh with the VAO
-	auto foundMeshIt = std::find_if(listIt->meshes.begin(), listIt->meshes.end(), [vao](render::MaterialCollection::Mesh const& meshInst)
+	// try finding an existing mesh with the VAO and index range
+	auto foundMeshIt = std::find_if(listIt->meshes.begin(), listIt->meshes.end(), [vao, indexOffset](render::MaterialCollection::Mesh const& meshInst)
 		{
-			return meshInst.m_VAO == vao;
+			return ((meshInst.m_VAO == vao) && (meshInst.m_IndexOffset == indexOffset));
 		});
 
 	// if none was found, create that meshes draw data
@@ -53,8 +54,11 @@ void OutlineExtension::AddMesh(AssetPtr<MeshData> const mesh, render::T_NodeId c
 		foundMeshIt = std::prev(listIt->meshes.end());
 
 		foundMeshIt->m_VAO = vao;
+		foundMeshIt->m_InstanceBuffer = 0u;
 		foundMeshIt->m_IndexCount = static_cast<uint32>(mesh->GetIndexCount());
 		foundMeshIt->m_IndexDataType = mesh->GetIndexDataType();
+		foundMeshIt->m_IndexOffset = indexOffset;
+		foundMeshIt->m_BaseVertex = mesh->GetBaseVertex();
 		foundMeshIt->m_BoundingVolume = mesh->GetBoundingSphere();
 	}
 
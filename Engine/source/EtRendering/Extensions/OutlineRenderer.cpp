@@ -172,6 +172,7 @@ void OutlineRenderer::Draw(T_FbLoc const targetFb,
 	ShaderData const* const shader = mat->GetShader();
 
 	api->SetShader(shader);
+	mat->UploadParameters();
 	shader->Upload("uViewSize"_hash, math::vecCast<float>(dim));
 
 	shader->Upload("uOcclusionFactor"_hash, 0.15f);
@@ -195,7 +196,11 @@ void OutlineRenderer::Draw(T_FbLoc const targetFb,
 				if (cam.GetFrustum().ContainsSphere(instSphere) != VolumeCheck::OUTSIDE)
 				{
 					shader->Upload("model"_hash, transform);
-					api->DrawElements(E_DrawMode::Triangles, mesh.m_IndexCount, mesh.m_IndexDataType, 0);
+					api->DrawElementsBaseVertex(E_DrawMode::Triangles,
+						mesh.m_IndexCount,
+						mesh.m_IndexDataType,
+						reinterpret_cast<void const*>(static_cast<uintptr_t>(mesh.m_IndexOffset)),
+						mesh.m_BaseVertex);
 				}
 			}
 		}
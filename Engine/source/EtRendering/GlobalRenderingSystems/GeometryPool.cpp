@@ -0,0 +1,266 @@
+#include "stdafx.h"
+#include "GeometryPool.h"
+
+#include <EtRendering/MaterialSystem/MaterialData.h>
+
+
+namespace et {
+namespace render {
+
+
+//===============
+// Geometry Pool
+//===============
+
+
+// static
+uint32 GeometryPool::s_NextGeneration = 1u;
+
+
+//---------------------------------
+// GeometryPool::d-tor
+//
+GeometryPool::~GeometryPool()
+{
+	Deinit();
+}
+
+//---------------------------------
+// GeometryPool::Deinit
+//
+// Free all pages, any allocations that are still around become invalid and can be released without effect
+//
+void GeometryPool::Deinit()
+{
+	while (!m_Pages.empty())
+	{
+		DestroyPage(m_Pages.ids()[0]);
+	}
+
+	m_Generation = s_NextGeneration++;
+}
+
+//---------------------------------
+// GeometryPool::Allocate
+//
+// Place geometry in the first page with a matching layout that has space for it, or start a new page.
+// Index data is expected to be relative to the first vertex of the mesh
+//
+GeometryPool::Allocation GeometryPool::Allocate(T_VertexFlags const flags,
+	size_t const vertexCount,
+	void const* const vertexData,
+	size_t const indexSize,
+	void const* const indexData)
+{
+	ET_ASSERT(vertexCount > 0u);
+	ET_ASSERT(indexSize > 0u);
+
+	size_t const alignedIndexSize = (indexSize + s_IndexAlignment - 1u) & ~(s_IndexAlignment - 1u);
+
+	Allocation allocation;
+
+	// try fitting the geometry into an existing page
+	for (auto pageIt = m_Pages.begin(); pageIt != m_Pages.end(); ++pageIt)
+	{
+		Page& page = *pageIt;
+		if (page.flags != flags)
+		{
+			continue;
+		}
+
+		size_t const baseVertex = page.vertices.Allocate(vertexCount);
+		if (baseVertex == core::RangeAllocator::s_InvalidOffset)
+		{
+			continue;
+		}
+
+		size_t const indexOffset = page.indices.Allocate(alignedIndexSize);
+		if (indexOffset == core::RangeAllocator::s_InvalidOffset)
+		{
+			page.vertices.Release(baseVertex, vertexCount);
+			continue;
+		}
+
+		allocation.page = m_Pages.iterator_id(pageIt);
+		allocation.baseVertex = baseVertex;
+		allocation.indexOffset = indexOffset;
+		break;
+	}
+
+	// otherwise start a new one - geometry that is larger than a page gets a page of its own
+	if (!allocation.IsValid())
+	{
+		size_t const vertexCapacity = std::max(m_PageVertexSize / AttributeDescriptor::GetVertexSize(flags), vertexCount);
+		size_t const indexCapacity = std::max(m_PageIndexSize, alignedIndexSize);
+
+		allocation.page = CreatePage(flags, vertexCapacity, indexCapacity);
+
+		Page& page = m_Pages[allocation.page];
+		allocation.baseVertex = page.vertices.Allocate(vertexCount);
+		allocation.indexOffset = page.indices.Allocate(alignedIndexSize);
+	}
+
+	allocation.generation = m_Generation;
+	allocation.vertexCount = vertexCount;
+	allocation.indexSize = alignedIndexSize;
+
+	// upload
+	Page& page = m_Pages[allocation.page];
+	page.allocationCount++;
+
+	I_GraphicsContextApi* const api = ContextHolder::GetRenderContext();
+
+	// make sure we don't modify the index buffer binding of whichever vertex array is bound
+	api->BindVertexArray(0u);
+
+	api->BindBuffer(E_BufferType::Vertex, page.vertexBuffer);
+	api->SetBufferSubData(E_BufferType::Vertex,
+		static_cast<int64>(allocation.baseVertex * page.vertexSize),
+		static_cast<int64>(vertexCount * page.vertexSize),
+		vertexData);
+
+	api->BindBuffer(E_BufferType::Index, page.indexBuffer);
+	api->SetBufferSubData(E_BufferType::Index, static_cast<int64>(allocation.indexOffset), static_cast<int64>(indexSize), indexData);
+
+	return allocation;
+}
+
+//---------------------------------
+// GeometryPool::Release
+//
+// Return the ranges of an allocation to its page, pages that end up empty are freed
+//  - allocations that were already freed by deinitializing their pool are only reset
+//
+void GeometryPool::Release(Allocation& allocation)
+{
+	ET_ASSERT(allocation.IsValid());
+
+	if (allocation.generation != m_Generation)
+	{
+		allocation = Allocation();
+		return;
+	}
+
+	Page& page = m_Pages[allocation.page];
+	ET_ASSERT(page.allocationCount > 0u);
+
+	page.vertices.Release(allocation.baseVertex, allocation.vertexCount);
+	page.indices.Release(allocation.indexOffset, allocation.indexSize);
+
+	page.allocationCount--;
+	if (page.allocationCount == 0u)
+	{
+		DestroyPage(allocation.page);
+	}
+
+	allocation = Allocation();
+}
+
+//---------------------------------
+// GeometryPool::GetSurface
+//
+// Retrieves (and potentially creates) the vertex array for drawing a page with the material in question.
+// The reference is valid until the next surface is created
+//
+GeometryPool::Surface const& GeometryPool::GetSurface(T_PageId const pageId, Material const* const material)
+{
+	ET_ASSERT(material != nullptr);
+
+	Page& page = m_Pages[pageId];
+
+	// try finding the existing surface
+	auto const surfaceIt = std::find_if(page.surfaces.cbegin(), page.surfaces.cend(), [material](Surface const& surface)
+		{
+			return (surface.material == material);
+		});
+
+	if (surfaceIt != page.surfaces.cend())
+	{
+		return *surfaceIt;
+	}
+
+	// if it isn't found, create a new vertex array and link it to the pages buffers
+	I_GraphicsContextApi* const api = ContextHolder::GetRenderContext();
+
+	Surface surface;
+	surface.material = material;
+
+	surface.vertexArray = api->CreateVertexArray();
+	api->BindVertexArray(surface.vertexArray);
+
+	api->BindBuffer(E_BufferType::Vertex, page.vertexBuffer);
+	api->BindBuffer(E_BufferType::Index, page.indexBuffer);
+
+	//Specify Input Layout
+	AttributeDescriptor::DefineAttributeArray(page.flags, material->GetLayoutFlags(), material->GetAttributeLocations());
+
+	// transforms for instanced drawing live in their own buffer, which is filled each time a mesh is drawn
+	if (material->SupportsInstancing())
+	{
+		surface.instanceBuffer = api->CreateBuffer();
+		api->BindBuffer(E_BufferType::Vertex, surface.instanceBuffer);
+		AttributeDescriptor::DefineInstanceTransformArray(material->GetInstanceTransformLocation());
+	}
+
+	api->BindVertexArray(0u);
+
+	page.surfaces.push_back(surface);
+	return page.surfaces.back();
+}
+
+//---------------------------------
+// GeometryPool::CreatePage
+//
+// Reserve GPU storage for a page, which is filled as geometry is allocated
+//
+GeometryPool::T_PageId GeometryPool::CreatePage(T_VertexFlags const flags, size_t const vertexCapacity, size_t const indexCapacity)
+{
+	I_GraphicsContextApi* const api = ContextHolder::GetRenderContext();
+
+	Page page;
+	page.flags = flags;
+	page.vertexSize = AttributeDescriptor::GetVertexSize(flags);
+	page.vertices = core::RangeAllocator(vertexCapacity);
+	page.indices = core::RangeAllocator(indexCapacity);
+
+	api->BindVertexArray(0u);
+
+	page.vertexBuffer = api->CreateBuffer();
+	api->BindBuffer(E_BufferType::Vertex, page.vertexBuffer);
+	api->SetBufferData(E_BufferType::Vertex, static_cast<int64>(vertexCapacity * page.vertexSize), nullptr, E_UsageHint::Static);
+
+	page.indexBuffer = api->CreateBuffer();
+	api->BindBuffer(E_BufferType::Index, page.indexBuffer);
+	api->SetBufferData(E_BufferType::Index, static_cast<int64>(indexCapacity), nullptr, E_UsageHint::Static);
+
+	return m_Pages.insert(std::move(page)).second;
+}
+
+//---------------------------------
+// GeometryPool::DestroyPage
+//
+// Free the GPU buffers and vertex arrays of a page
+//
+void GeometryPool::DestroyPage(T_PageId const pageId)
+{
+	I_GraphicsContextApi* const api = ContextHolder::GetRenderContext();
+
+	Page& page = m_Pages[pageId];
+	for (Surface& surface : page.surfaces)
+	{
+		api->DeleteVertexArray(surface.vertexArray);
+		if (surface.instanceBuffer != 0u)
+		{
+			api->DeleteBuffer(surface.instanceBuffer);
+		}
+	}
+
+	api->DeleteBuffer(page.vertexBuffer);
+	api->DeleteBuffer(page.indexBuffer);
+
+	m_Pages.erase(pageId);
+}
+
+
+} // namespace render
+} // namespace et
@@ -0,0 +1,138 @@
+#pragma once
+#include <EtRendering/GraphicsContext/GraphicsTypes.h>
+#include <EtRendering/GraphicsTypes/VertexInfo.h>
+
+#include <EtCore/Containers/slot_map.h>
+#include <EtCore/Memory/RangeAllocator.h>
+
+
+// forward declarations
+namespace et {
+namespace render {
+	class Material;
+} }
+
+
+namespace et {
+namespace render {
+
+
+//---------------------------------
+// GeometryPool
+//
+// Suballocates mesh geometry from a few large vertex and index buffers, grouped into pages by vertex layout
+//  - all meshes within a page share one vertex array per material, so they can be drawn without switching vertex arrays
+//  - meshes are drawn with a byte offset into the index buffer and a base vertex into the vertex buffer
+//  - page buffers are never reallocated, so vertex arrays stay valid, instead a new page is started once one is full
+//
+class GeometryPool final
+{
+	// definitions
+	//-------------
+public:
+	typedef core::T_SlotId T_PageId;
+
+	static constexpr size_t s_DefaultPageVertexSize = 16u * 1024u * 1024u; // bytes
+	static constexpr size_t s_DefaultPageIndexSize = 8u * 1024u * 1024u;
+
+	//---------------------------------
+	// GeometryPool::Allocation
+	//
+	// Where a meshes geometry lives within the pool
+	//
+	struct Allocation
+	{
+		T_PageId page = core::INVALID_SLOT_ID;
+		uint32 generation = 0u; // of the pool at the time of allocating
+
+		size_t baseVertex = 0u;
+		size_t vertexCount = 0u;
+
+		size_t indexOffset = 0u; // bytes
+		size_t indexSize = 0u;
+
+		bool IsValid() const { return (page != core::INVALID_SLOT_ID); }
+	};
+
+	//---------------------------------
+	// GeometryPool::Surface
+	//
+	// Vertex array that links a pages buffers to the attribute layout of a material
+	//
+	struct Surface
+	{
+		Material const* material = nullptr;
+		T_ArrayLoc vertexArray = 0u;
+		T_BufferLoc instanceBuffer = 0u; // per instance transforms, only if the material supports instancing
+	};
+
+private:
+	//---------------------------------
+	// GeometryPool::Page
+	//
+	struct Page
+	{
+		T_VertexFlags flags = 0u;
+		size_t vertexSize = 0u;
+
+		T_BufferLoc vertexBuffer = 0u;
+		T_BufferLoc indexBuffer = 0u;
+
+		core::RangeAllocator vertices; // in vertices
+		core::RangeAllocator indices; // in bytes
+
+		std::vector<Surface> surfaces;
+		size_t allocationCount = 0u;
+	};
+
+	// index ranges are aligned so that any index type can be read from their offset
+	static constexpr size_t s_IndexAlignment = 4u;
+
+	static uint32 s_NextGeneration; // unique across pools, so that allocations can't be released into a pool they don't belong to
+
+	// construct destruct
+	//--------------------
+public:
+	GeometryPool(size_t const pageVertexSize = s_DefaultPageVertexSize, size_t const pageIndexSize = s_DefaultPageIndexSize)
+		: m_PageVertexSize(pageVertexSize)
+		, m_PageIndexSize(pageIndexSize)
+		, m_Generation(s_NextGeneration++)
+	{}
+	~GeometryPool();
+
+	void Deinit();
+
+	// functionality
+	//---------------
+	Allocation Allocate(T_VertexFlags const flags,
+		size_t const vertexCount,
+		void const* const vertexData,
+		size_t const indexSize,
+		void const* const indexData);
+	void Release(Allocation& allocation);
+
+	Surface const& GetSurface(T_PageId const page, Material const* const material);
+
+	// accessors
+	//-----------
+	size_t GetPageCount() const { return static_cast<size_t>(m_Pages.size()); }
+
+	// utility
+	//---------
+private:
+	T_PageId CreatePage(T_VertexFlags const flags, size_t const vertexCapacity, size_t const indexCapacity);
+	void DestroyPage(T_PageId const page);
+
+	// Data
+	///////
+
+	size_t m_PageVertexSize;
+	size_t m_PageIndexSize;
+
+	core::slot_map<Page> m_Pages;
+	uint32 m_Generation; // changes when all pages are freed at once
+};
+
+
+} // namespace render
+} // namespace et
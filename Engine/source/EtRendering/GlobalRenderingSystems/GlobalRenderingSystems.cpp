@@ -120,6 +120,7 @@ void RenderingSystems::RemoveReference()
 void RenderingSystems::Initialize()
 {
 	m_SharedVarController.Init();
+	m_MaterialBlockBuffer.Init();
 
 	m_AtmospherePrecompute.Init();
 
@@ -128,6 +129,7 @@ void RenderingSystems::Initialize()
 
 	m_NullMaterial = core::ResourceManager::Instance()->GetAssetData<Material>(core::HashString("Materials/M_Null.json"));
 	m_ColorMaterial = core::ResourceManager::Instance()->GetAssetData<Material>(core::HashString("Materials/M_Color.json"));
+	m_ShadowMaterial = core::ResourceManager::Instance()->GetAssetData<Material>(core::HashString("Materials/M_Shadow.json"));
 
 	m_Patch.Init(4);
 
@@ -7,6 +7,8 @@
 #include "CIE.h"
 #include "LightVolume.h"
 #include "SharedVarController.h"
+#include "MaterialBlockBuffer.h"
+#include "GeometryPool.h"
 #include "RenderDebugVars.h"
 
 #include <EtRendering/MaterialSystem/MaterialData.h>
@@ -36,6 +38,7 @@ private:
 	//------------
 public:
 	static RenderingSystems* Instance();
+	static bool IsInitialized() { return (s_Instance != nullptr); }
 
 	static void AddReference(GraphicsSettings const& settings);
 	static void AddReference();
@@ -61,6 +64,8 @@ public:
 	PrimitiveRenderer& GetPrimitiveRenderer() { return m_PrimitiveRenderer; }
 	PbrPrefilter& GetPbrPrefilter() { return m_PbrPrefilter; }
 	SharedVarController& GetSharedVarController() { return m_SharedVarController; }
+	MaterialBlockBuffer& GetMaterialBlockBuffer() { return m_MaterialBlockBuffer; }
+	GeometryPool& GetGeometryPool() { return m_GeometryPool; }
 	CIE& GetCie() { return m_Cie; }
 	DirectLightVolume& GetDirectLightVolume() { return m_DirectLightVolume; }
 	PointLightVolume& GetPointLightVolume() { return m_PointLightVolume; }
@@ -68,6 +73,7 @@ public:
 	Patch& GetPatch() { return m_Patch; }
 	Material const* GetNullMaterial() const { return m_NullMaterial.get(); }
 	Material const* GetColorMaterial() const { return m_ColorMaterial.get(); }
+	Material const* GetShadowMaterial() const { return m_ShadowMaterial.get(); }
 
 #if ET_CT_IS_ENABLED(ET_CT_DBG_UTIL)
 	DebugVars const& GetDebugVars() const { return m_DebugVars; }
@@ -84,6 +90,8 @@ private:
 	PbrPrefilter m_PbrPrefilter;
 
 	SharedVarController m_SharedVarController;
+	MaterialBlockBuffer m_MaterialBlockBuffer;
+	GeometryPool m_GeometryPool;
 
 	CIE m_Cie;
 
@@ -95,6 +103,7 @@ private:
 
 	AssetPtr<Material> m_NullMaterial;
 	AssetPtr<Material> m_ColorMaterial;
+	AssetPtr<Material> m_ShadowMaterial; // depth only, with instanced transforms
 
 #if ET_CT_IS_ENABLED(ET_CT_DBG_UTIL)
 	DebugVars m_DebugVars;
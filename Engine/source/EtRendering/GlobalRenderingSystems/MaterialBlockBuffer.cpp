@@ -0,0 +1,201 @@
+#include "stdafx.h"
+#include "MaterialBlockBuffer.h"
+
+
+namespace et {
+namespace render {
+
+
+//=======================
+// Material Block Buffer
+//=======================
+
+
+//----------------------------
+// MaterialBlockBuffer::d-tor
+//
+MaterialBlockBuffer::~MaterialBlockBuffer()
+{
+	if (m_IsInitialized)
+	{
+		Deinit();
+	}
+}
+
+//-----------------------------
+// MaterialBlockBuffer::Init
+//
+// The GPU storage is only allocated once the first block is flushed
+//
+void MaterialBlockBuffer::Init()
+{
+	m_BufferLocation = ContextHolder::GetRenderContext()->CreateBuffer();
+	m_IsInitialized = true;
+}
+
+//-----------------------------
+// MaterialBlockBuffer::Deinit
+//
+void MaterialBlockBuffer::Deinit()
+{
+	ContextHolder::GetRenderContext()->DeleteBuffer(m_BufferLocation);
+	m_BufferSize = 0u;
+
+	m_IsInitialized = false;
+}
+
+//-------------------------------
+// MaterialBlockBuffer::Allocate
+//
+// Reserve a zero initialized range for a block of the given size, reusing released ranges where possible
+//
+MaterialBlockBuffer::T_BlockId MaterialBlockBuffer::Allocate(size_t const size)
+{
+	ET_ASSERT(size > 0u);
+
+	Range range{ 0u, (size + s_BlockAlignment - 1u) & ~(s_BlockAlignment - 1u) };
+	range.offset = m_Allocator.Allocate(range.size);
+	ET_ASSERT(range.offset != core::RangeAllocator::s_InvalidOffset);
+
+	if (range.offset + range.size > m_Data.size())
+	{
+		m_Data.resize(range.offset + range.size, 0u);
+	}
+
+	memset(m_Data.data() + range.offset, 0, range.size);
+
+	T_BlockId block;
+	if (m_FreeIds.empty())
+	{
+		block = static_cast<T_BlockId>(m_Blocks.size());
+		m_Blocks.push_back(range);
+	}
+	else
+	{
+		block = m_FreeIds.back();
+		m_FreeIds.pop_back();
+		m_Blocks[block] = range;
+	}
+
+	MarkDirty(range);
+	return block;
+}
+
+//------------------------------
+// MaterialBlockBuffer::Release
+//
+// Return the blocks range so that it can be reused by later allocations
+//
+void MaterialBlockBuffer::Release(T_BlockId& block)
+{
+	ET_ASSERT(block < m_Blocks.size());
+
+	Range& range = m_Blocks[block];
+	m_Allocator.Release(range.offset, range.size);
+	range.size = 0u;
+
+	m_FreeIds.push_back(block);
+
+	if (m_BoundBlock == block)
+	{
+		m_BoundBlock = s_InvalidBlock;
+	}
+
+	block = s_InvalidBlock;
+}
+
+//----------------------------
+// MaterialBlockBuffer::Write
+//
+// Access the CPU copy of a block in order to pack parameters into it
+//
+uint8* MaterialBlockBuffer::Write(T_BlockId const block)
+{
+	ET_ASSERT(block < m_Blocks.size());
+	ET_ASSERT(m_Blocks[block].size > 0u, "Writing to a released block");
+
+	Range const& range = m_Blocks[block];
+	MarkDirty(range);
+
+	return m_Data.data() + range.offset;
+}
+
+//----------------------------
+// MaterialBlockBuffer::Flush
+//
+// Upload the range that changed since the last flush, or reallocate the GPU storage if the buffer grew
+//
+void MaterialBlockBuffer::Flush()
+{
+	if (!IsDirty())
+	{
+		return;
+	}
+
+	ET_ASSERT(m_IsInitialized);
+
+	I_GraphicsContextApi* const api = ContextHolder::GetRenderContext();
+
+	api->BindBuffer(E_BufferType::Uniform, m_BufferLocation);
+	if (m_Data.size() > m_BufferSize)
+	{
+		api->SetBufferData(E_BufferType::Uniform, static_cast<int64>(m_Data.size()), m_Data.data(), E_UsageHint::Dynamic);
+		m_BufferSize = m_Data.size();
+		m_BoundBlock = s_InvalidBlock;
+	}
+	else
+	{
+		api->SetBufferSubData(E_BufferType::Uniform,
+			static_cast<int64>(m_DirtyBegin),
+			static_cast<int64>(m_DirtyEnd - m_DirtyBegin),
+			m_Data.data() + m_DirtyBegin);
+	}
+
+	api->BindBuffer(E_BufferType::Uniform, 0u);
+
+	m_DirtyBegin = 0u;
+	m_DirtyEnd = 0u;
+}
+
+//---------------------------
+// MaterialBlockBuffer::Bind
+//
+// Make a block the source of the material uniform block for following draw calls
+//
+void MaterialBlockBuffer::Bind(T_BlockId const block)
+{
+	ET_ASSERT(block < m_Blocks.size());
+
+	Flush();
+
+	if (block == m_BoundBlock)
+	{
+		return;
+	}
+
+	Range const& range = m_Blocks[block];
+	ContextHolder::GetRenderContext()->BindBufferRange(E_BufferType::Uniform, m_BufferBinding, m_BufferLocation, range.offset, range.size);
+
+	m_BoundBlock = block;
+}
+
+//--------------------------------
+// MaterialBlockBuffer::MarkDirty
+//
+void MaterialBlockBuffer::MarkDirty(Range const& range)
+{
+	if (IsDirty())
+	{
+		m_DirtyBegin = std::min(m_DirtyBegin, range.offset);
+		m_DirtyEnd = std::max(m_DirtyEnd, range.offset + range.size);
+	}
+	else
+	{
+		m_DirtyBegin = range.offset;
+		m_DirtyEnd = range.offset + range.size;
+	}
+}
+
+
+} // namespace render
+} // namespace et
@@ -0,0 +1,95 @@
+#pragma once
+#include <EtRendering/GraphicsContext/GraphicsTypes.h>
+
+#include <EtCore/Memory/RangeAllocator.h>
+
+
+namespace et {
+namespace render {
+
+
+//---------------------------------
+// MaterialBlockBuffer
+//
+// Single uniform buffer that holds the std140 packed parameters of all materials with a material block
+//  - binding a material is a single buffer range bind instead of uploading each of its uniforms
+//  - a CPU copy is kept so that only the range that changed since the last flush has to be uploaded
+//
+class MaterialBlockBuffer final
+{
+	// definitions
+	//-------------
+public:
+	typedef uint32 T_BlockId;
+	static constexpr T_BlockId s_InvalidBlock = std::numeric_limits<T_BlockId>::max();
+
+private:
+	//---------------------------------
+	// MaterialBlockBuffer::Range
+	//
+	struct Range
+	{
+		size_t offset;
+		size_t size;
+	};
+
+	// largest GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT the spec allows, so that block offsets are valid on any device
+	static constexpr size_t s_BlockAlignment = 256u;
+
+	// construct destruct
+	//--------------------
+public:
+	MaterialBlockBuffer() = default;
+	~MaterialBlockBuffer();
+
+	void Init();
+	void Deinit();
+
+	// functionality
+	//---------------
+	T_BlockId Allocate(size_t const size);
+	void Release(T_BlockId& block);
+
+	uint8* Write(T_BlockId const block); // marks the block dirty, the returned memory is valid until the next allocation
+
+	void Flush();
+	void Bind(T_BlockId const block);
+
+	// accessors
+	//-----------
+	uint32 GetBufferBinding() const { return m_BufferBinding; }
+	std::string const& GetBlockName() const { return m_UniformBlockName; }
+
+	size_t GetSize() const { return m_Data.size(); }
+	bool IsDirty() const { return (m_DirtyBegin < m_DirtyEnd); }
+
+	// utility
+	//---------
+private:
+	void MarkDirty(Range const& range);
+
+	// Data
+	///////
+
+	bool m_IsInitialized = false;
+
+	T_BufferLoc m_BufferLocation = 0u;
+	size_t m_BufferSize = 0u; // size of the GPU storage, may lag behind the CPU copy until the next flush
+
+	std::vector<uint8> m_Data; // never shrinks, so that the GPU storage doesn't need to be reallocated when blocks are reused
+	core::RangeAllocator m_Allocator;
+	std::vector<Range> m_Blocks; // addressed by block ID
+	std::vector<T_BlockId> m_FreeIds;
+
+	size_t m_DirtyBegin = 0u;
+	size_t m_DirtyEnd = 0u;
+
+	T_BlockId m_BoundBlock = s_InvalidBlock;
+
+	std::string m_UniformBlockName = "MaterialParameters";
+	uint32 m_BufferBinding = 1u; // shared variables use binding 0
+};
+
+
+} // namespace render
+} // namespace et
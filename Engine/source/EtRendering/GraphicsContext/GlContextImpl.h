@@ -175,6 +175,24 @@ public:
 		E_DataType const type, 
 		const void * indices, 
 		uint32 const primcount) override;
+	void DrawElementsBaseVertex(E_DrawMode const mode,
+		uint32 const count,
+		E_DataType const type,
+		const void * indices,
+		int32 const baseVertex) override;
+	void DrawElementsInstancedBaseVertex(E_DrawMode const mode,
+		uint32 const count,
+		E_DataType const type,
+		const void * indices,
+		uint32 const primcount,
+		int32 const baseVertex) override;
+	void DrawElementsInstancedBaseVertexBaseInstance(E_DrawMode const mode,
+		uint32 const count,
+		E_DataType const type,
+		const void * indices,
+		uint32 const primcount,
+		int32 const baseVertex,
+		uint32 const baseInstance) override;
 
 	// other commands
 	//--------------
@@ -182,6 +200,10 @@ public:
 	void Finish() const override;
 	void Clear(T_ClearFlags const mask) const override;
 
+	T_FenceLoc InsertFence() const override;
+	void WaitForFence(T_FenceLoc const fence) const override;
+	void DeleteFence(T_FenceLoc& fence) const override;
+
 	T_ArrayLoc CreateVertexArray() const override;
 	T_BufferLoc CreateBuffer() const override;
 
@@ -192,10 +214,15 @@ public:
 		int64 const size, 
 		void const* const data, 
 		E_UsageHint const usage) const override;
+	void SetBufferSubData(E_BufferType const target,
+		int64 const offset,
+		int64 const size,
+		void const* const data) const override;
 	void SetVertexAttributeArrayEnabled(uint32 const index, bool const enabled) const override; 
 
 	void* MapBuffer(E_BufferType const target, E_AccessMode const access) const override;
 	void UnmapBuffer(E_BufferType const target) const override;
+	void* SetPersistentBufferStorage(E_BufferType const target, int64 const size) const override;
 
 	void BindBufferRange(E_BufferType const target,
 		uint32 const index,
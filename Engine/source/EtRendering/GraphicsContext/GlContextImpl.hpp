@@ -1341,6 +1341,69 @@ void GL_CONTEXT_CLASSNAME::DrawElementsInstanced(E_DrawMode const mode, uint32 c
 #endif
 }
 
+//---------------------------------
+// GlContext::DrawElementsBaseVertex
+//
+// Draw vertex data with indices that are relative to a vertex within the bound buffer
+//
+void GL_CONTEXT_CLASSNAME::DrawElementsBaseVertex(E_DrawMode const mode,
+	uint32 const count,
+	E_DataType const type,
+	const void * indices,
+	int32 const baseVertex)
+{
+	glDrawElementsBaseVertex(GL_CONTEXT_NS::ConvDrawMode(mode), count, GL_CONTEXT_NS::ConvDataType(type), indices, baseVertex);
+
+#if ET_CT_IS_ENABLED(ET_CT_DBG_UTIL)
+	core::PerformanceInfo::GetInstance()->m_DrawCalls++;
+#endif
+}
+
+//---------------------------------
+// GlContext::DrawElementsInstancedBaseVertex
+//
+// Draw instanced vertex data with indices that are relative to a vertex within the bound buffer
+//
+void GL_CONTEXT_CLASSNAME::DrawElementsInstancedBaseVertex(E_DrawMode const mode,
+	uint32 const count,
+	E_DataType const type,
+	const void * indices,
+	uint32 const prims,
+	int32 const baseVertex)
+{
+	glDrawElementsInstancedBaseVertex(GL_CONTEXT_NS::ConvDrawMode(mode), count, GL_CONTEXT_NS::ConvDataType(type), indices, prims, baseVertex);
+
+#if ET_CT_IS_ENABLED(ET_CT_DBG_UTIL)
+	core::PerformanceInfo::GetInstance()->m_DrawCalls++;
+#endif
+}
+
+//---------------------------------
+// GlContext::DrawElementsInstancedBaseVertexBaseInstance
+//
+// Like DrawElementsInstancedBaseVertex, with per instance attributes read starting from baseInstance
+//
+void GL_CONTEXT_CLASSNAME::DrawElementsInstancedBaseVertexBaseInstance(E_DrawMode const mode,
+	uint32 const count,
+	E_DataType const type,
+	const void * indices,
+	uint32 const prims,
+	int32 const baseVertex,
+	uint32 const baseInstance)
+{
+	glDrawElementsInstancedBaseVertexBaseInstance(GL_CONTEXT_NS::ConvDrawMode(mode),
+		count,
+		GL_CONTEXT_NS::ConvDataType(type),
+		indices,
+		prims,
+		baseVertex,
+		baseInstance);
+
+#if ET_CT_IS_ENABLED(ET_CT_DBG_UTIL)
+	core::PerformanceInfo::GetInstance()->m_DrawCalls++;
+#endif
+}
+
 //---------------------------------
 // GlContext::Flush
 //
@@ -1388,6 +1451,46 @@ void GL_CONTEXT_CLASSNAME::Clear(T_ClearFlags const mask) const
 	glClear(field);
 }
 
+//---------------------------------
+// GlContext::InsertFence
+//
+// Create a sync object that is signaled once all previously issued commands are completed
+//
+T_FenceLoc GL_CONTEXT_CLASSNAME::InsertFence() const
+{
+	GLsync const sync = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+	return static_cast<T_FenceLoc>(reinterpret_cast<uintptr_t>(sync));
+}
+
+//---------------------------------
+// GlContext::WaitForFence
+//
+// Block until the GPU passed the fence, flushing the command queue so that it is guaranteed to get there
+//
+void GL_CONTEXT_CLASSNAME::WaitForFence(T_FenceLoc const fence) const
+{
+	static GLuint64 const s_Timeout = 1000000000u; // 1 second in nanoseconds
+
+	GLsync const sync = reinterpret_cast<GLsync>(static_cast<uintptr_t>(fence));
+
+	GLenum result = glClientWaitSync(sync, GL_SYNC_FLUSH_COMMANDS_BIT, s_Timeout);
+	while (result == GL_TIMEOUT_EXPIRED)
+	{
+		result = glClientWaitSync(sync, 0, s_Timeout);
+	}
+
+	ET_ASSERT(result != GL_WAIT_FAILED, "Failed to wait for fence");
+}
+
+//---------------------------------
+// GlContext::DeleteFence
+//
+void GL_CONTEXT_CLASSNAME::DeleteFence(T_FenceLoc& fence) const
+{
+	glDeleteSync(reinterpret_cast<GLsync>(static_cast<uintptr_t>(fence)));
+	fence = 0u;
+}
+
 //---------------------------------
 // GlContext::CreateVertexArray
 //
@@ -1438,6 +1541,16 @@ void GL_CONTEXT_CLASSNAME::SetBufferData(E_BufferType const target, int64 const
 	glBufferData(GL_CONTEXT_NS::ConvBufferType(target), size, data, GL_CONTEXT_NS::ConvUsageHint(usage));
 }
 
+//---------------------------------
+// GlContext::SetBufferSubData
+//
+// Overwrite part of the buffer at target without reallocating its storage
+//
+void GL_CONTEXT_CLASSNAME::SetBufferSubData(E_BufferType const target, int64 const offset, int64 const size, void const* const data) const
+{
+	glBufferSubData(GL_CONTEXT_NS::ConvBufferType(target), offset, size, data);
+}
+
 //---------------------------------
 // GlContext::SetVertexAttributeArrayEnabled
 //
@@ -1514,6 +1627,21 @@ void GL_CONTEXT_CLASSNAME::UnmapBuffer(E_BufferType const target) const
 	glUnmapBuffer(GL_CONTEXT_NS::ConvBufferType(target));
 }
 
+//---------------------------------
+// GlContext::SetPersistentBufferStorage
+//
+// Allocate immutable storage for the buffer at target and keep it mapped for its entire lifetime.
+// Writes are coherent, so the caller only has to make sure (with fences) that it doesn't overwrite data the GPU still reads
+//
+void* GL_CONTEXT_CLASSNAME::SetPersistentBufferStorage(E_BufferType const target, int64 const size) const
+{
+	GLbitfield const flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+
+	GLenum const glTarget = GL_CONTEXT_NS::ConvBufferType(target);
+	glBufferStorage(glTarget, size, nullptr, flags);
+	return glMapBufferRange(glTarget, 0, size, flags);
+}
+
 //---------------------------------
 // GlContext::BindBufferRange
 //
@@ -2083,6 +2211,12 @@ void GL_CONTEXT_CLASSNAME::GetActiveUniforms(T_ShaderLoc const program, uint32 c
 	std::string uniName = std::string(name, length);
 	std::string endName;
 
+	// uniforms in blocks are addressed by their offset instead of a location
+	GLint blockOffset = -1;
+	GLint arrayStride = 0;
+	glGetActiveUniformsiv(program, 1, &index, GL_UNIFORM_OFFSET, &blockOffset);
+	glGetActiveUniformsiv(program, 1, &index, GL_UNIFORM_ARRAY_STRIDE, &arrayStride);
+
 	// if we have an array of structs, separate out the beginning and end bit so we can create our name with the index
 	if (arrayCount > 1)
 	{
@@ -2112,6 +2246,11 @@ void GL_CONTEXT_CLASSNAME::GetActiveUniforms(T_ShaderLoc const program, uint32 c
 		uni.type = GL_CONTEXT_NS::ParseParamType(type);
 
 		uni.location = glGetUniformLocation(program, uni.name.c_str());
+
+		if (blockOffset >= 0)
+		{
+			uni.blockOffset = static_cast<int32>(blockOffset + arrayIdx * arrayStride);
+		}
 	}
 }
 
@@ -93,12 +93,38 @@ public:
 		const void * indices, 
 		uint32 const primcount) = 0;
 
+	// indices are offset by baseVertex, so that meshes sharing a buffer don't need to rebase them
+	virtual void DrawElementsBaseVertex(E_DrawMode const mode,
+		uint32 const count,
+		E_DataType const type,
+		const void * indices,
+		int32 const baseVertex) = 0;
+	virtual void DrawElementsInstancedBaseVertex(E_DrawMode const mode,
+		uint32 const count,
+		E_DataType const type,
+		const void * indices,
+		uint32 const primcount,
+		int32 const baseVertex) = 0;
+	// instanced attributes start at baseInstance, so that instance data can share a buffer too
+	virtual void DrawElementsInstancedBaseVertexBaseInstance(E_DrawMode const mode,
+		uint32 const count,
+		E_DataType const type,
+		const void * indices,
+		uint32 const primcount,
+		int32 const baseVertex,
+		uint32 const baseInstance) = 0;
+
 	// other commands
 	//--------------
 	virtual void Flush() const = 0;
 	virtual void Finish() const = 0;
 	virtual void Clear(T_ClearFlags const mask) const = 0;
 
+	// fences are signaled once all commands issued before them are executed
+	virtual T_FenceLoc InsertFence() const = 0;
+	virtual void WaitForFence(T_FenceLoc const fence) const = 0; // blocks the CPU until the fence is signaled
+	virtual void DeleteFence(T_FenceLoc& fence) const = 0;
+
 	virtual T_ArrayLoc CreateVertexArray() const = 0;
 	virtual T_BufferLoc CreateBuffer() const = 0;
 
@@ -106,11 +132,13 @@ public:
 	virtual void DeleteBuffer(T_BufferLoc& loc) const = 0;
 
 	virtual void SetBufferData(E_BufferType const target, int64 const size, void const* const data, E_UsageHint const usage) const = 0;
+	virtual void SetBufferSubData(E_BufferType const target, int64 const offset, int64 const size, void const* const data) const = 0;
 	// could at some point be a member on VertexArray data object
 	virtual void SetVertexAttributeArrayEnabled(uint32 const index, bool const enabled) const = 0; 
 
 	virtual void* MapBuffer(E_BufferType const target, E_AccessMode const access) const = 0;
 	virtual void UnmapBuffer(E_BufferType const target) const = 0;
+	virtual void* SetPersistentBufferStorage(E_BufferType const target, int64 const size) const = 0; // stays mapped for writing until the buffer is deleted
 
 	virtual void BindBufferRange(E_BufferType const target, 
 		uint32 const index, 
@@ -16,6 +16,7 @@ typedef uint64 T_TextureHandle;
 
 typedef uint32 T_BufferLoc;
 typedef uint32 T_ArrayLoc;
+typedef uint64 T_FenceLoc; // 0 is never a valid fence
 
 typedef uint32 T_FbLoc;
 typedef uint32 T_RbLoc;
@@ -389,6 +390,7 @@ struct UniformDescriptor
 	T_UniformLoc location;
 	E_ParamType type;
 	std::string name;
+	int32 blockOffset = -1; // byte offset within the containing uniform block, -1 for loose uniforms
 };
 
 
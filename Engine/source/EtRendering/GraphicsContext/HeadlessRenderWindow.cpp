@@ -0,0 +1,29 @@
+#include "stdafx.h"
+#include "HeadlessRenderWindow.h"
+
+
+namespace et {
+namespace render {
+
+
+//========================
+// Headless Render Window
+//========================
+
+
+//-------------------------------------
+// HeadlessRenderWindow::CreateContext
+//
+// Context parameters are meaningless without a driver, the recording context works the same regardless
+//
+I_GraphicsContextApi* HeadlessRenderWindow::CreateContext(GraphicsContextParams const& params)
+{
+	ET_UNUSED(params);
+
+	m_Context.Initialize(m_Dimensions);
+	return &m_Context;
+}
+
+
+} // namespace render
+} // namespace et
@@ -0,0 +1,46 @@
+#pragma once
+#include "RenderWindow.h"
+#include "RecordingContext.h"
+
+
+namespace et {
+namespace render {
+
+
+//---------------------------------
+// HeadlessRenderWindow
+//
+// Render window without an actual window or GPU, its context records graphics calls instead of executing them
+//  - allows running renderers in automated tests, and inspecting what they submit
+//
+class HeadlessRenderWindow final : public RenderWindow
+{
+	// construct destruct
+	//-------------------
+public:
+	HeadlessRenderWindow(ivec2 const dimensions) : RenderWindow(), m_Dimensions(dimensions) {}
+	~HeadlessRenderWindow() = default;
+
+	// accessors
+	//-----------
+	RecordingContext& GetContext() { return m_Context; }
+	RecordingContext const& GetContext() const { return m_Context; }
+
+	// Render Window Interface
+	//-------------------------
+	I_GraphicsContextApi* CreateContext(GraphicsContextParams const& params) override;
+	void SetCursorPos(ivec2 const pos) override {}
+
+	ivec2 GetDimensions() const override { return m_Dimensions; }
+	bool HasFocus() const override { return false; }
+
+	// Data
+	///////
+private:
+	ivec2 m_Dimensions;
+	RecordingContext m_Context;
+};
+
+
+} // namespace render
+} // namespace et
@@ -0,0 +1,1529 @@
+#include "stdafx.h"
+#include "RecordingContext.h"
+
+#include <EtRendering/GraphicsTypes/TextureData.h>
+
+
+namespace et {
+namespace render {
+
+
+namespace {
+
+	//---------------------------------
+	// GetChannelCount
+	//
+	// Number of components in an uncompressed pixel layout
+	//
+	uint64 GetChannelCount(E_ColorFormat const layout)
+	{
+		switch (layout)
+		{
+		case E_ColorFormat::Depth:
+		case E_ColorFormat::DepthStencil:
+		case E_ColorFormat::Red:
+			return 1u;
+
+		case E_ColorFormat::RG:
+			return 2u;
+
+		case E_ColorFormat::RGB:
+		case E_ColorFormat::BGR:
+			return 3u;
+
+		case E_ColorFormat::RGBA:
+		case E_ColorFormat::BGRA:
+			return 4u;
+
+		default:
+			ET_ASSERT(false, "Unhandled color layout!");
+			return 0u;
+		}
+	}
+
+} // namespace
+
+
+//===================
+// Recording Context
+//===================
+
+
+//---------------------------------
+// RecordingContext::Reset
+//
+// Clear the command log and all counters, live objects and bound state are kept
+//
+void RecordingContext::Reset()
+{
+	m_Commands.clear();
+	m_Stats = Stats();
+}
+
+//---------------------------------
+// RecordingContext::Initialize
+//
+void RecordingContext::Initialize(ivec2 const dimensions)
+{
+	m_ViewportSize = dimensions;
+	m_ScissorSize = dimensions;
+}
+
+//---------------------------------
+// RecordingContext::SetDepthEnabled
+//
+void RecordingContext::SetDepthEnabled(bool const enabled)
+{
+	SetState(m_DepthTestEnabled, enabled, "SetDepthEnabled");
+}
+
+//---------------------------------
+// RecordingContext::SetBlendEnabled
+//
+void RecordingContext::SetBlendEnabled(bool const enabled)
+{
+	SetState(m_BlendEnabled, enabled, "SetBlendEnabled");
+}
+
+//---------------------------------
+// RecordingContext::SetBlendEnabled
+//
+// Per draw buffer blending isn't tracked, so every call counts as a state change
+//
+void RecordingContext::SetBlendEnabled(bool const enabled, uint32 const index)
+{
+	ET_UNUSED(enabled);
+	ET_UNUSED(index);
+	RecordStateChange("SetBlendEnabledIndexed");
+}
+
+//---------------------------------
+// RecordingContext::SetBlendEnabled
+//
+void RecordingContext::SetBlendEnabled(std::vector<bool> const& blendBuffers)
+{
+	for (uint32 idx = 0u; idx < static_cast<uint32>(blendBuffers.size()); ++idx)
+	{
+		SetBlendEnabled(blendBuffers[idx], idx);
+	}
+}
+
+//---------------------------------
+// RecordingContext::SetStencilEnabled
+//
+void RecordingContext::SetStencilEnabled(bool const enabled)
+{
+	SetState(m_StencilTestEnabled, enabled, "SetStencilEnabled");
+}
+
+//---------------------------------
+// RecordingContext::SetCullEnabled
+//
+void RecordingContext::SetCullEnabled(bool const enabled)
+{
+	SetState(m_CullFaceEnabled, enabled, "SetCullEnabled");
+}
+
+//---------------------------------
+// RecordingContext::SetScissorEnabled
+//
+void RecordingContext::SetScissorEnabled(bool const enabled)
+{
+	SetState(m_ScissorEnabled, enabled, "SetScissorEnabled");
+}
+
+//---------------------------------
+// RecordingContext::SetColorMask
+//
+void RecordingContext::SetColorMask(T_ColorFlags const flags)
+{
+	SetState(m_ColorMask, flags, "SetColorMask");
+}
+
+//---------------------------------
+// RecordingContext::SetDepthMask
+//
+void RecordingContext::SetDepthMask(bool const flag)
+{
+	SetState(m_DepthMask, flag, "SetDepthMask");
+}
+
+//---------------------------------
+// RecordingContext::SetStencilMask
+//
+void RecordingContext::SetStencilMask(uint32 const mask)
+{
+	SetState(m_StencilMask, mask, "SetStencilMask");
+}
+
+//---------------------------------
+// RecordingContext::SetFaceCullingMode
+//
+void RecordingContext::SetFaceCullingMode(E_FaceCullMode const cullMode)
+{
+	SetState(m_CullFaceMode, cullMode, "SetFaceCullingMode");
+}
+
+//---------------------------------
+// RecordingContext::SetPolygonMode
+//
+void RecordingContext::SetPolygonMode(E_FaceCullMode const cullMode, E_PolygonMode const mode)
+{
+	ET_UNUSED(cullMode);
+	ET_UNUSED(mode);
+	RecordStateChange("SetPolygonMode");
+}
+
+//---------------------------------
+// RecordingContext::SetBlendEquation
+//
+void RecordingContext::SetBlendEquation(E_BlendEquation const equation)
+{
+	SetState(m_BlendEquation, equation, "SetBlendEquation");
+}
+
+//---------------------------------
+// RecordingContext::SetBlendFunction
+//
+void RecordingContext::SetBlendFunction(E_BlendFactor const sFactor, E_BlendFactor const dFactor)
+{
+	ET_UNUSED(sFactor);
+	ET_UNUSED(dFactor);
+	RecordStateChange("SetBlendFunction");
+}
+
+//---------------------------------
+// RecordingContext::SetBlendFunctionSeparate
+//
+void RecordingContext::SetBlendFunctionSeparate(E_BlendFactor const sRGB, E_BlendFactor const sAlpha, E_BlendFactor const dRGB, E_BlendFactor const dAlpha)
+{
+	ET_UNUSED(sRGB);
+	ET_UNUSED(sAlpha);
+	ET_UNUSED(dRGB);
+	ET_UNUSED(dAlpha);
+	RecordStateChange("SetBlendFunctionSeparate");
+}
+
+//---------------------------------
+// RecordingContext::SetDepthFunction
+//
+void RecordingContext::SetDepthFunction(E_DepthFunc const func)
+{
+	SetState(m_DepthFunc, func, "SetDepthFunction");
+}
+
+//---------------------------------
+// RecordingContext::SetStencilFunction
+//
+void RecordingContext::SetStencilFunction(T_StencilFunc const func, int32 const reference, uint32 const mask)
+{
+	ET_UNUSED(func);
+	ET_UNUSED(reference);
+	ET_UNUSED(mask);
+	RecordStateChange("SetStencilFunction");
+}
+
+//---------------------------------
+// RecordingContext::SetStencilOperation
+//
+void RecordingContext::SetStencilOperation(E_StencilOp const sFail, E_StencilOp const dFail, E_StencilOp const dsPass)
+{
+	ET_UNUSED(sFail);
+	ET_UNUSED(dFail);
+	ET_UNUSED(dsPass);
+	RecordStateChange("SetStencilOperation");
+}
+
+//---------------------------------
+// RecordingContext::SetScissor
+//
+void RecordingContext::SetScissor(ivec2 const pos, ivec2 const size)
+{
+	if (!(math::nearEqualsV(pos, m_ScissorPosition) && math::nearEqualsV(size, m_ScissorSize)))
+	{
+		m_ScissorPosition = pos;
+		m_ScissorSize = size;
+		RecordStateChange("SetScissor");
+	}
+}
+
+//---------------------------------
+// RecordingContext::SetViewport
+//
+void RecordingContext::SetViewport(ivec2 const pos, ivec2 const size)
+{
+	if (!(math::nearEqualsV(pos, m_ViewportPosition) && math::nearEqualsV(size, m_ViewportSize)))
+	{
+		m_ViewportPosition = pos;
+		m_ViewportSize = size;
+		RecordStateChange("SetViewport");
+	}
+}
+
+//---------------------------------
+// RecordingContext::GetViewport
+//
+void RecordingContext::GetViewport(ivec2& pos, ivec2& size)
+{
+	pos = m_ViewportPosition;
+	size = m_ViewportSize;
+}
+
+//---------------------------------
+// RecordingContext::SetClearColor
+//
+void RecordingContext::SetClearColor(vec4 const& col)
+{
+	if (!math::nearEqualsV(col, m_ClearColor))
+	{
+		m_ClearColor = col;
+		RecordStateChange("SetClearColor");
+	}
+}
+
+//---------------------------------
+// RecordingContext::SetShader
+//
+void RecordingContext::SetShader(ShaderData const* pShader)
+{
+	if (m_pBoundShader == pShader)
+	{
+		m_Stats.redundantBinds++;
+		return;
+	}
+
+	m_pBoundShader = pShader;
+	m_Stats.shaderBinds++;
+	Record(E_Command::BindShader, "SetShader", static_cast<uint64>(reinterpret_cast<uintptr_t>(pShader)));
+}
+
+//---------------------------------
+// RecordingContext::BindFramebuffer
+//
+void RecordingContext::BindFramebuffer(T_FbLoc const handle)
+{
+	if (m_ReadFramebuffer == handle && m_DrawFramebuffer == handle)
+	{
+		m_Stats.redundantBinds++;
+		return;
+	}
+
+	m_ReadFramebuffer = handle;
+	m_DrawFramebuffer = handle;
+	m_Stats.framebufferBinds++;
+	Record(E_Command::BindFramebuffer, "BindFramebuffer", handle);
+}
+
+//---------------------------------
+// RecordingContext::BindReadFramebuffer
+//
+void RecordingContext::BindReadFramebuffer(T_FbLoc const handle)
+{
+	if (m_ReadFramebuffer == handle)
+	{
+		m_Stats.redundantBinds++;
+		return;
+	}
+
+	m_ReadFramebuffer = handle;
+	m_Stats.framebufferBinds++;
+	Record(E_Command::BindFramebuffer, "BindReadFramebuffer", handle);
+}
+
+//---------------------------------
+// RecordingContext::BindDrawFramebuffer
+//
+void RecordingContext::BindDrawFramebuffer(T_FbLoc const handle)
+{
+	if (m_DrawFramebuffer == handle)
+	{
+		m_Stats.redundantBinds++;
+		return;
+	}
+
+	m_DrawFramebuffer = handle;
+	m_Stats.framebufferBinds++;
+	Record(E_Command::BindFramebuffer, "BindDrawFramebuffer", handle);
+}
+
+//---------------------------------
+// RecordingContext::BindRenderbuffer
+//
+void RecordingContext::BindRenderbuffer(T_RbLoc const handle)
+{
+	if (m_Renderbuffer == handle)
+	{
+		m_Stats.redundantBinds++;
+		return;
+	}
+
+	m_Renderbuffer = handle;
+	m_Stats.framebufferBinds++;
+	Record(E_Command::BindFramebuffer, "BindRenderbuffer", handle);
+}
+
+//---------------------------------
+// RecordingContext::BindTexture
+//
+// Textures that are already bound keep their unit, others get the next unit in a round robin fashion
+//
+T_TextureUnit RecordingContext::BindTexture(E_TextureType const target, T_TextureLoc const texLoc, bool const ensureActive)
+{
+	ET_UNUSED(target);
+	ET_UNUSED(ensureActive);
+
+	for (T_TextureUnit unit = 0u; unit < s_TextureUnitCount; ++unit)
+	{
+		if (m_TextureUnits[unit] == texLoc)
+		{
+			m_Stats.redundantBinds++;
+			return unit;
+		}
+	}
+
+	T_TextureUnit const unit = m_NextTextureUnit;
+	m_NextTextureUnit = (m_NextTextureUnit + 1u) % s_TextureUnitCount;
+
+	m_TextureUnits[unit] = texLoc;
+	m_Stats.textureBinds++;
+	Record(E_Command::BindTexture, "BindTexture", texLoc);
+
+	return unit;
+}
+
+//---------------------------------
+// RecordingContext::UnbindTexture
+//
+void RecordingContext::UnbindTexture(E_TextureType const target, T_TextureLoc const texLoc)
+{
+	ET_UNUSED(target);
+
+	for (T_TextureLoc& boundTex : m_TextureUnits)
+	{
+		if (boundTex == texLoc)
+		{
+			boundTex = 0u;
+		}
+	}
+}
+
+//---------------------------------
+// RecordingContext::BindVertexArray
+//
+void RecordingContext::BindVertexArray(T_ArrayLoc const vertexArray)
+{
+	if (m_VertexArray == vertexArray)
+	{
+		m_Stats.redundantBinds++;
+		return;
+	}
+
+	m_VertexArray = vertexArray;
+	m_Stats.vertexArrayBinds++;
+	Record(E_Command::BindVertexArray, "BindVertexArray", vertexArray);
+
+	// vertex arrays capture the index buffer binding
+	m_BufferTargets[E_BufferType::Index] = 0u;
+}
+
+//---------------------------------
+// RecordingContext::BindBuffer
+//
+void RecordingContext::BindBuffer(E_BufferType const target, T_BufferLoc const buffer)
+{
+	auto const targetIt = m_BufferTargets.find(target);
+	if (targetIt != m_BufferTargets.cend() && targetIt->second == buffer)
+	{
+		m_Stats.redundantBinds++;
+		return;
+	}
+
+	m_BufferTargets[target] = buffer;
+	m_Stats.bufferBinds++;
+	Record(E_Command::BindBuffer, "BindBuffer", buffer);
+}
+
+//---------------------------------
+// RecordingContext::SetLineWidth
+//
+void RecordingContext::SetLineWidth(float const lineWidth)
+{
+	if (!math::nearEquals(m_LineWidth, lineWidth))
+	{
+		m_LineWidth = lineWidth;
+		RecordStateChange("SetLineWidth");
+	}
+}
+
+//---------------------------------
+// RecordingContext::DrawArrays
+//
+void RecordingContext::DrawArrays(E_DrawMode const mode, uint32 const first, uint32 const count)
+{
+	ET_UNUSED(mode);
+	ET_UNUSED(first);
+
+	m_Stats.drawCalls++;
+	m_Stats.elements += count;
+	Record(E_Command::Draw, "DrawArrays", count);
+}
+
+//---------------------------------
+// RecordingContext::DrawElements
+//
+void RecordingContext::DrawElements(E_DrawMode const mode, uint32 const count, E_DataType const type, const void * indices)
+{
+	ET_UNUSED(mode);
+	ET_UNUSED(type);
+	ET_UNUSED(indices);
+
+	m_Stats.drawCalls++;
+	m_Stats.elements += count;
+	Record(E_Command::Draw, "DrawElements", count);
+}
+
+//---------------------------------
+// RecordingContext::DrawElementsInstanced
+//
+void RecordingContext::DrawElementsInstanced(E_DrawMode const mode,
+	uint32 const count,
+	E_DataType const type,
+	const void * indices,
+	uint32 const primcount)
+{
+	ET_UNUSED(mode);
+	ET_UNUSED(type);
+	ET_UNUSED(indices);
+
+	m_Stats.drawCalls++;
+	m_Stats.instancedDrawCalls++;
+	m_Stats.elements += static_cast<uint64>(count) * static_cast<uint64>(primcount);
+	m_Stats.instances += primcount;
+	Record(E_Command::DrawInstanced, "DrawElementsInstanced", primcount);
+}
+
+//---------------------------------
+// RecordingContext::DrawElementsBaseVertex
+//
+void RecordingContext::DrawElementsBaseVertex(E_DrawMode const mode,
+	uint32 const count,
+	E_DataType const type,
+	const void * indices,
+	int32 const baseVertex)
+{
+	ET_UNUSED(baseVertex);
+	DrawElements(mode, count, type, indices);
+}
+
+//---------------------------------
+// RecordingContext::DrawElementsInstancedBaseVertex
+//
+void RecordingContext::DrawElementsInstancedBaseVertex(E_DrawMode const mode,
+	uint32 const count,
+	E_DataType const type,
+	const void * indices,
+	uint32 const primcount,
+	int32 const baseVertex)
+{
+	ET_UNUSED(baseVertex);
+	DrawElementsInstanced(mode, count, type, indices, primcount);
+}
+
+//---------------------------------
+// RecordingContext::DrawElementsInstancedBaseVertexBaseInstance
+//
+void RecordingContext::DrawElementsInstancedBaseVertexBaseInstance(E_DrawMode const mode,
+	uint32 const count,
+	E_DataType const type,
+	const void * indices,
+	uint32 const primcount,
+	int32 const baseVertex,
+	uint32 const baseInstance)
+{
+	ET_UNUSED(baseVertex);
+	ET_UNUSED(baseInstance);
+	DrawElementsInstanced(mode, count, type, indices, primcount);
+}
+
+//---------------------------------
+// RecordingContext::Flush
+//
+void RecordingContext::Flush() const
+{
+	Record(E_Command::Other, "Flush");
+}
+
+//---------------------------------
+// RecordingContext::Finish
+//
+void RecordingContext::Finish() const
+{
+	Record(E_Command::Other, "Finish");
+}
+
+//---------------------------------
+// RecordingContext::Clear
+//
+void RecordingContext::Clear(T_ClearFlags const mask) const
+{
+	m_Stats.clears++;
+	Record(E_Command::Clear, "Clear", mask);
+}
+
+//---------------------------------
+// RecordingContext::InsertFence
+//
+T_FenceLoc RecordingContext::InsertFence() const
+{
+	T_FenceLoc const ret = static_cast<T_FenceLoc>(GenerateHandle());
+	m_LiveFences.emplace(ret);
+	Record(E_Command::Other, "InsertFence", ret);
+	return ret;
+}
+
+//---------------------------------
+// RecordingContext::WaitForFence
+//
+// Nothing is executed asynchronously, so all fences are signaled immediately
+//
+void RecordingContext::WaitForFence(T_FenceLoc const fence) const
+{
+	ET_ASSERT(m_LiveFences.find(fence) != m_LiveFences.cend(), "Waiting for fence " ET_FMT_SIZET " which doesn't exist", static_cast<size_t>(fence));
+
+	m_Stats.fenceWaits++;
+	Record(E_Command::Other, "WaitForFence", fence);
+}
+
+//---------------------------------
+// RecordingContext::DeleteFence
+//
+void RecordingContext::DeleteFence(T_FenceLoc& fence) const
+{
+	ET_ASSERT(m_LiveFences.find(fence) != m_LiveFences.cend(), "Deleting fence " ET_FMT_SIZET " which doesn't exist", static_cast<size_t>(fence));
+
+	m_LiveFences.erase(fence);
+	Record(E_Command::DeleteObject, "DeleteFence", fence);
+	fence = 0u;
+}
+
+//---------------------------------
+// RecordingContext::CreateVertexArray
+//
+T_ArrayLoc RecordingContext::CreateVertexArray() const
+{
+	T_ArrayLoc const ret = GenerateHandle();
+	m_LiveVertexArrays.emplace(ret);
+	Record(E_Command::CreateObject, "CreateVertexArray", ret);
+	return ret;
+}
+
+//---------------------------------
+// RecordingContext::CreateBuffer
+//
+T_BufferLoc RecordingContext::CreateBuffer() const
+{
+	T_BufferLoc const ret = GenerateHandle();
+	m_LiveBuffers.emplace(ret);
+	Record(E_Command::CreateObject, "CreateBuffer", ret);
+	return ret;
+}
+
+//---------------------------------
+// RecordingContext::DeleteVertexArray
+//
+void RecordingContext::DeleteVertexArray(T_ArrayLoc& loc) const
+{
+	ET_ASSERT(m_LiveVertexArrays.find(loc) != m_LiveVertexArrays.cend(), "Deleting vertex array %u which doesn't exist", loc);
+
+	m_LiveVertexArrays.erase(loc);
+	Record(E_Command::DeleteObject, "DeleteVertexArray", loc);
+}
+
+//---------------------------------
+// RecordingContext::DeleteBuffer
+//
+void RecordingContext::DeleteBuffer(T_BufferLoc& loc) const
+{
+	ET_ASSERT(m_LiveBuffers.find(loc) != m_LiveBuffers.cend(), "Deleting buffer %u which doesn't exist", loc);
+
+	m_LiveBuffers.erase(loc);
+	m_BufferStorage.erase(loc);
+	Record(E_Command::DeleteObject, "DeleteBuffer", loc);
+}
+
+//---------------------------------
+// RecordingContext::SetBufferData
+//
+// The buffer keeps a CPU side copy of the size, so that it can be mapped later
+//
+void RecordingContext::SetBufferData(E_BufferType const target, int64 const size, void const* const data, E_UsageHint const usage) const
+{
+	ET_UNUSED(usage);
+
+	auto const targetIt = m_BufferTargets.find(target);
+	ET_ASSERT(targetIt != m_BufferTargets.cend() && targetIt->second != 0u, "Setting buffer data without a bound buffer");
+
+	std::vector<uint8>& storage = m_BufferStorage[targetIt->second];
+	storage.resize(static_cast<size_t>(size));
+	if (data != nullptr)
+	{
+		memcpy(storage.data(), data, storage.size());
+	}
+
+	m_Stats.bufferUploads++;
+	m_Stats.bufferBytes += static_cast<uint64>(size);
+	Record(E_Command::BufferData, "SetBufferData", static_cast<uint64>(size));
+}
+
+//---------------------------------
+// RecordingContext::SetBufferSubData
+//
+void RecordingContext::SetBufferSubData(E_BufferType const target, int64 const offset, int64 const size, void const* const data) const
+{
+	auto const targetIt = m_BufferTargets.find(target);
+	ET_ASSERT(targetIt != m_BufferTargets.cend() && targetIt->second != 0u, "Setting buffer data without a bound buffer");
+
+	std::vector<uint8>& storage = m_BufferStorage[targetIt->second];
+	ET_ASSERT(static_cast<size_t>(offset + size) <= storage.size(), "Buffer sub data exceeds the buffers storage");
+	memcpy(storage.data() + offset, data, static_cast<size_t>(size));
+
+	m_Stats.bufferUploads++;
+	m_Stats.bufferBytes += static_cast<uint64>(size);
+	Record(E_Command::BufferData, "SetBufferSubData", static_cast<uint64>(size));
+}
+
+//---------------------------------
+// RecordingContext::SetVertexAttributeArrayEnabled
+//
+void RecordingContext::SetVertexAttributeArrayEnabled(uint32 const index, bool const enabled) const
+{
+	ET_UNUSED(enabled);
+	Record(E_Command::Other, "SetVertexAttributeArrayEnabled", index);
+}
+
+//---------------------------------
+// RecordingContext::MapBuffer
+//
+// Mapping counts the whole buffer as uploaded, as we can't know how much of it is written
+//
+void* RecordingContext::MapBuffer(E_BufferType const target, E_AccessMode const access) const
+{
+	ET_UNUSED(access);
+
+	auto const targetIt = m_BufferTargets.find(target);
+	ET_ASSERT(targetIt != m_BufferTargets.cend() && targetIt->second != 0u, "Mapping a buffer without a bound buffer");
+
+	std::vector<uint8>& storage = m_BufferStorage[targetIt->second];
+
+	m_Stats.bufferMaps++;
+	m_Stats.bufferBytes += static_cast<uint64>(storage.size());
+	Record(E_Command::BufferMap, "MapBuffer", static_cast<uint64>(storage.size()));
+
+	return storage.data();
+}
+
+//---------------------------------
+// RecordingContext::UnmapBuffer
+//
+void RecordingContext::UnmapBuffer(E_BufferType const target) const
+{
+	ET_UNUSED(target);
+	Record(E_Command::BufferMap, "UnmapBuffer");
+}
+
+//---------------------------------
+// RecordingContext::SetPersistentBufferStorage
+//
+// The CPU side copy doubles as the mapped memory, writes to it are not counted as uploads
+//
+void* RecordingContext::SetPersistentBufferStorage(E_BufferType const target, int64 const size) const
+{
+	auto const targetIt = m_BufferTargets.find(target);
+	ET_ASSERT(targetIt != m_BufferTargets.cend() && targetIt->second != 0u, "Setting buffer storage without a bound buffer");
+
+	std::vector<uint8>& storage = m_BufferStorage[targetIt->second];
+	storage.resize(static_cast<size_t>(size));
+
+	m_Stats.bufferMaps++;
+	Record(E_Command::BufferMap, "SetPersistentBufferStorage", static_cast<uint64>(size));
+
+	return storage.data();
+}
+
+//---------------------------------
+// RecordingContext::BindBufferRange
+//
+void RecordingContext::BindBufferRange(E_BufferType const target,
+	uint32 const index,
+	T_BufferLoc const buffer,
+	size_t const offset,
+	size_t const size) const
+{
+	ET_UNUSED(target);
+	ET_UNUSED(index);
+	ET_UNUSED(offset);
+	ET_UNUSED(size);
+
+	m_Stats.bufferBinds++;
+	Record(E_Command::BindBuffer, "BindBufferRange", buffer);
+}
+
+//---------------------------------
+// RecordingContext::GenerateTexture
+//
+T_TextureLoc RecordingContext::GenerateTexture() const
+{
+	T_TextureLoc const ret = GenerateHandle();
+	m_LiveTextures.emplace(ret);
+	Record(E_Command::CreateObject, "GenerateTexture", ret);
+	return ret;
+}
+
+//---------------------------------
+// RecordingContext::DeleteTexture
+//
+void RecordingContext::DeleteTexture(T_TextureLoc& texLoc)
+{
+	ET_ASSERT(m_LiveTextures.find(texLoc) != m_LiveTextures.cend(), "Deleting texture %u which doesn't exist", texLoc);
+
+	UnbindTexture(E_TextureType::Texture2D, texLoc);
+	m_LiveTextures.erase(texLoc);
+	Record(E_Command::DeleteObject, "DeleteTexture", texLoc);
+}
+
+//---------------------------------
+// RecordingContext::UploadTextureData
+//
+void RecordingContext::UploadTextureData(TextureData& texture,
+	void const* const data,
+	E_ColorFormat const layout,
+	E_DataType const dataType,
+	int32 const mipLevel)
+{
+	ET_UNUSED(data);
+
+	BindTexture(texture.GetTargetType(), texture.GetLocation(), true);
+
+	ivec2 const res = texture.GetResolution();
+	uint64 const width = static_cast<uint64>(std::max(res.x >> mipLevel, 1));
+	uint64 const height = static_cast<uint64>(std::max(res.y >> mipLevel, 1));
+	uint64 const layers = (texture.GetTargetType() == E_TextureType::CubeMap) ? 6u : static_cast<uint64>(std::max(texture.GetDepth(), 1));
+
+	uint64 const size = width * height * layers * GetChannelCount(layout) * static_cast<uint64>(DataTypeInfo::GetTypeSize(dataType));
+
+	m_Stats.textureUploads++;
+	m_Stats.textureBytes += size;
+	Record(E_Command::TextureUpload, "UploadTextureData", size);
+}
+
+//---------------------------------
+// RecordingContext::UploadCompressedTextureData
+//
+void RecordingContext::UploadCompressedTextureData(TextureData& texture, void const* const data, size_t const size, int32 const mipLevel)
+{
+	ET_UNUSED(data);
+	ET_UNUSED(mipLevel);
+
+	BindTexture(texture.GetTargetType(), texture.GetLocation(), true);
+
+	m_Stats.textureUploads++;
+	m_Stats.textureBytes += static_cast<uint64>(size);
+	Record(E_Command::TextureUpload, "UploadCompressedTextureData", static_cast<uint64>(size));
+}
+
+//---------------------------------
+// RecordingContext::AllocateTextureStorage
+//
+void RecordingContext::AllocateTextureStorage(TextureData& texture)
+{
+	BindTexture(texture.GetTargetType(), texture.GetLocation(), true);
+	Record(E_Command::Other, "AllocateTextureStorage", texture.GetLocation());
+}
+
+//---------------------------------
+// RecordingContext::SetTextureParams
+//
+void RecordingContext::SetTextureParams(TextureData const& texture, TextureParameters& prev, TextureParameters const& next, bool const force)
+{
+	ET_UNUSED(force);
+
+	prev = next;
+	Record(E_Command::Other, "SetTextureParams", texture.GetLocation());
+}
+
+//---------------------------------
+// RecordingContext::GenerateMipMaps
+//
+// Same level count a GL driver would produce
+//
+void RecordingContext::GenerateMipMaps(TextureData const& texture, uint8& mipLevels)
+{
+	BindTexture(texture.GetTargetType(), texture.GetLocation(), true);
+
+	ivec2 const res = texture.GetResolution();
+	float const largerRes = static_cast<float>(std::max(res.x, res.y));
+	mipLevels = 1u + static_cast<uint8>(floor(log10(largerRes) / log10(2.f)));
+
+	Record(E_Command::Other, "GenerateMipMaps", texture.GetLocation());
+}
+
+//---------------------------------
+// RecordingContext::SetTextureHandleResidency
+//
+void RecordingContext::SetTextureHandleResidency(T_TextureHandle const handle, bool const isResident) const
+{
+	ET_UNUSED(isResident);
+	Record(E_Command::Other, "SetTextureHandleResidency", handle);
+}
+
+//---------------------------------
+// RecordingContext::GetTextureData
+//
+// There is no GPU memory to read back from, so the output stays untouched
+//
+void RecordingContext::GetTextureData(TextureData const& texture, uint8 const mipLevel, E_ColorFormat const format, E_DataType const dataType, void* const data)
+{
+	ET_UNUSED(mipLevel);
+	ET_UNUSED(format);
+	ET_UNUSED(dataType);
+	ET_UNUSED(data);
+
+	Record(E_Command::Other, "GetTextureData", texture.GetLocation());
+}
+
+//---------------------------------
+// RecordingContext::CreateShader
+//
+T_ShaderLoc RecordingContext::CreateShader(E_ShaderType const type) const
+{
+	T_ShaderLoc const ret = GenerateHandle();
+	m_LiveShaders.emplace(ret);
+	m_Reflections.emplace(ret, ShaderReflection(type));
+	Record(E_Command::CreateObject, "CreateShader", ret);
+	return ret;
+}
+
+//---------------------------------
+// RecordingContext::CreateProgram
+//
+T_ShaderLoc RecordingContext::CreateProgram() const
+{
+	T_ShaderLoc const ret = GenerateHandle();
+	m_LiveShaders.emplace(ret);
+	Record(E_Command::CreateObject, "CreateProgram", ret);
+	return ret;
+}
+
+//---------------------------------
+// RecordingContext::DeleteShader
+//
+void RecordingContext::DeleteShader(T_ShaderLoc const shader)
+{
+	ET_ASSERT(m_LiveShaders.find(shader) != m_LiveShaders.cend(), "Deleting shader %u which doesn't exist", shader);
+
+	m_LiveShaders.erase(shader);
+	m_Reflections.erase(shader);
+	Record(E_Command::DeleteObject, "DeleteShader", shader);
+}
+
+//---------------------------------
+// RecordingContext::DeleteProgram
+//
+void RecordingContext::DeleteProgram(T_ShaderLoc const program)
+{
+	ET_ASSERT(m_LiveShaders.find(program) != m_LiveShaders.cend(), "Deleting program %u which doesn't exist", program);
+
+	m_LiveShaders.erase(program);
+	m_Reflections.erase(program);
+	m_AttachedShaders.erase(program);
+	Record(E_Command::DeleteObject, "DeleteProgram", program);
+}
+
+//---------------------------------
+// RecordingContext::CompileShader
+//
+// Parses the source instead of compiling it, so that linked programs can be reflected
+//
+void RecordingContext::CompileShader(T_ShaderLoc const shader, std::string const& source) const
+{
+	auto const foundIt = m_Reflections.find(shader);
+	ET_ASSERT(foundIt != m_Reflections.cend(), "Compiling shader %u which doesn't exist", shader);
+
+	foundIt->second.Parse(source);
+	Record(E_Command::Other, "CompileShader", shader);
+}
+
+//---------------------------------
+// RecordingContext::BindFragmentDataLocation
+//
+void RecordingContext::BindFragmentDataLocation(T_ShaderLoc const program, uint32 const colorNumber, std::string const& name) const
+{
+	ET_UNUSED(colorNumber);
+	ET_UNUSED(name);
+	Record(E_Command::Other, "BindFragmentDataLocation", program);
+}
+
+//---------------------------------
+// RecordingContext::AttachShader
+//
+void RecordingContext::AttachShader(T_ShaderLoc const program, T_ShaderLoc const shader) const
+{
+	m_AttachedShaders[program].push_back(shader);
+	Record(E_Command::Other, "AttachShader", shader);
+}
+
+//---------------------------------
+// RecordingContext::LinkProgram
+//
+// Merges the interfaces of the attached stages, the stages can be deleted afterwards like in GL
+//
+void RecordingContext::LinkProgram(T_ShaderLoc const program) const
+{
+	std::vector<ShaderReflection const*> stages;
+	for (T_ShaderLoc const shader : m_AttachedShaders[program])
+	{
+		stages.push_back(&GetReflection(shader));
+	}
+
+	m_Reflections[program].Link(stages);
+	Record(E_Command::Other, "LinkProgram", program);
+}
+
+//---------------------------------
+// RecordingContext::GetUniformBlockIndex
+//
+T_BlockIndex RecordingContext::GetUniformBlockIndex(T_ShaderLoc const program, std::string const& blockName) const
+{
+	std::vector<std::string> const& blocks = GetReflection(program).GetBlocks();
+
+	auto const foundIt = std::find(blocks.cbegin(), blocks.cend(), blockName);
+	return (foundIt != blocks.cend()) ? static_cast<T_BlockIndex>(foundIt - blocks.cbegin()) : -1;
+}
+
+//---------------------------------
+// RecordingContext::GetUniformBlockNames
+//
+std::vector<std::string> RecordingContext::GetUniformBlockNames(T_ShaderLoc const program) const
+{
+	return GetReflection(program).GetBlocks();
+}
+
+//---------------------------------
+// RecordingContext::GetUniformIndicesForBlock
+//
+std::vector<int32> RecordingContext::GetUniformIndicesForBlock(T_ShaderLoc const program, T_BlockIndex const blockIndex) const
+{
+	std::vector<ShaderReflection::Uniform> const& uniforms = GetReflection(program).GetUniforms();
+
+	std::vector<int32> ret;
+	for (size_t idx = 0u; idx < uniforms.size(); ++idx)
+	{
+		if (uniforms[idx].block == blockIndex)
+		{
+			ret.push_back(static_cast<int32>(idx));
+		}
+	}
+
+	return ret;
+}
+
+//---------------------------------
+// RecordingContext::SetUniformBlockBinding
+//
+void RecordingContext::SetUniformBlockBinding(T_ShaderLoc const program, T_BlockIndex const blockIndex, uint32 const bindingIndex) const
+{
+	ET_UNUSED(program);
+	ET_UNUSED(blockIndex);
+	Record(E_Command::Other, "SetUniformBlockBinding", bindingIndex);
+}
+
+//---------------------------------
+// RecordingContext::GetAttributeCount
+//
+int32 RecordingContext::GetAttributeCount(T_ShaderLoc const program) const
+{
+	return static_cast<int32>(GetReflection(program).GetAttributes().size());
+}
+
+//---------------------------------
+// RecordingContext::GetUniformCount
+//
+int32 RecordingContext::GetUniformCount(T_ShaderLoc const program) const
+{
+	return static_cast<int32>(GetReflection(program).GetUniforms().size());
+}
+
+//---------------------------------
+// RecordingContext::GetActiveUniforms
+//
+// Arrays are expanded into one descriptor per element, the same way the GL context does it
+//
+void RecordingContext::GetActiveUniforms(T_ShaderLoc const program, uint32 const index, std::vector<UniformDescriptor>& uniforms) const
+{
+	std::vector<ShaderReflection::Uniform> const& reflected = GetReflection(program).GetUniforms();
+	ET_ASSERT(index < reflected.size(), "Uniform index %u out of range", index);
+
+	ShaderReflection::Uniform const& uniform = reflected[index];
+
+	std::string const baseName = (uniform.arraySize > 1) ? uniform.name.substr(0u, uniform.name.rfind('[')) : uniform.name;
+	for (int32 arrayIdx = 0; arrayIdx < uniform.arraySize; ++arrayIdx)
+	{
+		uniforms.push_back(UniformDescriptor());
+		UniformDescriptor& uni = uniforms[uniforms.size() - 1];
+
+		uni.name = baseName;
+		if (uniform.arraySize > 1)
+		{
+			uni.name += "[" + std::to_string(arrayIdx) + "]";
+		}
+
+		uni.type = uniform.type;
+		uni.location = (uniform.location >= 0) ? (uniform.location + arrayIdx) : -1;
+
+		if (uniform.blockOffset >= 0)
+		{
+			uni.blockOffset = uniform.blockOffset + arrayIdx * uniform.arrayStride;
+		}
+	}
+}
+
+//---------------------------------
+// RecordingContext::GetActiveAttribute
+//
+void RecordingContext::GetActiveAttribute(T_ShaderLoc const program, uint32 const index, AttributeDescriptor& info) const
+{
+	std::vector<ShaderReflection::Attribute> const& attributes = GetReflection(program).GetAttributes();
+	ET_ASSERT(index < attributes.size(), "Attribute index %u out of range", index);
+
+	info = attributes[index].info;
+}
+
+//---------------------------------
+// RecordingContext::GetAttributeLocation
+//
+T_AttribLoc RecordingContext::GetAttributeLocation(T_ShaderLoc const program, std::string const& name) const
+{
+	for (ShaderReflection::Attribute const& attribute : GetReflection(program).GetAttributes())
+	{
+		if (attribute.info.name == name)
+		{
+			return attribute.location;
+		}
+	}
+
+	return -1;
+}
+
+//---------------------------------
+// RecordingContext::PopulateUniform
+//
+// Nothing is read back from a GPU, so uniforms hold the value they are initialized with in the source, or zero
+//
+void RecordingContext::PopulateUniform(T_ShaderLoc const program, T_UniformLoc const location, E_ParamType const type, void* data) const
+{
+	ShaderReflection::Uniform const* const uniform = GetReflection(program).FindUniform(location);
+	double const value = ((uniform != nullptr) && uniform->hasInitializer) ? uniform->initializer : 0.0;
+
+	switch (type)
+	{
+	case E_ParamType::Texture2D:
+	case E_ParamType::Texture3D:
+	case E_ParamType::TextureCube:
+	case E_ParamType::TextureShadow:
+		*static_cast<TextureData const**>(data) = nullptr;
+		return;
+	case E_ParamType::Matrix4x4:
+		*static_cast<mat4*>(data) = mat4() * static_cast<float>(value);
+		return;
+	case E_ParamType::Matrix3x3:
+		*static_cast<mat3*>(data) = mat3() * static_cast<float>(value);
+		return;
+	case E_ParamType::Vector4:
+		*static_cast<vec4*>(data) = vec4(static_cast<float>(value));
+		return;
+	case E_ParamType::Vector3:
+		*static_cast<vec3*>(data) = vec3(static_cast<float>(value));
+		return;
+	case E_ParamType::Vector2:
+		*static_cast<vec2*>(data) = vec2(static_cast<float>(value));
+		return;
+	case E_ParamType::UInt:
+		*static_cast<uint32*>(data) = static_cast<uint32>(value);
+		return;
+	case E_ParamType::Int:
+		*static_cast<int32*>(data) = static_cast<int32>(value);
+		return;
+	case E_ParamType::Float:
+		*static_cast<float*>(data) = static_cast<float>(value);
+		return;
+	case E_ParamType::Boolean:
+		*static_cast<bool*>(data) = (value != 0.0);
+		return;
+	}
+
+	ET_ASSERT(true, "Unhandled parameter type!");
+}
+
+//---------------------------------
+// RecordingContext::UploadUniform
+//
+void RecordingContext::UploadUniform(T_UniformLoc const location, bool const data) const
+{
+	ET_UNUSED(data);
+	UploadUniformInternal(location);
+}
+
+void RecordingContext::UploadUniform(T_UniformLoc const location, int32 const data) const
+{
+	ET_UNUSED(data);
+	UploadUniformInternal(location);
+}
+
+void RecordingContext::UploadUniform(T_UniformLoc const location, uint32 const data) const
+{
+	ET_UNUSED(data);
+	UploadUniformInternal(location);
+}
+
+void RecordingContext::UploadUniform(T_UniformLoc const location, float const data) const
+{
+	ET_UNUSED(data);
+	UploadUniformInternal(location);
+}
+
+void RecordingContext::UploadUniform(T_UniformLoc const location, vec2 const data) const
+{
+	ET_UNUSED(data);
+	UploadUniformInternal(location);
+}
+
+void RecordingContext::UploadUniform(T_UniformLoc const location, vec3 const& data) const
+{
+	ET_UNUSED(data);
+	UploadUniformInternal(location);
+}
+
+void RecordingContext::UploadUniform(T_UniformLoc const location, vec4 const& data) const
+{
+	ET_UNUSED(data);
+	UploadUniformInternal(location);
+}
+
+void RecordingContext::UploadUniform(T_UniformLoc const location, mat3 const& data) const
+{
+	ET_UNUSED(data);
+	UploadUniformInternal(location);
+}
+
+void RecordingContext::UploadUniform(T_UniformLoc const location, mat4 const& data) const
+{
+	ET_UNUSED(data);
+	UploadUniformInternal(location);
+}
+
+//---------------------------------
+// RecordingContext::DefineVertexAttributePointer
+//
+void RecordingContext::DefineVertexAttributePointer(uint32 const index,
+	int32 const size,
+	E_DataType const type,
+	bool const norm,
+	int32 const stride,
+	size_t const offset) const
+{
+	ET_UNUSED(size);
+	ET_UNUSED(type);
+	ET_UNUSED(norm);
+	ET_UNUSED(stride);
+	ET_UNUSED(offset);
+	Record(E_Command::Other, "DefineVertexAttributePointer", index);
+}
+
+//---------------------------------
+// RecordingContext::DefineVertexAttribIPointer
+//
+void RecordingContext::DefineVertexAttribIPointer(uint32 const index,
+	int32 const size,
+	E_DataType const type,
+	int32 const stride,
+	size_t const offset) const
+{
+	ET_UNUSED(size);
+	ET_UNUSED(type);
+	ET_UNUSED(stride);
+	ET_UNUSED(offset);
+	Record(E_Command::Other, "DefineVertexAttribIPointer", index);
+}
+
+//---------------------------------
+// RecordingContext::DefineVertexAttribDivisor
+//
+void RecordingContext::DefineVertexAttribDivisor(uint32 const index, uint32 const divisor) const
+{
+	ET_UNUSED(divisor);
+	Record(E_Command::Other, "DefineVertexAttribDivisor", index);
+}
+
+//---------------------------------
+// RecordingContext::GenFramebuffers
+//
+void RecordingContext::GenFramebuffers(int32 const n, T_FbLoc *ids) const
+{
+	for (int32 idx = 0; idx < n; ++idx)
+	{
+		ids[idx] = GenerateHandle();
+		m_LiveFramebuffers.emplace(ids[idx]);
+		Record(E_Command::CreateObject, "GenFramebuffers", ids[idx]);
+	}
+}
+
+//---------------------------------
+// RecordingContext::DeleteFramebuffers
+//
+void RecordingContext::DeleteFramebuffers(int32 const n, T_FbLoc *ids)
+{
+	for (int32 idx = 0; idx < n; ++idx)
+	{
+		ET_ASSERT(m_LiveFramebuffers.find(ids[idx]) != m_LiveFramebuffers.cend(), "Deleting framebuffer %u which doesn't exist", ids[idx]);
+
+		if (m_ReadFramebuffer == ids[idx])
+		{
+			m_ReadFramebuffer = 0u;
+		}
+
+		if (m_DrawFramebuffer == ids[idx])
+		{
+			m_DrawFramebuffer = 0u;
+		}
+
+		m_LiveFramebuffers.erase(ids[idx]);
+		Record(E_Command::DeleteObject, "DeleteFramebuffers", ids[idx]);
+	}
+}
+
+//---------------------------------
+// RecordingContext::GenRenderBuffers
+//
+void RecordingContext::GenRenderBuffers(int32 const n, T_RbLoc *ids) const
+{
+	for (int32 idx = 0; idx < n; ++idx)
+	{
+		ids[idx] = GenerateHandle();
+		m_LiveRenderbuffers.emplace(ids[idx]);
+		Record(E_Command::CreateObject, "GenRenderBuffers", ids[idx]);
+	}
+}
+
+//---------------------------------
+// RecordingContext::DeleteRenderBuffers
+//
+void RecordingContext::DeleteRenderBuffers(int32 const n, T_RbLoc *ids)
+{
+	for (int32 idx = 0; idx < n; ++idx)
+	{
+		ET_ASSERT(m_LiveRenderbuffers.find(ids[idx]) != m_LiveRenderbuffers.cend(), "Deleting renderbuffer %u which doesn't exist", ids[idx]);
+
+		if (m_Renderbuffer == ids[idx])
+		{
+			m_Renderbuffer = 0u;
+		}
+
+		m_LiveRenderbuffers.erase(ids[idx]);
+		Record(E_Command::DeleteObject, "DeleteRenderBuffers", ids[idx]);
+	}
+}
+
+//---------------------------------
+// RecordingContext::SetRenderbufferStorage
+//
+void RecordingContext::SetRenderbufferStorage(E_RenderBufferFormat const format, ivec2 const dimensions) const
+{
+	ET_UNUSED(format);
+	ET_UNUSED(dimensions);
+	Record(E_Command::Other, "SetRenderbufferStorage", m_Renderbuffer);
+}
+
+//---------------------------------
+// RecordingContext::LinkTextureToFbo
+//
+void RecordingContext::LinkTextureToFbo(uint8 const attachment, T_TextureLoc const texHandle, int32 const level) const
+{
+	ET_UNUSED(attachment);
+	ET_UNUSED(level);
+	Record(E_Command::Other, "LinkTextureToFbo", texHandle);
+}
+
+//---------------------------------
+// RecordingContext::LinkTextureToFbo2D
+//
+void RecordingContext::LinkTextureToFbo2D(uint8 const attachment, T_TextureLoc const texHandle, int32 const level) const
+{
+	ET_UNUSED(attachment);
+	ET_UNUSED(level);
+	Record(E_Command::Other, "LinkTextureToFbo2D", texHandle);
+}
+
+//---------------------------------
+// RecordingContext::LinkCubeMapFaceToFbo2D
+//
+void RecordingContext::LinkCubeMapFaceToFbo2D(uint8 const face, T_TextureLoc const texHandle, int32 const level) const
+{
+	ET_UNUSED(face);
+	ET_UNUSED(level);
+	Record(E_Command::Other, "LinkCubeMapFaceToFbo2D", texHandle);
+}
+
+//---------------------------------
+// RecordingContext::LinkTextureToFboDepth
+//
+void RecordingContext::LinkTextureToFboDepth(T_TextureLoc const texHandle) const
+{
+	Record(E_Command::Other, "LinkTextureToFboDepth", texHandle);
+}
+
+//---------------------------------
+// RecordingContext::LinkRenderbufferToFbo
+//
+void RecordingContext::LinkRenderbufferToFbo(E_RenderBufferFormat const attachment, uint32 const rboHandle) const
+{
+	ET_UNUSED(attachment);
+	Record(E_Command::Other, "LinkRenderbufferToFbo", rboHandle);
+}
+
+//---------------------------------
+// RecordingContext::SetDrawBufferCount
+//
+void RecordingContext::SetDrawBufferCount(size_t const count) const
+{
+	RecordStateChange("SetDrawBufferCount");
+	ET_UNUSED(count);
+}
+
+//---------------------------------
+// RecordingContext::SetReadBufferEnabled
+//
+void RecordingContext::SetReadBufferEnabled(bool const val) const
+{
+	RecordStateChange("SetReadBufferEnabled");
+	ET_UNUSED(val);
+}
+
+//---------------------------------
+// RecordingContext::CopyDepthReadToDrawFbo
+//
+void RecordingContext::CopyDepthReadToDrawFbo(ivec2 const source, ivec2 const target) const
+{
+	ET_UNUSED(source);
+	ET_UNUSED(target);
+	Record(E_Command::Other, "CopyDepthReadToDrawFbo", m_DrawFramebuffer);
+}
+
+//---------------------------------
+// RecordingContext::SetPixelUnpackAlignment
+//
+void RecordingContext::SetPixelUnpackAlignment(int32 const val) const
+{
+	RecordStateChange("SetPixelUnpackAlignment");
+	ET_UNUSED(val);
+}
+
+//---------------------------------
+// RecordingContext::ReadPixels
+//
+// There is no framebuffer memory to read back from, so the output stays untouched
+//
+void RecordingContext::ReadPixels(ivec2 const pos, ivec2 const size, E_ColorFormat const format, E_DataType const type, void* data) const
+{
+	ET_UNUSED(pos);
+	ET_UNUSED(format);
+	ET_UNUSED(type);
+	ET_UNUSED(data);
+	Record(E_Command::Other, "ReadPixels", static_cast<uint64>(size.x) * static_cast<uint64>(size.y));
+}
+
+//---------------------------------
+// RecordingContext::DebugPushGroup
+//
+void RecordingContext::DebugPushGroup(std::string const& message, bool const isThirdParty) const
+{
+	ET_UNUSED(message);
+	ET_UNUSED(isThirdParty);
+	Record(E_Command::Other, "DebugPushGroup");
+}
+
+//---------------------------------
+// RecordingContext::DebugPopGroup
+//
+void RecordingContext::DebugPopGroup() const
+{
+	Record(E_Command::Other, "DebugPopGroup");
+}
+
+
+//=========
+// Utility
+//=========
+
+
+//---------------------------------
+// RecordingContext::Record
+//
+// Add a command to the log if it is enabled
+//
+void RecordingContext::Record(E_Command const type, char const* const name, uint64 const value) const
+{
+	if (m_IsLogEnabled)
+	{
+		m_Commands.push_back(Command{ type, name, value });
+	}
+}
+
+//---------------------------------
+// RecordingContext::RecordStateChange
+//
+void RecordingContext::RecordStateChange(char const* const name) const
+{
+	m_Stats.stateChanges++;
+	Record(E_Command::StateChange, name);
+}
+
+//---------------------------------
+// RecordingContext::SetState
+//
+// Only changes that would have reached the API count as state changes
+//
+template<typename TValue>
+void RecordingContext::SetState(TValue& state, TValue const value, char const* const name)
+{
+	if (!(state == value))
+	{
+		state = value;
+		RecordStateChange(name);
+	}
+}
+
+//---------------------------------
+// RecordingContext::GetReflection
+//
+ShaderReflection const& RecordingContext::GetReflection(T_ShaderLoc const shader) const
+{
+	static ShaderReflection const s_Empty;
+
+	auto const foundIt = m_Reflections.find(shader);
+	ET_ASSERT(foundIt != m_Reflections.cend(), "No shader or program with handle %u", shader);
+
+	return (foundIt != m_Reflections.cend()) ? foundIt->second : s_Empty;
+}
+
+//---------------------------------
+// RecordingContext::UploadUniformInternal
+//
+void RecordingContext::UploadUniformInternal(T_UniformLoc const location) const
+{
+	m_Stats.uniformUploads++;
+	Record(E_Command::UniformUpload, "UploadUniform", static_cast<uint64>(location));
+}
+
+
+} // namespace render
+} // namespace et
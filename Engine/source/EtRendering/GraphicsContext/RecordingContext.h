@@ -0,0 +1,426 @@
+#pragma once
+#include <map>
+#include <unordered_set>
+
+#include "GraphicsContextApi.h"
+#include "ShaderReflection.h"
+
+
+namespace et {
+namespace render {
+
+
+//---------------------------------
+// RecordingContext
+//
+// Graphics API implementation that doesn't talk to a GPU, instead it records the calls it receives into a command log and counts them
+//  - object handles are fake but unique, so renderers can create and delete resources as usual
+//  - binds are filtered the same way the GL context does it, so redundant binds show up in the stats
+//  - shader sources are parsed on compilation, so programs reflect their uniforms and attributes like they would with a driver
+//
+class RecordingContext final : public I_GraphicsContextApi
+{
+public:
+	// definitions
+	//-------------
+
+	//---------------------------------
+	// E_Command
+	//
+	// Category of a recorded call
+	//
+	enum class E_Command : uint8
+	{
+		StateChange,
+		BindShader,
+		BindTexture,
+		BindBuffer,
+		BindVertexArray,
+		BindFramebuffer,
+		Draw,
+		DrawInstanced,
+		Clear,
+		BufferData,
+		BufferMap,
+		TextureUpload,
+		UniformUpload,
+		CreateObject,
+		DeleteObject,
+		Other
+	};
+
+	//---------------------------------
+	// Command
+	//
+	// Single entry in the command log, the value depends on the command (handle, index count or byte count)
+	//
+	struct Command final
+	{
+		E_Command type;
+		char const* name;
+		uint64 value;
+	};
+
+	//---------------------------------
+	// Stats
+	//
+	// Counters accumulated since the last reset
+	//
+	struct Stats final
+	{
+		uint32 drawCalls = 0u;
+		uint32 instancedDrawCalls = 0u;
+		uint64 elements = 0u; // vertices or indices
+		uint64 instances = 0u;
+
+		uint32 shaderBinds = 0u;
+		uint32 textureBinds = 0u;
+		uint32 bufferBinds = 0u;
+		uint32 vertexArrayBinds = 0u;
+		uint32 framebufferBinds = 0u;
+		uint32 redundantBinds = 0u; // binds that didn't change anything
+
+		uint32 stateChanges = 0u;
+		uint32 uniformUploads = 0u;
+		uint32 clears = 0u;
+
+		uint32 bufferUploads = 0u;
+		uint32 bufferMaps = 0u;
+		uint32 fenceWaits = 0u;
+		uint64 bufferBytes = 0u;
+
+		uint32 textureUploads = 0u;
+		uint64 textureBytes = 0u;
+	};
+
+	static constexpr T_TextureUnit s_TextureUnitCount = 32u;
+
+	// init deinit
+	//--------------
+	RecordingContext() : I_GraphicsContextApi() {}
+	~RecordingContext() = default;
+
+	// functionality
+	//---------------
+	void SetLogEnabled(bool const enabled) { m_IsLogEnabled = enabled; } // stats are always counted, the command log only when enabled
+	void Reset();
+
+	// accessors
+	//-----------
+	Stats const& GetStats() const { return m_Stats; }
+	std::vector<Command> const& GetCommands() const { return m_Commands; }
+
+	size_t GetLiveBufferCount() const { return m_LiveBuffers.size(); }
+	size_t GetLiveVertexArrayCount() const { return m_LiveVertexArrays.size(); }
+	size_t GetLiveTextureCount() const { return m_LiveTextures.size(); }
+	size_t GetLiveShaderCount() const { return m_LiveShaders.size(); }
+	size_t GetLiveFramebufferCount() const { return m_LiveFramebuffers.size(); }
+	size_t GetLiveRenderbufferCount() const { return m_LiveRenderbuffers.size(); }
+	size_t GetLiveFenceCount() const { return m_LiveFences.size(); }
+
+	//===============================
+	// Interface implementation
+	//===============================
+
+	void Initialize(ivec2 const dimensions) override;
+
+	// State changes
+	//--------------
+	void SetDepthEnabled(bool const enabled) override;
+	void SetBlendEnabled(bool const enabled) override;
+	void SetBlendEnabled(bool const enabled, uint32 const index) override;
+	void SetBlendEnabled(std::vector<bool> const& blendBuffers) override;
+	void SetStencilEnabled(bool const enabled) override;
+	void SetCullEnabled(bool const enabled) override;
+	void SetScissorEnabled(bool const enabled) override;
+
+	void SetColorMask(T_ColorFlags const flags) override;
+	void SetDepthMask(bool const flag) override;
+	void SetStencilMask(uint32 const mask) override;
+
+	void SetFaceCullingMode(E_FaceCullMode const cullMode) override;
+	void SetPolygonMode(E_FaceCullMode const cullMode, E_PolygonMode const mode) override;
+
+	void SetBlendEquation(E_BlendEquation const equation) override;
+	void SetBlendFunction(E_BlendFactor const sFactor, E_BlendFactor const dFactor) override;
+	void SetBlendFunctionSeparate(E_BlendFactor const sRGB, E_BlendFactor const sAlpha, E_BlendFactor const dRGB, E_BlendFactor const dAlpha) override;
+
+	void SetDepthFunction(E_DepthFunc const func) override;
+
+	void SetStencilFunction(T_StencilFunc const func, int32 const reference, uint32 const mask) override;
+	void SetStencilOperation(E_StencilOp const sFail, E_StencilOp const dFail, E_StencilOp const dsPass) override;
+
+	void SetScissor(ivec2 const pos, ivec2 const size) override;
+
+	void SetViewport(ivec2 const pos, ivec2 const size) override;
+	void GetViewport(ivec2& pos, ivec2& size) override;
+
+	void SetClearColor(vec4 const& col) override;
+
+	void SetShader(ShaderData const* pShader) override;
+
+	void BindFramebuffer(T_FbLoc const handle) override;
+	void BindReadFramebuffer(T_FbLoc const handle) override;
+	void BindDrawFramebuffer(T_FbLoc const handle) override;
+
+	void BindRenderbuffer(T_RbLoc const handle) override;
+
+	T_TextureUnit BindTexture(E_TextureType const target, T_TextureLoc const texLoc, bool const ensureActive) override;
+	void UnbindTexture(E_TextureType const target, T_TextureLoc const texLoc) override;
+
+	void BindVertexArray(T_ArrayLoc const vertexArray) override;
+	void BindBuffer(E_BufferType const target, T_BufferLoc const buffer) override;
+
+	void SetLineWidth(float const lineWidth) override;
+
+	T_FbLoc GetActiveFramebuffer() override { return m_ReadFramebuffer; }
+
+	//Draw Calls
+	//--------------
+	void DrawArrays(E_DrawMode const mode, uint32 const first, uint32 const count) override;
+	void DrawElements(E_DrawMode const mode, uint32 const count, E_DataType const type, const void * indices) override;
+	void DrawElementsInstanced(E_DrawMode const mode,
+		uint32 const count,
+		E_DataType const type,
+		const void * indices,
+		uint32 const primcount) override;
+	void DrawElementsBaseVertex(E_DrawMode const mode,
+		uint32 const count,
+		E_DataType const type,
+		const void * indices,
+		int32 const baseVertex) override;
+	void DrawElementsInstancedBaseVertex(E_DrawMode const mode,
+		uint32 const count,
+		E_DataType const type,
+		const void * indices,
+		uint32 const primcount,
+		int32 const baseVertex) override;
+	void DrawElementsInstancedBaseVertexBaseInstance(E_DrawMode const mode,
+		uint32 const count,
+		E_DataType const type,
+		const void * indices,
+		uint32 const primcount,
+		int32 const baseVertex,
+		uint32 const baseInstance) override;
+
+	// other commands
+	//--------------
+	void Flush() const override;
+	void Finish() const override;
+	void Clear(T_ClearFlags const mask) const override;
+
+	T_FenceLoc InsertFence() const override;
+	void WaitForFence(T_FenceLoc const fence) const override;
+	void DeleteFence(T_FenceLoc& fence) const override;
+
+	T_ArrayLoc CreateVertexArray() const override;
+	T_BufferLoc CreateBuffer() const override;
+
+	void DeleteVertexArray(T_ArrayLoc& loc) const override;
+	void DeleteBuffer(T_BufferLoc& loc) const override;
+
+	void SetBufferData(E_BufferType const target,
+		int64 const size,
+		void const* const data,
+		E_UsageHint const usage) const override;
+	void SetBufferSubData(E_BufferType const target,
+		int64 const offset,
+		int64 const size,
+		void const* const data) const override;
+	void SetVertexAttributeArrayEnabled(uint32 const index, bool const enabled) const override;
+
+	void* MapBuffer(E_BufferType const target, E_AccessMode const access) const override;
+	void UnmapBuffer(E_BufferType const target) const override;
+	void* SetPersistentBufferStorage(E_BufferType const target, int64 const size) const override;
+
+	void BindBufferRange(E_BufferType const target,
+		uint32 const index,
+		T_BufferLoc const buffer,
+		size_t const offset,
+		size_t const size) const override;
+
+	T_TextureLoc GenerateTexture() const override;
+	void DeleteTexture(T_TextureLoc& texLoc) override;
+	void UploadTextureData(TextureData& texture,
+		void const* const data,
+		E_ColorFormat const layout,
+		E_DataType const dataType,
+		int32 const mipLevel) override;
+	void UploadCompressedTextureData(TextureData& texture, void const* const data, size_t const size, int32 const mipLevel) override;
+	void AllocateTextureStorage(TextureData& texture) override;
+	void SetTextureParams(TextureData const& texture,
+		TextureParameters& prev,
+		TextureParameters const& next,
+		bool const force) override;
+	void GenerateMipMaps(TextureData const& texture, uint8& mipLevels) override;
+	T_TextureHandle GetTextureHandle(T_TextureLoc const texLoc) const override { return static_cast<T_TextureHandle>(texLoc); }
+	void SetTextureHandleResidency(T_TextureHandle const handle, bool const isResident) const override;
+	void GetTextureData(TextureData const& texture,
+		uint8 const mipLevel,
+		E_ColorFormat const format,
+		E_DataType const dataType,
+		void* const data) override;
+
+	T_ShaderLoc CreateShader(E_ShaderType const type) const override;
+	T_ShaderLoc CreateProgram() const override;
+	void DeleteShader(T_ShaderLoc const shader) override;
+	void DeleteProgram(T_ShaderLoc const program) override;
+
+	void CompileShader(T_ShaderLoc const shader, std::string const& source) const override;
+	void BindFragmentDataLocation(T_ShaderLoc const program, uint32 const colorNumber, std::string const& name) const override;
+	void AttachShader(T_ShaderLoc const program, T_ShaderLoc const shader) const override;
+	void LinkProgram(T_ShaderLoc const program) const override;
+
+	bool IsShaderCompiled(T_ShaderLoc const shader) const override { return true; }
+	void GetShaderInfo(T_ShaderLoc const shader, std::string& info) const override { info.clear(); }
+
+	T_BlockIndex GetUniformBlockIndex(T_ShaderLoc const program, std::string const& blockName) const override;
+	bool IsBlockIndexValid(T_BlockIndex const index) const override { return index >= 0; }
+	std::vector<std::string> GetUniformBlockNames(T_ShaderLoc const program) const override;
+	std::vector<int32> GetUniformIndicesForBlock(T_ShaderLoc const program, T_BlockIndex const blockIndex) const override;
+
+	void SetUniformBlockBinding(T_ShaderLoc const program, T_BlockIndex const blockIndex, uint32 const bindingIndex) const override;
+
+	int32 GetAttributeCount(T_ShaderLoc const program) const override;
+	int32 GetUniformCount(T_ShaderLoc const program) const override;
+	void GetActiveUniforms(T_ShaderLoc const program, uint32 const index, std::vector<UniformDescriptor>& uniforms) const override;
+	void GetActiveAttribute(T_ShaderLoc const program, uint32 const index, AttributeDescriptor& info) const override;
+	T_AttribLoc GetAttributeLocation(T_ShaderLoc const program, std::string const& name) const override;
+
+	void PopulateUniform(T_ShaderLoc const program, T_UniformLoc const location, E_ParamType const type, void* data) const override;
+
+	void UploadUniform(T_UniformLoc const location, bool const data) const override;
+	void UploadUniform(T_UniformLoc const location, int32 const data) const override;
+	void UploadUniform(T_UniformLoc const location, uint32 const data) const override;
+	void UploadUniform(T_UniformLoc const location, float const data) const override;
+	void UploadUniform(T_UniformLoc const location, vec2 const data) const override;
+	void UploadUniform(T_UniformLoc const location, vec3 const& data) const override;
+	void UploadUniform(T_UniformLoc const location, vec4 const& data) const override;
+	void UploadUniform(T_UniformLoc const location, mat3 const& data) const override;
+	void UploadUniform(T_UniformLoc const location, mat4 const& data) const override;
+
+	void DefineVertexAttributePointer(uint32 const index,
+		int32 const size,
+		E_DataType const type,
+		bool const norm,
+		int32 const stride,
+		size_t const offset) const override;
+	void DefineVertexAttribIPointer(uint32 const index,
+		int32 const size,
+		E_DataType const type,
+		int32 const stride,
+		size_t const offset) const override;
+	void DefineVertexAttribDivisor(uint32 const index, uint32 const divisor) const override;
+
+	void GenFramebuffers(int32 const n, T_FbLoc *ids) const override;
+	void DeleteFramebuffers(int32 const n, T_FbLoc *ids) override;
+
+	void GenRenderBuffers(int32 const n, T_RbLoc *ids) const override;
+	void DeleteRenderBuffers(int32 const n, T_RbLoc *ids) override;
+
+	void SetRenderbufferStorage(E_RenderBufferFormat const format, ivec2 const dimensions) const override;
+
+	void LinkTextureToFbo(uint8 const attachment, T_TextureLoc const texHandle, int32 const level) const override;
+	void LinkTextureToFbo2D(uint8 const attachment, T_TextureLoc const texHandle, int32 const level) const override;
+	void LinkCubeMapFaceToFbo2D(uint8 const face, T_TextureLoc const texHandle, int32 const level) const override;
+	void LinkTextureToFboDepth(T_TextureLoc const texHandle) const override;
+
+	void LinkRenderbufferToFbo(E_RenderBufferFormat const attachment, uint32 const rboHandle) const override;
+
+	void SetDrawBufferCount(size_t const count) const override;
+	void SetReadBufferEnabled(bool const val) const override;
+
+	bool IsFramebufferComplete() const override { return true; }
+
+	void CopyDepthReadToDrawFbo(ivec2 const source, ivec2 const target) const override;
+
+	void SetPixelUnpackAlignment(int32 const val) const override;
+
+	void ReadPixels(ivec2 const pos, ivec2 const size, E_ColorFormat const format, E_DataType const type, void* data) const override;
+
+	void DebugPushGroup(std::string const& message, bool const isThirdParty = false) const override;
+	void DebugPopGroup() const override;
+
+private:
+
+	//=========
+	// Utility
+	//=========
+
+	void Record(E_Command const type, char const* const name, uint64 const value = 0u) const;
+	void RecordStateChange(char const* const name) const;
+
+	template<typename TValue>
+	void SetState(TValue& state, TValue const value, char const* const name);
+
+	uint32 GenerateHandle() const { return m_NextHandle++; }
+	ShaderReflection const& GetReflection(T_ShaderLoc const shader) const;
+	void UploadUniformInternal(T_UniformLoc const location) const;
+
+	//================
+	// Current State
+	//================
+
+	// Data
+	///////
+
+	bool m_IsLogEnabled = false;
+	mutable std::vector<Command> m_Commands;
+	mutable Stats m_Stats;
+
+	// fake object handles, 0 is reserved for the default object like in GL
+	mutable uint32 m_NextHandle = 1u;
+	mutable std::unordered_set<T_BufferLoc> m_LiveBuffers;
+	mutable std::unordered_set<T_ArrayLoc> m_LiveVertexArrays;
+	mutable std::unordered_set<T_TextureLoc> m_LiveTextures;
+	mutable std::unordered_set<T_ShaderLoc> m_LiveShaders; // programs and shader stages
+	mutable std::unordered_set<T_FbLoc> m_LiveFramebuffers;
+	mutable std::unordered_set<T_RbLoc> m_LiveRenderbuffers;
+	mutable std::unordered_set<T_FenceLoc> m_LiveFences;
+
+	// interfaces of shader stages and linked programs
+	mutable std::unordered_map<T_ShaderLoc, ShaderReflection> m_Reflections;
+	mutable std::unordered_map<T_ShaderLoc, std::vector<T_ShaderLoc>> m_AttachedShaders;
+
+	// CPU side copies so that mapped buffers can be written to
+	mutable std::unordered_map<T_BufferLoc, std::vector<uint8>> m_BufferStorage;
+
+	// bound state
+	T_FbLoc m_ReadFramebuffer = 0u;
+	T_FbLoc m_DrawFramebuffer = 0u;
+	T_RbLoc m_Renderbuffer = 0u;
+
+	bool m_DepthTestEnabled = false;
+	bool m_BlendEnabled = false;
+	bool m_StencilTestEnabled = false;
+	bool m_CullFaceEnabled = false;
+	bool m_ScissorEnabled = false;
+
+	T_ColorFlags m_ColorMask = E_ColorFlag::CF_All;
+	bool m_DepthMask = true;
+	uint32 m_StencilMask = 0xFFFFFFFFu;
+
+	E_FaceCullMode m_CullFaceMode = E_FaceCullMode::Back;
+	E_BlendEquation m_BlendEquation = E_BlendEquation::Add;
+	E_DepthFunc m_DepthFunc = E_DepthFunc::Less;
+
+	ivec2 m_ScissorPosition = ivec2(0);
+	ivec2 m_ScissorSize;
+	ivec2 m_ViewportPosition = ivec2(0);
+	ivec2 m_ViewportSize;
+
+	vec4 m_ClearColor = vec4(0.f);
+	float m_LineWidth = 1.f;
+
+	ShaderData const* m_pBoundShader = nullptr;
+
+	T_TextureLoc m_TextureUnits[s_TextureUnitCount] = {};
+	T_TextureUnit m_NextTextureUnit = 0u;
+
+	T_ArrayLoc m_VertexArray = 0u;
+	std::map<E_BufferType, T_BufferLoc> m_BufferTargets;
+};
+
+
+} // namespace render
+} // namespace et
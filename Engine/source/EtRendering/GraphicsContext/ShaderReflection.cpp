@@ -0,0 +1,775 @@
+#include "stdafx.h"
+#include "ShaderReflection.h"
+
+#include <cctype>
+#include <unordered_set>
+
+#include <EtRendering/GraphicsTypes/ParameterBlock.h>
+
+
+namespace et {
+namespace render {
+
+
+namespace {
+
+	//---------------------------------
+	// ParseParamType
+	//
+	// Uniform type from its GLSL name, invalid for types parameters can't hold
+	//
+	E_ParamType ParseParamType(std::string const& type)
+	{
+		static std::unordered_map<std::string, E_ParamType> const s_Types = {
+			{ "sampler2D", E_ParamType::Texture2D },
+			{ "sampler3D", E_ParamType::Texture3D },
+			{ "samplerCube", E_ParamType::TextureCube },
+			{ "sampler2DShadow", E_ParamType::TextureShadow },
+			{ "mat4", E_ParamType::Matrix4x4 },
+			{ "mat3", E_ParamType::Matrix3x3 },
+			{ "vec4", E_ParamType::Vector4 },
+			{ "vec3", E_ParamType::Vector3 },
+			{ "vec2", E_ParamType::Vector2 },
+			{ "uint", E_ParamType::UInt },
+			{ "int", E_ParamType::Int },
+			{ "float", E_ParamType::Float },
+			{ "bool", E_ParamType::Boolean }
+		};
+
+		auto const foundIt = s_Types.find(type);
+		return (foundIt != s_Types.cend()) ? foundIt->second : E_ParamType::Invalid;
+	}
+
+	//---------------------------------
+	// ParseAttributeType
+	//
+	// Component type and count of a vertex input, returns false for types that can't be vertex inputs
+	//
+	bool ParseAttributeType(std::string const& type, AttributeDescriptor& info, uint32& slots)
+	{
+		slots = 1u;
+
+		size_t prefixLength = 0u;
+		if (type.compare(0u, 5u, "float") == 0)
+		{
+			info.dataType = E_DataType::Float;
+			info.dataCount = 1u;
+			return (type.size() == 5u);
+		}
+		else if (type.compare(0u, 6u, "double") == 0)
+		{
+			info.dataType = E_DataType::Double;
+			info.dataCount = 1u;
+			return (type.size() == 6u);
+		}
+		else if ((type == "int") || (type == "uint"))
+		{
+			info.dataType = (type == "int") ? E_DataType::Int : E_DataType::UInt;
+			info.dataCount = 1u;
+			return true;
+		}
+
+		// vectors and matrices, the dimensions follow the prefix
+		if (type.compare(0u, 3u, "vec") == 0)
+		{
+			info.dataType = E_DataType::Float;
+		}
+		else if ((type.compare(0u, 4u, "ivec") == 0) || (type.compare(0u, 4u, "uvec") == 0) || (type.compare(0u, 4u, "dvec") == 0))
+		{
+			info.dataType = (type[0] == 'i') ? E_DataType::Int : ((type[0] == 'u') ? E_DataType::UInt : E_DataType::Double);
+			prefixLength = 1u;
+		}
+		else if (type.compare(0u, 3u, "mat") == 0)
+		{
+			info.dataType = E_DataType::Float;
+		}
+		else if (type.compare(0u, 4u, "dmat") == 0)
+		{
+			info.dataType = E_DataType::Double;
+			prefixLength = 1u;
+		}
+		else
+		{
+			return false;
+		}
+
+		bool const isMatrix = (type[prefixLength] == 'm');
+		prefixLength += 3u;
+		if ((type.size() <= prefixLength) || !std::isdigit(type[prefixLength]))
+		{
+			return false;
+		}
+
+		uint32 const columns = static_cast<uint32>(type[prefixLength] - '0');
+		if (!isMatrix)
+		{
+			info.dataCount = columns;
+			return (type.size() == prefixLength + 1u);
+		}
+
+		// matNxM has N columns of M rows
+		uint32 rows = columns;
+		if ((type.size() == prefixLength + 3u) && (type[prefixLength + 1u] == 'x') && std::isdigit(type[prefixLength + 2u]))
+		{
+			rows = static_cast<uint32>(type[prefixLength + 2u] - '0');
+		}
+		else if (type.size() != prefixLength + 1u)
+		{
+			return false;
+		}
+
+		info.dataCount = columns * rows;
+		slots = columns;
+		return true;
+	}
+
+	//---------------------------------
+	// IsQualifier
+	//
+	// Keywords that can precede a declaration without changing how it is reflected
+	//
+	bool IsQualifier(std::string const& token)
+	{
+		static std::unordered_set<std::string> const s_Qualifiers = {
+			"flat", "smooth", "noperspective", "centroid", "sample", "patch", "invariant", "precise", "highp", "mediump", "lowp"
+		};
+
+		return (s_Qualifiers.find(token) != s_Qualifiers.cend());
+	}
+
+	//---------------------------------
+	// IsIdentifier
+	//
+	bool IsIdentifier(std::string const& token)
+	{
+		return (!token.empty() && (std::isalpha(token[0]) || (token[0] == '_')));
+	}
+
+	//---------------------------------
+	// ParseInteger
+	//
+	// Reads integer literals such as 4 or 4u, returns false for anything else
+	//
+	bool ParseInteger(std::string const& token, int32& value)
+	{
+		if (token.empty() || !std::isdigit(token[0]))
+		{
+			return false;
+		}
+
+		size_t end = 0u;
+		value = std::stoi(token, &end, 0);
+		return ((end == token.size()) || ((end + 1u == token.size()) && ((token[end] == 'u') || (token[end] == 'U'))));
+	}
+
+	//---------------------------------
+	// GetStd140Size
+	//
+	// Like the parameter version, but also for samplers, which can only be in blocks as bindless handles
+	//
+	int32 GetStd140Size(E_ParamType const type)
+	{
+		switch (type)
+		{
+		case E_ParamType::Texture2D:
+		case E_ParamType::Texture3D:
+		case E_ParamType::TextureCube:
+		case E_ParamType::TextureShadow:
+			return static_cast<int32>(sizeof(uint64));
+		}
+
+		return static_cast<int32>(parameters::GetStd140Size(type));
+	}
+
+	//---------------------------------
+	// GetStd140Alignment
+	//
+	// Scalars and two component vectors align to their size, everything larger to a vec4
+	//
+	int32 GetStd140Alignment(E_ParamType const type)
+	{
+		int32 const size = GetStd140Size(type);
+		return (size <= 8) ? size : 16;
+	}
+
+	//---------------------------------
+	// AlignOffset
+	//
+	int32 AlignOffset(int32 const offset, int32 const alignment)
+	{
+		return ((offset + alignment - 1) / alignment) * alignment;
+	}
+
+} // namespace
+
+
+//===================
+// Shader Reflection
+//===================
+
+
+//---------------------------------
+// ShaderReflection::Parse
+//
+// Extract the interface of a shader stage from its source
+//  - uniforms, uniform blocks and structs used by uniforms, and for vertex shaders the inputs
+//  - array sizes can be literals or integer constants and defines declared earlier in the source
+//
+void ShaderReflection::Parse(std::string const& source)
+{
+	m_Uniforms.clear();
+	m_Blocks.clear();
+	m_Attributes.clear();
+
+	T_Tokens tokens;
+	Tokenize(source, tokens);
+
+	// split into top level statements - declarations with a body continue until the semicolon, function definitions end with their body
+	T_Tokens statement;
+	int32 depth = 0;
+	bool isFunction = false;
+	for (std::string const& token : tokens)
+	{
+		statement.push_back(token);
+
+		if (token == "{")
+		{
+			if (depth == 0)
+			{
+				isFunction = ((statement.size() > 1u) && (statement[statement.size() - 2u] == ")"));
+			}
+
+			++depth;
+		}
+		else if (token == "}")
+		{
+			--depth;
+			if ((depth == 0) && isFunction)
+			{
+				statement.clear();
+			}
+		}
+		else if ((token == ";") && (depth == 0))
+		{
+			ParseStatement(statement);
+			statement.clear();
+		}
+	}
+
+	m_Constants.clear();
+	m_Structs.clear();
+}
+
+//---------------------------------
+// ShaderReflection::Link
+//
+// Merge the interfaces of all stages in a program and assign locations
+//  - uniforms and blocks declared in several stages are only listed once
+//  - inputs without an explicit location get the lowest free ones
+//
+void ShaderReflection::Link(std::vector<ShaderReflection const*> const& stages)
+{
+	m_Uniforms.clear();
+	m_Blocks.clear();
+	m_Attributes.clear();
+
+	for (ShaderReflection const* const stage : stages)
+	{
+		std::vector<T_BlockIndex> blockIndices;
+		for (std::string const& block : stage->GetBlocks())
+		{
+			auto const foundIt = std::find(m_Blocks.cbegin(), m_Blocks.cend(), block);
+			blockIndices.push_back(static_cast<T_BlockIndex>(foundIt - m_Blocks.cbegin()));
+			if (foundIt == m_Blocks.cend())
+			{
+				m_Blocks.push_back(block);
+			}
+		}
+
+		for (Uniform const& uniform : stage->GetUniforms())
+		{
+			if (std::find_if(m_Uniforms.cbegin(), m_Uniforms.cend(), [&uniform](Uniform const& existing)
+				{
+					return (existing.name == uniform.name);
+				}) != m_Uniforms.cend())
+			{
+				continue;
+			}
+
+			m_Uniforms.push_back(uniform);
+			if (uniform.block >= 0)
+			{
+				m_Uniforms.back().block = blockIndices[static_cast<size_t>(uniform.block)];
+			}
+		}
+
+		if (stage->GetType() == E_ShaderType::Vertex)
+		{
+			m_Attributes.insert(m_Attributes.end(), stage->GetAttributes().cbegin(), stage->GetAttributes().cend());
+		}
+	}
+
+	T_UniformLoc location = 0;
+	for (Uniform& uniform : m_Uniforms)
+	{
+		if (uniform.block < 0)
+		{
+			uniform.location = location;
+			location += uniform.arraySize;
+		}
+	}
+
+	std::vector<bool> usedLocations;
+	auto const isFree = [&usedLocations](T_AttribLoc const first, uint32 const slots)
+		{
+			for (uint32 slot = 0u; slot < slots; ++slot)
+			{
+				size_t const loc = static_cast<size_t>(first) + slot;
+				if ((loc < usedLocations.size()) && usedLocations[loc])
+				{
+					return false;
+				}
+			}
+
+			return true;
+		};
+	auto const markUsed = [&usedLocations](T_AttribLoc const first, uint32 const slots)
+		{
+			size_t const end = static_cast<size_t>(first) + slots;
+			if (usedLocations.size() < end)
+			{
+				usedLocations.resize(end, false);
+			}
+
+			std::fill(usedLocations.begin() + first, usedLocations.begin() + end, true);
+		};
+
+	for (Attribute const& attribute : m_Attributes)
+	{
+		if (attribute.location >= 0)
+		{
+			markUsed(attribute.location, attribute.slots);
+		}
+	}
+
+	for (Attribute& attribute : m_Attributes)
+	{
+		if (attribute.location < 0)
+		{
+			attribute.location = 0;
+			while (!isFree(attribute.location, attribute.slots))
+			{
+				++attribute.location;
+			}
+
+			markUsed(attribute.location, attribute.slots);
+		}
+	}
+}
+
+//---------------------------------
+// ShaderReflection::FindUniform
+//
+// Uniform that a location belongs to, including locations of array elements
+//
+ShaderReflection::Uniform const* ShaderReflection::FindUniform(T_UniformLoc const location) const
+{
+	for (Uniform const& uniform : m_Uniforms)
+	{
+		if ((uniform.location >= 0) && (location >= uniform.location) && (location < uniform.location + uniform.arraySize))
+		{
+			return &uniform;
+		}
+	}
+
+	return nullptr;
+}
+
+//---------------------------------
+// ShaderReflection::Tokenize
+//
+// Split source into identifiers, numbers and single character symbols
+//  - comments are dropped, as are preprocessor directives other than integer defines, which are kept as constants
+//
+void ShaderReflection::Tokenize(std::string const& source, T_Tokens& tokens)
+{
+	size_t pos = 0u;
+	bool isLineStart = true;
+	while (pos < source.size())
+	{
+		char const c = source[pos];
+
+		if (c == '\n')
+		{
+			isLineStart = true;
+			++pos;
+		}
+		else if (std::isspace(c))
+		{
+			++pos;
+		}
+		else if (source.compare(pos, 2u, "//") == 0)
+		{
+			pos = source.find('\n', pos);
+		}
+		else if (source.compare(pos, 2u, "/*") == 0)
+		{
+			size_t const end = source.find("*/", pos + 2u);
+			pos = (end == std::string::npos) ? end : end + 2u;
+		}
+		else if ((c == '#') && isLineStart)
+		{
+			size_t const end = source.find('\n', pos);
+			std::istringstream directive(source.substr(pos + 1u, (end == std::string::npos) ? end : end - pos - 1u));
+
+			std::string keyword;
+			std::string name;
+			std::string value;
+			directive >> keyword >> name >> value;
+
+			int32 constant;
+			if ((keyword == "define") && ParseInteger(value, constant))
+			{
+				m_Constants[name] = constant;
+			}
+
+			pos = end;
+		}
+		else
+		{
+			isLineStart = false;
+
+			size_t end = pos + 1u;
+			if (std::isalpha(c) || (c == '_'))
+			{
+				while ((end < source.size()) && (std::isalnum(source[end]) || (source[end] == '_')))
+				{
+					++end;
+				}
+			}
+			else if (std::isdigit(c) || ((c == '.') && (pos + 1u < source.size()) && std::isdigit(source[pos + 1u])))
+			{
+				while ((end < source.size())
+					&& (std::isalnum(source[end])
+						|| (source[end] == '.')
+						|| (((source[end] == '-') || (source[end] == '+')) && ((source[end - 1u] == 'e') || (source[end - 1u] == 'E')))))
+				{
+					++end;
+				}
+			}
+
+			tokens.push_back(source.substr(pos, end - pos));
+			pos = end;
+		}
+	}
+}
+
+//---------------------------------
+// ShaderReflection::ParseStatement
+//
+// Reflect a single top level declaration
+//
+void ShaderReflection::ParseStatement(T_Tokens const& statement)
+{
+	size_t pos = 0u;
+	T_AttribLoc location = -1;
+
+	auto const skipQualifiers = [&statement, &pos, &location]()
+		{
+			while (pos < statement.size())
+			{
+				if ((statement[pos] == "layout") && (pos + 1u < statement.size()) && (statement[pos + 1u] == "("))
+				{
+					pos += 2u;
+					while ((pos < statement.size()) && (statement[pos] != ")"))
+					{
+						int32 value;
+						if ((statement[pos] == "location")
+							&& (pos + 2u < statement.size())
+							&& (statement[pos + 1u] == "=")
+							&& ParseInteger(statement[pos + 2u], value))
+						{
+							location = value;
+						}
+
+						++pos;
+					}
+
+					++pos;
+				}
+				else if (IsQualifier(statement[pos]))
+				{
+					++pos;
+				}
+				else
+				{
+					break;
+				}
+			}
+		};
+
+	skipQualifiers();
+	if (pos + 2u >= statement.size())
+	{
+		return;
+	}
+
+	std::string const& keyword = statement[pos];
+	if (keyword == "struct")
+	{
+		std::vector<Member>& members = m_Structs[statement[pos + 1u]];
+		members.clear();
+		ParseMembers(statement, pos + 2u, members);
+	}
+	else if (keyword == "const")
+	{
+		// const int NAME = 4;
+		int32 value;
+		if ((pos + 4u < statement.size()) && (statement[pos + 3u] == "=") && ParseInteger(statement[pos + 4u], value))
+		{
+			m_Constants[statement[pos + 2u]] = value;
+		}
+	}
+	else if (keyword == "uniform")
+	{
+		++pos;
+		skipQualifiers();
+		if (pos + 1u >= statement.size())
+		{
+			return;
+		}
+
+		if (statement[pos + 1u] == "{")
+		{
+			// members of blocks with an instance name are prefixed with the block name
+			std::string const& blockName = statement[pos];
+			std::vector<Member> members;
+			size_t const close = ParseMembers(statement, pos + 1u, members);
+			bool const hasInstance = ((close + 1u < statement.size()) && IsIdentifier(statement[close + 1u]));
+
+			T_BlockIndex const block = static_cast<T_BlockIndex>(m_Blocks.size());
+			m_Blocks.push_back(blockName);
+
+			int32 offset = 0;
+			for (Member const& member : members)
+			{
+				AddUniform(member.type, hasInstance ? (blockName + "." + member.name) : member.name, member.arraySize, block, offset, T_Tokens());
+			}
+		}
+		else
+		{
+			std::string const& type = statement[pos];
+			++pos;
+
+			// comma separated declarators, each with an optional array size and initializer
+			while ((pos < statement.size()) && IsIdentifier(statement[pos]))
+			{
+				std::string const& name = statement[pos];
+				++pos;
+
+				int32 const arraySize = ParseArraySize(statement, pos);
+
+				T_Tokens initializer;
+				if ((pos < statement.size()) && (statement[pos] == "="))
+				{
+					int32 parentheses = 0;
+					for (++pos; pos < statement.size(); ++pos)
+					{
+						std::string const& token = statement[pos];
+						if ((parentheses == 0) && ((token == ",") || (token == ";")))
+						{
+							break;
+						}
+
+						parentheses += (token == "(") ? 1 : ((token == ")") ? -1 : 0);
+						initializer.push_back(token);
+					}
+				}
+
+				int32 offset = -1;
+				AddUniform(type, name, arraySize, -1, offset, initializer);
+
+				if ((pos < statement.size()) && (statement[pos] == ","))
+				{
+					++pos;
+				}
+			}
+		}
+	}
+	else if (((keyword == "in") || (keyword == "attribute")) && (m_Type == E_ShaderType::Vertex))
+	{
+		Attribute attribute;
+		if (!ParseAttributeType(statement[pos + 1u], attribute.info, attribute.slots))
+		{
+			return; // also skips input blocks
+		}
+
+		attribute.info.name = statement[pos + 2u];
+		attribute.location = location;
+		m_Attributes.push_back(attribute);
+	}
+}
+
+//---------------------------------
+// ShaderReflection::ParseMembers
+//
+// Read the declarations between a pair of braces, returns the position of the closing brace
+//
+size_t ShaderReflection::ParseMembers(T_Tokens const& statement, size_t const open, std::vector<Member>& members) const
+{
+	size_t pos = open + 1u;
+	while ((pos < statement.size()) && (statement[pos] != "}"))
+	{
+		// skip qualifiers and layouts on members
+		while ((pos < statement.size()) && (IsQualifier(statement[pos]) || (statement[pos] == "layout")))
+		{
+			if (statement[pos] == "layout")
+			{
+				pos = std::find(statement.cbegin() + pos, statement.cend(), ")") - statement.cbegin();
+			}
+
+			++pos;
+		}
+
+		if (pos + 1u >= statement.size())
+		{
+			break;
+		}
+
+		std::string const& type = statement[pos];
+		++pos;
+
+		while ((pos < statement.size()) && IsIdentifier(statement[pos]))
+		{
+			std::string const& name = statement[pos];
+			++pos;
+
+			members.push_back(Member{ type, name, ParseArraySize(statement, pos) });
+
+			if ((pos < statement.size()) && (statement[pos] == ","))
+			{
+				++pos;
+			}
+		}
+
+		// anything else up to the end of the member is ignored
+		while ((pos < statement.size()) && (statement[pos] != ";") && (statement[pos] != "}"))
+		{
+			++pos;
+		}
+
+		if ((pos < statement.size()) && (statement[pos] == ";"))
+		{
+			++pos;
+		}
+	}
+
+	return pos;
+}
+
+//---------------------------------
+// ShaderReflection::ParseArraySize
+//
+// Reads an optional [size] after a name, 1 if the name isn't an array
+//
+int32 ShaderReflection::ParseArraySize(T_Tokens const& statement, size_t& pos) const
+{
+	if ((pos >= statement.size()) || (statement[pos] != "["))
+	{
+		return 1;
+	}
+
+	int32 size = 1;
+	if ((pos + 1u < statement.size()) && !ParseInteger(statement[pos + 1u], size))
+	{
+		auto const foundIt = m_Constants.find(statement[pos + 1u]);
+		size = (foundIt != m_Constants.cend()) ? foundIt->second : 1;
+	}
+
+	pos = std::find(statement.cbegin() + pos, statement.cend(), "]") - statement.cbegin() + 1u;
+	return std::max(size, 1);
+}
+
+//---------------------------------
+// ShaderReflection::AddUniform
+//
+// Add a declared uniform, structs are expanded into their members
+//  - within blocks the offset is advanced according to std140 rules, outside of blocks it is left untouched
+//
+void ShaderReflection::AddUniform(std::string const& type,
+	std::string const& name,
+	int32 const arraySize,
+	T_BlockIndex const block,
+	int32& blockOffset,
+	T_Tokens const& initializer)
+{
+	E_ParamType const paramType = ParseParamType(type);
+	if (paramType != E_ParamType::Invalid)
+	{
+		Uniform uniform;
+		uniform.name = (arraySize > 1) ? (name + "[0]") : name;
+		uniform.type = paramType;
+		uniform.arraySize = arraySize;
+		uniform.block = block;
+
+		if (block >= 0)
+		{
+			// array elements are padded to a vec4
+			int32 const size = GetStd140Size(paramType);
+			int32 const alignment = (arraySize > 1) ? 16 : GetStd140Alignment(paramType);
+
+			uniform.blockOffset = AlignOffset(blockOffset, alignment);
+			uniform.arrayStride = (arraySize > 1) ? AlignOffset(size, 16) : 0;
+
+			blockOffset = uniform.blockOffset + ((arraySize > 1) ? (uniform.arrayStride * arraySize) : size);
+		}
+
+		if (initializer.size() == 1u)
+		{
+			std::string const& value = initializer[0];
+			if ((value == "true") || (value == "false"))
+			{
+				uniform.hasInitializer = true;
+				uniform.initializer = (value == "true") ? 1.0 : 0.0;
+			}
+			else if (std::isdigit(value[0]) || (value[0] == '.'))
+			{
+				uniform.hasInitializer = true;
+				uniform.initializer = std::strtod(value.c_str(), nullptr);
+			}
+		}
+
+		m_Uniforms.push_back(uniform);
+		return;
+	}
+
+	auto const structIt = m_Structs.find(type);
+	if (structIt == m_Structs.cend())
+	{
+		return; // not a type parameters can hold
+	}
+
+	// structs and arrays of structs list every member of every element
+	for (int32 elementIdx = 0; elementIdx < arraySize; ++elementIdx)
+	{
+		if (block >= 0)
+		{
+			blockOffset = AlignOffset(blockOffset, 16);
+		}
+
+		std::string const prefix = (arraySize > 1) ? (name + "[" + std::to_string(elementIdx) + "]") : name;
+		for (Member const& member : structIt->second)
+		{
+			AddUniform(member.type, prefix + "." + member.name, member.arraySize, block, blockOffset, T_Tokens());
+		}
+
+		if (block >= 0)
+		{
+			blockOffset = AlignOffset(blockOffset, 16);
+		}
+	}
+}
+
+
+} // namespace render
+} // namespace et
@@ -0,0 +1,119 @@
+#pragma once
+#include <unordered_map>
+
+#include "GraphicsTypes.h"
+
+#include <EtRendering/GraphicsTypes/VertexInfo.h>
+
+
+namespace et {
+namespace render {
+
+
+//---------------------------------
+// ShaderReflection
+//
+// Interface of a shader stage parsed from its GLSL source, or of a program merged from its stages, for contexts without a driver to ask
+//  - uniforms are listed the way GL lists active uniforms: arrays of basic types once with a [0] suffix, struct members one by one
+//  - nothing is optimized out, so everything that is declared counts as active
+//
+class ShaderReflection final
+{
+public:
+	// definitions
+	//-------------
+
+	//---------------------------------
+	// ShaderReflection::Uniform
+	//
+	struct Uniform final
+	{
+		std::string name;
+		E_ParamType type = E_ParamType::Invalid;
+		int32 arraySize = 1;
+
+		T_UniformLoc location = -1; // of the first element, the other elements follow it - block members have no location
+		T_BlockIndex block = -1;
+		int32 blockOffset = -1; // std140 offset of the first element
+		int32 arrayStride = 0;
+
+		bool hasInitializer = false; // only scalar literals are evaluated
+		double initializer = 0.0;
+	};
+
+	//---------------------------------
+	// ShaderReflection::Attribute
+	//
+	struct Attribute final
+	{
+		AttributeDescriptor info;
+		T_AttribLoc location = -1;
+		uint32 slots = 1u; // matrices take a location per column
+	};
+
+	// construct destruct
+	//--------------------
+	ShaderReflection() = default;
+	ShaderReflection(E_ShaderType const type) : m_Type(type) {}
+
+	// functionality
+	//---------------
+	void Parse(std::string const& source);
+	void Link(std::vector<ShaderReflection const*> const& stages);
+
+	// accessors
+	//-----------
+	E_ShaderType GetType() const { return m_Type; }
+
+	std::vector<Uniform> const& GetUniforms() const { return m_Uniforms; }
+	std::vector<std::string> const& GetBlocks() const { return m_Blocks; }
+	std::vector<Attribute> const& GetAttributes() const { return m_Attributes; }
+
+	Uniform const* FindUniform(T_UniformLoc const location) const;
+
+	// utility
+	//---------
+private:
+	//---------------------------------
+	// ShaderReflection::Member
+	//
+	// Declaration within a struct or uniform block
+	//
+	struct Member final
+	{
+		std::string type;
+		std::string name;
+		int32 arraySize;
+	};
+
+	typedef std::vector<std::string> T_Tokens;
+
+	void Tokenize(std::string const& source, T_Tokens& tokens);
+	void ParseStatement(T_Tokens const& statement);
+	size_t ParseMembers(T_Tokens const& statement, size_t const open, std::vector<Member>& members) const;
+	int32 ParseArraySize(T_Tokens const& statement, size_t& pos) const;
+
+	void AddUniform(std::string const& type,
+		std::string const& name,
+		int32 const arraySize,
+		T_BlockIndex const block,
+		int32& blockOffset,
+		T_Tokens const& initializer);
+
+	// Data
+	///////
+
+	E_ShaderType m_Type = E_ShaderType::Vertex;
+
+	std::vector<Uniform> m_Uniforms;
+	std::vector<std::string> m_Blocks;
+	std::vector<Attribute> m_Attributes;
+
+	// only needed while parsing
+	std::unordered_map<std::string, int32> m_Constants;
+	std::unordered_map<std::string, std::vector<Member>> m_Structs;
+};
+
+
+} // namespace render
+} // namespace et
@@ -17,14 +17,12 @@ namespace render {
 //---------------------------------
 // DirectionalShadowData::Init
 //
-// Create the render target and texture
+// Create the render targets and textures
 //
 void DirectionalShadowData::Init(ivec2 const resolution)
 {
 	render::GraphicsSettings const& graphicsSettings = RenderingSystems::Instance()->GetGraphicsSettings();
 
-	I_GraphicsContextApi* const api = ContextHolder::GetRenderContext();
-
 	//Calculate cascade distances
 	float distMult = graphicsSettings.CSMDrawDistance / powf(2.f, static_cast<float>(graphicsSettings.NumCascades - 1));
 
@@ -35,25 +33,12 @@ void DirectionalShadowData::Init(ivec2 const resolution)
 
 		cascade.distance = static_cast<float>((cascadeIdx + 1) ^ 2) * distMult;
 
-		// Create depth texture
-		cascade.texture = new TextureData(E_ColorFormat::Depth, resolution);
-		cascade.texture->AllocateStorage();
-
-		TextureParameters params(false, true);
-		params.wrapS = E_TextureWrapMode::ClampToEdge;
-		params.wrapT = E_TextureWrapMode::ClampToEdge;
-		params.compareMode = E_TextureCompareMode::CompareRToTexture;
-		cascade.texture->SetParameters(params);
-
-		// create render target
-		api->GenFramebuffers(1, &(cascade.fbo));
-		api->BindFramebuffer(cascade.fbo);
-		api->LinkTextureToFboDepth(cascade.texture->GetLocation());
-		//only depth components
-		api->SetDrawBufferCount(0);
-		api->SetReadBufferEnabled(false);
+		cascade.texture = CreateDepthTarget(resolution, cascade.fbo);
 
-		api->BindFramebuffer(0);
+		// static casters are rendered once and copied into the cascade before dynamic casters are added
+		cascade.staticTexture = CreateDepthTarget(resolution, cascade.staticFbo);
+		cascade.staticVersion = 0u;
+		cascade.isStaticValid = false;
 
 		m_Cascades.push_back(cascade);
 	}
@@ -72,9 +57,44 @@ void DirectionalShadowData::Destroy()
 	{
 		api->DeleteFramebuffers(1, &(cascade.fbo));
 		SafeDelete(cascade.texture);
+
+		api->DeleteFramebuffers(1, &(cascade.staticFbo));
+		SafeDelete(cascade.staticTexture);
 	}
 }
 
+//-------------------------------------------
+// DirectionalShadowData::CreateDepthTarget
+//
+// Create a depth texture and a render target that only writes to it
+//
+TextureData* DirectionalShadowData::CreateDepthTarget(ivec2 const resolution, T_FbLoc& fbo)
+{
+	I_GraphicsContextApi* const api = ContextHolder::GetRenderContext();
+
+	// Create depth texture
+	TextureData* const texture = new TextureData(E_ColorFormat::Depth, resolution);
+	texture->AllocateStorage();
+
+	TextureParameters params(false, true);
+	params.wrapS = E_TextureWrapMode::ClampToEdge;
+	params.wrapT = E_TextureWrapMode::ClampToEdge;
+	params.compareMode = E_TextureCompareMode::CompareRToTexture;
+	texture->SetParameters(params);
+
+	// create render target
+	api->GenFramebuffers(1, &fbo);
+	api->BindFramebuffer(fbo);
+	api->LinkTextureToFboDepth(texture->GetLocation());
+	//only depth components
+	api->SetDrawBufferCount(0);
+	api->SetReadBufferEnabled(false);
+
+	api->BindFramebuffer(0);
+
+	return texture;
+}
+
 
 } // namespace render
 } // namespace et
@@ -23,6 +23,7 @@ public:
 	// DirectionalShadowData::CascadeData
 	//
 	// Data required for a single shadow cascade
+	//  - static casters are rendered into a separate depth map that is kept until the light, the cascade projection or a static caster changes
 	//
 	struct CascadeData
 	{
@@ -31,6 +32,13 @@ public:
 
 		T_FbLoc fbo;
 		TextureData* texture;
+
+		T_FbLoc staticFbo;
+		TextureData* staticTexture;
+
+		mat4 staticLightVP; // light view projection the static depth map was rendered with
+		uint32 staticVersion; // version of the scenes static casters when the static depth map was rendered
+		bool isStaticValid;
 	};
 
 	// construct destruct
@@ -48,10 +56,14 @@ public:
 
 	float GetBias() const { return m_Bias; }
 
+	// utility
+	//---------
+private:
+	static TextureData* CreateDepthTarget(ivec2 const resolution, T_FbLoc& fbo);
+
 	// Data
 	///////
 
-private:
 	std::vector<CascadeData> m_Cascades;
 	float m_Bias = 0.f;
 };
@@ -3,11 +3,125 @@
 
 #include "Camera.h"
 
+#include <EtMath/Simd.h>
+
 
 namespace et {
 namespace render {
 
 
+namespace {
+
+	static_assert(64u % Frustum::s_CullLanes == 0u, "lane groups shouldn't straddle visibility mask words");
+
+	//---------------------------------
+	// WriteVisibleMask
+	//
+	// Sets a bit for every visible volume, given a function returning the visible lanes of a group
+	//
+	template<typename TLaneFn>
+	void WriteVisibleMask(size_t const count, TLaneFn const& laneFn, std::vector<uint64>& visibleMask)
+	{
+		visibleMask.assign((count + 63u) / 64u, 0u);
+		for (size_t idx = 0u; idx < count; idx += Frustum::s_CullLanes)
+		{
+			visibleMask[idx / 64u] |= static_cast<uint64>(laneFn(idx)) << (idx % 64u);
+		}
+	}
+
+	//---------------------------------
+	// WriteVisibleIndices
+	//
+	// Compacts the indices of visible volumes into a list, given a function returning the visible lanes of a group
+	//
+	template<typename TLaneFn>
+	void WriteVisibleIndices(size_t const count, TLaneFn const& laneFn, std::vector<uint32>& visibleIndices)
+	{
+		visibleIndices.clear();
+		for (size_t idx = 0u; idx < count; idx += Frustum::s_CullLanes)
+		{
+			uint32 const lanes = laneFn(idx);
+			for (size_t lane = 0u; lane < Frustum::s_CullLanes; ++lane)
+			{
+				if (lanes & (1u << lane))
+				{
+					visibleIndices.emplace_back(static_cast<uint32>(idx + lane));
+				}
+			}
+		}
+	}
+
+} // namespace
+
+
+//=================
+// Bounding Volumes
+//=================
+
+
+void BoundingSpheres::Clear()
+{
+	x.clear();
+	y.clear();
+	z.clear();
+	radius.clear();
+}
+
+void BoundingSpheres::Reserve(size_t const count)
+{
+	x.reserve(count);
+	y.reserve(count);
+	z.reserve(count);
+	radius.reserve(count);
+}
+
+void BoundingSpheres::Add(math::Sphere const& sphere)
+{
+	x.emplace_back(sphere.pos.x);
+	y.emplace_back(sphere.pos.y);
+	z.emplace_back(sphere.pos.z);
+	radius.emplace_back(sphere.radius);
+}
+
+void BoundingBoxes::Clear()
+{
+	centerX.clear();
+	centerY.clear();
+	centerZ.clear();
+	extentX.clear();
+	extentY.clear();
+	extentZ.clear();
+}
+
+void BoundingBoxes::Reserve(size_t const count)
+{
+	centerX.reserve(count);
+	centerY.reserve(count);
+	centerZ.reserve(count);
+	extentX.reserve(count);
+	extentY.reserve(count);
+	extentZ.reserve(count);
+}
+
+void BoundingBoxes::Add(vec3 const& min, vec3 const& max)
+{
+	vec3 const center = (min + max) * 0.5f;
+	vec3 const extent = (max - min) * 0.5f;
+
+	centerX.emplace_back(center.x);
+	centerY.emplace_back(center.y);
+	centerZ.emplace_back(center.z);
+	extentX.emplace_back(extent.x);
+	extentY.emplace_back(extent.y);
+	extentZ.emplace_back(extent.z);
+}
+
+
+//=========
+// Frustum
+//=========
+
+
 void FrustumCorners::Transform(mat4 const& space)
 {
 	//move corners of the near plane
@@ -82,7 +196,34 @@ void Frustum::Update(Viewport const* const viewport)
 	m_PositionObject = (m_CullInverse*vec4(m_Position, 0)).xyz;
 	m_RadInvFOV = 1 / math::radians(m_FOV);
 
-	//construct planes
+	UpdatePlanes();
+}
+
+//the corners of the clip space cube transformed back into world space
+void Frustum::SetToViewProjection(mat4 const& viewProjection)
+{
+	mat4 const inverseVP = math::inverse(viewProjection);
+	auto unproject = [&inverseVP](vec3 const& ndc) -> vec3
+		{
+			vec4 const world = inverseVP * vec4(ndc, 1.f);
+			return world.xyz / world.w;
+		};
+
+	m_Corners.na = unproject(vec3(-1.f, 1.f, -1.f));
+	m_Corners.nb = unproject(vec3(1.f, 1.f, -1.f));
+	m_Corners.nc = unproject(vec3(-1.f, -1.f, -1.f));
+	m_Corners.nd = unproject(vec3(1.f, -1.f, -1.f));
+	m_Corners.fa = unproject(vec3(-1.f, 1.f, 1.f));
+	m_Corners.fb = unproject(vec3(1.f, 1.f, 1.f));
+	m_Corners.fc = unproject(vec3(-1.f, -1.f, 1.f));
+	m_Corners.fd = unproject(vec3(1.f, -1.f, 1.f));
+
+	UpdatePlanes();
+}
+
+//construct planes from the corners
+void Frustum::UpdatePlanes()
+{
 	m_Planes.clear();
 	//winding in an outside perspective so the cross product creates normals pointing inward
 	m_Planes.push_back(math::Plane(m_Corners.na, m_Corners.nb, m_Corners.nc));//Near
@@ -91,11 +232,31 @@ void Frustum::Update(Viewport const* const viewport)
 	m_Planes.push_back(math::Plane(m_Corners.nb, m_Corners.fb, m_Corners.nd));//Right
 	m_Planes.push_back(math::Plane(m_Corners.fa, m_Corners.fb, m_Corners.na));//Top
 	m_Planes.push_back(math::Plane(m_Corners.nc, m_Corners.nd, m_Corners.fc));//Bottom
+
+	//projections that mirror space flip the winding, so make sure the normals face the center
+	vec3 const center = (m_Corners.na + m_Corners.nb + m_Corners.nc + m_Corners.nd + m_Corners.fa + m_Corners.fb + m_Corners.fc + m_Corners.fd) / 8.f;
+	for (math::Plane& plane : m_Planes)
+	{
+		if (math::dot(plane.n, center - plane.d) < 0.f)
+		{
+			plane.n = -plane.n;
+		}
+	}
+
+	ET_ASSERT(m_Planes.size() == s_PlaneCount);
+	for (size_t planeIdx = 0u; planeIdx < s_PlaneCount; ++planeIdx)
+	{
+		math::Plane const& plane = m_Planes[planeIdx];
+		m_PlaneNormalX[planeIdx] = plane.n.x;
+		m_PlaneNormalY[planeIdx] = plane.n.y;
+		m_PlaneNormalZ[planeIdx] = plane.n.z;
+		m_PlaneDist[planeIdx] = math::dot(plane.n, plane.d);
+	}
 }
 
 VolumeCheck Frustum::ContainsPoint(const vec3 &point) const
 {
-	for (auto plane : m_Planes)
+	for (math::Plane const& plane : m_Planes)
 	{
 		if (math::dot(plane.n, point - plane.d) < 0)return VolumeCheck::OUTSIDE;
 	}
@@ -104,7 +265,7 @@ VolumeCheck Frustum::ContainsPoint(const vec3 &point) const
 VolumeCheck Frustum::ContainsSphere(math::Sphere const& sphere) const
 {
 	VolumeCheck ret = VolumeCheck::CONTAINS;
-	for (auto plane : m_Planes)
+	for (math::Plane const& plane : m_Planes)
 	{
 		float dist = math::dot(plane.n, sphere.pos - plane.d);
 		if (dist < -sphere.radius)return VolumeCheck::OUTSIDE;
@@ -118,7 +279,7 @@ VolumeCheck Frustum::ContainsSphere(math::Sphere const& sphere) const
 VolumeCheck Frustum::ContainsTriangle(vec3 &a, vec3 &b, vec3 &c)
 {
 	VolumeCheck ret = VolumeCheck::CONTAINS;
-	for (auto plane : m_Planes)
+	for (math::Plane const& plane : m_Planes)
 	{
 		char rejects = 0;
 		if (math::dot(plane.n, a - plane.d) < 0)rejects++;
@@ -135,7 +296,7 @@ VolumeCheck Frustum::ContainsTriangle(vec3 &a, vec3 &b, vec3 &c)
 VolumeCheck Frustum::ContainsTriVolume(vec3 &a, vec3 &b, vec3 &c, float height)
 {
 	VolumeCheck ret = VolumeCheck::CONTAINS;
-	for (auto plane : m_Planes)
+	for (math::Plane const& plane : m_Planes)
 	{
 		char rejects = 0;
 		if (math::dot(plane.n, a - plane.d) < 0)rejects++;
@@ -157,5 +318,157 @@ VolumeCheck Frustum::ContainsTriVolume(vec3 &a, vec3 &b, vec3 &c, float height)
 }
 
 
+//batch culling
+//***************
+
+void Frustum::CullSpheres(BoundingSpheres const& spheres, std::vector<uint64>& visibleMask) const
+{
+	WriteVisibleMask(spheres.GetCount(), [this, &spheres](size_t const first)
+		{
+			return GetVisibleSphereLanes(spheres, first);
+		}, visibleMask);
+}
+
+void Frustum::CullSpheres(BoundingSpheres const& spheres, std::vector<uint32>& visibleIndices) const
+{
+	WriteVisibleIndices(spheres.GetCount(), [this, &spheres](size_t const first)
+		{
+			return GetVisibleSphereLanes(spheres, first);
+		}, visibleIndices);
+}
+
+void Frustum::CullBoxes(BoundingBoxes const& boxes, std::vector<uint64>& visibleMask) const
+{
+	WriteVisibleMask(boxes.GetCount(), [this, &boxes](size_t const first)
+		{
+			return GetVisibleBoxLanes(boxes, first);
+		}, visibleMask);
+}
+
+void Frustum::CullBoxes(BoundingBoxes const& boxes, std::vector<uint32>& visibleIndices) const
+{
+	WriteVisibleIndices(boxes.GetCount(), [this, &boxes](size_t const first)
+		{
+			return GetVisibleBoxLanes(boxes, first);
+		}, visibleIndices);
+}
+
+//a sphere is outside if it is further behind any plane than its radius
+uint32 Frustum::GetVisibleSphereLanes(BoundingSpheres const& spheres, size_t const first) const
+{
+	size_t const count = spheres.GetCount();
+
+#if ETM_SIMD_SSE
+	if (first + s_CullLanes <= count)
+	{
+		__m128 const x = _mm_loadu_ps(spheres.x.data() + first);
+		__m128 const y = _mm_loadu_ps(spheres.y.data() + first);
+		__m128 const z = _mm_loadu_ps(spheres.z.data() + first);
+		__m128 const negRadius = _mm_sub_ps(_mm_setzero_ps(), _mm_loadu_ps(spheres.radius.data() + first));
+
+		__m128 outside = _mm_setzero_ps();
+		for (size_t planeIdx = 0u; planeIdx < s_PlaneCount; ++planeIdx)
+		{
+			__m128 dist = _mm_mul_ps(_mm_set1_ps(m_PlaneNormalX[planeIdx]), x);
+			dist = _mm_add_ps(dist, _mm_mul_ps(_mm_set1_ps(m_PlaneNormalY[planeIdx]), y));
+			dist = _mm_add_ps(dist, _mm_mul_ps(_mm_set1_ps(m_PlaneNormalZ[planeIdx]), z));
+			dist = _mm_sub_ps(dist, _mm_set1_ps(m_PlaneDist[planeIdx]));
+
+			outside = _mm_or_ps(outside, _mm_cmplt_ps(dist, negRadius));
+		}
+
+		return static_cast<uint32>(~_mm_movemask_ps(outside)) & 0xFu;
+	}
+#endif
+
+	// remaining volumes that don't fill a register, or everything if SIMD is disabled
+	uint32 lanes = 0u;
+	size_t const end = std::min(first + s_CullLanes, count);
+	for (size_t idx = first; idx < end; ++idx)
+	{
+		bool isOutside = false;
+		for (size_t planeIdx = 0u; planeIdx < s_PlaneCount; ++planeIdx)
+		{
+			float const dist = m_PlaneNormalX[planeIdx] * spheres.x[idx] 
+				+ m_PlaneNormalY[planeIdx] * spheres.y[idx] 
+				+ m_PlaneNormalZ[planeIdx] * spheres.z[idx] 
+				- m_PlaneDist[planeIdx];
+
+			isOutside |= (dist < -spheres.radius[idx]);
+		}
+
+		if (!isOutside)
+		{
+			lanes |= 1u << (idx - first);
+		}
+	}
+
+	return lanes;
+}
+
+//a box is outside if its center is further behind any plane than the extents projected onto the plane normal
+uint32 Frustum::GetVisibleBoxLanes(BoundingBoxes const& boxes, size_t const first) const
+{
+	size_t const count = boxes.GetCount();
+
+#if ETM_SIMD_SSE
+	if (first + s_CullLanes <= count)
+	{
+		__m128 const x = _mm_loadu_ps(boxes.centerX.data() + first);
+		__m128 const y = _mm_loadu_ps(boxes.centerY.data() + first);
+		__m128 const z = _mm_loadu_ps(boxes.centerZ.data() + first);
+		__m128 const ex = _mm_loadu_ps(boxes.extentX.data() + first);
+		__m128 const ey = _mm_loadu_ps(boxes.extentY.data() + first);
+		__m128 const ez = _mm_loadu_ps(boxes.extentZ.data() + first);
+
+		__m128 outside = _mm_setzero_ps();
+		for (size_t planeIdx = 0u; planeIdx < s_PlaneCount; ++planeIdx)
+		{
+			__m128 dist = _mm_mul_ps(_mm_set1_ps(m_PlaneNormalX[planeIdx]), x);
+			dist = _mm_add_ps(dist, _mm_mul_ps(_mm_set1_ps(m_PlaneNormalY[planeIdx]), y));
+			dist = _mm_add_ps(dist, _mm_mul_ps(_mm_set1_ps(m_PlaneNormalZ[planeIdx]), z));
+			dist = _mm_sub_ps(dist, _mm_set1_ps(m_PlaneDist[planeIdx]));
+
+			__m128 projExtent = _mm_mul_ps(_mm_set1_ps(std::abs(m_PlaneNormalX[planeIdx])), ex);
+			projExtent = _mm_add_ps(projExtent, _mm_mul_ps(_mm_set1_ps(std::abs(m_PlaneNormalY[planeIdx])), ey));
+			projExtent = _mm_add_ps(projExtent, _mm_mul_ps(_mm_set1_ps(std::abs(m_PlaneNormalZ[planeIdx])), ez));
+
+			outside = _mm_or_ps(outside, _mm_cmplt_ps(dist, _mm_sub_ps(_mm_setzero_ps(), projExtent)));
+		}
+
+		return static_cast<uint32>(~_mm_movemask_ps(outside)) & 0xFu;
+	}
+#endif
+
+	// remaining volumes that don't fill a register, or everything if SIMD is disabled
+	uint32 lanes = 0u;
+	size_t const end = std::min(first + s_CullLanes, count);
+	for (size_t idx = first; idx < end; ++idx)
+	{
+		bool isOutside = false;
+		for (size_t planeIdx = 0u; planeIdx < s_PlaneCount; ++planeIdx)
+		{
+			float const dist = m_PlaneNormalX[planeIdx] * boxes.centerX[idx] 
+				+ m_PlaneNormalY[planeIdx] * boxes.centerY[idx] 
+				+ m_PlaneNormalZ[planeIdx] * boxes.centerZ[idx] 
+				- m_PlaneDist[planeIdx];
+
+			float const projExtent = std::abs(m_PlaneNormalX[planeIdx]) * boxes.extentX[idx]
+				+ std::abs(m_PlaneNormalY[planeIdx]) * boxes.extentY[idx]
+				+ std::abs(m_PlaneNormalZ[planeIdx]) * boxes.extentZ[idx];
+
+			isOutside |= (dist < -projExtent);
+		}
+
+		if (!isOutside)
+		{
+			lanes |= 1u << (idx - first);
+		}
+	}
+
+	return lanes;
+}
+
+
 } // namespace render
 } // namespace et
@@ -31,13 +31,57 @@ struct FrustumCorners
 	vec3 fd;
 };
 
+//---------------------------------
+// BoundingSpheres
+//
+// Spheres stored as structure of arrays, so that the frustum can cull several of them at once
+//
+struct BoundingSpheres
+{
+	void Clear();
+	void Reserve(size_t const count);
+	void Add(math::Sphere const& sphere);
+
+	size_t GetCount() const { return radius.size(); }
+
+	std::vector<float> x;
+	std::vector<float> y;
+	std::vector<float> z;
+	std::vector<float> radius;
+};
+
+//---------------------------------
+// BoundingBoxes
+//
+// Axis aligned boxes stored as centers and half extents in structure of arrays form
+//
+struct BoundingBoxes
+{
+	void Clear();
+	void Reserve(size_t const count);
+	void Add(vec3 const& min, vec3 const& max);
+
+	size_t GetCount() const { return extentX.size(); }
+
+	std::vector<float> centerX;
+	std::vector<float> centerY;
+	std::vector<float> centerZ;
+	std::vector<float> extentX;
+	std::vector<float> extentY;
+	std::vector<float> extentZ;
+};
+
 class Frustum
 {
 public:
+	static constexpr size_t s_PlaneCount = 6u;
+	static constexpr size_t s_CullLanes = 4u; // volumes tested against all planes at once
+
 	Frustum();
 	~Frustum();
 
 	void Update(Viewport const* const viewport);
+	void SetToViewProjection(mat4 const& viewProjection); // world space volume of any projection, for example a shadow cascade
 
 	void SetToCamera(Camera const& camera);
 	void SetCullTransform(mat4 const& objectWorld);
@@ -47,6 +91,12 @@ public:
 	VolumeCheck ContainsTriangle(vec3 &a, vec3 &b, vec3 &c);
 	VolumeCheck ContainsTriVolume(vec3 &a, vec3 &b, vec3 &c, float height);
 
+	//batch culling - volumes that aren't fully outside either get their bit set in the mask, or their index added to the list
+	void CullSpheres(BoundingSpheres const& spheres, std::vector<uint64>& visibleMask) const;
+	void CullSpheres(BoundingSpheres const& spheres, std::vector<uint32>& visibleIndices) const;
+	void CullBoxes(BoundingBoxes const& boxes, std::vector<uint64>& visibleMask) const;
+	void CullBoxes(BoundingBoxes const& boxes, std::vector<uint32>& visibleIndices) const;
+
 	vec3 const& GetPositionOS() const { return m_PositionObject; }
 	float GetFOV() const { return m_FOV; }
 	float GetRadInvFOV() const { return m_RadInvFOV; }
@@ -54,11 +104,23 @@ public:
 	FrustumCorners const& GetCorners() const { return m_Corners; }
 
 private:
+	void UpdatePlanes();
+
+	uint32 GetVisibleSphereLanes(BoundingSpheres const& spheres, size_t const first) const;
+	uint32 GetVisibleBoxLanes(BoundingBoxes const& boxes, size_t const first) const;
+
 	//transform to the culled objects object space and back to world space
 	mat4 m_CullWorld, m_CullInverse;
 
 	//stuff in the culled objects object space
 	std::vector<math::Plane> m_Planes;
+
+	//the same planes as structure of arrays for batch culling, with the distance to the origin precomputed
+	float m_PlaneNormalX[s_PlaneCount] = {};
+	float m_PlaneNormalY[s_PlaneCount] = {};
+	float m_PlaneNormalZ[s_PlaneCount] = {};
+	float m_PlaneDist[s_PlaneCount] = {};
+
 	FrustumCorners m_Corners;
 	vec3 m_PositionObject;
 
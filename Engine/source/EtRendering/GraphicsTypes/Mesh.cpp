@@ -8,6 +8,7 @@
 #include <EtCore/IO/BinaryReader.h>
 
 #include <EtRendering/MaterialSystem/MaterialData.h>
+#include <EtRendering/GlobalRenderingSystems/GlobalRenderingSystems.h>
 
 
 namespace et {
@@ -29,31 +30,12 @@ MeshSurface::MeshSurface(MeshData const* const mesh, render::Material const* con
 {
 	ET_ASSERT(mesh != nullptr);
 	ET_ASSERT(m_Material != nullptr);
+	ET_ASSERT(mesh->GetAllocation().IsValid());
 
-	I_GraphicsContextApi* const api = ContextHolder::GetRenderContext();
+	GeometryPool::Surface const& poolSurface = RenderingSystems::Instance()->GetGeometryPool().GetSurface(mesh->GetAllocation().page, m_Material);
 
-	// create a new vertex array
-	m_VertexArray = api->CreateVertexArray();
-	api->BindVertexArray(m_VertexArray);
-
-	// link it to the mesh's buffer
-	api->BindBuffer(E_BufferType::Vertex, mesh->GetVertexBuffer());
-	api->BindBuffer(E_BufferType::Index, mesh->GetIndexBuffer());
-
-	//Specify Input Layout
-	AttributeDescriptor::DefineAttributeArray(mesh->GetSupportedFlags(), m_Material->GetLayoutFlags(), m_Material->GetAttributeLocations());
-
-	api->BindVertexArray(0u);
-}
-
-//---------------------------------
-// MeshSurface::d-tor
-//
-// Free GPU data
-//
-MeshSurface::~MeshSurface()
-{
-	ContextHolder::GetRenderContext()->DeleteVertexArray(m_VertexArray);
+	m_VertexArray = poolSurface.vertexArray;
+	m_InstanceBuffer = poolSurface.instanceBuffer;
 }
 
 
@@ -115,16 +97,17 @@ MeshData::MeshData()
 //---------------------------------
 // MeshData::d-tor
 //
-// Free the GPU buffers for this mesh
+// Return the meshes geometry to the pool
+//  - assets can outlive the rendering systems during shutdown, in which case the pool already freed the geometry with its pages
 //
 MeshData::~MeshData()
 {
-	I_GraphicsContextApi* const api = ContextHolder::GetRenderContext();
-
-	api->DeleteBuffer(m_VertexBuffer);
-	api->DeleteBuffer(m_IndexBuffer);
-
 	delete m_Surfaces;
+
+	if (m_Allocation.IsValid() && RenderingSystems::IsInitialized())
+	{
+		RenderingSystems::Instance()->GetGeometryPool().Release(m_Allocation);
+	}
 }
 
 //---------------------------------
@@ -199,7 +182,6 @@ bool MeshAsset::ReadEtMesh(MeshData* const meshData, std::vector<uint8> const& l
 	meshData->m_BoundingSphere.radius = reader.Read<float>();
 
 	uint64 const iBufferSize = indexCount * static_cast<uint64>(render::DataTypeInfo::GetTypeSize(meshData->m_IndexDataType));
-	uint64 const vBufferSize = vertexCount * static_cast<uint64>(render::AttributeDescriptor::GetVertexSize(meshData->m_SupportedFlags));
 
 	// setup buffers
 	//---------------
@@ -208,17 +190,12 @@ bool MeshAsset::ReadEtMesh(MeshData* const meshData, std::vector<uint8> const& l
 
 	uint8 const* const vertexData = reader.GetCurrentDataPointer();
 
-	I_GraphicsContextApi* const api = ContextHolder::GetRenderContext();
-
-	// vertex buffer
-	meshData->m_VertexBuffer = api->CreateBuffer();
-	api->BindBuffer(E_BufferType::Vertex, meshData->m_VertexBuffer);
-	api->SetBufferData(E_BufferType::Vertex, static_cast<int64>(vBufferSize), reinterpret_cast<void const*>(vertexData), E_UsageHint::Static);
-
-	// index buffer 
-	meshData->m_IndexBuffer = api->CreateBuffer();
-	api->BindBuffer(E_BufferType::Index, meshData->m_IndexBuffer);
-	api->SetBufferData(E_BufferType::Index, static_cast<int64>(iBufferSize), reinterpret_cast<void const*>(indexData), E_UsageHint::Static);
+	// vertex and index data are suballocated from buffers shared with other meshes of the same layout
+	meshData->m_Allocation = RenderingSystems::Instance()->GetGeometryPool().Allocate(meshData->m_SupportedFlags,
+		static_cast<size_t>(vertexCount),
+		reinterpret_cast<void const*>(vertexData),
+		static_cast<size_t>(iBufferSize),
+		reinterpret_cast<void const*>(indexData));
 
 	return true;
 }
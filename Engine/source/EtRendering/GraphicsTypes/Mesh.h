@@ -1,6 +1,8 @@
 #pragma once
 #include "VertexInfo.h"
 
+#include <EtRendering/GlobalRenderingSystems/GeometryPool.h>
+
 #include <EtCore/Content/Asset.h>
 #include <EtCore/Util/LinkerUtils.h>
 
@@ -24,6 +26,7 @@ namespace render {
 // MeshSurface
 //
 // Render packet / renderable view into a subset of a mesh's vertex information
+//  - the vertex array is owned by the geometry pool and shared with all meshes in the same page
 //
 class MeshSurface final
 {
@@ -31,18 +34,20 @@ public:
 	// c-tor d-tor
 	//-------------
 	MeshSurface(MeshData const* const mesh, render::Material const* const material);
-	~MeshSurface();
+	~MeshSurface() = default;
 
 	// accessors
 	//-----------
 	render::Material const* GetMaterial() const { return m_Material; }
 	T_ArrayLoc GetVertexArray() const { return m_VertexArray; }
+	T_BufferLoc GetInstanceBuffer() const { return m_InstanceBuffer; }
 
 	// Data
 	///////
 private:
 	render::Material const* m_Material = nullptr;
 	T_ArrayLoc m_VertexArray = 0u;
+	T_BufferLoc m_InstanceBuffer = 0u; // per instance transforms, only if the material supports instancing
 };
 
 
@@ -95,8 +100,9 @@ public:
 	math::Sphere const& GetBoundingSphere() const { return m_BoundingSphere; }
 	size_t GetIndexCount() const { return m_IndexCount; }
 	E_DataType GetIndexDataType() const { return m_IndexDataType; }
-	T_BufferLoc GetVertexBuffer() const { return m_VertexBuffer; }
-	T_BufferLoc GetIndexBuffer() const { return m_IndexBuffer; }
+	GeometryPool::Allocation const& GetAllocation() const { return m_Allocation; }
+	int32 GetBaseVertex() const { return static_cast<int32>(m_Allocation.baseVertex); }
+	size_t GetIndexOffset() const { return m_Allocation.indexOffset; } // bytes into the index buffer
 	MeshSurface const* GetSurface(render::Material const* const material) const;
 
 	// Data
@@ -111,8 +117,7 @@ private:
 	size_t m_VertexCount = 0u;
 	size_t m_IndexCount = 0u;
 
-	T_BufferLoc m_VertexBuffer = 0u;
-	T_BufferLoc m_IndexBuffer = 0u;
+	GeometryPool::Allocation m_Allocation; // vertex and index data live in shared buffers
 
 	SurfaceContainer* m_Surfaces = nullptr; // pointer in order to enable const access
 };
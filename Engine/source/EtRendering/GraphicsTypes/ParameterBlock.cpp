@@ -118,6 +118,69 @@ bool Compare(T_ConstParameterBlock const lhs, T_ConstParameterBlock const rhs, s
 	return (memcmp(lhs + offset, rhs + offset, GetSize(type)) == 0);
 }
 
+//---------------------------------
+// GetStd140Size
+//
+// Size a parameter occupies in a std140 uniform block, not including the padding before it
+//
+size_t GetStd140Size(E_ParamType const type)
+{
+	switch (type)
+	{
+	case E_ParamType::Matrix4x4: return 4u * sizeof(vec4);
+	case E_ParamType::Matrix3x3: return 3u * sizeof(vec4); // rows are padded to vec4
+	case E_ParamType::Vector4: return sizeof(vec4);
+	case E_ParamType::Vector3: return sizeof(vec3);
+	case E_ParamType::Vector2: return sizeof(vec2);
+	case E_ParamType::UInt: return sizeof(uint32);
+	case E_ParamType::Int: return sizeof(int32);
+	case E_ParamType::Float: return sizeof(float);
+	case E_ParamType::Boolean: return sizeof(uint32); // GLSL bools are 4 bytes
+	}
+
+	ET_ASSERT(false, "Parameter type can't be contained in a uniform block!");
+	return 0u;
+}
+
+//---------------------------------
+// WriteStd140
+//
+// Convert a parameter to its std140 representation, target points at the parameters offset within the uniform block
+//
+void WriteStd140(T_ConstParameterBlock const block, size_t const offset, E_ParamType const type, uint8* const target)
+{
+	switch (type)
+	{
+	case E_ParamType::Matrix3x3:
+		{
+			mat3 const& mat = Read<mat3>(block, offset);
+			for (uint8 rowIdx = 0u; rowIdx < 3u; ++rowIdx)
+			{
+				memcpy(target + rowIdx * sizeof(vec4), &mat.rows[rowIdx], sizeof(vec3));
+			}
+		}
+		break;
+
+	case E_ParamType::Boolean:
+		{
+			uint32 const value = Read<bool>(block, offset) ? 1u : 0u;
+			memcpy(target, &value, sizeof(uint32));
+		}
+		break;
+
+	case E_ParamType::Texture2D:
+	case E_ParamType::Texture3D:
+	case E_ParamType::TextureCube:
+	case E_ParamType::TextureShadow:
+		ET_ASSERT(false, "Textures can't be contained in a uniform block!");
+		break;
+
+	default:
+		memcpy(target, block + offset, GetStd140Size(type));
+		break;
+	}
+}
+
 
 } // namespace parameters
 } // namespace render
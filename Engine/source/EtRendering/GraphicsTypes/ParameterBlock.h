@@ -28,6 +28,19 @@ struct UniformParam
 };
 
 
+//---------------------------------
+// BlockParam
+//
+// access information for a parameter that is packed into a std140 uniform block instead of being uploaded as a uniform
+//
+struct BlockParam
+{
+	size_t offset; // within the parameter block
+	size_t blockOffset; // within the uniform block
+	E_ParamType type;
+};
+
+
 //---------------------------------
 // parameters
 //
@@ -47,6 +60,9 @@ void CopyBlockData(T_ConstParameterBlock const source, T_ParameterBlock const ta
 
 bool Compare(T_ConstParameterBlock const lhs, T_ConstParameterBlock const rhs, size_t const offset, E_ParamType const type);
 
+size_t GetStd140Size(E_ParamType const type);
+void WriteStd140(T_ConstParameterBlock const block, size_t const offset, E_ParamType const type, uint8* const target);
+
 template<typename TParamType>
 TParamType const& Read(T_ConstParameterBlock const block, size_t const offset);
 
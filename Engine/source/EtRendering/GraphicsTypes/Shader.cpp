@@ -8,6 +8,7 @@
 
 #include <EtRendering/GlobalRenderingSystems/GlobalRenderingSystems.h>
 #include <EtRendering/GlobalRenderingSystems/SharedVarController.h>
+#include <EtRendering/GlobalRenderingSystems/MaterialBlockBuffer.h>
 
 
 namespace et {
@@ -57,17 +58,53 @@ render::T_ParameterBlock ShaderData::CopyParameterBlock(render::T_ConstParameter
 	return ret;
 }
 
+//--------------------------------
+// ShaderData::GetUniformHandle
+//
+// Look up a uniform once, so that it can be uploaded without searching for it again
+//
+UniformHandle ShaderData::GetUniformHandle(T_Hash const uniform, bool const reportWarnings) const
+{
+	UniformHandle handle;
+
+	// material block parameters can't be uploaded individually
+	auto const idsEnd = m_UniformIds.cbegin() + m_LooseUniformCount;
+
+	auto const idIt = std::find(m_UniformIds.cbegin(), idsEnd, uniform);
+	if (idIt == idsEnd)
+	{
+		if (reportWarnings)
+		{
+			ET_ASSERT(false, "Couldn't find uniform!");
+		}
+
+		return handle;
+	}
+
+	handle.index = static_cast<uint32>(idIt - m_UniformIds.cbegin());
+	handle.offset = m_UniformLayout[handle.index].offset;
+
+#if ET_CT_IS_ENABLED(ET_CT_ASSERT)
+	handle.shader = this;
+#endif
+
+	return handle;
+}
+
 //----------------------------------
 // ShaderData::UploadParameterBlock
 //
-// Upload all variables in a parameter block according to the shaders layout
+// Upload all loose variables in a parameter block according to the shaders layout
+//  - parameters in the material block are packed with PackMaterialBlock instead
 //
 void ShaderData::UploadParameterBlock(render::T_ConstParameterBlock const block) const
 {
 	I_GraphicsContextApi* const api = ContextHolder::GetRenderContext();
 
-	for (render::UniformParam const& param : m_UniformLayout)
+	for (size_t paramIdx = 0u; paramIdx < m_LooseUniformCount; ++paramIdx)
 	{
+		render::UniformParam const& param = m_UniformLayout[paramIdx];
+
 		// textures are alwats updated as we are not storing their binding points at the moement 
 		// #todo: this can and should be improved
 		switch (param.type)
@@ -142,6 +179,19 @@ void ShaderData::UploadParameterBlock(render::T_ConstParameterBlock const block)
 	render::parameters::CopyBlockData(block, m_CurrentUniforms, m_UniformDataSize);
 }
 
+//-------------------------------
+// ShaderData::PackMaterialBlock
+//
+// Convert the material block parameters in a parameter block to std140 layout, target needs to hold GetMaterialBlockSize bytes
+//
+void ShaderData::PackMaterialBlock(render::T_ConstParameterBlock const block, uint8* const target) const
+{
+	for (render::BlockParam const& param : m_MaterialBlockLayout)
+	{
+		render::parameters::WriteStd140(block, param.offset, param.type, target + param.blockOffset);
+	}
+}
+
 
 //===================
 // Shader Asset
@@ -281,23 +331,44 @@ void ShaderAsset::InitUniforms(ShaderData* const data)
 		data->m_UniformBlocks.emplace_back(GetHash(blockName));
 	}
 
-	// hook up shared uniform variables if the shader requires it
-	render::SharedVarController const& sharedVarController = RenderingSystems::Instance()->GetSharedVarController();
+	// hook up shared uniform variables if the shader requires it - without rendering systems (tools, tests) there are no buffers to bind to
+	T_BlockIndex materialBlockIndex = -1;
+	if (RenderingSystems::IsInitialized())
+	{
+		render::SharedVarController const& sharedVarController = RenderingSystems::Instance()->GetSharedVarController();
 
-	core::HashString const sharedBlockId(sharedVarController.GetBlockName().c_str());
-	auto const foundBlock = std::find(data->m_UniformBlocks.cbegin(), data->m_UniformBlocks.cend(), sharedBlockId);
+		core::HashString const sharedBlockId(sharedVarController.GetBlockName().c_str());
+		auto const foundBlock = std::find(data->m_UniformBlocks.cbegin(), data->m_UniformBlocks.cend(), sharedBlockId);
 
-	if (foundBlock != data->m_UniformBlocks.cend())
-	{
-		T_BlockIndex const blockIndex = static_cast<T_BlockIndex>(foundBlock - data->m_UniformBlocks.cbegin());
-		api->SetUniformBlockBinding(data->m_ShaderProgram, blockIndex, sharedVarController.GetBufferBinding());
+		if (foundBlock != data->m_UniformBlocks.cend())
+		{
+			T_BlockIndex const blockIndex = static_cast<T_BlockIndex>(foundBlock - data->m_UniformBlocks.cbegin());
+			api->SetUniformBlockBinding(data->m_ShaderProgram, blockIndex, sharedVarController.GetBufferBinding());
+		}
+
+		// same for the material block, which is filled from the parameter block instead of by uploading uniforms
+		render::MaterialBlockBuffer const& materialBlockBuffer = RenderingSystems::Instance()->GetMaterialBlockBuffer();
+
+		core::HashString const materialBlockId(materialBlockBuffer.GetBlockName().c_str());
+		auto const foundMaterialBlock = std::find(data->m_UniformBlocks.cbegin(), data->m_UniformBlocks.cend(), materialBlockId);
+
+		if (foundMaterialBlock != data->m_UniformBlocks.cend())
+		{
+			materialBlockIndex = static_cast<T_BlockIndex>(foundMaterialBlock - data->m_UniformBlocks.cbegin());
+			api->SetUniformBlockBinding(data->m_ShaderProgram, materialBlockIndex, materialBlockBuffer.GetBufferBinding());
+		}
 	}
 
 	// get all uniforms that are contained by uniform blocsk so we can exclude them
 	std::vector<int32> blockContainedUniIndices;
+	std::vector<int32> materialBlockUniIndices;
 	for (T_BlockIndex blockIdx = 0; blockIdx < static_cast<T_BlockIndex>(data->m_UniformBlocks.size()); ++blockIdx)
 	{
 		std::vector<int32> indicesForCurrentBlock = api->GetUniformIndicesForBlock(data->m_ShaderProgram, blockIdx);
+		if (blockIdx == materialBlockIndex)
+		{
+			materialBlockUniIndices = indicesForCurrentBlock;
+		}
 
 		// merge with blockContainedUniIndices
 		blockContainedUniIndices.reserve(blockContainedUniIndices.size() + indicesForCurrentBlock.size());
@@ -340,13 +411,51 @@ void ShaderAsset::InitUniforms(ShaderData* const data)
 		}
 	}
 
+	data->m_LooseUniformCount = data->m_UniformLayout.size();
+
+	// material block uniforms
+	//-------------------------
+	for (int32 const uniIdx : materialBlockUniIndices)
+	{
+		std::vector<UniformDescriptor> unis;
+		api->GetActiveUniforms(data->m_ShaderProgram, static_cast<uint32>(uniIdx), unis);
+
+		for (UniformDescriptor const& uni : unis)
+		{
+			ET_ASSERT(uni.blockOffset >= 0);
+
+			core::HashString const hash(uni.name.c_str());
+			ET_ASSERT(std::find(data->m_UniformIds.cbegin(), data->m_UniformIds.cend(), hash) == data->m_UniformIds.cend());
+
+			// still part of the layout so that materials can set the parameter by name
+			data->m_UniformIds.push_back(hash);
+			data->m_UniformLayout.push_back(render::UniformParam{ uni.location, uni.type, data->m_UniformDataSize });
+
+			size_t const blockOffset = static_cast<size_t>(uni.blockOffset);
+			data->m_MaterialBlockLayout.push_back(render::BlockParam{ data->m_UniformDataSize, blockOffset, uni.type });
+			data->m_MaterialBlockSize = std::max(data->m_MaterialBlockSize, blockOffset + render::parameters::GetStd140Size(uni.type));
+
+			data->m_UniformDataSize += render::parameters::GetSize(uni.type);
+		}
+	}
+
+	data->m_MaterialBlockSize = (data->m_MaterialBlockSize + sizeof(vec4) - 1u) & ~(sizeof(vec4) - 1u); // std140 blocks are vec4 aligned
+
 	// allocate parameters
 	data->m_CurrentUniforms = render::parameters::CreateBlock(data->m_UniformDataSize);
 
-	// init defaults
-	for (render::UniformParam const& param : data->m_UniformLayout)
+	// init defaults - uniform blocks have no initializers
+	for (size_t paramIdx = 0u; paramIdx < data->m_UniformLayout.size(); ++paramIdx)
 	{
-		api->PopulateUniform(data->m_ShaderProgram, param.location, param.type, static_cast<void*>(data->m_CurrentUniforms + param.offset));
+		render::UniformParam const& param = data->m_UniformLayout[paramIdx];
+		if (paramIdx < data->m_LooseUniformCount)
+		{
+			api->PopulateUniform(data->m_ShaderProgram, param.location, param.type, static_cast<void*>(data->m_CurrentUniforms + param.offset));
+		}
+		else
+		{
+			memset(data->m_CurrentUniforms + param.offset, 0, render::parameters::GetSize(param.type));
+		}
 	}
 }
 
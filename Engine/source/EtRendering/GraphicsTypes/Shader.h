@@ -17,6 +17,29 @@ namespace et {
 namespace render {
 
 
+// forward
+class ShaderData;
+
+
+//---------------------------------
+// UniformHandle
+//
+// Uniform that was looked up once in a shaders layout, so that uploading it later doesn't need to search for its ID
+//  - an invalid handle is returned for uniforms the shader doesn't have, uploads to it are ignored
+//
+struct UniformHandle
+{
+	bool IsValid() const { return (index != std::numeric_limits<uint32>::max()); }
+
+	uint32 index = std::numeric_limits<uint32>::max(); // into the shaders uniform layout
+	size_t offset = 0u; // of the value in the shaders current uniform block
+
+#if ET_CT_IS_ENABLED(ET_CT_ASSERT)
+	ShaderData const* shader = nullptr; // handles are only valid for the shader they where resolved with
+#endif
+};
+
+
 //---------------------------------
 // ShaderData
 //
@@ -48,16 +71,25 @@ public:
 	std::vector<core::HashString> const& GetUniformIds() const { return m_UniformIds; }
 	render::T_ConstParameterBlock GetCurrentUniforms() const { return m_CurrentUniforms; }
 
+	bool HasMaterialBlock() const { return !m_MaterialBlockLayout.empty(); }
+	size_t GetMaterialBlockSize() const { return m_MaterialBlockSize; }
+
 	// functionliaty
 	//---------------------
 	render::T_ParameterBlock CopyParameterBlock(render::T_ConstParameterBlock const source) const;
 	void UploadParameterBlock(render::T_ConstParameterBlock const block) const;
+	void PackMaterialBlock(render::T_ConstParameterBlock const block, uint8* const target) const;
+
+	UniformHandle GetUniformHandle(T_Hash const uniform, bool const reportWarnings = true) const;
 
 	template<typename TDataType>
 	bool Upload(T_Hash const uniform, TDataType const& data, bool const reportWarnings = true) const;
 
+	template<typename TDataType>
+	bool Upload(UniformHandle const uniform, TDataType const& data) const;
+
 	template<>
-	bool Upload<TextureData const*>(T_Hash const uniform, TextureData const* const& textureData, bool const reportWarnings) const;
+	bool Upload<TextureData const*>(UniformHandle const uniform, TextureData const* const& textureData) const;
 
 	// Data
 	///////
@@ -72,14 +104,19 @@ private:
 	// uniform data
 	//--------------
 
-	// loose uniforms
+	// loose uniforms, followed by the parameters of the material block
 	std::vector<render::UniformParam> m_UniformLayout;
 	std::vector<core::HashString> m_UniformIds;
 	render::T_ParameterBlock m_CurrentUniforms = nullptr;
 	size_t m_UniformDataSize = 0u;
+	size_t m_LooseUniformCount = 0u;
 
 	// within blocks
 	std::vector<core::HashString> m_UniformBlocks; // addressed by their indices
+
+	// std140 material block, packed from the parameter block into the material block buffer
+	std::vector<render::BlockParam> m_MaterialBlockLayout;
+	size_t m_MaterialBlockSize = 0u;
 };
 
 //---------------------------------
@@ -16,37 +16,47 @@ namespace render {
 //-------------------------------
 // ShaderData::Upload
 //
-// Upload a uniform in the shader the GPU for standard parameter types
+// Upload a uniform by its ID - for repeated uploads prefer resolving a handle once
 //
 template<typename TDataType>
-bool ShaderData::Upload(T_Hash const uniform, const TDataType &data, bool const reportWarnings) const
+bool ShaderData::Upload(T_Hash const uniform, TDataType const& data, bool const reportWarnings) const
 {
-	// Try finding the uniform
-	auto const idIt = std::find(m_UniformIds.cbegin(), m_UniformIds.cend(), uniform);
-
-	if (idIt == m_UniformIds.cend())
+	UniformHandle const handle = GetUniformHandle(uniform, reportWarnings);
+	if (!handle.IsValid())
 	{
-		if (reportWarnings)
-		{
-			ET_ASSERT(false, "Couldn't find uniform!");
-		}
+		return false;
+	}
 
+	return Upload(handle, data);
+}
+
+//-------------------------------
+// ShaderData::Upload
+//
+// Upload a uniform in the shader the GPU for standard parameter types
+//
+template<typename TDataType>
+bool ShaderData::Upload(UniformHandle const uniform, TDataType const& data) const
+{
+	if (!uniform.IsValid())
+	{
 		return false;
 	}
 
-	render::UniformParam const& param = m_UniformLayout[idIt - m_UniformIds.cbegin()];
+	ET_ASSERT(uniform.shader == this, "Uniform handle was resolved with a different shader!");
 
-	if (render::parameters::Read<TDataType>(m_CurrentUniforms, param.offset) == data)
+	if (render::parameters::Read<TDataType>(m_CurrentUniforms, uniform.offset) == data)
 	{
 		return true; // no need for API call as the state wouldn't change
 	}
 
+	render::UniformParam const& param = m_UniformLayout[uniform.index];
 	ET_ASSERT(render::parameters::GetTypeId(param.type) == rttr::type::get<TDataType>());
 
 	ContextHolder::GetRenderContext()->UploadUniform(param.location, data);
 
 	// ensure the shader reflects the GPU state
-	render::parameters::Write<TDataType>(m_CurrentUniforms, param.offset, data);
+	render::parameters::Write<TDataType>(m_CurrentUniforms, uniform.offset, data);
 
 	return true;
 }
@@ -57,29 +67,23 @@ bool ShaderData::Upload(T_Hash const uniform, const TDataType &data, bool const
 // Upload a texture to a shader
 //
 template<>
-bool ShaderData::Upload<TextureData const*>(T_Hash const uniform, TextureData const* const& textureData, bool const reportWarnings) const
+bool ShaderData::Upload<TextureData const*>(UniformHandle const uniform, TextureData const* const& textureData) const
 {
-	// Try finding the uniform
-	auto const idIt = std::find(m_UniformIds.cbegin(), m_UniformIds.cend(), uniform);
-
-	if (idIt == m_UniformIds.cend())
+	if (!uniform.IsValid())
 	{
-		if (reportWarnings)
-		{
-			ET_ASSERT(false, "Couldn't find uniform!");
-		}
-
 		return false;
 	}
 
-	render::UniformParam const& param = m_UniformLayout[idIt - m_UniformIds.cbegin()];
+	ET_ASSERT(uniform.shader == this, "Uniform handle was resolved with a different shader!");
+
+	render::UniformParam const& param = m_UniformLayout[uniform.index];
 
 	ET_ASSERT(render::parameters::MatchesTexture(param.type, textureData->GetTargetType()));
 
 	//T_TextureHandle const texHandle = textureData->GetHandle();
 	//if (texHandle != 0u)
 	//{
-	//	if (render::parameters::Read<TextureData const*>(m_CurrentUniforms, param.offset) == textureData)
+	//	if (render::parameters::Read<TextureData const*>(m_CurrentUniforms, uniform.offset) == textureData)
 	//	{
 	//		return true; // no need for API call as the state wouldn't change
 	//	}
@@ -97,7 +101,7 @@ bool ShaderData::Upload<TextureData const*>(T_Hash const uniform, TextureData co
 	//}
 
 	// ensure the shader reflects the GPU state
-	render::parameters::Write<TextureData const*>(m_CurrentUniforms, param.offset, textureData);
+	render::parameters::Write<TextureData const*>(m_CurrentUniforms, uniform.offset, textureData);
 
 	return true;
 }
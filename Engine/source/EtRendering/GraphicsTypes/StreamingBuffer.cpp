@@ -0,0 +1,196 @@
+#include "stdafx.h"
+#include "StreamingBuffer.h"
+
+
+namespace et {
+namespace render {
+
+
+//==================
+// Streaming Buffer
+//==================
+
+
+//---------------------------------
+// StreamingBuffer::d-tor
+//
+StreamingBuffer::~StreamingBuffer()
+{
+	if (m_Buffer != 0u)
+	{
+		Deinit();
+	}
+}
+
+//---------------------------------
+// StreamingBuffer::Init
+//
+void StreamingBuffer::Init(size_t const frameSize)
+{
+	ET_ASSERT(frameSize > 0u);
+	ET_ASSERT(m_Buffer == 0u);
+
+	m_FrameSize = frameSize;
+	CreateStorage();
+}
+
+//---------------------------------
+// StreamingBuffer::Deinit
+//
+void StreamingBuffer::Deinit()
+{
+	ReleaseRetiredBuffers();
+	DestroyStorage();
+	m_FrameSize = 0u;
+}
+
+//---------------------------------
+// StreamingBuffer::Allocate
+//
+// Reserve a range in the current frames region. If it doesn't fit the buffer is replaced by one with larger regions.
+//  - the old buffer is only deleted at the end of the frame, so vertex arrays that are still linked to it stay valid
+//    for the allocations that were made in it earlier this frame
+//  - this doesn't need to wait for the GPU, as the old buffer is never written to again, and the driver keeps its
+//    storage alive for as long as issued draws still read from it
+//
+size_t StreamingBuffer::Allocate(size_t const size, size_t const alignment)
+{
+	ET_ASSERT(m_Buffer != 0u);
+	ET_ASSERT(size > 0u);
+	ET_ASSERT(alignment > 0u);
+
+	// alignment is relative to the start of the buffer, so that offsets can be used as base vertices of any stride
+	size_t const frameStart = m_FrameIdx * m_FrameSize;
+	size_t offset = ((frameStart + m_Head + alignment - 1u) / alignment) * alignment;
+
+	if (offset + size > frameStart + m_FrameSize)
+	{
+		size_t frameSize = m_FrameSize * 2u;
+		while (frameSize < size + alignment)
+		{
+			frameSize *= 2u;
+		}
+
+		m_RetiredBuffers.push_back(m_Buffer);
+		m_Buffer = 0u;
+		DestroyStorage();
+
+		m_FrameSize = frameSize;
+		CreateStorage();
+
+		offset = 0u;
+	}
+
+	m_Head = offset + size - (m_FrameIdx * m_FrameSize);
+	return offset;
+}
+
+//---------------------------------
+// StreamingBuffer::Write
+//
+void StreamingBuffer::Write(size_t const offset, void const* const data, size_t const size)
+{
+	ET_ASSERT(m_MappedData != nullptr);
+	ET_ASSERT(offset + size <= m_FrameSize * s_FrameCount);
+
+	memcpy(m_MappedData + offset, data, size);
+}
+
+//---------------------------------
+// StreamingBuffer::EndFrame
+//
+// Fence the current region once all draws that read from it are issued, and move on to the next one.
+// This only blocks if the GPU is still using that region, i.e. if it is more than s_FrameCount - 1 frames behind
+//
+void StreamingBuffer::EndFrame()
+{
+	ReleaseRetiredBuffers();
+
+	if (m_Head == 0u)
+	{
+		return;
+	}
+
+	I_GraphicsContextApi* const api = ContextHolder::GetRenderContext();
+
+	m_Fences[m_FrameIdx] = api->InsertFence();
+
+	m_FrameIdx = (m_FrameIdx + 1u) % s_FrameCount;
+	m_Head = 0u;
+
+	T_FenceLoc& fence = m_Fences[m_FrameIdx];
+	if (fence != 0u)
+	{
+		api->WaitForFence(fence);
+		api->DeleteFence(fence);
+	}
+}
+
+//---------------------------------
+// StreamingBuffer::CreateStorage
+//
+void StreamingBuffer::CreateStorage()
+{
+	I_GraphicsContextApi* const api = ContextHolder::GetRenderContext();
+
+	m_Buffer = api->CreateBuffer();
+	api->BindBuffer(E_BufferType::Vertex, m_Buffer);
+	m_MappedData = static_cast<uint8*>(api->SetPersistentBufferStorage(E_BufferType::Vertex, static_cast<int64>(m_FrameSize * s_FrameCount)));
+	api->BindBuffer(E_BufferType::Vertex, 0u);
+
+	ET_ASSERT(m_MappedData != nullptr);
+
+	m_FrameIdx = 0u;
+	m_Head = 0u;
+}
+
+//---------------------------------
+// StreamingBuffer::DestroyStorage
+//
+// Fences of the old storage don't need to be waited on as its regions are never written to again
+//
+void StreamingBuffer::DestroyStorage()
+{
+	I_GraphicsContextApi* const api = ContextHolder::GetRenderContext();
+
+	for (T_FenceLoc& fence : m_Fences)
+	{
+		if (fence != 0u)
+		{
+			api->DeleteFence(fence);
+		}
+	}
+
+	if (m_Buffer != 0u)
+	{
+		api->DeleteBuffer(m_Buffer);
+		m_Buffer = 0u;
+	}
+
+	m_MappedData = nullptr;
+}
+
+//-----------------------------------------
+// StreamingBuffer::ReleaseRetiredBuffers
+//
+// Delete buffers that were replaced during the frame, once no more draws that use them can be issued
+//
+void StreamingBuffer::ReleaseRetiredBuffers()
+{
+	if (m_RetiredBuffers.empty())
+	{
+		return;
+	}
+
+	I_GraphicsContextApi* const api = ContextHolder::GetRenderContext();
+	for (T_BufferLoc& buffer : m_RetiredBuffers)
+	{
+		api->DeleteBuffer(buffer);
+	}
+
+	m_RetiredBuffers.clear();
+}
+
+
+} // namespace render
+} // namespace et
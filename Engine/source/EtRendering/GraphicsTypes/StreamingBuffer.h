@@ -0,0 +1,74 @@
+#pragma once
+#include <EtRendering/GraphicsContext/GraphicsTypes.h>
+
+
+namespace et {
+namespace render {
+
+
+//---------------------------------
+// StreamingBuffer
+//
+// Persistently mapped buffer for geometry that is regenerated every frame, split into one region per frame in flight
+//  - allocations are written directly into mapped memory, so there is no per draw upload or implicit synchronization
+//  - the end of each frame is fenced, and a region is only reused once the GPU is done reading it
+//  - if a frame doesn't fit its region, the buffer is replaced by a larger one, so users need to relink their vertex arrays
+//    when GetBuffer changes. Data a single draw reads should therefore come from a single allocation
+//  - a replaced buffer stays alive until the end of the frame, so draws linked to it can still use earlier allocations
+//
+class StreamingBuffer final
+{
+	// definitions
+	//-------------
+public:
+	static constexpr size_t s_FrameCount = 3u;
+	static constexpr size_t s_InvalidOffset = std::numeric_limits<size_t>::max();
+
+	// construct destruct
+	//--------------------
+	StreamingBuffer() = default;
+	~StreamingBuffer();
+
+	void Init(size_t const frameSize);
+	void Deinit();
+
+	// functionality
+	//---------------
+	// returns the offset from the start of GetBuffer, which may change with this call
+	//  - only the current buffer is mapped, so an allocation has to be written before the next call to Allocate
+	size_t Allocate(size_t const size, size_t const alignment);
+	void Write(size_t const offset, void const* const data, size_t const size);
+
+	void EndFrame();
+
+	// accessors
+	//-----------
+	T_BufferLoc GetBuffer() const { return m_Buffer; }
+	size_t GetFrameSize() const { return m_FrameSize; }
+	size_t GetFrameUsage() const { return m_Head; }
+
+	// utility
+	//---------
+private:
+	void CreateStorage();
+	void DestroyStorage();
+	void ReleaseRetiredBuffers();
+
+	// Data
+	///////
+
+	T_BufferLoc m_Buffer = 0u;
+	uint8* m_MappedData = nullptr;
+
+	size_t m_FrameSize = 0u;
+	size_t m_FrameIdx = 0u;
+	size_t m_Head = 0u; // relative to the start of the current frames region
+
+	T_FenceLoc m_Fences[s_FrameCount] = {}; // signaled once the GPU is done with a frames region
+
+	std::vector<T_BufferLoc> m_RetiredBuffers; // replaced during the current frame, deleted once it ends
+};
+
+
+} // namespace render
+} // namespace et
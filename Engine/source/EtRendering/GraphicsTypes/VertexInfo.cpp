@@ -64,6 +64,9 @@ std::map<E_VertexFlag, AttributeDescriptor const> const AttributeDescriptor::s_V
 	{ E_VertexFlag::TEXCOORD,	{ "texcoord",	E_DataType::Float, 2 } }
 };
 
+// shaders that declare this attribute can draw all instances of a mesh in one call
+AttributeDescriptor const AttributeDescriptor::s_InstanceTransform = { "instanceModel", E_DataType::Float, 16 };
+
 
 //---------------------------------
 // AttributeDescriptor::PrintFlags
@@ -204,6 +207,27 @@ void AttributeDescriptor::DefineAttributeArray(T_VertexFlags const supportedFlag
 	ET_ASSERT(locationIdx == locations.size());
 }
 
+//---------------------------------------------------
+// AttributeDescriptor::DefineInstanceTransformArray
+//
+// Enables a mat4 attribute sourced from the bound vertex buffer, advancing once per instance instead of once per vertex
+//  - matrix attributes take up 4 consecutive locations, one for each row of our matrices which GLSL reads as columns, same as uniforms
+//
+void AttributeDescriptor::DefineInstanceTransformArray(int32 const location)
+{
+	I_GraphicsContextApi* const api = ContextHolder::GetRenderContext();
+
+	ET_ASSERT(location >= 0);
+	uint32 const baseLocation = static_cast<uint32>(location);
+
+	for (uint32 row = 0u; row < 4u; ++row)
+	{
+		api->SetVertexAttributeArrayEnabled(baseLocation + row, true);
+		api->DefineVertexAttributePointer(baseLocation + row, 4, E_DataType::Float, false, sizeof(mat4), static_cast<size_t>(row) * sizeof(vec4));
+		api->DefineVertexAttribDivisor(baseLocation + row, 1u);
+	}
+}
+
 //-------------------------------------------
 // AttributeDescriptor::GetVertexFlag
 //
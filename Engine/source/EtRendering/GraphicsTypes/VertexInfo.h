@@ -55,6 +55,7 @@ struct AttributeDescriptor
 	// Definitions
 	//-------------
 	static std::map<E_VertexFlag, AttributeDescriptor const> const s_VertexAttributes;
+	static AttributeDescriptor const s_InstanceTransform; // per instance model matrix, read from a separate buffer
 
 	// static functionality
 	//----------------------
@@ -63,6 +64,7 @@ struct AttributeDescriptor
 	static bool ValidateFlags(T_VertexFlags const supportedFlags, T_VertexFlags const requiredFlags);
 	static void DefineAttributeArray(T_VertexFlags const flags, std::vector<int32> const& locations);
 	static void DefineAttributeArray(T_VertexFlags const supportedFlags, T_VertexFlags const targetFlags, std::vector<int32> const& locations);
+	static void DefineInstanceTransformArray(int32 const location);
 	static bool GetVertexFlag(AttributeDescriptor const& desc, E_VertexFlag& flag);
 
 	// Data
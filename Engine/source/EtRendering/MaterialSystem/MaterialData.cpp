@@ -6,6 +6,8 @@
 #include <EtCore/Content/AssetRegistration.h>
 #include <EtCore/Reflection/BinaryDeserializer.h>
 
+#include <EtRendering/GlobalRenderingSystems/GlobalRenderingSystems.h>
+
 
 namespace et {
 namespace render {
@@ -71,6 +73,25 @@ Material::Material(AssetPtr<ShaderData> const shader,
 			m_LayoutFlags |= it->first;
 		}
 	}
+
+	// shaders reading the model matrix per instance
+	auto const instanceIt = std::find_if(attributes.cbegin(), attributes.cend(), [](ShaderData::T_AttributeLocation const& loc)
+	{
+		return AttributeDescriptor::s_InstanceTransform.name == loc.second.name;
+	});
+
+	if (instanceIt != attributes.cend())
+	{
+		m_InstanceTransformLocation = instanceIt->first;
+	}
+
+	// parameters in the material block are bound as a buffer range
+	if (m_Shader->HasMaterialBlock())
+	{
+		MaterialBlockBuffer& blockBuffer = RenderingSystems::Instance()->GetMaterialBlockBuffer();
+		m_BlockId = blockBuffer.Allocate(m_Shader->GetMaterialBlockSize());
+		m_Shader->PackMaterialBlock(m_DefaultParameters, blockBuffer.Write(m_BlockId));
+	}
 }
 
 //--------------------------
@@ -82,6 +103,11 @@ Material::~Material()
 	{
 		parameters::DestroyBlock(m_DefaultParameters);
 	}
+
+	if (m_BlockId != MaterialBlockBuffer::s_InvalidBlock)
+	{
+		RenderingSystems::Instance()->GetMaterialBlockBuffer().Release(m_BlockId);
+	}
 }
 
 
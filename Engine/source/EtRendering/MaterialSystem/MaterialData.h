@@ -64,6 +64,7 @@ public:
 	//---------------------
 	Material const* GetBaseMaterial() const override { return this; }
 	T_ConstParameterBlock GetParameters() const override { return m_DefaultParameters; }
+	MaterialBlockBuffer::T_BlockId GetBlockId() const override { return m_BlockId; }
 
 	// accessors
 	//---------------------
@@ -74,6 +75,8 @@ public:
 
 	T_VertexFlags GetLayoutFlags() const { return m_LayoutFlags; }
 	std::vector<int32> const& GetAttributeLocations() const { return m_AttributeLocations; }
+	T_AttribLoc GetInstanceTransformLocation() const { return m_InstanceTransformLocation; }
+	bool SupportsInstancing() const { return (m_InstanceTransformLocation >= 0); }
 
 	// Data
 	///////
@@ -86,9 +89,11 @@ private:
 	// vertices
 	T_VertexFlags m_LayoutFlags = 0u;
 	std::vector<int32> m_AttributeLocations;
+	T_AttribLoc m_InstanceTransformLocation = -1;
 
 	// parameters
 	T_ParameterBlock m_DefaultParameters = nullptr;
+	MaterialBlockBuffer::T_BlockId m_BlockId = MaterialBlockBuffer::s_InvalidBlock;
 
 	// utility
 	std::vector<AssetPtr<TextureData>> m_TextureReferences; // prevent textures from unloading
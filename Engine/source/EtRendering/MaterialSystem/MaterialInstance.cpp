@@ -7,6 +7,8 @@
 #include <EtCore/Reflection/Registration.h>
 #include <EtCore/Reflection/BinaryDeserializer.h>
 
+#include <EtRendering/GlobalRenderingSystems/GlobalRenderingSystems.h>
+
 
 namespace et {
 namespace render {
@@ -42,7 +44,9 @@ MaterialInstance::MaterialInstance(AssetPtr<Material> const material,
 	, m_Material(material)
 	, m_Parameters(params)
 	, m_TextureReferences(textureRefs)
-{ }
+{
+	InitBlock();
+}
 
 //--------------------------
 // MaterialInstance::c-tor
@@ -61,6 +65,7 @@ MaterialInstance::MaterialInstance(AssetPtr<MaterialInstance> const parent,
 	ET_ASSERT(m_Parent != nullptr);
 
 	m_Material = m_Parent->GetMaterialAsset();
+	InitBlock();
 }
 
 //--------------------------
@@ -69,6 +74,27 @@ MaterialInstance::MaterialInstance(AssetPtr<MaterialInstance> const parent,
 MaterialInstance::~MaterialInstance()
 {
 	parameters::DestroyBlock(m_Parameters);
+
+	if (m_BlockId != MaterialBlockBuffer::s_InvalidBlock)
+	{
+		RenderingSystems::Instance()->GetMaterialBlockBuffer().Release(m_BlockId);
+	}
+}
+
+//------------------------------
+// MaterialInstance::InitBlock
+//
+// Pack the overridden parameters into a block of their own, if the shader has a material block
+//
+void MaterialInstance::InitBlock()
+{
+	ShaderData const* const shader = m_Material->GetShader();
+	if (shader->HasMaterialBlock())
+	{
+		MaterialBlockBuffer& blockBuffer = RenderingSystems::Instance()->GetMaterialBlockBuffer();
+		m_BlockId = blockBuffer.Allocate(shader->GetMaterialBlockSize());
+		shader->PackMaterialBlock(m_Parameters, blockBuffer.Write(m_BlockId));
+	}
 }
 
 
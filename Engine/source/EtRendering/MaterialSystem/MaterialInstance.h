@@ -30,12 +30,18 @@ public:
 	//---------------------
 	Material const* GetBaseMaterial() const override { return m_Material.get(); }
 	T_ConstParameterBlock GetParameters() const override { return m_Parameters; }
+	MaterialBlockBuffer::T_BlockId GetBlockId() const override { return m_BlockId; }
 
 	// accessors
 	//---------------------
 	AssetPtr<Material> GetMaterialAsset() const { return m_Material; }
 	MaterialInstance const* GetParent() const { return m_Parent.get(); }
 
+	// utility
+	//---------------------
+private:
+	void InitBlock();
+
 	// Data
 	///////
 private:
@@ -46,6 +52,7 @@ private:
 
 	// parameters
 	T_ParameterBlock m_Parameters = nullptr;
+	MaterialBlockBuffer::T_BlockId m_BlockId = MaterialBlockBuffer::s_InvalidBlock;
 
 	// utility
 	std::vector<AssetPtr<TextureData>> m_TextureReferences; // prevent textures from unloading
@@ -0,0 +1,37 @@
+#include "stdafx.h"
+#include "MaterialInterface.h"
+
+#include "MaterialData.h"
+
+#include <EtRendering/GlobalRenderingSystems/GlobalRenderingSystems.h>
+
+
+namespace et {
+namespace render {
+
+
+//====================
+// Material Interface
+//====================
+
+
+//---------------------------------
+// I_Material::UploadParameters
+//
+// Set the parameters of this material for following draw calls, the shader of the base material needs to be active
+//  - loose uniforms are uploaded, while the material block is bound as a range of the shared material block buffer
+//
+void I_Material::UploadParameters() const
+{
+	GetBaseMaterial()->GetShader()->UploadParameterBlock(GetParameters());
+
+	MaterialBlockBuffer::T_BlockId const blockId = GetBlockId();
+	if (blockId != MaterialBlockBuffer::s_InvalidBlock)
+	{
+		RenderingSystems::Instance()->GetMaterialBlockBuffer().Bind(blockId);
+	}
+}
+
+
+} // namespace render
+} // namespace et
@@ -1,5 +1,6 @@
 #pragma once
 #include <EtRendering/GraphicsTypes/ParameterBlock.h>
+#include <EtRendering/GlobalRenderingSystems/MaterialBlockBuffer.h>
 
 
 namespace et {
@@ -22,6 +23,9 @@ public:
 
 	virtual Material const* GetBaseMaterial() const = 0;
 	virtual T_ConstParameterBlock GetParameters() const = 0;
+	virtual MaterialBlockBuffer::T_BlockId GetBlockId() const = 0; // invalid if the shader has no material block
+
+	void UploadParameters() const;
 };
 
 
@@ -55,6 +55,33 @@ void PostProcessingRenderer::Initialize()
 	m_pPostProcShader = core::ResourceManager::Instance()->GetAssetData<ShaderData>(core::HashString("Shaders/PostProcessing.glsl"));
 	m_pFXAAShader = core::ResourceManager::Instance()->GetAssetData<ShaderData>(core::HashString("Shaders/PostFXAA.glsl"));
 
+	//Resolve uniforms that are uploaded every frame
+	m_DownsampleTexColor = m_pDownsampleShader->GetUniformHandle("texColor"_hash);
+	m_DownsampleThreshold = m_pDownsampleShader->GetUniformHandle("threshold"_hash);
+
+	m_GaussianImage = m_pGaussianShader->GetUniformHandle("image"_hash);
+	m_GaussianHorizontal = m_pGaussianShader->GetUniformHandle("horizontal"_hash);
+
+	m_PostProcTexColor = m_pPostProcShader->GetUniformHandle("texColor"_hash);
+	for (int32 i = 0; i <= NUM_BLOOM_DOWNSAMPLES; ++i)
+	{
+		m_PostProcTexBloom[i] = m_pPostProcShader->GetUniformHandle(GetHash(FS("texBloom%i", i)));
+	}
+
+	m_PostProcShoulderStrength = m_pPostProcShader->GetUniformHandle("uShoulderStrength"_hash);
+	m_PostProcLinearStrength = m_pPostProcShader->GetUniformHandle("uLinearStrength"_hash);
+	m_PostProcEdivF = m_pPostProcShader->GetUniformHandle("uEdivF"_hash);
+	m_PostProcCB = m_pPostProcShader->GetUniformHandle("uCB"_hash);
+	m_PostProcDE = m_pPostProcShader->GetUniformHandle("uDE"_hash);
+	m_PostProcDF = m_pPostProcShader->GetUniformHandle("uDF"_hash);
+	m_PostProcLinearWhiteMapped = m_pPostProcShader->GetUniformHandle("uLinearWhiteMapped"_hash);
+	m_PostProcExposure = m_pPostProcShader->GetUniformHandle("exposure"_hash);
+	m_PostProcGamma = m_pPostProcShader->GetUniformHandle("gamma"_hash);
+	m_PostProcBloomMult = m_pPostProcShader->GetUniformHandle("bloomMult"_hash);
+
+	m_FxaaInverseScreen = m_pFXAAShader->GetUniformHandle("uInverseScreen"_hash);
+	m_FxaaTexColor = m_pFXAAShader->GetUniformHandle("texColor"_hash);
+
 	GenerateFramebuffers();
 }
 
@@ -154,8 +181,8 @@ void PostProcessingRenderer::Draw(T_FbLoc const FBO, PostProcessingSettings cons
 	//get glow
 	api->BindFramebuffer(m_HDRoutFBO);
 	api->SetShader(m_pDownsampleShader.get());
-	m_pDownsampleShader->Upload("texColor"_hash, static_cast<TextureData const*>(m_CollectTex));
-	m_pDownsampleShader->Upload("threshold"_hash, settings.bloomThreshold);
+	m_pDownsampleShader->Upload(m_DownsampleTexColor, static_cast<TextureData const*>(m_CollectTex));
+	m_pDownsampleShader->Upload(m_DownsampleThreshold, settings.bloomThreshold);
 	RenderingSystems::Instance()->GetPrimitiveRenderer().Draw<primitives::Quad>();
 	//downsample glow
 	api->DebugPushGroup("downsample glow");
@@ -172,10 +199,10 @@ void PostProcessingRenderer::Draw(T_FbLoc const FBO, PostProcessingSettings cons
 		api->BindFramebuffer(m_DownSampleFBO[i]);
 		if (i > 0)
 		{
-			m_pDownsampleShader->Upload("texColor"_hash, static_cast<TextureData const*>(m_DownSampleTexture[i - 1]));
+			m_pDownsampleShader->Upload(m_DownsampleTexColor, static_cast<TextureData const*>(m_DownSampleTexture[i - 1]));
 		}
 
-		m_pDownsampleShader->Upload("threshold"_hash, settings.bloomThreshold);
+		m_pDownsampleShader->Upload(m_DownsampleThreshold, settings.bloomThreshold);
 		RenderingSystems::Instance()->GetPrimitiveRenderer().Draw<primitives::Quad>();
 
 		//blur downsampled
@@ -188,8 +215,8 @@ void PostProcessingRenderer::Draw(T_FbLoc const FBO, PostProcessingSettings cons
 			//output is the current framebuffer, or on the last item the framebuffer of the downsample texture
 			api->BindFramebuffer(horizontal ? m_DownPingPongFBO[i] : m_DownSampleFBO[i]);
 			//input is previous framebuffers texture, or on first item the result of downsampling
-			m_pGaussianShader->Upload("image"_hash, static_cast<TextureData const*>(horizontal ? m_DownSampleTexture[i] : m_DownPingPongTexture[i]));
-			m_pGaussianShader->Upload("horizontal"_hash, horizontal);
+			m_pGaussianShader->Upload(m_GaussianImage, static_cast<TextureData const*>(horizontal ? m_DownSampleTexture[i] : m_DownPingPongTexture[i]));
+			m_pGaussianShader->Upload(m_GaussianHorizontal, horizontal);
 			RenderingSystems::Instance()->GetPrimitiveRenderer().Draw<primitives::Quad>();
 		}
 
@@ -207,8 +234,8 @@ void PostProcessingRenderer::Draw(T_FbLoc const FBO, PostProcessingSettings cons
 	for (uint32 i = 0; i < static_cast<uint32>(graphicsSettings.NumBlurPasses * 2); i++)
 	{
 		api->BindFramebuffer(m_PingPongFBO[horizontal]);
-		m_pGaussianShader->Upload("horizontal"_hash, horizontal);
-		m_pGaussianShader->Upload("image"_hash, static_cast<TextureData const*>((i == 0) ? m_ColorBuffers[1] : m_PingPongTexture[!horizontal]));
+		m_pGaussianShader->Upload(m_GaussianHorizontal, horizontal);
+		m_pGaussianShader->Upload(m_GaussianImage, static_cast<TextureData const*>((i == 0) ? m_ColorBuffers[1] : m_PingPongTexture[!horizontal]));
 		RenderingSystems::Instance()->GetPrimitiveRenderer().Draw<primitives::Quad>();
 		horizontal = !horizontal;
 	}
@@ -222,11 +249,11 @@ void PostProcessingRenderer::Draw(T_FbLoc const FBO, PostProcessingSettings cons
 	api->BindFramebuffer(currentFb);
 	api->SetShader(m_pPostProcShader.get());
 
-	m_pPostProcShader->Upload("texColor"_hash, static_cast<TextureData const*>(m_CollectTex));
-	m_pPostProcShader->Upload("texBloom0"_hash, static_cast<TextureData const*>(m_PingPongTexture[0]));
+	m_pPostProcShader->Upload(m_PostProcTexColor, static_cast<TextureData const*>(m_CollectTex));
+	m_pPostProcShader->Upload(m_PostProcTexBloom[0], static_cast<TextureData const*>(m_PingPongTexture[0]));
 	for (int32 i = 0; i < NUM_BLOOM_DOWNSAMPLES; ++i)
 	{
-		m_pPostProcShader->Upload(GetHash(FS("texBloom%i", i + 1)), static_cast<TextureData const*>(m_DownSampleTexture[i]));
+		m_pPostProcShader->Upload(m_PostProcTexBloom[i + 1], static_cast<TextureData const*>(m_DownSampleTexture[i]));
 	}
 
 	// precalculate some tonemapping settings
@@ -242,13 +269,13 @@ void PostProcessingRenderer::Draw(T_FbLoc const FBO, PostProcessingSettings cons
 		float const de = settings.toeStrength * settings.toeNumerator;
 		float const df = settings.toeStrength * settings.toeDenominator;
 
-		m_pPostProcShader->Upload("uShoulderStrength"_hash, settings.shoulderStrength);
-		m_pPostProcShader->Upload("uLinearStrength"_hash, settings.linearStrength);
+		m_pPostProcShader->Upload(m_PostProcShoulderStrength, settings.shoulderStrength);
+		m_pPostProcShader->Upload(m_PostProcLinearStrength, settings.linearStrength);
 
-		m_pPostProcShader->Upload("uEdivF"_hash, eDivF);
-		m_pPostProcShader->Upload("uCB"_hash, cb);
-		m_pPostProcShader->Upload("uDE"_hash, de);
-		m_pPostProcShader->Upload("uDF"_hash, df);
+		m_pPostProcShader->Upload(m_PostProcEdivF, eDivF);
+		m_pPostProcShader->Upload(m_PostProcCB, cb);
+		m_pPostProcShader->Upload(m_PostProcDE, de);
+		m_pPostProcShader->Upload(m_PostProcDF, df);
 
 		// apply filmic function to linear white
 		{
@@ -256,13 +283,13 @@ void PostProcessingRenderer::Draw(T_FbLoc const FBO, PostProcessingSettings cons
 			float const shoulderX = settings.shoulderStrength * x;
 			float const fLinWhite = ((x * (shoulderX + cb) + de) / (x * (shoulderX + settings.linearStrength) + df)) - eDivF;
 
-			m_pPostProcShader->Upload("uLinearWhiteMapped"_hash, fLinWhite);
+			m_pPostProcShader->Upload(m_PostProcLinearWhiteMapped, fLinWhite);
 		}
 	}
 
-	m_pPostProcShader->Upload("exposure"_hash, settings.exposure);
-	m_pPostProcShader->Upload("gamma"_hash, settings.gamma);
-	m_pPostProcShader->Upload("bloomMult"_hash, settings.bloomMult);
+	m_pPostProcShader->Upload(m_PostProcExposure, settings.exposure);
+	m_pPostProcShader->Upload(m_PostProcGamma, settings.gamma);
+	m_pPostProcShader->Upload(m_PostProcBloomMult, settings.bloomMult);
 	RenderingSystems::Instance()->GetPrimitiveRenderer().Draw<primitives::Quad>();
 	api->DebugPopGroup(); // bloom + tonemapping
 
@@ -277,8 +304,8 @@ void PostProcessingRenderer::Draw(T_FbLoc const FBO, PostProcessingSettings cons
 		api->BindFramebuffer(FBO);
 
 		api->SetShader(m_pFXAAShader.get());
-		m_pFXAAShader->Upload("uInverseScreen"_hash, 1.f / math::vecCast<float>(dim));
-		m_pFXAAShader->Upload("texColor"_hash, static_cast<TextureData const*>(m_PingPongTexture[1]));
+		m_pFXAAShader->Upload(m_FxaaInverseScreen, 1.f / math::vecCast<float>(dim));
+		m_pFXAAShader->Upload(m_FxaaTexColor, static_cast<TextureData const*>(m_PingPongTexture[1]));
 
 		RenderingSystems::Instance()->GetPrimitiveRenderer().Draw<primitives::Quad>();
 
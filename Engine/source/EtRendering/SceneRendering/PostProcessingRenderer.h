@@ -3,13 +3,13 @@
 
 #include <EtRendering/GraphicsTypes/FrameBuffer.h>
 #include <EtRendering/GraphicsTypes/PostProcessingSettings.h>
+#include <EtRendering/GraphicsTypes/Shader.h>
 
 
 namespace et {
 namespace render {
 
 
-class ShaderData;
 class TextureData;
 class I_OverlayRenderer;
 
@@ -41,6 +41,29 @@ private:
 	AssetPtr<ShaderData> m_pPostProcShader;
 	AssetPtr<ShaderData> m_pFXAAShader;
 
+	// uniforms resolved once the shaders are loaded
+	UniformHandle m_DownsampleTexColor;
+	UniformHandle m_DownsampleThreshold;
+
+	UniformHandle m_GaussianImage;
+	UniformHandle m_GaussianHorizontal;
+
+	UniformHandle m_PostProcTexColor;
+	UniformHandle m_PostProcTexBloom[NUM_BLOOM_DOWNSAMPLES + 1];
+	UniformHandle m_PostProcShoulderStrength;
+	UniformHandle m_PostProcLinearStrength;
+	UniformHandle m_PostProcEdivF;
+	UniformHandle m_PostProcCB;
+	UniformHandle m_PostProcDE;
+	UniformHandle m_PostProcDF;
+	UniformHandle m_PostProcLinearWhiteMapped;
+	UniformHandle m_PostProcExposure;
+	UniformHandle m_PostProcGamma;
+	UniformHandle m_PostProcBloomMult;
+
+	UniformHandle m_FxaaInverseScreen;
+	UniformHandle m_FxaaTexColor;
+
 	T_FbLoc m_CollectFBO;
 	TextureData* m_CollectTex = nullptr;
 	T_RbLoc m_CollectRBO;
@@ -0,0 +1,439 @@
+#include "stdafx.h"
+#include "RenderQueue.h"
+
+#include <EtCore/Concurrency/WorkerPool.h>
+
+#include <EtRendering/GlobalRenderingSystems/GlobalRenderingSystems.h>
+#include <EtRendering/GraphicsTypes/Camera.h>
+#include <EtRendering/MaterialSystem/MaterialInterface.h>
+#include <EtRendering/MaterialSystem/MaterialData.h>
+#include <EtRendering/SceneStructure/RenderScene.h>
+
+
+namespace et {
+namespace render {
+
+
+//==============
+// Render Queue
+//==============
+
+
+//---------------------------------
+// RenderQueue::MakeKey
+//
+// Pack draw state into a key so that sorting groups state changes
+//  - depth is normalized between the near and far plane
+//  - opaque:  | pass 4 | shader 12 | material 16 | mesh 16 | depth 16 |
+//  - forward: | pass 4 | inverse depth 16 | shader 12 | material 16 | mesh 16 |
+//  - Build splits into segments before an index reaches its field limit
+//
+uint64 RenderQueue::MakeKey(E_Pass const pass, uint32 const shader, uint32 const material, uint32 const mesh, float const depth)
+{
+	ET_ASSERT(shader < s_MaxShaders);
+	ET_ASSERT(material < s_MaxMaterials);
+	ET_ASSERT(mesh < s_MaxMeshes);
+
+	uint64 const maxDepth = (1u << s_DepthBits) - 1u;
+	uint64 const depthBits = static_cast<uint64>(math::Clamp01(depth) * static_cast<float>(maxDepth));
+
+	uint64 const state = (static_cast<uint64>(shader) << (s_MaterialBits + s_MeshBits))
+		| (static_cast<uint64>(material) << s_MeshBits)
+		| static_cast<uint64>(mesh);
+
+	uint64 key = static_cast<uint64>(pass) << (s_ShaderBits + s_MaterialBits + s_MeshBits + s_DepthBits);
+	if (pass == E_Pass::Forward)
+	{
+		// blended geometry needs to be drawn back to front, so depth takes precedence over state
+		key |= ((maxDepth - depthBits) << (s_ShaderBits + s_MaterialBits + s_MeshBits)) | state;
+	}
+	else
+	{
+		key |= (state << s_DepthBits) | depthBits;
+	}
+
+	return key;
+}
+
+//---------------------------------
+// RenderQueue::SortItems
+//
+// Least significant digit radix sort on the item keys, one byte at a time
+//  - passes in which all keys share the same byte are skipped, which is common since state indices are small
+//
+void RenderQueue::SortItems(std::vector<DrawItem>& items, std::vector<DrawItem>& scratch)
+{
+	static constexpr size_t s_DigitCount = sizeof(uint64);
+	static constexpr size_t s_BucketCount = 256u;
+
+	if (items.size() < 2u)
+	{
+		return;
+	}
+
+	// count all digits in a single pass over the data
+	size_t counts[s_DigitCount][s_BucketCount] = {};
+	for (DrawItem const& item : items)
+	{
+		for (size_t digit = 0u; digit < s_DigitCount; ++digit)
+		{
+			counts[digit][(item.key >> (digit * 8u)) & 0xFFu]++;
+		}
+	}
+
+	scratch.resize(items.size());
+	std::vector<DrawItem>* source = &items;
+	std::vector<DrawItem>* target = &scratch;
+
+	for (size_t digit = 0u; digit < s_DigitCount; ++digit)
+	{
+		size_t const shift = digit * 8u;
+		if (counts[digit][(items[0].key >> shift) & 0xFFu] == items.size())
+		{
+			continue;
+		}
+
+		size_t offsets[s_BucketCount];
+		size_t offset = 0u;
+		for (size_t bucket = 0u; bucket < s_BucketCount; ++bucket)
+		{
+			offsets[bucket] = offset;
+			offset += counts[digit][bucket];
+		}
+
+		for (DrawItem const& item : *source)
+		{
+			(*target)[offsets[(item.key >> shift) & 0xFFu]++] = item;
+		}
+
+		std::swap(source, target);
+	}
+
+	if (source != &items)
+	{
+		items.swap(scratch);
+	}
+}
+
+//---------------------------------
+// RenderQueue::Build
+//
+// Generate sorted draw items for all visible instances in a collection group
+//  - key fields only have to tell apart what is drawn consecutively, so meshes count within their material and materials within their shader
+//  - if a field still runs out of indices the build is split into segments which are sorted separately
+//
+void RenderQueue::Build(core::slot_map<MaterialCollection> const& collectionGroup, E_Pass const pass, Scene const& scene, Camera const& camera)
+{
+	// flatten the collection hierachy so that meshes can be distributed over threads
+	m_Materials.clear();
+	m_Meshes.clear();
+	m_SegmentStarts.clear();
+	m_SegmentStarts.push_back(0u);
+
+	uint32 shaderIdx = 0u;
+	uint32 shaderKey = 0u;
+	uint32 materialKey = 0u;
+	uint32 meshKey = 0u;
+	auto const startSegment = [this, &shaderKey, &materialKey, &meshKey](size_t const firstMesh)
+		{
+			m_SegmentStarts.push_back(firstMesh);
+			shaderKey = 0u;
+			materialKey = 0u;
+			meshKey = 0u;
+		};
+
+	for (MaterialCollection const& collection : collectionGroup)
+	{
+		if (shaderKey == s_MaxShaders)
+		{
+			startSegment(m_Meshes.size());
+		}
+
+		materialKey = 0u;
+
+		UniformHandle const model = collection.m_Shader->GetUniformHandle("model"_hash, false);
+		for (MaterialCollection::MaterialInstance const& material : collection.m_Materials)
+		{
+			ET_ASSERT(collection.m_Shader.get() == material.m_Material->GetBaseMaterial()->GetShader());
+
+			if (materialKey == s_MaxMaterials)
+			{
+				startSegment(m_Meshes.size());
+			}
+
+			meshKey = 0u;
+
+			uint32 const materialIdx = static_cast<uint32>(m_Materials.size());
+			m_Materials.push_back(MaterialEntry{ collection.m_Shader.get(), material.m_Material, shaderIdx, model });
+
+			size_t const firstMesh = m_Meshes.size();
+			for (MaterialCollection::Mesh const& mesh : material.m_Meshes)
+			{
+				m_Meshes.push_back(MeshEntry{ &mesh, materialIdx, 0u, 0u, 0u });
+			}
+
+			// meshes from the same geometry pool page share a VAO, keeping them adjacent lets them be drawn without rebinding it
+			std::stable_sort(m_Meshes.begin() + firstMesh, m_Meshes.end(), [](MeshEntry const& lhs, MeshEntry const& rhs)
+				{
+					return (lhs.mesh->m_VAO < rhs.mesh->m_VAO);
+				});
+
+			for (size_t meshIdx = firstMesh; meshIdx < m_Meshes.size(); ++meshIdx)
+			{
+				if (meshKey == s_MaxMeshes)
+				{
+					startSegment(meshIdx);
+				}
+
+				MeshEntry& entry = m_Meshes[meshIdx];
+				entry.shaderKey = shaderKey;
+				entry.materialKey = materialKey;
+				entry.meshKey = meshKey++;
+			}
+
+			++materialKey;
+		}
+
+		++shaderIdx;
+		++shaderKey;
+	}
+
+	m_Items.clear();
+	for (size_t segmentIdx = 0u; segmentIdx < m_SegmentStarts.size(); ++segmentIdx)
+	{
+		size_t const lastMesh = (segmentIdx + 1u < m_SegmentStarts.size()) ? m_SegmentStarts[segmentIdx + 1u] : m_Meshes.size();
+
+		size_t instanceCount = 0u;
+		for (size_t meshIdx = m_SegmentStarts[segmentIdx]; meshIdx < lastMesh; ++meshIdx)
+		{
+			instanceCount += m_Meshes[meshIdx].mesh->m_Instances.size();
+		}
+
+		BuildSegment(m_SegmentStarts[segmentIdx], lastMesh, instanceCount, pass, scene, camera);
+	}
+
+	// blended geometry has to be back to front across segments too, depth comes first in the key so reused state indices only break ties
+	if ((pass == E_Pass::Forward) && (m_SegmentStarts.size() > 1u))
+	{
+		SortItems(m_Items, m_SortScratch);
+	}
+}
+
+//---------------------------------
+// RenderQueue::BuildSegment
+//
+// Generate items for a range of meshes whose key fields don't overlap, and append them to the item list in sorted order
+//
+void RenderQueue::BuildSegment(size_t const firstMesh,
+	size_t const lastMesh,
+	size_t const instanceCount,
+	E_Pass const pass,
+	Scene const& scene,
+	Camera const& camera)
+{
+	size_t const meshCount = lastMesh - firstMesh;
+
+	// split meshes into ranges of similar instance counts
+	size_t jobCount = 1u;
+	if (m_WorkerPool != nullptr)
+	{
+		jobCount = std::min(m_WorkerPool->GetWorkerCount() + 1u, instanceCount / s_MinInstancesPerJob);
+		jobCount = std::max(std::min(jobCount, meshCount), static_cast<size_t>(1u));
+	}
+
+	if (m_ThreadData.size() < jobCount)
+	{
+		m_ThreadData.resize(jobCount);
+	}
+
+	if (jobCount == 1u)
+	{
+		GenerateItems(firstMesh, lastMesh, pass, scene, camera, m_ThreadData[0]);
+	}
+	else
+	{
+		size_t const instancesPerJob = (instanceCount + jobCount - 1u) / jobCount;
+
+		core::WorkerPool::JobGroup jobs;
+
+		size_t jobFirstMesh = firstMesh;
+		size_t jobIdx = 0u;
+		size_t jobInstances = 0u;
+		for (size_t meshIdx = firstMesh; meshIdx < lastMesh; ++meshIdx)
+		{
+			jobInstances += m_Meshes[meshIdx].mesh->m_Instances.size();
+
+			bool const isLast = (meshIdx + 1u == lastMesh);
+			if (((jobInstances >= instancesPerJob) && (jobIdx + 1u < jobCount)) || isLast)
+			{
+				size_t const jobLastMesh = meshIdx + 1u;
+				ThreadData* const threadData = &m_ThreadData[jobIdx];
+				m_WorkerPool->Push([this, jobFirstMesh, jobLastMesh, pass, &scene, &camera, threadData]()
+					{
+						GenerateItems(jobFirstMesh, jobLastMesh, pass, scene, camera, *threadData);
+					}, jobs);
+
+				jobFirstMesh = jobLastMesh;
+				jobInstances = 0u;
+				++jobIdx;
+			}
+		}
+
+		jobCount = jobIdx;
+		m_WorkerPool->Wait(jobs);
+	}
+
+	// gather items from all threads and sort them, reusing the first thread's list for the segment
+	std::vector<DrawItem>& segmentItems = m_ThreadData[0].items;
+	for (size_t jobIdx = 1u; jobIdx < jobCount; ++jobIdx)
+	{
+		std::vector<DrawItem> const& threadItems = m_ThreadData[jobIdx].items;
+		segmentItems.insert(segmentItems.end(), threadItems.cbegin(), threadItems.cend());
+	}
+
+	SortItems(segmentItems, m_SortScratch);
+	if (m_Items.empty())
+	{
+		m_Items.swap(segmentItems);
+	}
+	else
+	{
+		m_Items.insert(m_Items.end(), segmentItems.cbegin(), segmentItems.cend());
+	}
+}
+
+//---------------------------------
+// RenderQueue::Submit
+//
+// Draw all items in order, only changing state when it differs from the previous item
+//  - materials with a material block are bound as a single range of the shared material block buffer
+//
+void RenderQueue::Submit(Scene const& scene)
+{
+	I_GraphicsContextApi* const api = ContextHolder::GetRenderContext();
+
+	uint32 currentShader = std::numeric_limits<uint32>::max();
+	uint32 currentMaterial = std::numeric_limits<uint32>::max();
+	T_ArrayLoc currentVAO = 0u;
+
+	size_t itemIdx = 0u;
+	while (itemIdx < m_Items.size())
+	{
+		DrawItem const& first = m_Items[itemIdx];
+		MaterialEntry const& material = m_Materials[first.material];
+
+		if (material.shaderIdx != currentShader)
+		{
+			api->SetShader(material.shader);
+			currentShader = material.shaderIdx;
+		}
+
+		if (first.material != currentMaterial)
+		{
+			material.material->UploadParameters();
+			currentMaterial = first.material;
+		}
+
+		// consecutive items of the same mesh form a single batch
+		size_t batchEnd = itemIdx + 1u;
+		while ((batchEnd < m_Items.size()) && (m_Items[batchEnd].mesh == first.mesh))
+		{
+			++batchEnd;
+		}
+
+		MaterialCollection::Mesh const& mesh = *first.mesh;
+		if (mesh.m_VAO != currentVAO)
+		{
+			api->BindVertexArray(mesh.m_VAO);
+			currentVAO = mesh.m_VAO;
+		}
+
+		if (mesh.m_InstanceBuffer != 0u)
+		{
+			m_InstanceTransforms.clear();
+			for (size_t batchIdx = itemIdx; batchIdx < batchEnd; ++batchIdx)
+			{
+				m_InstanceTransforms.emplace_back(scene.GetNodes()[m_Items[batchIdx].node]);
+			}
+
+			api->BindBuffer(E_BufferType::Vertex, mesh.m_InstanceBuffer);
+			api->SetBufferData(E_BufferType::Vertex,
+				static_cast<int64>(m_InstanceTransforms.size() * sizeof(mat4)),
+				m_InstanceTransforms.data(),
+				E_UsageHint::Stream);
+
+			api->DrawElementsInstancedBaseVertex(E_DrawMode::Triangles,
+				mesh.m_IndexCount,
+				mesh.m_IndexDataType,
+				reinterpret_cast<void const*>(static_cast<uintptr_t>(mesh.m_IndexOffset)),
+				static_cast<uint32>(m_InstanceTransforms.size()),
+				mesh.m_BaseVertex);
+		}
+		else
+		{
+			for (size_t batchIdx = itemIdx; batchIdx < batchEnd; ++batchIdx)
+			{
+				material.shader->Upload(material.model, scene.GetNodes()[m_Items[batchIdx].node]);
+				api->DrawElementsBaseVertex(E_DrawMode::Triangles,
+					mesh.m_IndexCount,
+					mesh.m_IndexDataType,
+					reinterpret_cast<void const*>(static_cast<uintptr_t>(mesh.m_IndexOffset)),
+					mesh.m_BaseVertex);
+			}
+		}
+
+		itemIdx = batchEnd;
+	}
+}
+
+//---------------------------------
+// RenderQueue::GenerateItems
+//
+// Cull the instances of a range of meshes and emit an item for each visible one
+//  - only reads shared data, so several ranges can be processed concurrently
+//
+void RenderQueue::GenerateItems(size_t const firstMesh,
+	size_t const lastMesh,
+	E_Pass const pass,
+	Scene const& scene,
+	Camera const& camera,
+	ThreadData& threadData) const
+{
+	threadData.items.clear();
+
+	vec3 const& camPos = camera.GetPosition();
+	vec3 const& camForward = camera.GetForward();
+	float const nearPlane = camera.GetNearPlane();
+	float const depthRange = camera.GetFarPlane() - nearPlane;
+
+	for (size_t meshIdx = firstMesh; meshIdx < lastMesh; ++meshIdx)
+	{
+		MeshEntry const& entry = m_Meshes[meshIdx];
+		MaterialCollection::Mesh const& mesh = *entry.mesh;
+
+		threadData.cullSpheres.Clear();
+		for (T_NodeId const node : mesh.m_Instances)
+		{
+			mat4 const& transform = scene.GetNodes()[node];
+			threadData.cullSpheres.Add(math::Sphere((transform * vec4(mesh.m_BoundingVolume.pos, 1.f)).xyz,
+				math::length(math::decomposeScale(transform)) * mesh.m_BoundingVolume.radius));
+		}
+
+		camera.GetFrustum().CullSpheres(threadData.cullSpheres, threadData.visibleInstances);
+
+		for (uint32 const instanceIdx : threadData.visibleInstances)
+		{
+			vec3 const center(threadData.cullSpheres.x[instanceIdx], threadData.cullSpheres.y[instanceIdx], threadData.cullSpheres.z[instanceIdx]);
+			float const depth = (math::dot(center - camPos, camForward) - nearPlane) / depthRange;
+
+			threadData.items.push_back(DrawItem{ MakeKey(pass, entry.shaderKey, entry.materialKey, entry.meshKey, depth),
+				&mesh,
+				mesh.m_Instances[instanceIdx],
+				entry.material });
+		}
+	}
+}
+
+
+} // namespace render
+} // namespace et
@@ -0,0 +1,154 @@
+#pragma once
+#include <EtRendering/SceneStructure/MaterialCollection.h>
+#include <EtRendering/GraphicsTypes/Frustum.h>
+#include <EtRendering/GraphicsTypes/Shader.h>
+
+
+namespace et {
+namespace core {
+	class WorkerPool;
+}
+
+namespace render {
+
+
+class Camera;
+class Scene;
+
+
+//---------------------------------
+// RenderQueue
+//
+// Flattens material collections into draw items with 64 bit sort keys, which are radix sorted and then submitted in order
+//  - culling and item generation are split over worker threads, each writing into its own item list
+//  - consecutive items of the same mesh are merged into a single instanced draw call
+//
+class RenderQueue final
+{
+	// definitions
+	//-------------
+public:
+	//---------------------------------
+	// RenderQueue::E_Pass
+	//
+	// Highest bits of the sort key, opaque geometry is sorted by state and then front to back, forward geometry back to front
+	//
+	enum class E_Pass : uint8
+	{
+		Opaque,
+		Forward
+	};
+
+	//---------------------------------
+	// RenderQueue::DrawItem
+	//
+	// A single visible instance of a mesh
+	//
+	struct DrawItem
+	{
+		uint64 key;
+		MaterialCollection::Mesh const* mesh;
+		T_NodeId node;
+		uint32 material; // index into the queues material list
+	};
+
+	static constexpr size_t s_ShaderBits = 12u;
+	static constexpr size_t s_MaterialBits = 16u;
+	static constexpr size_t s_MeshBits = 16u;
+	static constexpr size_t s_DepthBits = 16u;
+
+	// index limits of the key fields, mesh indices count within a material and material indices within a shader
+	static constexpr uint32 s_MaxShaders = 1u << s_ShaderBits;
+	static constexpr uint32 s_MaxMaterials = 1u << s_MaterialBits;
+	static constexpr uint32 s_MaxMeshes = 1u << s_MeshBits;
+
+private:
+	//---------------------------------
+	// RenderQueue::MaterialEntry
+	//
+	struct MaterialEntry
+	{
+		ShaderData const* shader;
+		I_Material const* material;
+		uint32 shaderIdx;
+		UniformHandle model; // invalid for shaders that read instance transforms from a vertex buffer
+	};
+
+	//---------------------------------
+	// RenderQueue::MeshEntry
+	//
+	struct MeshEntry
+	{
+		MaterialCollection::Mesh const* mesh;
+		uint32 material;
+
+		// key fields, relative to the segment the mesh is built in
+		uint32 shaderKey;
+		uint32 materialKey;
+		uint32 meshKey;
+	};
+
+	//---------------------------------
+	// RenderQueue::ThreadData
+	//
+	// Scratch data for generating items on a single thread
+	//
+	struct ThreadData
+	{
+		BoundingSpheres cullSpheres;
+		std::vector<uint32> visibleInstances;
+		std::vector<DrawItem> items;
+	};
+
+	static constexpr size_t s_MinInstancesPerJob = 1024u; // below this splitting work over threads costs more than it saves
+
+	// static functionality
+	//----------------------
+public:
+	static uint64 MakeKey(E_Pass const pass, uint32 const shader, uint32 const material, uint32 const mesh, float const depth);
+	static void SortItems(std::vector<DrawItem>& items, std::vector<DrawItem>& scratch);
+
+	// construct destruct
+	//--------------------
+	RenderQueue() = default;
+
+	// functionality
+	//---------------
+	void SetWorkerPool(core::WorkerPool* const pool) { m_WorkerPool = pool; } // nullptr generates items on the calling thread
+
+	void Build(core::slot_map<MaterialCollection> const& collectionGroup, E_Pass const pass, Scene const& scene, Camera const& camera);
+	void Submit(Scene const& scene);
+
+	// accessors
+	//-----------
+	std::vector<DrawItem> const& GetItems() const { return m_Items; }
+
+	// utility
+	//---------
+private:
+	void BuildSegment(size_t const firstMesh, size_t const lastMesh, size_t const instanceCount, E_Pass const pass, Scene const& scene, Camera const& camera);
+	void GenerateItems(size_t const firstMesh,
+		size_t const lastMesh,
+		E_Pass const pass,
+		Scene const& scene,
+		Camera const& camera,
+		ThreadData& threadData) const;
+
+	// Data
+	///////
+
+	std::vector<MaterialEntry> m_Materials;
+	std::vector<MeshEntry> m_Meshes;
+	std::vector<size_t> m_SegmentStarts; // once a key field runs out of indices, the following meshes are sorted separately
+
+	std::vector<ThreadData> m_ThreadData;
+	std::vector<DrawItem> m_Items;
+	std::vector<DrawItem> m_SortScratch;
+	std::vector<mat4> m_InstanceTransforms;
+
+	core::WorkerPool* m_WorkerPool = nullptr;
+};
+
+
+} // namespace render
+} // namespace et
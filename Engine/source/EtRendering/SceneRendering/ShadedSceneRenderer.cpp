@@ -196,7 +196,7 @@ void ShadedSceneRenderer::OnRender(T_FbLoc const targetFb)
 	// render opaque objects to GBuffer
 	api->DebugPushGroup("opaque objects");
 	api->SetCullEnabled(true);
-	DrawMaterialCollectionGroup(m_RenderScene->GetOpaqueRenderables());
+	DrawMaterialCollectionGroup(m_RenderScene->GetOpaqueRenderables(), RenderQueue::E_Pass::Opaque);
 	api->DebugPopGroup();
 
 	api->DebugPushGroup("extensions");
@@ -334,7 +334,7 @@ void ShadedSceneRenderer::OnRender(T_FbLoc const targetFb)
 	// forward rendering
 	api->DebugPushGroup("forward renderables");
 	api->SetCullEnabled(true);
-	DrawMaterialCollectionGroup(m_RenderScene->GetForwardRenderables());
+	DrawMaterialCollectionGroup(m_RenderScene->GetForwardRenderables(), RenderQueue::E_Pass::Forward);
 	api->DebugPopGroup();
 
 	api->DebugPushGroup("extensions");
@@ -417,32 +417,32 @@ Camera const& ShadedSceneRenderer::GetCamera() const
 //---------------------------------
 // ShadedSceneRenderer::DrawShadow
 //
-// Render the scene to the depth buffer of the current framebuffer
+// Render either the static or the dynamic shadow casters within the light frustum to the depth buffer of the current framebuffer
 //
-void ShadedSceneRenderer::DrawShadow(I_Material const* const nullMaterial)
+void ShadedSceneRenderer::DrawShadow(I_Material const* const shadowMaterial, Frustum const& lightFrustum, E_ShadowCasters const casters)
 {
-	I_GraphicsContextApi* const api = ContextHolder::GetRenderContext();
+	ShaderData const* const shader = shadowMaterial->GetBaseMaterial()->GetShader();
+	UniformHandle const model = shader->GetUniformHandle("model"_hash, false);
+
+	MaterialCollection::MaterialInstance const& casterInstance = (casters == E_ShadowCasters::Static)
+		? m_RenderScene->GetStaticShadowCasters()
+		: m_RenderScene->GetDynamicShadowCasters();
 
 	// No need to set shaders or upload material parameters as that is the calling functions responsibility
-	for (MaterialCollection::Mesh const& mesh : m_RenderScene->GetShadowCasters().m_Meshes)
+	for (MaterialCollection::Mesh const& mesh : casterInstance.m_Meshes)
 	{
-		api->BindVertexArray(mesh.m_VAO);
-		for (T_NodeId const node : mesh.m_Instances)
-		{
-			// #todo: collect a list of transforms and draw this instanced
-			mat4 const& transform = m_RenderScene->GetNodes()[node];
-			math::Sphere instSphere = math::Sphere((transform * vec4(mesh.m_BoundingVolume.pos, 1.f)).xyz,
-				math::length(math::decomposeScale(transform)) * mesh.m_BoundingVolume.radius);
-
-			if (true) // #todo: light frustum check
-			{
-				nullMaterial->GetBaseMaterial()->GetShader()->Upload("model"_hash, transform);
-				api->DrawElements(E_DrawMode::Triangles, mesh.m_IndexCount, mesh.m_IndexDataType, 0);
-			}
-		}
+		DrawMeshInstances(mesh, lightFrustum, shader, model);
 	}
 }
 
+//---------------------------------------------
+// ShadedSceneRenderer::GetStaticShadowVersion
+//
+uint32 ShadedSceneRenderer::GetStaticShadowVersion() const
+{
+	return m_RenderScene->GetStaticShadowVersion();
+}
+
 //------------------------------------
 // ShadedSceneRenderer::Get3DPolyMode
 //
@@ -484,39 +484,75 @@ PostProcessingSettings const& ShadedSceneRenderer::GetPostProcessingSettings()
 //--------------------------------------------------
 // ShadedSceneRenderer::DrawMaterialCollectionGroup
 //
-// Draws all meshes in a list of shaders
+// Draws all visible meshes in a list of shaders through the render queue, sorted by state and depth
+//  - instances of the same mesh end up next to each other and are drawn with one instanced draw call if the shader supports it
+//
+void ShadedSceneRenderer::DrawMaterialCollectionGroup(core::slot_map<MaterialCollection> const& collectionGroup, RenderQueue::E_Pass const pass)
+{
+	m_RenderQueue.Build(collectionGroup, pass, *m_RenderScene, GetCamera());
+	m_RenderQueue.Submit(*m_RenderScene);
+}
+
+//----------------------------------------
+// ShadedSceneRenderer::DrawMeshInstances
+//
+// Culls all instances of a mesh against a frustum in one go and draws the visible ones
+//  - instanced if the shader reads transforms per instance, otherwise the model matrix is uploaded for every instance
 //
-void ShadedSceneRenderer::DrawMaterialCollectionGroup(core::slot_map<MaterialCollection> const& collectionGroup)
+void ShadedSceneRenderer::DrawMeshInstances(MaterialCollection::Mesh const& mesh,
+	Frustum const& frustum,
+	ShaderData const* const shader,
+	UniformHandle const model)
 {
+	m_CullSpheres.Clear();
+	for (T_NodeId const node : mesh.m_Instances)
+	{
+		mat4 const& transform = m_RenderScene->GetNodes()[node];
+		m_CullSpheres.Add(math::Sphere((transform * vec4(mesh.m_BoundingVolume.pos, 1.f)).xyz,
+			math::length(math::decomposeScale(transform)) * mesh.m_BoundingVolume.radius));
+	}
+
+	frustum.CullSpheres(m_CullSpheres, m_VisibleInstances);
+	if (m_VisibleInstances.empty())
+	{
+		return;
+	}
+
 	I_GraphicsContextApi* const api = ContextHolder::GetRenderContext();
+	api->BindVertexArray(mesh.m_VAO);
 
-	Camera const& camera = GetCamera();
+	if (mesh.m_InstanceBuffer != 0u)
+	{
+		// upload the transforms of visible instances and draw them all at once
+		m_InstanceTransforms.clear();
+		for (uint32 const instanceIdx : m_VisibleInstances)
+		{
+			m_InstanceTransforms.emplace_back(m_RenderScene->GetNodes()[mesh.m_Instances[instanceIdx]]);
+		}
 
-	for (MaterialCollection const& collection : collectionGroup)
+		api->BindBuffer(E_BufferType::Vertex, mesh.m_InstanceBuffer);
+		api->SetBufferData(E_BufferType::Vertex,
+			static_cast<int64>(m_InstanceTransforms.size() * sizeof(mat4)),
+			m_InstanceTransforms.data(),
+			E_UsageHint::Stream);
+
+		api->DrawElementsInstancedBaseVertex(E_DrawMode::Triangles,
+			mesh.m_IndexCount,
+			mesh.m_IndexDataType,
+			reinterpret_cast<void const*>(static_cast<uintptr_t>(mesh.m_IndexOffset)),
+			static_cast<uint32>(m_InstanceTransforms.size()),
+			mesh.m_BaseVertex);
+	}
+	else
 	{
-		api->SetShader(collection.m_Shader.get());
-		for (MaterialCollection::MaterialInstance const& material : collection.m_Materials)
+		for (uint32 const instanceIdx : m_VisibleInstances)
 		{
-			ET_ASSERT(collection.m_Shader.get() == material.m_Material->GetBaseMaterial()->GetShader());
-
-			collection.m_Shader->UploadParameterBlock(material.m_Material->GetParameters());
-			for (MaterialCollection::Mesh const& mesh : material.m_Meshes)
-			{
-				api->BindVertexArray(mesh.m_VAO);
-				for (T_NodeId const node : mesh.m_Instances)
-				{
-					// #todo: collect a list of transforms and draw this instanced
-					mat4 const& transform = m_RenderScene->GetNodes()[node];
-					math::Sphere instSphere = math::Sphere((transform * vec4(mesh.m_BoundingVolume.pos, 1.f)).xyz,
-						math::length(math::decomposeScale(transform)) * mesh.m_BoundingVolume.radius);
-
-					if (camera.GetFrustum().ContainsSphere(instSphere) != VolumeCheck::OUTSIDE)
-					{
-						collection.m_Shader->Upload("model"_hash, transform);
-						api->DrawElements(E_DrawMode::Triangles, mesh.m_IndexCount, mesh.m_IndexDataType, 0);
-					}
-				}
-			}
+			shader->Upload(model, m_RenderScene->GetNodes()[mesh.m_Instances[instanceIdx]]);
+			api->DrawElementsBaseVertex(E_DrawMode::Triangles,
+				mesh.m_IndexCount,
+				mesh.m_IndexDataType,
+				reinterpret_cast<void const*>(static_cast<uintptr_t>(mesh.m_IndexOffset)),
+				mesh.m_BaseVertex);
 		}
 	}
 }
@@ -4,6 +4,7 @@
 #include "ScreenSpaceReflections.h"
 #include "PostProcessingRenderer.h"
 #include "SceneRendererFwd.h"
+#include "RenderQueue.h"
 
 #include <EtRendering/GraphicsTypes/Camera.h>
 #include <EtRendering/GraphicsContext/ViewportRenderer.h>
@@ -42,6 +43,7 @@ public:
 	//---------------
 	void SetCamera(core::T_SlotId const cameraId) { m_CameraId = cameraId; }
 	void SetRenderMode(E_RenderMode const mode) { m_RenderMode = mode; }
+	void SetWorkerPool(core::WorkerPool* const pool) { m_RenderQueue.SetWorkerPool(pool); } // spreads draw item generation over threads
 
 	// Viewport Renderer Interface
 	//-----------------------------
@@ -56,7 +58,8 @@ protected:
 	//-----------------------------
 public:
 	Camera const& GetCamera() const override;
-	void DrawShadow(I_Material const* const nullMaterial) override;
+	void DrawShadow(I_Material const* const shadowMaterial, Frustum const& lightFrustum, E_ShadowCasters const casters) override;
+	uint32 GetStaticShadowVersion() const override;
 
 	// accessors
 	//--------------
@@ -74,7 +77,8 @@ public:
 	//---------
 private:
 	PostProcessingSettings const& GetPostProcessingSettings();
-	void DrawMaterialCollectionGroup(core::slot_map<MaterialCollection> const& collectionGroup);
+	void DrawMaterialCollectionGroup(core::slot_map<MaterialCollection> const& collectionGroup, RenderQueue::E_Pass const pass);
+	void DrawMeshInstances(MaterialCollection::Mesh const& mesh, Frustum const& frustum, ShaderData const* const shader, UniformHandle const model);
 
 #if ET_CT_IS_ENABLED(ET_CT_DBG_UTIL)
 	void DrawDebugVisualizations();
@@ -97,6 +101,13 @@ private:
 
 	render::Scene* m_RenderScene = nullptr;
 
+	// scratch data for culling and instancing meshes, kept around to avoid reallocating every frame
+	BoundingSpheres m_CullSpheres;
+	std::vector<uint32> m_VisibleInstances;
+	std::vector<mat4> m_InstanceTransforms;
+
+	RenderQueue m_RenderQueue;
+
 	ShadowRenderer m_ShadowRenderer;
 	Gbuffer m_GBuffer;
 	ScreenSpaceReflections m_SSR;
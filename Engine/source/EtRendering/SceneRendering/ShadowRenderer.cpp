@@ -1,7 +1,7 @@
 #include "stdafx.h"
 #include "ShadowRenderer.h"
 
-#include <limits>
+#include <cmath>
 
 #include <EtCore/Content/ResourceManager.h>
 
@@ -27,13 +27,17 @@ namespace render {
 //
 void ShadowRenderer::Initialize()
 {
-	m_Shader = core::ResourceManager::Instance()->GetAssetData<ShaderData>(core::HashString("Shaders/FwdNullShader.glsl"));
+	m_Shader = core::ResourceManager::Instance()->GetAssetData<ShaderData>(core::HashString("Shaders/FwdShadowShader.glsl"));
+	m_WorldViewProj = m_Shader->GetUniformHandle("worldViewProj"_hash);
 }
 
 //---------------------------------
 // ShadowRenderer::MapDirectional
 //
 // Fill out shadow data for a directional lights perspective relative to a camera
+//  - static casters are only redrawn when the cascade moved or the static casters changed, dynamic casters are drawn on top of a copy every frame
+//  - cascades are fit around a bounding sphere snapped to shadow map texels, so that they don't move when the camera rotates and only move in
+//    whole texel steps when it translates - this keeps the cached static depth valid for longer and avoids shimmering edges
 //
 void ShadowRenderer::MapDirectional(mat4 const& lightTransform, DirectionalShadowData& shadowData, I_ShadowRenderer* const shadowRenderer)
 {
@@ -53,6 +57,9 @@ void ShadowRenderer::MapDirectional(mat4 const& lightTransform, DirectionalShado
 	FrustumCorners corners = shadowRenderer->GetCamera().GetFrustum().GetCorners();
 	corners.Transform(lightView);
 
+	uint32 const staticVersion = shadowRenderer->GetStaticShadowVersion();
+	I_Material const* const shadowMaterial = RenderingSystems::Instance()->GetShadowMaterial();
+
 	std::vector<DirectionalShadowData::CascadeData>& cascades = shadowData.AccessCascades();
 	for (int32 i = 0; i < cascades.size(); i++)
 	{
@@ -69,43 +76,73 @@ void ShadowRenderer::MapDirectional(mat4 const& lightTransform, DirectionalShado
 		cascade.push_back(corners.fc + (corners.fc - corners.nc)*cascadeEnd);
 		cascade.push_back(corners.fd + (corners.fd - corners.nd)*cascadeEnd);
 
-		float left = std::numeric_limits<float>::max();
-		float right = std::numeric_limits<float>::lowest();
-		float bottom = std::numeric_limits<float>::max();
-		float top = std::numeric_limits<float>::lowest();
-		float zFar = std::numeric_limits<float>::lowest();
+		//bounding sphere of the cascade - the slice has the same shape regardless of camera orientation, so neither does the sphere
+		vec3 center(0.f);
+		for (size_t j = 0; j < cascade.size(); j++)
+		{
+			center = center + cascade[j];
+		}
 
-		float zNear = -graphicsSettings.CSMDrawDistance;//temp, should be calculated differently
+		center = center / static_cast<float>(cascade.size());
 
+		float radius = 0.f;
 		for (size_t j = 0; j < cascade.size(); j++)
 		{
-			if (cascade[j].x < left) left = cascade[j].x;
-			if (cascade[j].x > right) right = cascade[j].x;
-			if (cascade[j].y < bottom) bottom = cascade[j].y;
-			if (cascade[j].y > top) top = cascade[j].y;
-			if (cascade[j].z > zFar) zFar = cascade[j].z;
+			radius = std::max(radius, math::distance(center, cascade[j]));
 		}
 
 		float mult = 0.25f;
-		mat4 lightProjection = math::orthographic(left*mult, right*mult, bottom*mult, top*mult, zNear, zFar*mult);
+		center = center * mult;
+		radius = std::ceil(radius * mult * 16.f) / 16.f; // round up so that floating point noise doesn't change the cascade size
+
+		ivec2 res = cascades[i].texture->GetResolution();
+
+		//snap the center to whole texels, and the far plane to whole cascade diameters
+		float const diameter = radius * 2.f;
+		vec2 const texelSize(diameter / static_cast<float>(res.x), diameter / static_cast<float>(res.y));
+		center.x = std::floor(center.x / texelSize.x) * texelSize.x;
+		center.y = std::floor(center.y / texelSize.y) * texelSize.y;
+
+		float const zNear = -graphicsSettings.CSMDrawDistance;//temp, should be calculated differently
+		float const zFar = std::ceil((center.z + radius) / diameter) * diameter;
+
+		mat4 lightProjection = math::orthographic(center.x - radius, center.x + radius, center.y - radius, center.y + radius, zNear, zFar);
 
 		//view projection
 		mat4 lightVP = lightView * lightProjection;
 		cascades[i].lightVP = lightVP;
 
+		//anything outside of the orthographic volume can't cast a shadow into this cascade
+		m_CascadeFrustum.SetToViewProjection(lightVP);
+
 		//Set viewport
-		ivec2 res = cascades[i].texture->GetResolution();
 		api->SetViewport(ivec2(0), res);
-		//Set Framebuffer
-		api->BindFramebuffer(cascades[i].fbo);
-		//Clear Framebuffer
-		api->Clear(E_ClearFlag::CF_Color | E_ClearFlag::CF_Depth);
 
 		api->SetShader(m_Shader.get());
-		m_Shader->Upload("worldViewProj"_hash, lightVP);
+		shadowMaterial->UploadParameters();
+		m_Shader->Upload(m_WorldViewProj, lightVP);
+
+		//Redraw static casters if the cached depth is out of date
+		if (!(cascades[i].isStaticValid && (cascades[i].staticVersion == staticVersion) && (cascades[i].staticLightVP == lightVP)))
+		{
+			api->BindFramebuffer(cascades[i].staticFbo);
+			api->Clear(E_ClearFlag::CF_Depth);
+
+			shadowRenderer->DrawShadow(shadowMaterial, m_CascadeFrustum, E_ShadowCasters::Static);
 
-		//Draw scene with light matrix and null material
-		shadowRenderer->DrawShadow(RenderingSystems::Instance()->GetNullMaterial());
+			cascades[i].staticLightVP = lightVP;
+			cascades[i].staticVersion = staticVersion;
+			cascades[i].isStaticValid = true;
+		}
+
+		//Start from the cached static depth
+		api->BindReadFramebuffer(cascades[i].staticFbo);
+		api->BindDrawFramebuffer(cascades[i].fbo);
+		api->CopyDepthReadToDrawFbo(res, res);
+
+		//Draw dynamic casters with light matrix and shadow material on top
+		api->BindFramebuffer(cascades[i].fbo);
+		shadowRenderer->DrawShadow(shadowMaterial, m_CascadeFrustum, E_ShadowCasters::Dynamic);
 	}
 }
 
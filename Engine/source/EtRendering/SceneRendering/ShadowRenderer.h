@@ -1,6 +1,9 @@
 #pragma once
 #include "ShadowRendererInterface.h"
 
+#include <EtRendering/GraphicsTypes/Frustum.h>
+#include <EtRendering/GraphicsTypes/Shader.h>
+
 #include <EtCore/Content/AssetPointer.h>
 
 
@@ -9,7 +12,6 @@ namespace render {
 
 
 // forward
-class ShaderData;
 class DirectionalShadowData;
 
 
@@ -37,6 +39,8 @@ public:
 private:
 
 	AssetPtr<ShaderData> m_Shader;
+	UniformHandle m_WorldViewProj;
+	Frustum m_CascadeFrustum; // volume covered by the cascade currently being rendered
 };
 
 
@@ -6,9 +6,22 @@ namespace render {
 
 
 class Camera;
+class Frustum;
 class I_Material;
 
 
+//---------------------------------
+// E_ShadowCasters
+//
+// Static casters can be cached in shadow maps across frames, dynamic casters are drawn on top every frame
+//
+enum class E_ShadowCasters : uint8
+{
+	Static,
+	Dynamic
+};
+
+
 //---------------------------------
 // I_ShadowRenderer
 //
@@ -19,7 +32,8 @@ class I_ShadowRenderer
 public:
 	virtual ~I_ShadowRenderer() = default;
 
-	virtual void DrawShadow(I_Material const* const nullMaterial) = 0;
+	virtual void DrawShadow(I_Material const* const shadowMaterial, Frustum const& lightFrustum, E_ShadowCasters const casters) = 0; // only casters within the light frustum need drawing
+	virtual uint32 GetStaticShadowVersion() const = 0; // changes whenever static casters are added, removed or moved
 	virtual Camera const& GetCamera() const = 0;
 };
 
@@ -32,9 +32,12 @@ public:
 	//
 	struct Mesh
 	{
-		T_ArrayLoc m_VAO;
+		T_ArrayLoc m_VAO; // shared by all meshes in the same geometry pool page
+		T_BufferLoc m_InstanceBuffer; // zero if the shader reads the model matrix from a uniform
 		uint32 m_IndexCount;
 		E_DataType m_IndexDataType;
+		size_t m_IndexOffset; // bytes into the index buffer
+		int32 m_BaseVertex;
 		math::Sphere m_BoundingVolume;
 		std::vector<T_NodeId> m_Instances;
 	};
@@ -21,6 +21,13 @@ namespace render {
 //=======
 
 
+//---------------
+// Scene::c-tor
+//
+Scene::Scene()
+	: m_CasterNodes(32u, core::slot_map<mat4>::s_InvalidIndex)
+{ }
+
 //----------------------
 // Scene::AddNode
 //
@@ -39,6 +46,22 @@ T_NodeId Scene::AddNode(mat4 const& transform)
 void Scene::UpdateNode(T_NodeId const node, mat4 const& transform)
 {
 	m_Nodes[node] = transform;
+	OnNodeMoved(node);
+}
+
+//----------------------
+// Scene::UpdateNodes
+//
+// Change the transformations of many nodes in one go
+//  - different threads may update nodes concurrently, as long as they don't write the same nodes
+//
+void Scene::UpdateNodes(T_NodeId const* const nodes, mat4 const* const transforms, size_t const count)
+{
+	for (size_t idx = 0u; idx < count; ++idx)
+	{
+		m_Nodes[nodes[idx]] = transforms[idx];
+		OnNodeMoved(nodes[idx]);
+	}
 }
 
 //----------------------
@@ -129,22 +152,40 @@ Scene::T_InstanceId Scene::AddInstance(I_Material const* const material, AssetPt
 	// find or create a mesh in the material instance
 	T_MeshId meshId = AddMeshToMaterial(*foundMaterialIt, mesh, node);
 
-	// also make the mesh cast a shadow
-	if (m_ShadowCasters.m_Material == nullptr)
+	// also make the mesh cast a shadow - it's considered static unless its node already moved after being placed
+	if (m_StaticShadowCasters.m_Material == nullptr)
 	{
-		m_ShadowCasters.m_Material = RenderingSystems::Instance()->GetNullMaterial();
+		m_StaticShadowCasters.m_Material = RenderingSystems::Instance()->GetShadowMaterial();
+		m_DynamicShadowCasters.m_Material = m_StaticShadowCasters.m_Material;
+	}
+
+	CasterNode& casterNode = m_CasterNodes.emplace(node, CasterNode()).first->second;
+
+	bool const isDynamicCaster = (casterNode.m_Mobility.load() == CasterNode::E_Mobility::Dynamic);
+	T_MeshId casterId;
+	if (isDynamicCaster)
+	{
+		casterId = AddMeshToMaterial(m_DynamicShadowCasters, mesh, node);
+	}
+	else
+	{
+		casterId = AddMeshToMaterial(m_StaticShadowCasters, mesh, node);
+		m_StaticShadowVersion++;
 	}
-	T_MeshId casterId = AddMeshToMaterial(m_ShadowCasters, mesh, node);
 
 	// link the instance data to its own ID
 	auto newInstance = m_Instances.insert(MeshInstance());
 
+	newInstance.first->m_MeshData = mesh;
 	newInstance.first->m_Collection = collectionId;
 	newInstance.first->m_Material = materialId;
 	newInstance.first->m_Mesh = meshId;
 	newInstance.first->m_ShadowCaster = casterId;
 	newInstance.first->m_Transform = node;
 	newInstance.first->m_IsOpaque = opaque;
+	newInstance.first->m_IsDynamicCaster = isDynamicCaster;
+
+	casterNode.m_Instances.push_back(newInstance.second);
 
 	return newInstance.second;
 }
@@ -160,7 +201,28 @@ void Scene::RemoveInstance(T_InstanceId const instance)
 
 	MaterialCollection& collection = collectionGroup[inst.m_Collection];
 	MaterialCollection::MaterialInstance& material = collection.m_Materials[inst.m_Material];
-	RemoveMeshFromMaterial(m_ShadowCasters, inst.m_ShadowCaster, inst.m_Transform);
+	if (inst.m_IsDynamicCaster)
+	{
+		RemoveMeshFromMaterial(m_DynamicShadowCasters, inst.m_ShadowCaster, inst.m_Transform);
+	}
+	else
+	{
+		RemoveMeshFromMaterial(m_StaticShadowCasters, inst.m_ShadowCaster, inst.m_Transform);
+		m_StaticShadowVersion++;
+	}
+
+	auto const foundCasterNode = m_CasterNodes.find(inst.m_Transform);
+	ET_ASSERT(foundCasterNode != m_CasterNodes.end());
+	std::vector<T_InstanceId>& nodeInstances = foundCasterNode->second.m_Instances;
+	auto const foundNodeInstance = std::find(nodeInstances.begin(), nodeInstances.end(), instance);
+	ET_ASSERT(foundNodeInstance != nodeInstances.end());
+	*foundNodeInstance = nodeInstances.back();
+	nodeInstances.pop_back();
+	if (nodeInstances.empty())
+	{
+		m_CasterNodes.erase(foundCasterNode);
+	}
+
 	RemoveMeshFromMaterial(material, inst.m_Mesh, inst.m_Transform);
 	if (material.m_Meshes.size() == 0u)
 	{
@@ -489,11 +551,14 @@ render::I_SceneExtension* Scene::GetExtension(core::HashString const extensionId
 //
 core::T_SlotId Scene::AddMeshToMaterial(MaterialCollection::MaterialInstance& material, AssetPtr<MeshData> const mesh, T_NodeId const node)
 {
-	T_ArrayLoc const vao = mesh->GetSurface(material.m_Material->GetBaseMaterial())->GetVertexArray();
+	MeshSurface const* const surface = mesh->GetSurface(material.m_Material->GetBaseMaterial());
+	T_ArrayLoc const vao = surface->GetVertexArray();
+	size_t const indexOffset = mesh->GetIndexOffset();
 
-	auto foundMeshIt = std::find_if(material.m_Meshes.begin(), material.m_Meshes.end(), [vao](MaterialCollection::Mesh const& matInst)
+	// meshes in the same geometry pool page share a VAO, so they are told apart by where their indices start
+	auto foundMeshIt = std::find_if(material.m_Meshes.begin(), material.m_Meshes.end(), [vao, indexOffset](MaterialCollection::Mesh const& matInst)
 		{
-			return matInst.m_VAO == vao;
+			return ((matInst.m_VAO == vao) && (matInst.m_IndexOffset == indexOffset));
 		});
 
 	T_MaterialInstanceId meshId = core::slot_map<MaterialCollection::MaterialInstance>::s_InvalidIndex;
@@ -505,8 +570,11 @@ core::T_SlotId Scene::AddMeshToMaterial(MaterialCollection::MaterialInstance& ma
 		meshId = newMesh.second;
 
 		foundMeshIt->m_VAO = vao;
+		foundMeshIt->m_InstanceBuffer = surface->GetInstanceBuffer();
 		foundMeshIt->m_IndexCount = static_cast<uint32>(mesh->GetIndexCount());
 		foundMeshIt->m_IndexDataType = mesh->GetIndexDataType();
+		foundMeshIt->m_IndexOffset = indexOffset;
+		foundMeshIt->m_BaseVertex = mesh->GetBaseVertex();
 		foundMeshIt->m_BoundingVolume = mesh->GetBoundingSphere();
 	}
 	else
@@ -541,6 +609,56 @@ void Scene::RemoveMeshFromMaterial(MaterialCollection::MaterialInstance& materia
 	}
 }
 
+//--------------------
+// Scene::OnNodeMoved
+//
+// Static shadow maps need to be redrawn when a static caster moves, and casters that keep moving after being placed become dynamic
+//  - the node map is only read here, so that nodes can be updated from several threads
+//  - mobility is read without the lock only to skip dynamic nodes, it is checked again and changed under the lock
+//
+void Scene::OnNodeMoved(T_NodeId const node)
+{
+	auto const foundCasterNode = m_CasterNodes.find(node);
+	if (foundCasterNode == m_CasterNodes.end())
+	{
+		return;
+	}
+
+	CasterNode& casterNode = foundCasterNode->second;
+	if (casterNode.m_Mobility.load(std::memory_order_acquire) == CasterNode::E_Mobility::Dynamic)
+	{
+		return;
+	}
+
+	std::lock_guard<std::mutex> lock(m_CasterMutex);
+
+	CasterNode::E_Mobility const mobility = casterNode.m_Mobility.load(std::memory_order_relaxed);
+	if (mobility == CasterNode::E_Mobility::Dynamic)
+	{
+		return;
+	}
+
+	m_StaticShadowVersion++;
+
+	if (mobility == CasterNode::E_Mobility::Unplaced)
+	{
+		casterNode.m_Mobility.store(CasterNode::E_Mobility::Static, std::memory_order_release);
+		return;
+	}
+
+	for (T_InstanceId const instance : casterNode.m_Instances)
+	{
+		MeshInstance& inst = m_Instances[instance];
+		ET_ASSERT(!inst.m_IsDynamicCaster);
+
+		RemoveMeshFromMaterial(m_StaticShadowCasters, inst.m_ShadowCaster, node);
+		inst.m_ShadowCaster = AddMeshToMaterial(m_DynamicShadowCasters, inst.m_MeshData, node);
+		inst.m_IsDynamicCaster = true;
+	}
+
+	casterNode.m_Mobility.store(CasterNode::E_Mobility::Dynamic, std::memory_order_release);
+}
+
 
 } // namespace render
 } // namespace et
@@ -1,4 +1,7 @@
 #pragma once
+#include <mutex>
+#include <atomic>
+
 #include "RenderSceneFwd.h"
 #include "Skybox.h"
 
@@ -10,6 +13,8 @@
 #include <EtRendering/GraphicsTypes/Mesh.h>
 #include <EtRendering/GraphicsTypes/Camera.h>
 
+#include <EtCore/Containers/linear_hash_map.h>
+
 
 namespace et {
 namespace render {
@@ -35,12 +40,42 @@ class Scene final
 	//
 	struct MeshInstance
 	{
+		AssetPtr<MeshData> m_MeshData; // kept so the shadow caster can be moved to the dynamic casters
 		T_CollectionId m_Collection;
 		T_MaterialInstanceId m_Material;
 		T_MeshId m_Mesh;
 		T_MeshId m_ShadowCaster;
 		T_NodeId m_Transform;
 		bool m_IsOpaque;
+		bool m_IsDynamicCaster;
+	};
+
+	//----------------------
+	// CasterNode
+	//
+	// Tracks how nodes with shadow casters move - the first update only places a node, after that its casters are dynamic
+	//  - mobility is atomic so that moving nodes can skip the lock once they are dynamic, it only changes under the lock
+	//
+	struct CasterNode
+	{
+		enum class E_Mobility : uint8
+		{
+			Unplaced,
+			Static,
+			Dynamic
+		};
+
+		CasterNode() = default;
+		CasterNode(CasterNode const& other) : m_Instances(other.m_Instances), m_Mobility(other.m_Mobility.load()) {}
+		CasterNode& operator=(CasterNode const& other)
+		{
+			m_Instances = other.m_Instances;
+			m_Mobility.store(other.m_Mobility.load());
+			return *this;
+		}
+
+		std::vector<core::T_SlotId> m_Instances; // mesh instances using this node
+		std::atomic<E_Mobility> m_Mobility{ E_Mobility::Unplaced };
 	};
 
 	//----------------------
@@ -58,10 +93,15 @@ class Scene final
 public:
 	typedef core::slot_map<MeshInstance>::id_type T_InstanceId;
 
+	// construct destruct
+	//--------------------
+	Scene();
+
 	// functionality
 	//-------------
 	T_NodeId AddNode(mat4 const& transform);
 	void UpdateNode(T_NodeId const node, mat4 const& transform);
+	void UpdateNodes(T_NodeId const* const nodes, mat4 const* const transforms, size_t const count);
 	void RemoveNode(T_NodeId const node);
 
 	core::T_SlotId AddCamera();
@@ -113,7 +153,9 @@ public:
 	core::slot_map<DirectionalShadowData>& GetDirectionalShadowData() { return m_DirectionalShadowData; }
 	core::slot_map<DirectionalShadowData> const& GetDirectionalShadowData() const { return m_DirectionalShadowData; }
 
-	MaterialCollection::MaterialInstance const& GetShadowCasters() const { return m_ShadowCasters; }
+	MaterialCollection::MaterialInstance const& GetStaticShadowCasters() const { return m_StaticShadowCasters; }
+	MaterialCollection::MaterialInstance const& GetDynamicShadowCasters() const { return m_DynamicShadowCasters; }
+	uint32 GetStaticShadowVersion() const { return m_StaticShadowVersion; }
 
 	Skybox const& GetSkybox() const { return m_Skybox; }
 	StarField const* GetStarfield() const { return m_Starfield; }
@@ -132,6 +174,8 @@ private:
 	core::T_SlotId AddMeshToMaterial(MaterialCollection::MaterialInstance& material, AssetPtr<MeshData> const mesh, T_NodeId const node);
 	void RemoveMeshFromMaterial(MaterialCollection::MaterialInstance& material, T_MeshId meshId, T_NodeId node);
 
+	void OnNodeMoved(T_NodeId const node);
+
 
 	// Data
 	///////
@@ -156,7 +200,12 @@ private:
 	core::slot_map<Light> m_DirectionalLightsShaded;
 	core::slot_map<DirectionalShadowData> m_DirectionalShadowData;
 
-	MaterialCollection::MaterialInstance m_ShadowCasters;
+	// casters that didn't move since they were placed are cached in the shadow maps, the version changes whenever that set changes
+	MaterialCollection::MaterialInstance m_StaticShadowCasters;
+	MaterialCollection::MaterialInstance m_DynamicShadowCasters;
+	core::lin_hash_map<T_NodeId, CasterNode> m_CasterNodes;
+	uint32 m_StaticShadowVersion = 0u;
+	std::mutex m_CasterMutex; // nodes may be updated from several threads
 
 	Skybox m_Skybox;
 	StarField* m_Starfield = nullptr;
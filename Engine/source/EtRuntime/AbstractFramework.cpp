@@ -211,6 +211,7 @@ void AbstractFramework::Run()
 	// scene rendering
 	m_SceneRenderer = Create<render::ShadedSceneRenderer>(&(unifiedScene.GetRenderScene()));
 	m_SceneRenderer->InitRenderingSystems();
+	m_SceneRenderer->SetWorkerPool(&(unifiedScene.GetWorkerPool()));
 
 	// ui rendering
 	m_GuiRenderer.Init(ToPtr(&(m_SceneRenderer->GetEventDispatcher())));
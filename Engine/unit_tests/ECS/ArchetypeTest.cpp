@@ -14,7 +14,8 @@
 
 TEST_CASE("archetype create", "[ecs]")
 {
-	fw::Archetype archBC(fw::GenSignature<TestBComponent, TestCComponent>());
+	fw::ChunkPool chunkPool;
+	fw::Archetype archBC(fw::GenSignature<TestBComponent, TestCComponent>(), chunkPool);
 
 	REQUIRE_FALSE(archBC.HasComponent(TestAComponent::GetTypeIndex()));
 	REQUIRE(archBC.HasComponent(TestBComponent::GetTypeIndex()));
@@ -32,7 +33,8 @@ TEST_CASE("archetype create", "[ecs]")
 
 TEST_CASE("archetype add", "[ecs]")
 {
-	fw::Archetype archBC(fw::GenSignature<TestBComponent, TestCComponent>());
+	fw::ChunkPool chunkPool;
+	fw::Archetype archBC(fw::GenSignature<TestBComponent, TestCComponent>(), chunkPool);
 
 	REQUIRE(archBC.GetSize() == 0u);
 
@@ -80,7 +82,8 @@ TEST_CASE("archetype add", "[ecs]")
 
 TEST_CASE("archetype remove", "[ecs]")
 {
-	fw::Archetype archBC(fw::GenSignature<TestBComponent, TestCComponent>());
+	fw::ChunkPool chunkPool;
+	fw::Archetype archBC(fw::GenSignature<TestBComponent, TestCComponent>(), chunkPool);
 
 	fw::T_EntityId const ent0 = 10u;
 	fw::T_EntityId const ent1 = 11u;
@@ -142,3 +145,275 @@ TEST_CASE("archetype remove", "[ecs]")
 	REQUIRE(archBC.GetPool(TestBComponent::GetTypeIndex()).GetSize() == 0u);
 	REQUIRE(archBC.GetPool(TestCComponent::GetTypeIndex()).GetSize() == 0u);
 }
+
+
+TEST_CASE("archetype chunks", "[ecs]")
+{
+	fw::ChunkPool chunkPool;
+	fw::Archetype archBC(fw::GenSignature<TestBComponent, TestCComponent>(), chunkPool);
+
+	size_t const capacity = archBC.GetChunkCapacity();
+	REQUIRE(capacity > 0u);
+	REQUIRE(archBC.GetChunkCount() == 0u);
+
+	// fill two chunks and start a third one
+	size_t const entityCount = capacity * 2u + 1u;
+	for (size_t idx = 0u; idx < entityCount; ++idx)
+	{
+		archBC.AddEntity(static_cast<fw::T_EntityId>(idx), {
+			fw::MakeRawComponent(TestBComponent(std::to_string(idx))), 
+			fw::MakeRawComponent(TestCComponent(static_cast<uint32>(idx)))
+			});
+	}
+
+	REQUIRE(archBC.GetChunkCount() == 3u);
+	REQUIRE(chunkPool.GetAllocatedCount() == 3u);
+
+	// component arrays start on cache lines
+	for (size_t chunkIdx = 0u; chunkIdx < archBC.GetChunkCount(); ++chunkIdx)
+	{
+		size_t const idx = chunkIdx * capacity;
+		REQUIRE(reinterpret_cast<uintptr_t>(archBC.GetPool(TestBComponent::GetTypeIndex()).At(idx)) % fw::ChunkPool::s_Alignment == 0u);
+		REQUIRE(reinterpret_cast<uintptr_t>(archBC.GetPool(TestCComponent::GetTypeIndex()).At(idx)) % fw::ChunkPool::s_Alignment == 0u);
+	}
+
+	// pointers to components in earlier chunks stay valid while the archetype grows
+	TestCComponent const* const firstC = &archBC.GetPool(TestCComponent::GetTypeIndex()).Get<TestCComponent>(0u);
+	archBC.AddEntity(static_cast<fw::T_EntityId>(entityCount), {
+		fw::MakeRawComponent(TestBComponent("last")), 
+		fw::MakeRawComponent(TestCComponent(static_cast<uint32>(entityCount)))
+		});
+
+	REQUIRE(firstC == &archBC.GetPool(TestCComponent::GetTypeIndex()).Get<TestCComponent>(0u));
+
+	for (size_t idx = 0u; idx < entityCount; ++idx)
+	{
+		REQUIRE(archBC.GetPool(TestCComponent::GetTypeIndex()).Get<TestCComponent>(idx).val == static_cast<uint32>(idx));
+		REQUIRE(archBC.GetPool(TestBComponent::GetTypeIndex()).Get<TestBComponent>(idx).name == std::to_string(idx));
+	}
+
+	// chunks that become empty are returned to the pool
+	while (archBC.GetSize() > capacity)
+	{
+		archBC.RemoveEntity(0u);
+	}
+
+	REQUIRE(archBC.GetChunkCount() == 1u);
+	REQUIRE(chunkPool.GetFreeCount() == 2u);
+
+	archBC.Clear();
+	REQUIRE(archBC.GetChunkCount() == 0u);
+	REQUIRE(chunkPool.GetFreeCount() == 3u);
+}
+
+
+TEST_CASE("archetype chunk versions", "[ecs]")
+{
+	fw::ChunkPool chunkPool;
+	fw::Archetype archAC(fw::GenSignature<TestAComponent, TestCComponent>(), chunkPool);
+
+	size_t const capacity = archAC.GetChunkCapacity();
+	for (size_t idx = 0u; idx < capacity + 1u; ++idx)
+	{
+		archAC.AddEntity(static_cast<fw::T_EntityId>(idx), { fw::MakeRawComponent(TestAComponent()), fw::MakeRawComponent(TestCComponent()) });
+	}
+
+	REQUIRE(archAC.GetChunkCount() == 2u);
+	REQUIRE(archAC.GetChunkVersion(TestAComponent::GetTypeIndex(), 0u) == 0u);
+	REQUIRE(archAC.GetChunkVersion(TestCComponent::GetTypeIndex(), 1u) == 0u);
+
+	// versions are tracked per chunk and component type
+	archAC.MarkChunkChanged(TestCComponent::GetTypeIndex(), 1u, 3u);
+	REQUIRE(archAC.GetChunkVersion(TestAComponent::GetTypeIndex(), 1u) == 0u);
+	REQUIRE(archAC.GetChunkVersion(TestCComponent::GetTypeIndex(), 0u) == 0u);
+	REQUIRE(archAC.GetChunkVersion(TestCComponent::GetTypeIndex(), 1u) == 3u);
+	REQUIRE(archAC.GetVersion(TestAComponent::GetTypeIndex()) == 0u);
+	REQUIRE(archAC.GetVersion(TestCComponent::GetTypeIndex()) == 3u);
+
+	// entity changes affect all types in the chunk
+	archAC.MarkEntityChanged(1u, 5u);
+	REQUIRE(archAC.GetChunkVersion(TestAComponent::GetTypeIndex(), 0u) == 5u);
+	REQUIRE(archAC.GetChunkVersion(TestCComponent::GetTypeIndex(), 0u) == 5u);
+	REQUIRE(archAC.GetChunkVersion(TestCComponent::GetTypeIndex(), 1u) == 3u);
+	REQUIRE(archAC.GetVersion(TestAComponent::GetTypeIndex()) == 5u);
+	REQUIRE(archAC.GetVersion(TestCComponent::GetTypeIndex()) == 5u);
+
+	// new chunks start out unchanged
+	archAC.RemoveEntity(capacity);
+	REQUIRE(archAC.GetChunkCount() == 1u);
+
+	archAC.AddEntity(static_cast<fw::T_EntityId>(capacity), { fw::MakeRawComponent(TestAComponent()), fw::MakeRawComponent(TestCComponent()) });
+	REQUIRE(archAC.GetChunkVersion(TestCComponent::GetTypeIndex(), 1u) == 0u);
+
+	archAC.Clear();
+}
+
+TEST_CASE("archetype relocate", "[ecs]")
+{
+	uint32 refCount = 0u;
+
+	fw::ChunkPool chunkPool;
+	fw::Archetype archAR(fw::GenSignature<TestAComponent, TestRefCountComp>(), chunkPool);
+	fw::Archetype archACR(fw::GenSignature<TestAComponent, TestCComponent, TestRefCountComp>(), chunkPool);
+
+	// edges are only known once they are set
+	REQUIRE(archAR.GetAddEdge(TestCComponent::GetTypeIndex()) == nullptr);
+	REQUIRE(archACR.GetRemoveEdge(TestCComponent::GetTypeIndex()) == nullptr);
+
+	archAR.SetAddEdge(TestCComponent::GetTypeIndex(), &archACR);
+	archACR.SetRemoveEdge(TestCComponent::GetTypeIndex(), &archAR);
+
+	REQUIRE(archAR.GetAddEdge(TestCComponent::GetTypeIndex()) == &archACR);
+	REQUIRE(archAR.GetAddEdge(TestBComponent::GetTypeIndex()) == nullptr);
+	REQUIRE(archACR.GetRemoveEdge(TestCComponent::GetTypeIndex()) == &archAR);
+
+	TestAComponent aComp;
+	aComp.x = 7;
+	{
+		TestRefCountComp refComp(&refCount);
+		archAR.AddEntity(1u, { fw::MakeRawComponent(aComp), fw::MakeRawComponent(refComp) });
+		archAR.AddEntity(2u, { fw::MakeRawComponent(aComp), fw::MakeRawComponent(refComp) });
+	}
+
+	REQUIRE(refCount == 2u);
+
+	// move the first entity over, adding the C component
+	TestCComponent cComp(3u);
+	size_t const idx = archACR.RelocateEntity(1u, archAR, 0u, { fw::MakeRawComponent(cComp) });
+	REQUIRE(archAR.RemoveRelocatedEntity(0u, archACR) == 2u);
+
+	REQUIRE(archAR.GetSize() == 1u);
+	REQUIRE(archACR.GetSize() == 1u);
+	REQUIRE(archACR.GetEntity(idx) == 1u);
+
+	REQUIRE(archACR.GetPool(TestAComponent::GetTypeIndex()).Get<TestAComponent>(idx).x == 7);
+	REQUIRE(archACR.GetPool(TestCComponent::GetTypeIndex()).Get<TestCComponent>(idx).val == 3u);
+
+	// non trivial components are copied and destroyed, so the count stays the same
+	REQUIRE(refCount == 2u);
+	REQUIRE(archACR.GetPool(TestRefCountComp::GetTypeIndex()).Get<TestRefCountComp>(idx).ptr == &refCount);
+
+	archAR.RemoveEntity(0u);
+	archACR.RemoveEntity(idx);
+	REQUIRE(refCount == 0u);
+}
+
+TEST_CASE("archetype layers", "[ecs]")
+{
+	uint32 refCount = 0u;
+
+	fw::ChunkPool chunkPool;
+	fw::Archetype archCR(fw::GenSignature<TestCComponent, TestRefCountComp>(), chunkPool);
+
+	// the C value encodes the layer an entity was added to, the owner keeps track of indices through the moved list
+	std::unordered_map<fw::T_EntityId, size_t> indices;
+	fw::Archetype::T_IndexList moved;
+	auto const applyMoved = [&archCR, &indices, &moved]()
+		{
+			for (size_t const idx : moved)
+			{
+				if (idx < archCR.GetSize())
+				{
+					indices[archCR.GetEntity(idx)] = idx;
+				}
+			}
+
+			moved.clear();
+		};
+
+	auto const checkLayers = [&archCR, &indices]()
+		{
+			REQUIRE(archCR.GetLayerEnd(archCR.GetLayerCount()) == archCR.GetSize());
+			for (size_t layer = 0u; layer < archCR.GetLayerCount(); ++layer)
+			{
+				for (size_t idx = archCR.GetLayerBegin(layer); idx < archCR.GetLayerEnd(layer); ++idx)
+				{
+					REQUIRE(archCR.GetLayer(idx) == static_cast<uint8>(layer));
+					REQUIRE(archCR.GetPool(TestCComponent::GetTypeIndex()).Get<TestCComponent>(idx).val / 100000u == static_cast<uint32>(layer));
+					REQUIRE(indices[archCR.GetEntity(idx)] == idx);
+				}
+			}
+		};
+
+	fw::T_EntityId nextEntity = 0u;
+	auto const addEntity = [&](uint8 const layer)
+		{
+			fw::T_EntityId const entity = nextEntity++;
+			TestRefCountComp refComp(&refCount);
+			TestCComponent cComp(static_cast<uint32>(layer) * 100000u + entity);
+			indices[entity] = archCR.AddEntity(entity, { fw::MakeRawComponent(cComp), fw::MakeRawComponent(refComp) }, layer, &moved);
+			applyMoved();
+		};
+
+	// enough entities to span several chunks, added in an order that forces upper layers to shift
+	for (size_t idx = 0u; idx < archCR.GetChunkCapacity() * 2u; ++idx)
+	{
+		addEntity(static_cast<uint8>(2u - (idx % 3u)));
+	}
+
+	REQUIRE(archCR.GetLayerCount() == 3u);
+	REQUIRE(refCount == static_cast<uint32>(archCR.GetSize()));
+	checkLayers();
+
+	// a batch into the middle layer
+	{
+		std::vector<fw::T_EntityId> batch;
+		for (size_t idx = 0u; idx < 50u; ++idx)
+		{
+			batch.emplace_back(nextEntity++);
+		}
+
+		TestRefCountComp refComp(&refCount);
+		TestCComponent cComp(100000u);
+		size_t const firstIdx = archCR.AddEntities(batch.data(), batch.size(), { fw::MakeRawComponent(cComp), fw::MakeRawComponent(refComp) }, 1u, &moved);
+		applyMoved();
+
+		for (size_t idx = 0u; idx < batch.size(); ++idx)
+		{
+			indices[batch[idx]] = firstIdx + idx;
+		}
+	}
+
+	REQUIRE(refCount == static_cast<uint32>(archCR.GetSize()));
+	checkLayers();
+
+	// moving an entity to a deeper layer keeps its components
+	fw::T_EntityId const movedEntity = archCR.GetEntity(archCR.GetLayerBegin(0u));
+	uint32 const movedVal = archCR.GetPool(TestCComponent::GetTypeIndex()).Get<TestCComponent>(indices[movedEntity]).val;
+	size_t const movedIdx = archCR.ChangeLayer(indices[movedEntity], 3u, &moved);
+	applyMoved();
+	indices[movedEntity] = movedIdx;
+
+	REQUIRE(archCR.GetLayerCount() == 4u);
+	REQUIRE(archCR.GetLayer(movedIdx) == 3u);
+	REQUIRE(archCR.GetEntity(movedIdx) == movedEntity);
+	REQUIRE(archCR.GetPool(TestCComponent::GetTypeIndex()).Get<TestCComponent>(movedIdx).val == movedVal);
+	REQUIRE(refCount == static_cast<uint32>(archCR.GetSize()));
+
+	archCR.GetPool(TestCComponent::GetTypeIndex()).Get<TestCComponent>(movedIdx).val = 300000u;
+	checkLayers();
+
+	// removing from the bottom layer shifts every layer above it, and drops layers that become empty
+	indices.erase(movedEntity);
+	archCR.RemoveEntity(movedIdx, &moved);
+	applyMoved();
+	REQUIRE(archCR.GetLayerCount() == 3u);
+
+	while (archCR.GetSize() > 0u)
+	{
+		size_t const idx = archCR.GetLayerBegin(archCR.GetLayer(archCR.GetSize() / 2u));
+		indices.erase(archCR.GetEntity(idx));
+		archCR.RemoveEntity(idx, &moved);
+		applyMoved();
+
+		REQUIRE(refCount == static_cast<uint32>(archCR.GetSize()));
+		if ((archCR.GetSize() % 64u) == 0u)
+		{
+			checkLayers();
+		}
+	}
+
+	REQUIRE(archCR.GetLayerCount() == 0u);
+	REQUIRE(archCR.GetChunkCount() == 0u);
+	REQUIRE(refCount == 0u);
+}
@@ -9,29 +9,33 @@
 
 #include <mainTesting.h>
 
+#include <EtFramework/ECS/ChunkPool.h>
 #include <EtFramework/ECS/ComponentPool.h>
 
 
-TEST_CASE("append, get, at pool", "[ecs]")
+TEST_CASE("construct, get, at pool", "[ecs]")
 {
-	fw::ComponentPool myCPool(TestCComponent::GetTypeIndex());
+	fw::ChunkPool chunkPool;
+	std::vector<uint8*> chunks{ chunkPool.Allocate() };
+	fw::ComponentPool myCPool(TestCComponent::GetTypeIndex(), chunks, 0u, fw::ChunkPool::s_ChunkSize / sizeof(TestCComponent));
 
 	REQUIRE(myCPool.GetSize() == 0u);
 
-	myCPool.Append(TestCComponent(0u));
-	myCPool.Append<TestCComponent>(1u);
+	myCPool.Expand(4u);
+	REQUIRE(myCPool.GetSize() == 4u);
+
+	for (uint32 idx = 0u; idx < 3u; ++idx)
 	{
-		TestCComponent comp(2u);
-		void const* const compPtr = static_cast<void const*>(&comp);
-		myCPool.Append(compPtr);
+		TestCComponent const comp(idx);
+		myCPool.Construct(static_cast<size_t>(idx), &comp);
 	}
+
 	{
-		TestCComponent comp(3u);
-		myCPool.Append(&comp);
+		TestCComponent const comp(3u);
+		void const* const compPtr = static_cast<void const*>(&comp);
+		myCPool.Construct(3u, compPtr);
 	}
 
-	REQUIRE(myCPool.GetSize() == 4u);
-
 	TestCComponent const& at0 = myCPool.Get<TestCComponent>(0u);
 	TestCComponent const& at1 = myCPool.Get<TestCComponent>(1u);
 	void const* const at2Ptr = myCPool.At(2u);
@@ -45,40 +49,172 @@ TEST_CASE("append, get, at pool", "[ecs]")
 
 	at3 = 4u;
 	REQUIRE(myCPool.Get<TestCComponent>(3u).val == 4u);
+
+	TestCComponent const copy(7u);
+	myCPool.Expand(3u);
+	myCPool.ConstructCopies(4u, 3u, &copy);
+	REQUIRE(myCPool.GetSize() == 7u);
+	REQUIRE(myCPool.Get<TestCComponent>(4u).val == 7u);
+	REQUIRE(myCPool.Get<TestCComponent>(6u).val == 7u);
+
+	chunkPool.Free(chunks[0u]);
 }
 
 
-TEST_CASE("erase pool", "[ecs]")
+TEST_CASE("destroy and move pool", "[ecs]")
 {
-	fw::ComponentPool myCPool(TestCComponent::GetTypeIndex());
-
-	myCPool.Append(TestCComponent(0u));
-	myCPool.Append(TestCComponent(1u));
-	myCPool.Append(TestCComponent(2u));
-	myCPool.Append(TestCComponent(3u));
+	fw::ChunkPool chunkPool;
+	std::vector<uint8*> chunks{ chunkPool.Allocate() };
+	fw::ComponentPool myCPool(TestCComponent::GetTypeIndex(), chunks, 0u, fw::ChunkPool::s_ChunkSize / sizeof(TestCComponent));
 
-	REQUIRE(myCPool.GetSize() == 4u);
+	myCPool.Expand(4u);
+	for (uint32 idx = 0u; idx < 4u; ++idx)
+	{
+		TestCComponent const comp(idx);
+		myCPool.Construct(static_cast<size_t>(idx), &comp);
+	}
 
 	REQUIRE(myCPool.Get<TestCComponent>(1u).val == 1u);
 
-	myCPool.Erase(1u);
+	// fill the gap of a destroyed component with the last one
+	myCPool.Destroy(1u);
+	myCPool.Move(3u, 1u);
+	myCPool.PopBack();
 
 	REQUIRE(myCPool.GetSize() == 3u);
-
 	REQUIRE(myCPool.Get<TestCComponent>(1u).val == 3u);
 
-	myCPool.Append(TestCComponent(5u));
+	TestCComponent const comp(5u);
+	myCPool.Expand(1u);
+	myCPool.Construct(3u, &comp);
 	REQUIRE(myCPool.GetSize() == 4u);
 	REQUIRE(myCPool.Get<TestCComponent>(1u).val == 3u);
 	REQUIRE(myCPool.Get<TestCComponent>(3u).val == 5u);
 
-	myCPool.Erase(3u);
+	myCPool.Destroy(3u);
+	myCPool.PopBack();
 	REQUIRE(myCPool.GetSize() == 3u);
 
-	myCPool.Erase(0u);
-	myCPool.Erase(0u);
-	myCPool.Erase(0u);
+	for (size_t idx = 0u; idx < 3u; ++idx)
+	{
+		myCPool.Destroy(idx);
+	}
 
+	myCPool.Clear();
 	REQUIRE(myCPool.GetSize() == 0u);
+
+	chunkPool.Free(chunks[0u]);
+}
+
+
+TEST_CASE("pool spanning chunks", "[ecs]")
+{
+	size_t const capacity = 4u;
+
+	fw::ChunkPool chunkPool;
+	std::vector<uint8*> chunks{ chunkPool.Allocate(), chunkPool.Allocate() };
+	fw::ComponentPool myCPool(TestCComponent::GetTypeIndex(), chunks, fw::ChunkPool::s_Alignment, capacity);
+
+	myCPool.Expand(capacity * 2u);
+	for (uint32 idx = 0u; idx < static_cast<uint32>(capacity * 2u); ++idx)
+	{
+		TestCComponent const comp(idx);
+		myCPool.Construct(static_cast<size_t>(idx), &comp);
+	}
+
+	// elements are addressed relative to the chunk they are in
+	REQUIRE(myCPool.At(0u) == chunks[0u] + fw::ChunkPool::s_Alignment);
+	REQUIRE(myCPool.At(capacity) == chunks[1u] + fw::ChunkPool::s_Alignment);
+	REQUIRE(myCPool.Get<TestCComponent>(capacity - 1u).val == static_cast<uint32>(capacity - 1u));
+	REQUIRE(myCPool.Get<TestCComponent>(capacity).val == static_cast<uint32>(capacity));
+
+	// moving the last element across chunks
+	myCPool.Destroy(1u);
+	myCPool.Move(capacity * 2u - 1u, 1u);
+	myCPool.PopBack();
+	REQUIRE(myCPool.GetSize() == capacity * 2u - 1u);
+	REQUIRE(myCPool.Get<TestCComponent>(1u).val == static_cast<uint32>(capacity * 2u - 1u));
+
+	for (uint8* const chunk : chunks)
+	{
+		chunkPool.Free(chunk);
+	}
+}
+
+
+TEST_CASE("pool relocating non trivial components", "[ecs]")
+{
+	// short strings live inside the string object, so they break when memcopied and the old slot is reused
+	REQUIRE_FALSE(fw::ComponentRegistry::Instance().IsTriviallyRelocatable(TestBComponent::GetTypeIndex()));
+
+	fw::ChunkPool chunkPool;
+	std::vector<uint8*> chunks{ chunkPool.Allocate() };
+	fw::ComponentPool myCPool(TestBComponent::GetTypeIndex(), chunks, 0u, fw::ChunkPool::s_ChunkSize / sizeof(TestBComponent));
+
+	myCPool.Expand(3u);
+	for (size_t idx = 0u; idx < 3u; ++idx)
+	{
+		TestBComponent const comp(std::to_string(idx));
+		myCPool.Construct(idx, &comp);
+	}
+
+	// move within the pool and reuse the source slot
+	myCPool.Destroy(0u);
+	myCPool.Move(2u, 0u);
+	{
+		TestBComponent const comp("new");
+		myCPool.Construct(2u, &comp);
+	}
+
+	REQUIRE(myCPool.Get<TestBComponent>(0u).name == "2");
+	REQUIRE(myCPool.Get<TestBComponent>(2u).name == "new");
+
+	// move out of the pool and back in
+	alignas(TestBComponent) uint8 stash[sizeof(TestBComponent)];
+	myCPool.MoveOut(1u, stash);
+	{
+		TestBComponent const comp("temp");
+		myCPool.Construct(1u, &comp);
+	}
+
+	REQUIRE(reinterpret_cast<TestBComponent const*>(stash)->name == "1");
+
+	myCPool.Destroy(1u);
+	myCPool.MoveIn(1u, stash);
+	REQUIRE(myCPool.Get<TestBComponent>(1u).name == "1");
+
+	for (size_t idx = 0u; idx < 3u; ++idx)
+	{
+		myCPool.Destroy(idx);
+	}
+
+	myCPool.Clear();
+	chunkPool.Free(chunks[0u]);
+}
+
+
+TEST_CASE("chunk pool recycling", "[ecs]")
+{
+	fw::ChunkPool chunkPool;
+
+	uint8* const chunk0 = chunkPool.Allocate();
+	uint8* const chunk1 = chunkPool.Allocate();
+
+	REQUIRE(chunk0 != chunk1);
+	REQUIRE(reinterpret_cast<uintptr_t>(chunk0) % fw::ChunkPool::s_Alignment == 0u);
+	REQUIRE(reinterpret_cast<uintptr_t>(chunk1) % fw::ChunkPool::s_Alignment == 0u);
+	REQUIRE(chunkPool.GetAllocatedCount() == 2u);
+	REQUIRE(chunkPool.GetFreeCount() == 0u);
+
+	chunkPool.Free(chunk1);
+	REQUIRE(chunkPool.GetFreeCount() == 1u);
+
+	// freed chunks are handed out again instead of allocating new memory
+	REQUIRE(chunkPool.Allocate() == chunk1);
+	REQUIRE(chunkPool.GetAllocatedCount() == 2u);
+	REQUIRE(chunkPool.GetFreeCount() == 0u);
+
+	chunkPool.Free(chunk0);
+	chunkPool.Free(chunk1);
 }
 
@@ -74,3 +74,45 @@ TEST_CASE("signature", "[ecs]")
 	REQUIRE(abSig.MatchesComponentsUnsorted(compList));
 	REQUIRE_FALSE(bcSig.MatchesComponentsUnsorted(compList));
 }
+
+
+TEST_CASE("signature bitset", "[ecs]")
+{
+	fw::ComponentSignature sig;
+	REQUIRE(sig.GetSize() == 0u);
+	REQUIRE(sig.GetMaxComponentType() == fw::INVALID_COMP_TYPE_IDX);
+
+	sig.Add(TestCComponent::GetTypeIndex());
+	sig.Add(TestAComponent::GetTypeIndex());
+	sig.Add(TestAComponent::GetTypeIndex()); // adding twice doesn't change anything
+	REQUIRE(sig.GetSize() == 2u);
+	REQUIRE(sig.Has(TestAComponent::GetTypeIndex()));
+	REQUIRE_FALSE(sig.Has(TestBComponent::GetTypeIndex()));
+	REQUIRE(sig == fw::GenSignature<TestAComponent, TestCComponent>());
+	REQUIRE(sig.GenId() == fw::GenSignature<TestCComponent, TestAComponent>().GenId());
+
+	sig.Remove(TestCComponent::GetTypeIndex());
+	REQUIRE(sig == fw::GenSignature<TestAComponent>());
+	REQUIRE(sig.GenId() == fw::GenSignature<TestAComponent>().GenId());
+
+	// types beyond the inline bits spill into the overflow words
+	fw::T_CompTypeIdx const farType = static_cast<fw::T_CompTypeIdx>(fw::ComponentSignature::s_InlineTypeCount + 70u);
+
+	fw::ComponentSignature farSig = fw::GenSignature<TestAComponent>();
+	farSig.Add(farType);
+	REQUIRE(farSig.GetSize() == 2u);
+	REQUIRE(farSig.Has(farType));
+	REQUIRE(farSig.GetMaxComponentType() == farType);
+	REQUIRE(farSig.GetTypes().size() == 2u);
+	REQUIRE(farSig.GetTypes()[1] == farType);
+
+	REQUIRE(farSig.Contains(sig));
+	REQUIRE_FALSE(sig.Contains(farSig));
+	REQUIRE(farSig != sig);
+
+	// removing the far type leaves an empty overflow word, which must not affect comparisons or hashing
+	farSig.Remove(farType);
+	REQUIRE(farSig == sig);
+	REQUIRE(sig == farSig);
+	REQUIRE(farSig.GenId() == sig.GenId());
+}
@@ -28,11 +28,12 @@ TEST_CASE("component view", "[ecs]")
 {
 	size_t const entityCount = 16;
 
-	fw::Archetype arch = GenTestArchetype(entityCount);
-	REQUIRE(arch.GetSize() == entityCount);
+	fw::ChunkPool chunkPool;
+	fw::Archetype* const arch = GenTestArchetype(chunkPool, entityCount);
+	REQUIRE(arch->GetSize() == entityCount);
 
 	// full iteration
-	fw::ComponentRange<TestBCView> range(nullptr, &arch, 0u, entityCount);
+	fw::ComponentRange<TestBCView> range(nullptr, arch, 0u, entityCount);
 
 	size_t idx = 0u;
 	for (TestBCView& view : range)
@@ -47,7 +48,7 @@ TEST_CASE("component view", "[ecs]")
 
 	// iteration starting from an offset (8 - 15)
 	size_t const halved = entityCount / 2u;
-	fw::ComponentRange<TestBCView> halfRange(nullptr, &arch, halved, halved);
+	fw::ComponentRange<TestBCView> halfRange(nullptr, arch, halved, halved);
 
 	idx = 0u;
 	for (TestBCView& view : halfRange)
@@ -58,4 +59,56 @@ TEST_CASE("component view", "[ecs]")
 	}
 
 	REQUIRE(idx == halved);
+
+	delete arch;
+}
+
+
+TEST_CASE("component view across chunks", "[ecs]")
+{
+	fw::ChunkPool chunkPool;
+	fw::Archetype* const arch = new fw::Archetype(fw::GenSignature<TestBComponent, TestCComponent>(), chunkPool);
+
+	size_t const capacity = arch->GetChunkCapacity();
+	size_t const entityCount = capacity * 3u + 5u;
+	for (size_t idx = 0u; idx < entityCount; ++idx)
+	{
+		arch->AddEntity(static_cast<fw::T_EntityId>(idx), {
+			fw::MakeRawComponent(TestBComponent(std::to_string(idx))),
+			fw::MakeRawComponent(TestCComponent(static_cast<uint32>(idx)))
+			});
+	}
+
+	REQUIRE(arch->GetChunkCount() == 4u);
+
+	// full iteration
+	fw::ComponentRange<TestBCView> range(nullptr, arch, 0u, entityCount);
+
+	size_t idx = 0u;
+	for (TestBCView& view : range)
+	{
+		REQUIRE(view.c->val == static_cast<uint32>(idx));
+		REQUIRE(view.b->name == std::to_string(idx));
+
+		idx++;
+	}
+
+	REQUIRE(idx == entityCount);
+
+	// range starting just before the end of a chunk
+	size_t const offset = capacity * 2u - 3u;
+	size_t const count = capacity + 6u;
+	fw::ComponentRange<TestBCView> straddlingRange(nullptr, arch, offset, count);
+
+	idx = 0u;
+	for (TestBCView& view : straddlingRange)
+	{
+		REQUIRE(view.c->val == static_cast<uint32>(idx + offset));
+
+		idx++;
+	}
+
+	REQUIRE(idx == count);
+
+	delete arch;
 }
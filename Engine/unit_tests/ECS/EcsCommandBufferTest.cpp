@@ -177,3 +177,144 @@ TEST_CASE("command buffer add / duplicate / remove", "[ecs]")
 }
 
 
+TEST_CASE("command buffer remove hierarchy", "[ecs]")
+{
+	fw::EcsController ecs;
+
+	fw::T_EntityId const parent = ecs.AddEntity(TestCComponent(0u));
+	TestCComponent childC(0u);
+	ecs.AddEntityChild(parent, childC);
+	ecs.AddEntity(TestBComponent(""));
+
+	// the child is queued after its parent, but it is already gone once the parent is removed
+	class TestRemoveCSystem final : public fw::System<TestRemoveCSystem, TestCView>
+	{
+	public:
+		TestRemoveCSystem() = default;
+
+		void Process(fw::ComponentRange<TestCView>& range)
+		{
+			fw::EcsCommandBuffer& cb = GetCommandBuffer();
+
+			for (TestCView& view : range)
+			{
+				cb.RemoveEntity(view.GetCurrentEntity());
+			}
+		}
+	};
+
+	ecs.RegisterSystem<TestRemoveCSystem>();
+	ecs.Process();
+
+	REQUIRE(ecs.GetEntityCount() == 1u);
+}
+
+// records a mix of structural changes depending on the C value
+class TestCommandSystem final : public fw::System<TestCommandSystem, TestCView>
+{
+public:
+	TestCommandSystem(uint32* const refCount, size_t* const callbacks) : m_RefCount(refCount), m_Callbacks(callbacks) {}
+
+	void Process(fw::ComponentRange<TestCView>& range) override
+	{
+		fw::EcsCommandBuffer& cb = GetCommandBuffer();
+		for (TestCView& view : range)
+		{
+			fw::T_EntityId const entity = view.GetCurrentEntity();
+			switch (view.c->val % 4u)
+			{
+			case 0u:
+			{
+				// components for the same entity recorded separately are added in one go
+				TestBComponent b("added");
+				cb.AddComponents(entity, b);
+
+				TestRefCountComp refComp(m_RefCount);
+				cb.AddComponents(entity, refComp);
+
+				size_t* const callbacks = m_Callbacks;
+				fw::EcsCommandBuffer::T_OnMergeFn fn([callbacks](fw::EcsController& ecs, fw::T_EntityId const merged)
+					{
+						REQUIRE(ecs.HasComponent<TestBComponent>(merged));
+						REQUIRE(ecs.HasComponent<TestRefCountComp>(merged));
+						(*callbacks)++;
+					});
+				cb.OnMerge(entity, fn);
+			}
+			break;
+
+			case 1u:
+				cb.RemoveComponents<TestCComponent>(entity);
+				cb.RemoveComponents<TestAComponent>(entity);
+				break;
+
+			case 2u:
+				cb.RemoveEntity(entity);
+				break;
+
+			default:
+				break;
+			}
+		}
+	}
+
+private:
+	uint32* m_RefCount;
+	size_t* m_Callbacks;
+};
+
+
+TEST_CASE("command buffer merge", "[ecs]")
+{
+	// enough commands to span several blocks of the command stream
+	size_t const entityCount = 2000u;
+
+	uint32 refCount = 0u;
+	size_t callbacks = 0u;
+
+	{
+		fw::EcsController ecs;
+		for (size_t idx = 0u; idx < entityCount; ++idx)
+		{
+			ecs.AddEntity(TestAComponent(), TestCComponent(static_cast<uint32>(idx)));
+		}
+
+		ecs.RegisterSystem<TestCommandSystem>(&refCount, &callbacks);
+		ecs.Process();
+
+		REQUIRE(ecs.GetEntityCount() == entityCount - (entityCount / 4u));
+		REQUIRE(callbacks == entityCount / 4u);
+
+		// only the copies in the ECS are alive, the ones in the command stream were destroyed after merging
+		REQUIRE(refCount == entityCount / 4u);
+
+		for (fw::T_EntityId const entity : ecs.GetEntities())
+		{
+			if (!ecs.HasComponent<TestCComponent>(entity))
+			{
+				REQUIRE_FALSE(ecs.HasComponent<TestAComponent>(entity));
+				continue;
+			}
+
+			uint32 const val = ecs.GetComponent<TestCComponent>(entity).val;
+			REQUIRE((val % 4u) != 1u);
+			REQUIRE((val % 4u) != 2u);
+
+			bool const added = ((val % 4u) == 0u);
+			REQUIRE(ecs.HasComponent<TestBComponent>(entity) == added);
+			REQUIRE(ecs.HasComponent<TestRefCountComp>(entity) == added);
+			if (added)
+			{
+				REQUIRE(ecs.GetComponent<TestBComponent>(entity).name == "added");
+			}
+		}
+
+		ecs.UnregisterSystem<TestCommandSystem>();
+		for (fw::T_EntityId const entity : std::vector<fw::T_EntityId>(ecs.GetEntities()))
+		{
+			ecs.RemoveEntity(entity);
+		}
+	}
+
+	REQUIRE(refCount == 0u);
+}
@@ -309,3 +309,282 @@ TEST_CASE("controller component construction, component events", "[ecs]")
 	REQUIRE(counter == 1u);
 	REQUIRE(counter2 == 0u);
 }
+
+
+TEST_CASE("controller component toggling", "[ecs]")
+{
+	fw::EcsController ecs;
+
+	uint32 refCount = 0u;
+	size_t const entityCount = 64u;
+
+	for (size_t idx = 0u; idx < entityCount; ++idx)
+	{
+		TestAComponent aComp;
+		aComp.x = static_cast<int32>(idx);
+		ecs.AddEntity(aComp, TestBComponent(std::to_string(idx)), TestRefCountComp(&refCount));
+	}
+
+	REQUIRE(refCount == entityCount);
+
+	// repeatedly adding and removing a tag like component takes the cached transition after the first time
+	for (size_t iteration = 0u; iteration < 3u; ++iteration)
+	{
+		for (fw::T_EntityId const entity : ecs.GetEntities())
+		{
+			ecs.AddComponents(entity, TestCComponent(static_cast<uint32>(iteration)));
+		}
+
+		for (fw::T_EntityId const entity : ecs.GetEntities())
+		{
+			REQUIRE(ecs.GetComponent<TestCComponent>(entity).val == static_cast<uint32>(iteration));
+		}
+
+		for (fw::T_EntityId const entity : ecs.GetEntities())
+		{
+			ecs.RemoveComponents<TestCComponent>(entity);
+		}
+	}
+
+	// component data survives the relocations, and non trivial components were neither leaked nor destroyed twice
+	REQUIRE(refCount == entityCount);
+	for (fw::T_EntityId const entity : ecs.GetEntities())
+	{
+		REQUIRE_FALSE(ecs.HasComponent<TestCComponent>(entity));
+		REQUIRE(std::to_string(ecs.GetComponent<TestAComponent>(entity).x) == ecs.GetComponent<TestBComponent>(entity).name);
+	}
+
+	// moving entities to a new hierachy layer also relocates them
+	fw::T_EntityId const parent = ecs.GetEntities()[0u];
+	fw::T_EntityId const child = ecs.GetEntities()[1u];
+	ecs.ReparentEntity(child, parent);
+
+	REQUIRE(ecs.GetParent(child) == parent);
+	REQUIRE(ecs.GetComponent<TestBComponent>(child).name == std::to_string(ecs.GetComponent<TestAComponent>(child).x));
+	REQUIRE(refCount == entityCount);
+}
+
+
+TEST_CASE("controller spawn entities", "[ecs]")
+{
+	fw::EcsController ecs;
+
+	uint32 refCount = 0u;
+	size_t addedComps = 0u;
+	size_t addedEntities = 0u;
+
+	auto onAdded = [&addedComps](fw::EcsController& controller, TestCComponent& comp, fw::T_EntityId const entity) -> void
+	{
+		REQUIRE(&controller.GetComponent<TestCComponent>(entity) == &comp);
+		++addedComps;
+	};
+
+	auto onEntityAdded = [&addedEntities](fw::EcsController& controller, fw::T_EntityId const entity) -> void
+	{
+		REQUIRE(controller.HasComponent<TestCComponent>(entity));
+		++addedEntities;
+	};
+
+	ecs.RegisterOnComponentAdded(fw::T_CompEventFn<TestCComponent>(onAdded));
+	ecs.RegisterOnEntityAdded(fw::T_EntityEventFn(onEntityAdded));
+
+	// enough entities to span several storage chunks, after some that already exist
+	fw::T_EntityId const parent = ecs.AddEntity(TestCComponent(1u));
+	ecs.AddEntityChild(parent, TestCComponent(2u), TestRefCountComp(&refCount));
+
+	size_t const entityCount = 3000u;
+	std::vector<fw::T_EntityId> const spawned = ecs.SpawnEntities(entityCount, TestCComponent(3u), TestRefCountComp(&refCount));
+	REQUIRE(spawned.size() == entityCount);
+	REQUIRE(ecs.GetEntityCount() == entityCount + 2u);
+
+	// every entity got its own copy of the components and its event
+	REQUIRE(refCount == entityCount + 1u);
+	REQUIRE(addedComps == entityCount + 2u);
+	REQUIRE(addedEntities == entityCount + 2u);
+
+	for (fw::T_EntityId const entity : spawned)
+	{
+		REQUIRE(ecs.GetComponent<TestCComponent>(entity).val == 3u);
+		REQUIRE_FALSE(ecs.HasParent(entity));
+	}
+
+	ecs.GetComponent<TestCComponent>(spawned[0]).val = 4u;
+	REQUIRE(ecs.GetComponent<TestCComponent>(spawned[1]).val == 3u);
+
+	// children
+	std::vector<fw::RawComponentPtr> components;
+	TestCComponent comp(5u);
+	components.emplace_back(fw::MakeRawComponent(comp));
+
+	std::vector<fw::T_EntityId> const children = ecs.SpawnEntitiesBatched(parent, 10u, components);
+	REQUIRE(ecs.GetChildren(parent).size() == 11u);
+	for (fw::T_EntityId const child : children)
+	{
+		REQUIRE(ecs.GetParent(child) == parent);
+		REQUIRE(ecs.GetComponent<TestCComponent>(child).val == 5u);
+	}
+
+	// spawned entities are regular entities
+	ecs.RemoveEntity(spawned[0]);
+	REQUIRE(refCount == entityCount);
+	REQUIRE(ecs.GetComponent<TestCComponent>(spawned.back()).val == 3u);
+
+	ecs.RemoveAllEntities();
+	REQUIRE(ecs.GetEntityCount() == 0u);
+}
+
+
+TEST_CASE("controller batched events with structural changes", "[ecs]")
+{
+	fw::EcsController ecs;
+
+	// a new controller hands out entity ids in order, so callbacks can refer to entities later in the batch
+	size_t const entityCount = 100u;
+	size_t handled = 0u;
+
+	// moving entities to another archetype or removing them shifts the rest of the batch
+	auto onAdded = [entityCount, &handled](fw::EcsController& controller, TestCComponent& comp, fw::T_EntityId const entity) -> void
+	{
+		REQUIRE(&controller.GetComponent<TestCComponent>(entity) == &comp);
+		comp.val = static_cast<uint32>(entity);
+		++handled;
+
+		if ((entity % 2u) == 0u)
+		{
+			controller.AddComponents(entity, TestAComponent());
+		}
+		else if (((entity % 3u) == 0u) && (entity + 1u < entityCount))
+		{
+			controller.RemoveEntity(entity + 1u); // an entity that wasn't handled yet
+		}
+	};
+
+	ecs.RegisterOnComponentAdded(fw::T_CompEventFn<TestCComponent>(onAdded));
+
+	std::vector<fw::T_EntityId> const spawned = ecs.SpawnEntities(entityCount, TestCComponent(0u));
+	REQUIRE(spawned.size() == entityCount);
+
+	size_t remaining = 0u;
+	for (size_t idx = 0u; idx < entityCount; ++idx)
+	{
+		fw::T_EntityId const entity = spawned[idx];
+		REQUIRE(entity == static_cast<fw::T_EntityId>(idx));
+
+		if ((entity > 0u) && ((entity % 2u) == 0u) && (((entity - 1u) % 3u) == 0u))
+		{
+			continue; // removed by the previous entities callback
+		}
+
+		++remaining;
+		REQUIRE(ecs.GetComponent<TestCComponent>(entity).val == static_cast<uint32>(entity));
+		REQUIRE(ecs.HasComponent<TestAComponent>(entity) == ((entity % 2u) == 0u));
+	}
+
+	REQUIRE(handled == remaining);
+	REQUIRE(ecs.GetEntityCount() == remaining);
+}
+
+
+TEST_CASE("controller hierachy layers share archetypes", "[ecs]")
+{
+	fw::EcsController ecs;
+
+	// chains of entities with the same components at different depths
+	size_t const chainCount = 100u;
+	size_t const depth = 5u;
+
+	std::vector<fw::T_EntityId> roots;
+	for (size_t chainIdx = 0u; chainIdx < chainCount; ++chainIdx)
+	{
+		fw::T_EntityId parent = ecs.AddEntity(TestCComponent(0u));
+		roots.emplace_back(parent);
+
+		for (size_t layer = 1u; layer < depth; ++layer)
+		{
+			parent = ecs.AddEntityChild(parent, TestCComponent(0u));
+		}
+	}
+
+	fw::Archetype const* const archetype = ecs.GetArchetype(roots[0]);
+	for (fw::T_EntityId const entity : ecs.GetEntities())
+	{
+		REQUIRE(ecs.GetArchetype(entity) == archetype);
+	}
+
+	REQUIRE(archetype->GetSize() == chainCount * depth);
+	REQUIRE(archetype->GetLayerCount() == depth);
+
+	// components are still found after layers were shifted
+	for (fw::T_EntityId const entity : ecs.GetEntities())
+	{
+		ecs.GetComponent<TestCComponent>(entity).val = entity;
+	}
+
+	for (fw::T_EntityId const entity : ecs.GetEntities())
+	{
+		REQUIRE(ecs.GetComponent<TestCComponent>(entity).val == entity);
+	}
+
+	// moving a chain under another one moves all its entities to deeper layers of the same archetype
+	ecs.ReparentEntity(roots[1], ecs.GetChildren(ecs.GetChildren(roots[0])[0])[0]);
+	REQUIRE(archetype->GetLayerCount() == depth + 3u);
+	REQUIRE(ecs.GetArchetype(roots[1]) == archetype);
+
+	for (fw::T_EntityId const entity : ecs.GetEntities())
+	{
+		REQUIRE(ecs.GetComponent<TestCComponent>(entity).val == entity);
+		ecs.GetComponent<TestCComponent>(entity).val = 0u;
+	}
+
+	// parents are processed before their children, so the value equals the depth
+	struct TestCDepthView final : public fw::ComponentView
+	{
+		TestCDepthView() : fw::ComponentView()
+		{
+			Declare(parentC);
+			Declare(c);
+		}
+
+		ParentRead<TestCComponent> parentC;
+		WriteAccess<TestCComponent> c;
+	};
+
+	class TestCDepthSystem final : public fw::System<TestCDepthSystem, TestCDepthView>
+	{
+	public:
+		TestCDepthSystem() = default;
+
+		void Process(fw::ComponentRange<TestCDepthView>& range)
+		{
+			for (TestCDepthView& view : range)
+			{
+				view.c->val = view.parentC.IsValid() ? (view.parentC->val + 1u) : 0u;
+			}
+		}
+	};
+
+	ecs.RegisterSystem<TestCDepthSystem>();
+	ecs.Process();
+
+	std::function<void(fw::T_EntityId const, uint32 const)> checkDepth = [&ecs, &checkDepth](fw::T_EntityId const entity, uint32 const layer)
+		{
+			REQUIRE(ecs.GetComponent<TestCComponent>(entity).val == layer);
+			for (fw::T_EntityId const child : ecs.GetChildren(entity))
+			{
+				checkDepth(child, layer + 1u);
+			}
+		};
+
+	for (fw::T_EntityId const root : roots)
+	{
+		if (!ecs.HasParent(root))
+		{
+			checkDepth(root, 0u);
+		}
+	}
+
+	// removing the deep chain drops the layers it occupied
+	ecs.RemoveEntity(roots[1]);
+	REQUIRE(archetype->GetLayerCount() == depth);
+	REQUIRE(ecs.GetEntityCount() == (chainCount - 1u) * depth);
+}
@@ -6,9 +6,12 @@
 
 #include <thread>
 #include <chrono>
+#include <atomic>
 
 #include <mainTesting.h>
 
+#include <EtCore/Concurrency/WorkerPool.h>
+
 #include <EtFramework/ECS/EcsController.h>
 
 
@@ -69,6 +72,74 @@ private:
 };
 
 
+// systems that only process chunks which changed
+//////////////////////////////////////////////////
+
+struct TestChangeView final : public fw::ComponentView
+{
+	TestChangeView() : fw::ComponentView()
+	{
+		Declare(c);
+	}
+
+	ReadAccess<TestCComponent> c;
+};
+
+class TestChangeSystem final : public fw::System<TestChangeSystem, TestChangeView>
+{
+public:
+	TestChangeSystem(size_t* const processed)
+		: m_Processed(processed)
+	{
+		DeclareChangeFilter<TestCComponent>();
+	}
+
+	void Process(fw::ComponentRange<TestChangeView>& range) override
+	{
+		for (TestChangeView& view : range)
+		{
+			ET_UNUSED(view);
+			++(*m_Processed);
+		}
+	}
+private:
+	size_t* const m_Processed;
+};
+
+struct TestParentChangeView final : public fw::ComponentView
+{
+	TestParentChangeView() : fw::ComponentView()
+	{
+		Declare(parentC);
+		Declare(a);
+	}
+
+	ParentRead<TestCComponent> parentC;
+	ReadAccess<TestAComponent> a;
+};
+
+class TestParentChangeSystem final : public fw::System<TestParentChangeSystem, TestParentChangeView>
+{
+public:
+	TestParentChangeSystem(size_t* const processed)
+		: m_Processed(processed)
+	{
+		DeclareParentChangeFilter<TestCComponent>();
+	}
+
+	void Process(fw::ComponentRange<TestParentChangeView>& range) override
+	{
+		for (TestParentChangeView& view : range)
+		{
+			ET_UNUSED(view);
+			++(*m_Processed);
+		}
+	}
+private:
+	size_t* const m_Processed;
+};
+
+
 // the test
 ////////////
 
@@ -98,3 +169,428 @@ TEST_CASE("controller system scheduling", "[ecs]")
 	REQUIRE(executedOrder[5] == rttr::type::get<TestLastSystem>().get_id());
 }
 
+
+TEST_CASE("controller parallel system scheduling", "[ecs]")
+{
+	std::vector<fw::T_SystemType> executedOrder;
+
+	core::WorkerPool pool(3u);
+
+	fw::EcsController ecs;
+	ecs.SetWorkerPool(&pool);
+
+	fw::T_EntityId const ent0 = ecs.AddEntity();
+
+	ecs.RegisterSystem<TestLastSystem>(&executedOrder);
+	ecs.RegisterSystem<TestFirstSystem>(&executedOrder);
+	ecs.RegisterSystem<TestBetweenSystem>(&executedOrder);
+
+	fw::T_EntityId const ent1 = ecs.AddEntity(TestAComponent());
+
+	// dependencies place every system in its own stage, so the order is the same as in serial processing
+	ecs.Process();
+
+	REQUIRE(executedOrder.size() == 6u);
+	REQUIRE(executedOrder[0] == rttr::type::get<TestFirstSystem>().get_id());
+	REQUIRE(executedOrder[1] == rttr::type::get<TestFirstSystem>().get_id());
+	REQUIRE(executedOrder[2] == rttr::type::get<TestBetweenSystem>().get_id());
+	REQUIRE(executedOrder[3] == rttr::type::get<TestBetweenSystem>().get_id());
+	REQUIRE(executedOrder[4] == rttr::type::get<TestLastSystem>().get_id());
+	REQUIRE(executedOrder[5] == rttr::type::get<TestLastSystem>().get_id());
+}
+
+
+// systems with independent component access
+/////////////////////////////////////////////
+
+struct TestAWriteView final : public fw::ComponentView
+{
+	TestAWriteView() : fw::ComponentView()
+	{
+		Declare(a);
+	}
+
+	WriteAccess<TestAComponent> a;
+};
+
+class TestAIncrementSystem final : public fw::System<TestAIncrementSystem, TestAWriteView>
+{
+public:
+	TestAIncrementSystem() = default;
+
+	void Process(fw::ComponentRange<TestAWriteView>& range) override
+	{
+		for (TestAWriteView& view : range)
+		{
+			view.a->x++;
+		}
+	}
+};
+
+class TestCIncrementSystem final : public fw::System<TestCIncrementSystem, TestCWriteView>
+{
+public:
+	TestCIncrementSystem() = default;
+
+	void Process(fw::ComponentRange<TestCWriteView>& range) override
+	{
+		for (TestCWriteView& view : range)
+		{
+			view.c->val++;
+		}
+	}
+};
+
+class TestCReadSystem final : public fw::System<TestCReadSystem, TestCView>
+{
+public:
+	TestCReadSystem(uint32* const sum) : m_Sum(sum) {}
+
+	void Process(fw::ComponentRange<TestCView>& range) override
+	{
+		for (TestCView& view : range)
+		{
+			*m_Sum += view.c->val;
+		}
+	}
+
+private:
+	uint32* const m_Sum;
+};
+
+
+TEST_CASE("controller parallel system conflicts", "[ecs]")
+{
+	size_t const entityCount = 64u;
+
+	uint32 sum = 0u;
+
+	core::WorkerPool pool(3u);
+
+	fw::EcsController ecs;
+	ecs.SetWorkerPool(&pool);
+
+	for (size_t idx = 0u; idx < entityCount; ++idx)
+	{
+		ecs.AddEntity(TestAComponent(), TestCComponent(1u));
+	}
+
+	// incrementing A doesn't conflict with anything, reading C has to wait until it was incremented as it was registered later
+	ecs.RegisterSystem<TestAIncrementSystem>();
+	ecs.RegisterSystem<TestCIncrementSystem>();
+	ecs.RegisterSystem<TestCReadSystem>(&sum);
+
+	ecs.Process();
+
+	REQUIRE(sum == static_cast<uint32>(entityCount * 2u));
+
+	ecs.ProcessViewOneShot(fw::T_OneShotProcess<TestAWriteView>([](fw::ComponentRange<TestAWriteView>& range)
+		{
+			for (TestAWriteView& view : range)
+			{
+				REQUIRE(view.a->x == 1);
+			}
+		}));
+}
+
+
+// systems sharing state outside of the ECS
+/////////////////////////////////////////////
+
+class TestSharedResource final
+{
+public:
+	// stays inside for a while, so that another system accessing the resource from the same stage would be caught
+	void Access()
+	{
+		++m_Active;
+
+		auto const start = std::chrono::steady_clock::now();
+		while ((m_Active.load() < 2u) && ((std::chrono::steady_clock::now() - start) < std::chrono::milliseconds(50)))
+		{
+			std::this_thread::yield();
+		}
+
+		if (m_Active.load() > 1u)
+		{
+			m_Overlapped = true;
+		}
+
+		--m_Active;
+	}
+
+	bool HasOverlapped() const { return m_Overlapped.load(); }
+
+private:
+	std::atomic<uint32> m_Active{ 0u };
+	std::atomic<bool> m_Overlapped{ false };
+};
+
+struct TestBWriteView final : public fw::ComponentView
+{
+	TestBWriteView() : fw::ComponentView()
+	{
+		Declare(b);
+	}
+
+	WriteAccess<TestBComponent> b;
+};
+
+class TestResourceWriteASystem final : public fw::System<TestResourceWriteASystem, TestAWriteView>
+{
+public:
+	TestResourceWriteASystem(TestSharedResource* const resource) : m_Resource(resource)
+	{
+		DeclareResourceWrite<TestSharedResource>();
+	}
+
+	void Process(fw::ComponentRange<TestAWriteView>& range) override
+	{
+		ET_UNUSED(range);
+		m_Resource->Access();
+	}
+
+private:
+	TestSharedResource* const m_Resource;
+};
+
+class TestResourceWriteBSystem final : public fw::System<TestResourceWriteBSystem, TestBWriteView>
+{
+public:
+	TestResourceWriteBSystem(TestSharedResource* const resource) : m_Resource(resource)
+	{
+		DeclareResourceWrite<TestSharedResource>();
+	}
+
+	void Process(fw::ComponentRange<TestBWriteView>& range) override
+	{
+		ET_UNUSED(range);
+		m_Resource->Access();
+	}
+
+private:
+	TestSharedResource* const m_Resource;
+};
+
+class TestResourceReadSystem final : public fw::System<TestResourceReadSystem, TestCWriteView>
+{
+public:
+	TestResourceReadSystem(TestSharedResource* const resource) : m_Resource(resource)
+	{
+		DeclareResourceRead<TestSharedResource>();
+	}
+
+	void Process(fw::ComponentRange<TestCWriteView>& range) override
+	{
+		ET_UNUSED(range);
+		m_Resource->Access();
+	}
+
+private:
+	TestSharedResource* const m_Resource;
+};
+
+
+TEST_CASE("controller parallel system resource conflicts", "[ecs]")
+{
+	TestSharedResource resource;
+
+	core::WorkerPool pool(3u);
+
+	fw::EcsController ecs;
+	ecs.SetWorkerPool(&pool);
+
+	ecs.AddEntity(TestAComponent(), TestBComponent(), TestCComponent(1u));
+
+	// none of the systems share a component type, so only the resource keeps them out of the same stage
+	SECTION("writers")
+	{
+		ecs.RegisterSystem<TestResourceWriteASystem>(&resource);
+		ecs.RegisterSystem<TestResourceWriteBSystem>(&resource);
+
+		ecs.Process();
+		REQUIRE_FALSE(resource.HasOverlapped());
+	}
+
+	SECTION("reader and writer")
+	{
+		ecs.RegisterSystem<TestResourceReadSystem>(&resource);
+		ecs.RegisterSystem<TestResourceWriteASystem>(&resource);
+
+		ecs.Process();
+		REQUIRE_FALSE(resource.HasOverlapped());
+	}
+}
+
+
+// chunked systems
+///////////////////
+
+struct TestACWriteView final : public fw::ComponentView
+{
+	TestACWriteView() : fw::ComponentView()
+	{
+		Declare(a);
+		Declare(c);
+	}
+
+	WriteAccess<TestAComponent> a;
+	ReadAccess<TestCComponent> c;
+};
+
+class TestChunkedSystem final : public fw::System<TestChunkedSystem, TestACWriteView>
+{
+public:
+	TestChunkedSystem() 
+	{
+		DeclareParallelChunks(16u);
+	}
+
+	void Process(fw::ComponentRange<TestACWriteView>& range) override
+	{
+		for (TestACWriteView& view : range)
+		{
+			view.a->x++;
+
+			if ((view.c->val % 2u) == 1u)
+			{
+				GetCommandBuffer().RemoveComponents<TestCComponent>(view.GetCurrentEntity());
+			}
+		}
+	}
+};
+
+
+TEST_CASE("controller chunked system processing", "[ecs]")
+{
+	size_t const entityCount = 100u;
+
+	core::WorkerPool pool(3u);
+
+	fw::EcsController ecs;
+	ecs.SetWorkerPool(&pool);
+
+	for (size_t idx = 0u; idx < entityCount; ++idx)
+	{
+		ecs.AddEntity(TestAComponent(), TestCComponent(static_cast<uint32>(idx)));
+	}
+
+	ecs.RegisterSystem<TestChunkedSystem>();
+
+	// every chunk records into its own command buffer, all of them get merged after processing
+	ecs.Process();
+
+	size_t withC = 0u;
+	for (fw::T_EntityId const entity : ecs.GetEntities())
+	{
+		REQUIRE(ecs.GetComponent<TestAComponent>(entity).x == 1);
+
+		if (ecs.HasComponent<TestCComponent>(entity))
+		{
+			REQUIRE((ecs.GetComponent<TestCComponent>(entity).val % 2u) == 0u);
+			++withC;
+		}
+	}
+
+	REQUIRE(withC == entityCount / 2u);
+
+	// the remaining entities are processed once more, only their chunks record commands
+	ecs.Process();
+
+	for (fw::T_EntityId const entity : ecs.GetEntities())
+	{
+		int32 const expected = ecs.HasComponent<TestCComponent>(entity) ? 2 : 1;
+		REQUIRE(ecs.GetComponent<TestAComponent>(entity).x == expected);
+	}
+}
+
+
+TEST_CASE("controller change filtered systems", "[ecs]")
+{
+	size_t processed = 0u;
+
+	fw::EcsController ecs;
+	ecs.RegisterSystem<TestChangeSystem>(&processed);
+
+	// enough entities to span several storage chunks
+	size_t const entityCount = 10000u;
+	std::vector<fw::T_EntityId> entities;
+	for (size_t idx = 0u; idx < entityCount; ++idx)
+	{
+		entities.push_back(ecs.AddEntity(TestCComponent(static_cast<uint32>(idx))));
+	}
+
+	// new entities count as changed
+	ecs.Process();
+	REQUIRE(processed == entityCount);
+
+	// nothing changed since
+	processed = 0u;
+	ecs.Process();
+	REQUIRE(processed == 0u);
+
+	// reading doesn't mark chunks as changed
+	fw::EcsController const& constEcs = ecs;
+	REQUIRE(constEcs.GetComponent<TestCComponent>(entities.back()).val == static_cast<uint32>(entityCount - 1u));
+	ecs.Process();
+	REQUIRE(processed == 0u);
+
+	// writing to a single entity only processes its chunk
+	ecs.GetComponent<TestCComponent>(entities.back()).val = 0u;
+	ecs.Process();
+	REQUIRE(processed > 0u);
+	REQUIRE(processed < entityCount);
+
+	processed = 0u;
+	ecs.Process();
+	REQUIRE(processed == 0u);
+
+	// so do structural changes
+	ecs.AddComponents(entities.front(), TestAComponent());
+	ecs.Process();
+	REQUIRE(processed > 0u);
+	REQUIRE(processed < entityCount);
+
+	// systems writing the filtered type mark the chunks they process
+	ecs.RegisterSystem<TestCIncrementSystem>();
+	processed = 0u;
+	ecs.Process();
+	ecs.Process();
+	REQUIRE(processed >= entityCount);
+}
+
+TEST_CASE("controller parent change filtered systems", "[ecs]")
+{
+	size_t processed = 0u;
+
+	fw::EcsController ecs;
+	ecs.RegisterSystem<TestParentChangeSystem>(&processed);
+
+	fw::T_EntityId const parent = ecs.AddEntity(TestCComponent(1u));
+	fw::T_EntityId const otherParent = ecs.AddEntity(TestCComponent(2u));
+	ecs.AddEntityChild(parent, TestAComponent());
+	ecs.AddEntityChild(parent, TestAComponent());
+
+	// parents were just added
+	ecs.Process();
+	REQUIRE(processed == 2u);
+
+	processed = 0u;
+	ecs.Process();
+	REQUIRE(processed == 0u);
+
+	// changing the child doesn't matter, only the parent does
+	ecs.GetComponent<TestAComponent>(ecs.GetChildren(parent)[0]).x = 3;
+	ecs.Process();
+	REQUIRE(processed == 0u);
+
+	ecs.GetComponent<TestCComponent>(parent).val = 3u;
+	ecs.Process();
+	REQUIRE(processed == 2u);
+
+	// both parents share a chunk, so changes to the other parent are not distinguished
+	processed = 0u;
+	ecs.GetComponent<TestCComponent>(otherParent).val = 4u;
+	ecs.Process();
+	REQUIRE(processed == 2u);
+}
@@ -41,13 +41,13 @@ ECS_REGISTER_COMPONENT(TestRefCountComp);
 // utility
 //---------
 
-fw::Archetype GenTestArchetype(size_t const count)
+fw::Archetype* GenTestArchetype(fw::ChunkPool& chunkPool, size_t const count)
 {
-	fw::Archetype arch(fw::GenSignature<TestBComponent, TestCComponent>());
+	fw::Archetype* const arch = new fw::Archetype(fw::GenSignature<TestBComponent, TestCComponent>(), chunkPool);
 
 	for (size_t idx = 0u; idx < count; ++idx)
 	{
-		arch.AddEntity(static_cast<fw::T_EntityId>(idx), {
+		arch->AddEntity(static_cast<fw::T_EntityId>(idx), {
 			fw::MakeRawComponent(TestBComponent(std::to_string(idx))),
 			fw::MakeRawComponent(TestCComponent(static_cast<uint32>(idx)))
 			});
@@ -128,7 +128,7 @@ struct TestOverwriteSystemView final : public fw::ComponentView
 // utility
 //*********
 
-fw::Archetype GenTestArchetype(size_t const count);
+fw::Archetype* GenTestArchetype(fw::ChunkPool& chunkPool, size_t const count); // caller takes ownership
 
 // systems
 //*********
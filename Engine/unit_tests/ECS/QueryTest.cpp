@@ -0,0 +1,132 @@
+#include <EtFramework/stdafx.h>
+#include "EcsTestUtilities.h"
+
+#include <catch2/catch.hpp>
+#include <rttr/registration>
+
+#include <mainTesting.h>
+
+#include <EtCore/Concurrency/WorkerPool.h>
+
+#include <EtFramework/ECS/EcsController.h>
+#include <EtFramework/ECS/Query.h>
+
+
+typedef fw::Query<fw::Write<TestAComponent>, fw::Read<TestCComponent>> T_TestACQuery;
+
+
+// system adding the C value to A for every entity
+class TestACQuerySystem final : public fw::System<TestACQuerySystem, T_TestACQuery>
+{
+public:
+	TestACQuerySystem() = default;
+
+	void Process(T_Query::Chunk const& chunk)
+	{
+		TestAComponent* const a = chunk.Get<TestAComponent>();
+		TestCComponent const* const c = chunk.Get<TestCComponent>();
+
+		for (size_t idx = 0u; idx < chunk.GetCount(); ++idx)
+		{
+			a[idx].x += static_cast<int32>(c[idx].val);
+		}
+	}
+};
+
+// same but processing chunks on worker threads
+class TestACParallelQuerySystem final : public fw::System<TestACParallelQuerySystem, T_TestACQuery>
+{
+public:
+	TestACParallelQuerySystem()
+	{
+		DeclareDependencies<TestACQuerySystem>();
+		DeclareParallelChunks(100u);
+	}
+
+	void Process(T_Query::Chunk const& chunk)
+	{
+		TestAComponent* const a = chunk.Get<TestAComponent>();
+		TestCComponent const* const c = chunk.Get<TestCComponent>();
+
+		for (size_t idx = 0u; idx < chunk.GetCount(); ++idx)
+		{
+			a[idx].x += static_cast<int32>(c[idx].val);
+		}
+	}
+};
+
+
+TEST_CASE("query signature", "[ecs]")
+{
+	REQUIRE(T_TestACQuery::GetSignature() == fw::GenSignature<TestAComponent, TestCComponent>());
+
+	fw::T_CompAccessList const access = T_TestACQuery::GetAccess();
+	REQUIRE(access.size() == 2u);
+	REQUIRE(access[0].typeIdx == TestAComponent::GetTypeIndex());
+	REQUIRE(access[0].access == fw::E_ComponentAccess::ReadWrite);
+	REQUIRE(access[1].typeIdx == TestCComponent::GetTypeIndex());
+	REQUIRE(access[1].access == fw::E_ComponentAccess::Read);
+}
+
+
+TEST_CASE("query chunk", "[ecs]")
+{
+	fw::ChunkPool chunkPool;
+	fw::Archetype archAC(fw::GenSignature<TestAComponent, TestCComponent>(), chunkPool);
+
+	size_t const entityCount = 16u;
+	for (size_t idx = 0u; idx < entityCount; ++idx)
+	{
+		archAC.AddEntity(static_cast<fw::T_EntityId>(idx), { fw::MakeRawComponent(TestAComponent()), fw::MakeRawComponent(TestCComponent(static_cast<uint32>(idx))) });
+	}
+
+	T_TestACQuery::Chunk const chunk(archAC, 4u, 8u);
+	REQUIRE(chunk.GetCount() == 8u);
+
+	// arrays point straight into the archetype
+	REQUIRE(chunk.Get<TestAComponent>() == &archAC.GetPool(TestAComponent::GetTypeIndex()).Get<TestAComponent>(4u));
+	REQUIRE(chunk.Get<TestCComponent>() == &archAC.GetPool(TestCComponent::GetTypeIndex()).Get<TestCComponent>(4u));
+
+	for (size_t idx = 0u; idx < chunk.GetCount(); ++idx)
+	{
+		REQUIRE(chunk.Get<TestCComponent>()[idx].val == static_cast<uint32>(idx + 4u));
+		REQUIRE(chunk.GetEntities()[idx] == static_cast<fw::T_EntityId>(idx + 4u));
+	}
+
+	archAC.Clear();
+}
+
+
+TEST_CASE("query system", "[ecs]")
+{
+	core::WorkerPool pool(3u);
+
+	fw::EcsController ecs;
+	ecs.SetWorkerPool(&pool);
+
+	// enough entities to span several storage chunks
+	size_t const entityCount = 5000u;
+	for (size_t idx = 0u; idx < entityCount; ++idx)
+	{
+		ecs.AddEntity(TestAComponent(), TestCComponent(static_cast<uint32>(idx % 7u)));
+	}
+
+	ecs.AddEntity(TestAComponent()); // not matching
+
+	ecs.RegisterSystem<TestACQuerySystem>();
+	ecs.RegisterSystem<TestACParallelQuerySystem>();
+
+	ecs.Process();
+
+	for (fw::T_EntityId const entity : ecs.GetEntities())
+	{
+		if (ecs.HasComponent<TestCComponent>(entity))
+		{
+			REQUIRE(ecs.GetComponent<TestAComponent>(entity).x == static_cast<int32>(ecs.GetComponent<TestCComponent>(entity).val * 2u));
+		}
+		else
+		{
+			REQUIRE(ecs.GetComponent<TestAComponent>(entity).x == 0);
+		}
+	}
+}
@@ -25,15 +25,18 @@ TEST_CASE("system iterate", "[ecs]")
 {
 	size_t const entityCount = 16;
 
-	fw::Archetype arch = GenTestArchetype(entityCount);
-	REQUIRE(arch.GetSize() == entityCount);
+	fw::ChunkPool chunkPool;
+	fw::Archetype* const arch = GenTestArchetype(chunkPool, entityCount);
+	REQUIRE(arch->GetSize() == entityCount);
 
 	TestBCSystem systemBC;
 	REQUIRE(systemBC.GetSignature() == fw::GenSignature<TestCComponent, TestBComponent>());
 
-	REQUIRE(arch.GetSignature().Contains(systemBC.GetSignature()));
+	REQUIRE(arch->GetSignature().Contains(systemBC.GetSignature()));
 
-	systemBC.RootProcess(nullptr, &arch, 0u, entityCount);
+	systemBC.RootProcess(nullptr, arch, 0u, entityCount);
+
+	delete arch;
 }
 
 TEST_CASE("system overwrite", "[ecs]")
@@ -43,7 +46,8 @@ TEST_CASE("system overwrite", "[ecs]")
 	size_t const overwriteEnd = 12u;
 
 	// generate entities
-	fw::Archetype arch(fw::GenSignature<TestOverwriteComp, TestCComponent>());
+	fw::ChunkPool chunkPool;
+	fw::Archetype arch(fw::GenSignature<TestOverwriteComp, TestCComponent>(), chunkPool);
 
 	for (uint32 idx = 0u; idx < static_cast<uint32>(entityCount); ++idx)
 	{
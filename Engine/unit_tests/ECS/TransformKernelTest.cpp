@@ -0,0 +1,86 @@
+#include <EtFramework/stdafx.h>
+
+#include <catch2/catch.hpp>
+
+#include <EtMath/Transform.h>
+
+#include <EtFramework/Systems/TransformKernel.h>
+
+
+namespace {
+
+	// matches what the transform system computed per entity before transforms were batched
+	mat4 ReferenceMatrix(vec3 const& position, quat const& rotation, vec3 const& scale)
+	{
+		return math::scale(scale) * math::rotate(rotation) * math::translate(position);
+	}
+
+	quat GenRotation(size_t const idx)
+	{
+		float const f = static_cast<float>(idx);
+		return quat(math::normalize(vec3(0.3f * f, 1.f, -0.2f * f)), 0.37f * f);
+	}
+
+}
+
+
+TEST_CASE("transform kernel matrices", "[ecs]")
+{
+	// not a multiple of any lane count, so that padding is exercised
+	size_t const count = 13u;
+
+	fw::TransformKernel kernel;
+	for (size_t idx = 0u; idx < count; ++idx)
+	{
+		float const f = static_cast<float>(idx);
+		kernel.Add(vec3(f, -2.f * f, 0.5f), GenRotation(idx), vec3(1.f + 0.1f * f, 2.f, 0.5f + f));
+	}
+
+	REQUIRE(kernel.GetCount() == count);
+	REQUIRE_FALSE(kernel.IsFull());
+
+	mat4 matrices[fw::TransformKernel::s_Capacity];
+	kernel.ComputeMatrices(matrices);
+
+	for (size_t idx = 0u; idx < count; ++idx)
+	{
+		float const f = static_cast<float>(idx);
+		mat4 const expected = ReferenceMatrix(vec3(f, -2.f * f, 0.5f), GenRotation(idx), vec3(1.f + 0.1f * f, 2.f, 0.5f + f));
+		REQUIRE(math::nearEqualsM(matrices[idx], expected, 0.0001f));
+	}
+}
+
+
+TEST_CASE("transform kernel orientations", "[ecs]")
+{
+	fw::TransformKernel kernel;
+	while (!kernel.IsFull())
+	{
+		kernel.Add(vec3(), quat(), vec3(1.f));
+	}
+
+	// orientations use rotations set after the batch was gathered
+	for (size_t idx = 0u; idx < kernel.GetCount(); ++idx)
+	{
+		kernel.SetRotation(idx, GenRotation(idx));
+	}
+
+	vec3 forward[fw::TransformKernel::s_Capacity];
+	vec3 right[fw::TransformKernel::s_Capacity];
+	vec3 up[fw::TransformKernel::s_Capacity];
+	kernel.ComputeOrientations(forward, right, up);
+
+	for (size_t idx = 0u; idx < kernel.GetCount(); ++idx)
+	{
+		quat const rotation = GenRotation(idx);
+		vec3 const expectedForward = rotation * vec3::FORWARD;
+		vec3 const expectedRight = rotation * vec3::RIGHT;
+
+		REQUIRE(math::nearEqualsV(forward[idx], expectedForward, 0.0001f));
+		REQUIRE(math::nearEqualsV(right[idx], expectedRight, 0.0001f));
+		REQUIRE(math::nearEqualsV(up[idx], math::cross(expectedForward, expectedRight), 0.0001f));
+	}
+
+	kernel.Clear();
+	REQUIRE(kernel.GetCount() == 0u);
+}
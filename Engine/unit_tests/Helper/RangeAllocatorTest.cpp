@@ -0,0 +1,68 @@
+#include <EtCore/stdafx.h>
+
+#include <catch2/catch.hpp>
+
+#include <EtCore/Memory/RangeAllocator.h>
+
+
+using namespace et;
+
+
+TEST_CASE("range allocator", "[memory]")
+{
+	core::RangeAllocator allocator(100u);
+
+	size_t const first = allocator.Allocate(20u);
+	size_t const second = allocator.Allocate(30u);
+	size_t const third = allocator.Allocate(10u);
+
+	REQUIRE(first == 0u);
+	REQUIRE(second == 20u);
+	REQUIRE(third == 50u);
+	REQUIRE(allocator.GetEnd() == 60u);
+	REQUIRE(allocator.GetAllocatedSize() == 60u);
+
+	SECTION("ranges that don't fit are rejected")
+	{
+		REQUIRE((allocator.Allocate(41u) == core::RangeAllocator::s_InvalidOffset));
+		REQUIRE(allocator.Allocate(40u) == 60u);
+		REQUIRE(allocator.GetEnd() == 100u);
+	}
+
+	SECTION("released ranges are reused first fit")
+	{
+		allocator.Release(first, 20u);
+
+		REQUIRE(allocator.Allocate(25u) == 60u);
+		REQUIRE(allocator.Allocate(15u) == 0u);
+		REQUIRE(allocator.Allocate(5u) == 15u);
+	}
+
+	SECTION("neighbouring ranges are merged")
+	{
+		allocator.Release(first, 20u);
+		allocator.Release(second, 30u);
+
+		REQUIRE(allocator.Allocate(50u) == 0u);
+		REQUIRE(allocator.GetEnd() == 60u);
+	}
+
+	SECTION("releasing the last range shrinks the end")
+	{
+		allocator.Release(second, 30u);
+		allocator.Release(third, 10u);
+
+		REQUIRE(allocator.GetEnd() == 20u);
+		REQUIRE(allocator.Allocate(80u) == 20u);
+	}
+
+	SECTION("releasing everything empties the allocator")
+	{
+		allocator.Release(second, 30u);
+		allocator.Release(first, 20u);
+		allocator.Release(third, 10u);
+
+		REQUIRE(allocator.IsEmpty());
+		REQUIRE(allocator.GetEnd() == 0u);
+	}
+}
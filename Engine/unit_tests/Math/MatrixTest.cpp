@@ -235,4 +235,45 @@ TEST_CASE( "Specialized matrix functionality", "[matrix]" )
 
 		REQUIRE( math::nearEquals( det, manualDet, 0.00001f ) );
 	}
-}
\ No newline at end of file
+}
+
+TEST_CASE( "SIMD matrix operations", "[matrix]" )
+{
+	// the generic templates are called explicitly so the SIMD overloads can be compared against them
+	mat4 a( {	5.3f, 1.2f, 3.0f, 0.f,
+				2.3f, 5.8f, 7.3f, 0.f,
+				3.2f, 4.9f, 6.3f, 0.f,
+				-3.2f, 1.2f, 2.3f, 1.f } );
+	mat4 b( {	0.5f, -1.5f, 2.0f, 0.f,
+				1.1f, 0.2f, -0.7f, 0.f,
+				2.4f, 3.3f, 0.9f, 0.f,
+				7.f, -2.f, 4.5f, 1.f } );
+
+	SECTION( "matrix multiplication" )
+	{
+		REQUIRE( math::nearEqualsM( a * b, math::operator*<4u, 4u, float>( a, b ), 0.00001f ) );
+		REQUIRE( math::nearEqualsM( b * a, math::operator*<4u, 4u, float>( b, a ), 0.00001f ) );
+	}
+	SECTION( "vector multiplication" )
+	{
+		vec4 const v( 1.5f, -2.f, 0.25f, 1.f );
+		REQUIRE( math::nearEqualsV( a * v, math::operator*<4u, 4u, float>( a, v ), 0.00001f ) );
+	}
+	SECTION( "transpose" )
+	{
+		mat4 const transposed = math::transpose( a );
+		for (math::uint8 rowIdx = 0u; rowIdx < 4u; ++rowIdx)
+		{
+			for (math::uint8 colIdx = 0u; colIdx < 4u; ++colIdx)
+			{
+				REQUIRE( transposed[rowIdx][colIdx] == a[colIdx][rowIdx] );
+			}
+		}
+	}
+	SECTION( "inverse" )
+	{
+		REQUIRE( math::nearEqualsM( math::inverse( a ), math::inverse<float>( a ), 0.00001f ) );
+		REQUIRE( math::nearEqualsM( math::inverse( b ), math::inverse<float>( b ), 0.00001f ) );
+		REQUIRE( math::nearEqualsM( mat4(), a * math::inverse( a ), 0.00001f ) );
+	}
+}
@@ -83,6 +83,32 @@ TEST_CASE( "quaternion multiplication", "[quat]" )
 		REQUIRE( math::nearEqualsV( math::inverse(R1).v4, math::inverseSafe(R1).v4, 0.0001f ) );
 	}
 }
+
+TEST_CASE( "SIMD quaternion operations", "[quat]" )
+{
+	// the generic templates are called explicitly so the SIMD overloads can be compared against them
+	quat const R1 = quat( math::normalize( vec3( 0.3f, 1.f, -0.5f ) ), 1.2f );
+	quat const R2 = quat( math::normalize( vec3( -2.f, 0.4f, 1.f ) ), -0.7f );
+
+	SECTION( "quat mul quat" )
+	{
+		REQUIRE( math::nearEqualsV( ( R1 * R2 ).v4, math::operator*<float>( R1, R2 ).v4, 0.00001f ) );
+		REQUIRE( math::nearEqualsV( ( R2 * R1 ).v4, math::operator*<float>( R2, R1 ).v4, 0.00001f ) );
+	}
+	SECTION( "rotate vector" )
+	{
+		vec3 const v( 1.5f, -2.f, 0.25f );
+		REQUIRE( math::nearEqualsV( R1 * v, math::operator*<float>( R1, v ), 0.00001f ) );
+	}
+	SECTION( "normalize" )
+	{
+		quat q( 1.f, 2.f, -3.f, 4.f );
+		math::normalize( q );
+		REQUIRE( math::nearEqualsV( q.v4, math::normalize<4u, float>( vec4( 1.f, 2.f, -3.f, 4.f ) ), 0.00001f ) );
+		REQUIRE( math::nearEquals( math::length( q.v4 ), 1.f, 0.00001f ) );
+	}
+}
+
 TEST_CASE( "matrix compatibility", "[quat]" )
 {
 	quat R1 = quat( vec3( 0, 0, 1 ), math::PI_DIV2 );
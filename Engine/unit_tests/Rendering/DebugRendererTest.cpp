@@ -0,0 +1,166 @@
+#include <EtRendering/stdafx.h>
+
+#include <catch2/catch.hpp>
+
+#include <EtCore/Util/DebugUtilFwd.h>
+
+#if ET_CT_IS_ENABLED(ET_CT_DBG_UTIL)
+
+#include <EtCore/Content/ResourceManager.h>
+
+#include <EtRendering/GraphicsContext/ContextHolder.h>
+#include <EtRendering/GraphicsContext/HeadlessRenderWindow.h>
+#include <EtRendering/GraphicsTypes/Shader.h>
+#include <EtRendering/GraphicsTypes/Camera.h>
+#include <EtRendering/Extensions/DebugRenderer.h>
+
+
+using namespace et;
+
+
+namespace {
+
+	//---------------------------------
+	// TestResourceManager
+	//
+	// Serves the debug renderer shader from memory, so that it can be loaded without an asset database
+	//
+	class TestResourceManager final : public core::ResourceManager
+	{
+	public:
+		TestResourceManager(std::string const& shaderSource) : core::ResourceManager(), m_ShaderSource(shaderSource)
+		{
+			m_Shader.SetPath("Shaders/");
+			m_Shader.SetName("DebugRenderer.glsl");
+		}
+
+		bool GetLoadData(core::I_Asset const* const asset, std::vector<uint8>& outData) const override
+		{
+			if (asset != &m_Shader)
+			{
+				return false;
+			}
+
+			outData.assign(m_ShaderSource.cbegin(), m_ShaderSource.cend());
+			return true;
+		}
+
+		void Flush() override {}
+
+	protected:
+		void Init() override {}
+		void Deinit() override {}
+
+		core::I_Asset* GetAssetInternal(core::HashString const assetId, rttr::type const type, bool const reportErrors) override
+		{
+			ET_UNUSED(reportErrors);
+
+			if ((assetId == m_Shader.GetId()) && (type == rttr::type::get<render::ShaderData>()))
+			{
+				return &m_Shader;
+			}
+
+			return nullptr;
+		}
+
+	private:
+		std::string m_ShaderSource;
+		render::ShaderAsset m_Shader;
+	};
+
+} // namespace
+
+
+TEST_CASE("debug renderer", "[rendering]")
+{
+	// vertex stage of Shaders/DebugRenderer.glsl, the fragment stage has no uniforms or attributes
+	std::string const shaderSource = R"(
+		#version 330 core
+		layout (location = 0) in vec3 pos;
+		layout (location = 1) in vec4 color;
+		out vec4 Color;
+
+		uniform mat4 uViewProj;
+
+		void main()
+		{
+			Color = color;
+			gl_Position = uViewProj*vec4(pos, 1.0);
+		}
+	)";
+
+	core::ResourceManager::SetInstance(new TestResourceManager(shaderSource));
+
+	{
+		render::HeadlessRenderWindow window(ivec2(64, 64));
+		render::ContextHolder::Instance().CreateMainRenderContext(&window);
+		render::RecordingContext& context = window.GetContext();
+
+		render::Camera camera;
+
+		render::DebugRenderer renderer;
+		renderer.Initialize();
+
+		// the shader interface comes from the recording contexts reflection
+		AssetPtr<render::ShaderData> const shader = core::ResourceManager::Instance()->GetAssetData<render::ShaderData>(
+			core::HashString("Shaders/DebugRenderer.glsl"));
+		REQUIRE(shader != nullptr);
+		REQUIRE(shader->GetUniformIds().size() == 1u);
+		REQUIRE(shader->GetUniformIds()[0] == core::HashString("uViewProj"));
+		REQUIRE(shader->GetAttributes().size() == 2u);
+		REQUIRE(shader->GetAttributes()[1].first == 1);
+
+		auto const drawLines = [&renderer]()
+			{
+				renderer.DrawLine(vec3(0.f), vec3(1.f, 0.f, 0.f));
+				renderer.DrawLine(vec3(0.f), vec3(0.f, 1.f, 0.f));
+				renderer.DrawLine(vec3(0.f), vec3(0.f, 0.f, 1.f), vec4(1.f), 2.f);
+			};
+
+		SECTION("lines of the same thickness share a draw call")
+		{
+			drawLines();
+
+			context.Reset();
+			renderer.Draw(camera);
+
+			REQUIRE(context.GetStats().drawCalls == 2u);
+			REQUIRE(context.GetStats().elements == 6u);
+
+			// the view projection doesn't match the default of the shader yet, vertices are streamed without uploads
+			REQUIRE(context.GetStats().uniformUploads == 1u);
+			REQUIRE(context.GetStats().bufferUploads == 0u);
+			REQUIRE(context.GetStats().bufferMaps == 0u);
+		}
+
+		SECTION("unchanged uniforms are not uploaded again")
+		{
+			drawLines();
+			renderer.Draw(camera);
+
+			drawLines();
+
+			context.Reset();
+			renderer.Draw(camera);
+
+			REQUIRE(context.GetStats().drawCalls == 2u);
+			REQUIRE(context.GetStats().uniformUploads == 0u);
+			REQUIRE(context.GetStats().bufferUploads == 0u);
+		}
+
+		SECTION("nothing is drawn without lines")
+		{
+			context.Reset();
+			renderer.Draw(camera);
+
+			REQUIRE(context.GetStats().drawCalls == 0u);
+			REQUIRE(context.GetStats().uniformUploads == 0u);
+		}
+	}
+
+	// the renderer released the shader before the context went away
+	core::ResourceManager::DestroyInstance();
+	REQUIRE(render::ContextHolder::GetRenderContext() == nullptr);
+}
+
+#endif // ET_CT_IS_ENABLED(ET_CT_DBG_UTIL)
@@ -0,0 +1,207 @@
+#include <EtRendering/stdafx.h>
+
+#include <catch2/catch.hpp>
+
+#include <EtRendering/GraphicsTypes/Frustum.h>
+
+
+using namespace et;
+
+
+namespace {
+
+	// more than one mask word, and not a multiple of the lane count so the last group only partially fills a register
+	size_t const s_VolumeCount = 70u;
+
+	// an axis aligned cube from -10 to 10 on every axis
+	render::Frustum CreateCubeFrustum()
+	{
+		render::Frustum frustum;
+		frustum.SetToViewProjection(math::orthographic(-10.f, 10.f, 10.f, -10.f, -10.f, 10.f));
+		return frustum;
+	}
+
+	// volumes are spread along x so that some lie on either side of the frustum and some inside it
+	// none of them exactly touch a plane, so the result doesn't depend on rounding
+	vec3 GetVolumeCenter(size_t const idx)
+	{
+		float const offset = static_cast<float>(idx % 5u) - 2.f;
+		return vec3(static_cast<float>(idx) - 35.f, offset, -offset);
+	}
+
+	float GetVolumeSize(size_t const idx)
+	{
+		return 0.25f + static_cast<float>(idx % 3u);
+	}
+
+	bool IsVolumeVisible(size_t const idx)
+	{
+		return (std::abs(GetVolumeCenter(idx).x) - GetVolumeSize(idx)) < 10.f;
+	}
+
+	render::BoundingSpheres CreateSpheres(size_t const first, size_t const count)
+	{
+		render::BoundingSpheres spheres;
+		for (size_t idx = first; idx < first + count; ++idx)
+		{
+			spheres.Add(math::Sphere(GetVolumeCenter(idx), GetVolumeSize(idx)));
+		}
+
+		return spheres;
+	}
+
+	render::BoundingBoxes CreateBoxes(size_t const first, size_t const count)
+	{
+		render::BoundingBoxes boxes;
+		for (size_t idx = first; idx < first + count; ++idx)
+		{
+			vec3 const extent(GetVolumeSize(idx));
+			boxes.Add(GetVolumeCenter(idx) - extent, GetVolumeCenter(idx) + extent);
+		}
+
+		return boxes;
+	}
+
+	//---------------------------------
+	// CheckCulling
+	//
+	// Compares the index and mask output of batch culling with the expected visibility, and with culling each volume on its own
+	//  - a single volume never fills a register, so it always goes through the scalar path
+	//
+	template<typename TCreateFn, typename TCullFn>
+	void CheckCulling(size_t const count, TCreateFn const& createFn, TCullFn const& cullFn)
+	{
+		auto const volumes = createFn(0u, count);
+		REQUIRE(volumes.GetCount() == count);
+
+		std::vector<uint32> visibleIndices;
+		std::vector<uint64> visibleMask;
+		cullFn(volumes, visibleIndices);
+		cullFn(volumes, visibleMask);
+
+		REQUIRE(visibleMask.size() == (count + 63u) / 64u);
+
+		size_t listIdx = 0u;
+		std::vector<uint32> singleIndices;
+		for (size_t idx = 0u; idx < count; ++idx)
+		{
+			bool const inMask = (visibleMask[idx / 64u] & (static_cast<uint64>(1u) << (idx % 64u))) != 0u;
+			bool const inList = (listIdx < visibleIndices.size()) && (visibleIndices[listIdx] == static_cast<uint32>(idx));
+			if (inList)
+			{
+				++listIdx;
+			}
+
+			REQUIRE(inMask == IsVolumeVisible(idx));
+			REQUIRE(inList == inMask);
+
+			cullFn(createFn(idx, 1u), singleIndices);
+			REQUIRE(singleIndices.empty() != inMask);
+		}
+
+		REQUIRE(listIdx == visibleIndices.size());
+	}
+
+} // namespace
+
+
+TEST_CASE("frustum cull spheres", "[rendering]")
+{
+	render::Frustum const frustum = CreateCubeFrustum();
+
+	auto const cullFn = [&frustum](render::BoundingSpheres const& spheres, auto& output)
+		{
+			frustum.CullSpheres(spheres, output);
+		};
+
+	SECTION("batches match the scalar path and each other")
+	{
+		CheckCulling(s_VolumeCount, CreateSpheres, cullFn);
+	}
+
+	SECTION("partially filled lanes")
+	{
+		// counts around the lane count, starting where visibility changes from one volume to the next
+		for (size_t count = 1u; count <= 2u * render::Frustum::s_CullLanes + 1u; ++count)
+		{
+			render::BoundingSpheres const spheres = CreateSpheres(22u, count);
+
+			std::vector<uint32> visibleIndices;
+			frustum.CullSpheres(spheres, visibleIndices);
+
+			std::vector<uint32> expected;
+			for (size_t idx = 0u; idx < count; ++idx)
+			{
+				if (IsVolumeVisible(idx + 22u))
+				{
+					expected.emplace_back(static_cast<uint32>(idx));
+				}
+			}
+
+			REQUIRE(visibleIndices == expected);
+		}
+	}
+
+	SECTION("batches agree with single sphere checks")
+	{
+		render::BoundingSpheres const spheres = CreateSpheres(0u, s_VolumeCount);
+
+		std::vector<uint64> visibleMask;
+		frustum.CullSpheres(spheres, visibleMask);
+
+		for (size_t idx = 0u; idx < s_VolumeCount; ++idx)
+		{
+			bool const inMask = (visibleMask[idx / 64u] & (static_cast<uint64>(1u) << (idx % 64u))) != 0u;
+			bool const contained = frustum.ContainsSphere(math::Sphere(GetVolumeCenter(idx), GetVolumeSize(idx))) != render::VolumeCheck::OUTSIDE;
+			REQUIRE(inMask == contained);
+		}
+	}
+
+	SECTION("empty batches")
+	{
+		std::vector<uint32> visibleIndices = { 1u };
+		std::vector<uint64> visibleMask = { 1u };
+		frustum.CullSpheres(render::BoundingSpheres(), visibleIndices);
+		frustum.CullSpheres(render::BoundingSpheres(), visibleMask);
+
+		REQUIRE(visibleIndices.empty());
+		REQUIRE(visibleMask.empty());
+	}
+}
+
+TEST_CASE("frustum cull boxes", "[rendering]")
+{
+	render::Frustum const frustum = CreateCubeFrustum();
+
+	auto const cullFn = [&frustum](render::BoundingBoxes const& boxes, auto& output)
+		{
+			frustum.CullBoxes(boxes, output);
+		};
+
+	SECTION("batches match the scalar path and each other")
+	{
+		CheckCulling(s_VolumeCount, CreateBoxes, cullFn);
+	}
+
+	SECTION("partially filled lanes")
+	{
+		for (size_t count = 1u; count <= 2u * render::Frustum::s_CullLanes + 1u; ++count)
+		{
+			render::BoundingBoxes const boxes = CreateBoxes(22u, count);
+
+			std::vector<uint32> visibleIndices;
+			frustum.CullBoxes(boxes, visibleIndices);
+
+			std::vector<uint32> expected;
+			for (size_t idx = 0u; idx < count; ++idx)
+			{
+				if (IsVolumeVisible(idx + 22u))
+				{
+					expected.emplace_back(static_cast<uint32>(idx));
+				}
+			}
+
+			REQUIRE(visibleIndices == expected);
+		}
+	}
+}
@@ -0,0 +1,124 @@
+#include <EtRendering/stdafx.h>
+
+#include <catch2/catch.hpp>
+
+#include <EtRendering/GraphicsContext/ContextHolder.h>
+#include <EtRendering/GraphicsContext/HeadlessRenderWindow.h>
+#include <EtRendering/GlobalRenderingSystems/GeometryPool.h>
+
+
+using namespace et;
+
+
+TEST_CASE("geometry pool", "[rendering]")
+{
+	render::HeadlessRenderWindow window(ivec2(16, 16));
+	render::ContextHolder::Instance().CreateMainRenderContext(&window);
+	render::RecordingContext& context = window.GetContext();
+
+	render::T_VertexFlags const positionFlags = render::E_VertexFlag::POSITION; // 12 byte vertices
+	render::T_VertexFlags const normalFlags = render::E_VertexFlag::POSITION | render::E_VertexFlag::NORMAL;
+
+	// pages fit 100 position vertices and 400 bytes of indices
+	render::GeometryPool pool(1200u, 400u);
+
+	std::vector<uint8> const vertexData(12000u, 0u);
+	std::vector<uint8> const indexData(1000u, 0u);
+
+	size_t const initialBufferCount = context.GetLiveBufferCount();
+
+	render::GeometryPool::Allocation first = pool.Allocate(positionFlags, 40u, vertexData.data(), 240u, indexData.data());
+	render::GeometryPool::Allocation second = pool.Allocate(positionFlags, 40u, vertexData.data(), 6u, indexData.data());
+
+	SECTION("meshes with the same layout share a page")
+	{
+		REQUIRE(pool.GetPageCount() == 1u);
+		REQUIRE(first.page == second.page);
+
+		REQUIRE(first.baseVertex == 0u);
+		REQUIRE(first.indexOffset == 0u);
+		REQUIRE(second.baseVertex == 40u);
+		REQUIRE(second.indexOffset == 240u);
+		REQUIRE(second.indexSize == 8u); // aligned so that the next mesh starts on a 4 byte boundary
+
+		REQUIRE(context.GetLiveBufferCount() == initialBufferCount + 2u);
+	}
+
+	SECTION("different layouts don't share pages")
+	{
+		render::GeometryPool::Allocation other = pool.Allocate(normalFlags, 10u, vertexData.data(), 12u, indexData.data());
+
+		REQUIRE(pool.GetPageCount() == 2u);
+		REQUIRE(other.page != first.page);
+		REQUIRE(other.baseVertex == 0u);
+
+		pool.Release(other);
+		REQUIRE(!other.IsValid());
+	}
+
+	SECTION("a full page starts a new one")
+	{
+		render::GeometryPool::Allocation third = pool.Allocate(positionFlags, 30u, vertexData.data(), 12u, indexData.data());
+
+		REQUIRE(pool.GetPageCount() == 2u);
+		REQUIRE(third.page != first.page);
+
+		// oversized meshes get a page of their own
+		render::GeometryPool::Allocation large = pool.Allocate(positionFlags, 1000u, vertexData.data(), 12u, indexData.data());
+		REQUIRE(pool.GetPageCount() == 3u);
+		REQUIRE(large.page != third.page);
+
+		pool.Release(large);
+		pool.Release(third);
+	}
+
+	SECTION("uploads only touch the allocated range")
+	{
+		context.Reset();
+		render::GeometryPool::Allocation third = pool.Allocate(positionFlags, 10u, vertexData.data(), 12u, indexData.data());
+
+		REQUIRE(context.GetStats().bufferUploads == 2u);
+		REQUIRE(context.GetStats().bufferBytes == 132u);
+
+		pool.Release(third);
+	}
+
+	SECTION("empty pages are freed")
+	{
+		pool.Release(first);
+		REQUIRE(pool.GetPageCount() == 1u);
+
+		pool.Release(second);
+		REQUIRE(pool.GetPageCount() == 0u);
+		REQUIRE(context.GetLiveBufferCount() == initialBufferCount);
+	}
+
+	SECTION("allocations freed by deinitializing the pool are released without effect")
+	{
+		pool.Deinit();
+		REQUIRE(pool.GetPageCount() == 0u);
+		REQUIRE(context.GetLiveBufferCount() == initialBufferCount);
+
+		render::GeometryPool::Allocation third = pool.Allocate(positionFlags, 10u, vertexData.data(), 6u, indexData.data());
+
+		// doesn't touch the page that now holds the new allocation, even if it reuses the old pages ID
+		pool.Release(first);
+		pool.Release(second);
+		REQUIRE_FALSE(first.IsValid());
+		REQUIRE_FALSE(second.IsValid());
+		REQUIRE(pool.GetPageCount() == 1u);
+
+		pool.Release(third);
+		REQUIRE(pool.GetPageCount() == 0u);
+	}
+
+	if (first.IsValid())
+	{
+		pool.Release(first);
+	}
+
+	if (second.IsValid())
+	{
+		pool.Release(second);
+	}
+}
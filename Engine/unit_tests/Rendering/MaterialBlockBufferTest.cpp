@@ -0,0 +1,132 @@
+#include <EtRendering/stdafx.h>
+
+#include <catch2/catch.hpp>
+
+#include <EtRendering/GraphicsContext/ContextHolder.h>
+#include <EtRendering/GraphicsContext/HeadlessRenderWindow.h>
+#include <EtRendering/GraphicsTypes/ParameterBlock.h>
+#include <EtRendering/GlobalRenderingSystems/MaterialBlockBuffer.h>
+
+
+using namespace et;
+
+
+TEST_CASE("std140 packing", "[rendering]")
+{
+	SECTION("sizes")
+	{
+		REQUIRE(render::parameters::GetStd140Size(render::E_ParamType::Matrix4x4) == 64u);
+		REQUIRE(render::parameters::GetStd140Size(render::E_ParamType::Matrix3x3) == 48u);
+		REQUIRE(render::parameters::GetStd140Size(render::E_ParamType::Vector3) == 12u);
+		REQUIRE(render::parameters::GetStd140Size(render::E_ParamType::Boolean) == 4u);
+	}
+
+	SECTION("mat3 rows are padded to vec4")
+	{
+		mat3 mat;
+		for (uint8 rowIdx = 0u; rowIdx < 3u; ++rowIdx)
+		{
+			for (uint8 colIdx = 0u; colIdx < 3u; ++colIdx)
+			{
+				mat.data[rowIdx][colIdx] = static_cast<float>(rowIdx * 3u + colIdx + 1u);
+			}
+		}
+
+		render::T_ParameterBlock block = render::parameters::CreateBlock(sizeof(mat3));
+		render::parameters::Write(block, 0u, mat);
+
+		float packed[12] = {};
+		render::parameters::WriteStd140(block, 0u, render::E_ParamType::Matrix3x3, reinterpret_cast<uint8*>(packed));
+
+		REQUIRE(packed[0] == 1.f);
+		REQUIRE(packed[2] == 3.f);
+		REQUIRE(packed[3] == 0.f);
+		REQUIRE(packed[4] == 4.f);
+		REQUIRE(packed[8] == 7.f);
+		REQUIRE(packed[10] == 9.f);
+
+		render::parameters::DestroyBlock(block);
+	}
+
+	SECTION("bools are 4 bytes")
+	{
+		render::T_ParameterBlock block = render::parameters::CreateBlock(sizeof(bool));
+		render::parameters::Write(block, 0u, true);
+
+		uint32 packed = 0xFFFFFFFFu;
+		render::parameters::WriteStd140(block, 0u, render::E_ParamType::Boolean, reinterpret_cast<uint8*>(&packed));
+		REQUIRE(packed == 1u);
+
+		render::parameters::DestroyBlock(block);
+	}
+}
+
+TEST_CASE("material block buffer", "[rendering]")
+{
+	{
+		render::HeadlessRenderWindow window(ivec2(16, 16));
+		render::ContextHolder::Instance().CreateMainRenderContext(&window);
+		render::RecordingContext& context = window.GetContext();
+
+		render::MaterialBlockBuffer buffer;
+		buffer.Init();
+
+		render::MaterialBlockBuffer::T_BlockId first = buffer.Allocate(64u);
+		render::MaterialBlockBuffer::T_BlockId const second = buffer.Allocate(300u);
+
+		// blocks are aligned so that any of them can be bound as a range
+		REQUIRE(buffer.GetSize() == 768u);
+		REQUIRE(buffer.IsDirty());
+
+		SECTION("the first flush allocates the whole buffer")
+		{
+			context.Reset();
+			buffer.Bind(first);
+
+			REQUIRE(!buffer.IsDirty());
+			REQUIRE(context.GetStats().bufferUploads == 1u);
+			REQUIRE(context.GetStats().bufferBytes == 768u);
+		}
+
+		SECTION("binding the same block again does nothing")
+		{
+			buffer.Bind(first);
+			context.Reset();
+			buffer.Bind(first);
+
+			REQUIRE(context.GetStats().bufferBinds == 0u);
+			REQUIRE(context.GetStats().bufferUploads == 0u);
+		}
+
+		SECTION("writes only upload the dirty range")
+		{
+			buffer.Flush();
+			buffer.Write(second)[0] = 1u;
+
+			context.Reset();
+			buffer.Bind(second);
+
+			REQUIRE(context.GetStats().bufferUploads == 1u);
+			REQUIRE(context.GetStats().bufferBytes == 512u);
+		}
+
+		SECTION("released ranges are reused")
+		{
+			buffer.Release(first);
+			REQUIRE((first == render::MaterialBlockBuffer::s_InvalidBlock));
+
+			render::MaterialBlockBuffer::T_BlockId const third = buffer.Allocate(200u);
+			REQUIRE(buffer.GetSize() == 768u);
+
+			buffer.Release(second);
+			render::MaterialBlockBuffer::T_BlockId const fourth = buffer.Allocate(512u);
+			REQUIRE(buffer.GetSize() == 768u);
+			REQUIRE(third != fourth);
+		}
+
+		buffer.Deinit();
+	}
+
+	// the window going out of scope releases the global render context again
+	REQUIRE(render::ContextHolder::GetRenderContext() == nullptr);
+}
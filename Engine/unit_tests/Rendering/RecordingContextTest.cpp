@@ -0,0 +1,320 @@
+#include <EtRendering/stdafx.h>
+
+#include <catch2/catch.hpp>
+
+#include <EtRendering/GraphicsContext/ContextHolder.h>
+#include <EtRendering/GraphicsContext/HeadlessRenderWindow.h>
+
+
+using namespace et;
+
+
+TEST_CASE("recording context objects", "[rendering]")
+{
+	render::RecordingContext context;
+	context.Initialize(ivec2(64, 32));
+
+	render::T_BufferLoc buffer = context.CreateBuffer();
+	render::T_ArrayLoc vertexArray = context.CreateVertexArray();
+	render::T_TextureLoc texture = context.GenerateTexture();
+
+	REQUIRE(buffer != 0u);
+	REQUIRE(vertexArray != 0u);
+	REQUIRE(texture != 0u);
+	REQUIRE(buffer != vertexArray);
+	REQUIRE(vertexArray != texture);
+
+	render::T_FbLoc framebuffers[2];
+	context.GenFramebuffers(2, framebuffers);
+	REQUIRE(framebuffers[0] != framebuffers[1]);
+
+	REQUIRE(context.GetLiveBufferCount() == 1u);
+	REQUIRE(context.GetLiveVertexArrayCount() == 1u);
+	REQUIRE(context.GetLiveTextureCount() == 1u);
+	REQUIRE(context.GetLiveFramebufferCount() == 2u);
+
+	ivec2 pos;
+	ivec2 size;
+	context.GetViewport(pos, size);
+	REQUIRE(size.x == 64);
+	REQUIRE(size.y == 32);
+
+	context.DeleteBuffer(buffer);
+	context.DeleteVertexArray(vertexArray);
+	context.DeleteTexture(texture);
+	context.DeleteFramebuffers(2, framebuffers);
+
+	REQUIRE(context.GetLiveBufferCount() == 0u);
+	REQUIRE(context.GetLiveVertexArrayCount() == 0u);
+	REQUIRE(context.GetLiveTextureCount() == 0u);
+	REQUIRE(context.GetLiveFramebufferCount() == 0u);
+}
+
+TEST_CASE("recording context stats", "[rendering]")
+{
+	render::RecordingContext context;
+	context.Initialize(ivec2(64, 32));
+	context.SetLogEnabled(true);
+
+	render::T_ArrayLoc const vertexArray = context.CreateVertexArray();
+	render::T_BufferLoc const buffer = context.CreateBuffer();
+	context.Reset();
+
+	context.BindVertexArray(vertexArray);
+	context.BindVertexArray(vertexArray);
+	context.BindBuffer(render::E_BufferType::Vertex, buffer);
+
+	std::vector<float> const vertices(12u, 1.f);
+	context.SetBufferData(render::E_BufferType::Vertex, 
+		static_cast<int64>(vertices.size() * sizeof(float)), 
+		vertices.data(), 
+		render::E_UsageHint::Dynamic);
+
+	// mapped buffers are backed by the size of the last upload
+	void* const mapped = context.MapBuffer(render::E_BufferType::Vertex, render::E_AccessMode::Write);
+	REQUIRE(mapped != nullptr);
+	REQUIRE(static_cast<float const*>(mapped)[11] == 1.f);
+	context.UnmapBuffer(render::E_BufferType::Vertex);
+
+	context.SetDepthEnabled(true);
+	context.SetDepthEnabled(true);
+
+	context.UploadUniform(0, 1.f);
+	context.UploadUniform(1, mat4());
+
+	context.DrawArrays(render::E_DrawMode::Triangles, 0u, 3u);
+	context.DrawElementsInstanced(render::E_DrawMode::Triangles, 6u, render::E_DataType::UInt, nullptr, 10u);
+
+	render::RecordingContext::Stats const& stats = context.GetStats();
+	REQUIRE(stats.vertexArrayBinds == 1u);
+	REQUIRE(stats.bufferBinds == 1u);
+	REQUIRE(stats.redundantBinds == 1u);
+	REQUIRE(stats.bufferUploads == 1u);
+	REQUIRE(stats.bufferMaps == 1u);
+	REQUIRE(stats.bufferBytes == 2u * 12u * sizeof(float));
+	REQUIRE(stats.stateChanges == 1u);
+	REQUIRE(stats.uniformUploads == 2u);
+	REQUIRE(stats.drawCalls == 2u);
+	REQUIRE(stats.instancedDrawCalls == 1u);
+	REQUIRE(stats.instances == 10u);
+	REQUIRE(stats.elements == 3u + 60u);
+
+	std::vector<render::RecordingContext::Command> const& commands = context.GetCommands();
+	REQUIRE(commands.size() == 10u);
+	REQUIRE(commands.front().type == render::RecordingContext::E_Command::BindVertexArray);
+	REQUIRE(commands.back().type == render::RecordingContext::E_Command::DrawInstanced);
+	REQUIRE(commands.back().value == 10u);
+
+	context.Reset();
+	REQUIRE(context.GetCommands().empty());
+	REQUIRE(context.GetStats().drawCalls == 0u);
+}
+
+TEST_CASE("headless render window", "[rendering]")
+{
+	render::ContextHolder contextHolder; 
+
+	{
+		render::HeadlessRenderWindow window(ivec2(128, 64));
+		contextHolder.CreateMainRenderContext(&window);
+
+		REQUIRE(contextHolder.GetMainRenderContext().GetContext() == &window.GetContext());
+		REQUIRE(window.GetDimensions().x == 128);
+	}
+
+	// destroying the window releases the context
+	REQUIRE(contextHolder.GetMainRenderContext().GetContext() == nullptr);
+}
+
+TEST_CASE("recording context shader reflection", "[rendering]")
+{
+	render::RecordingContext context;
+	context.Initialize(ivec2(64, 32));
+
+	std::string const vertSource = R"(
+		#version 450 core
+		layout (location = 0) in vec3 pos;
+		layout (location = 4) in vec2 texCoord;
+		in mat4 instanceModel; // takes a location per column
+
+		layout(std140) uniform SharedVars
+		{
+			mat4 viewProjection;
+			float time;
+			vec3 camPos;
+		};
+
+		uniform mat4 model;
+
+		void main()
+		{
+			gl_Position = viewProjection * model * instanceModel * vec4(pos, 1.0);
+		}
+	)";
+
+	std::string const fragSource = R"(
+		#version 450 core
+		#define NUM_WEIGHTS 5
+		const int NUM_CASCADES = 2;
+
+		struct Cascade
+		{
+			mat4 LightVP;
+			sampler2DShadow ShadowMap;
+		};
+
+		layout(std140) uniform SharedVars
+		{
+			mat4 viewProjection;
+			float time;
+			vec3 camPos;
+		};
+
+		uniform Cascade cascades[NUM_CASCADES];
+		uniform float weight[NUM_WEIGHTS];
+		uniform int PcfSamples = 3, /* comments are ignored */ Unset;
+
+		out vec4 outColor;
+
+		vec4 Shade(in vec3 pos)
+		{
+			return vec4(pos, 1.0);
+		}
+
+		void main()
+		{
+			outColor = Shade(vec3(weight[0]));
+		}
+	)";
+
+	render::T_ShaderLoc const vert = context.CreateShader(render::E_ShaderType::Vertex);
+	render::T_ShaderLoc const frag = context.CreateShader(render::E_ShaderType::Fragment);
+	context.CompileShader(vert, vertSource);
+	context.CompileShader(frag, fragSource);
+
+	render::T_ShaderLoc const program = context.CreateProgram();
+	context.AttachShader(program, vert);
+	context.AttachShader(program, frag);
+	context.LinkProgram(program);
+
+	// the program keeps its interface when the stages are deleted
+	context.DeleteShader(vert);
+	context.DeleteShader(frag);
+
+	SECTION("uniform blocks")
+	{
+		std::vector<std::string> const blocks = context.GetUniformBlockNames(program);
+		REQUIRE(blocks.size() == 1u);
+		REQUIRE(blocks[0] == "SharedVars");
+		REQUIRE(context.GetUniformBlockIndex(program, "SharedVars") == 0);
+		REQUIRE(!context.IsBlockIndexValid(context.GetUniformBlockIndex(program, "Missing")));
+
+		std::vector<int32> const indices = context.GetUniformIndicesForBlock(program, 0);
+		REQUIRE(indices.size() == 3u);
+
+		// std140 offsets, vec3 aligns to 16 bytes
+		std::vector<render::UniformDescriptor> unis;
+		for (int32 const index : indices)
+		{
+			context.GetActiveUniforms(program, static_cast<uint32>(index), unis);
+		}
+
+		REQUIRE(unis.size() == 3u);
+		REQUIRE(unis[0].name == "viewProjection");
+		REQUIRE(unis[0].location == -1);
+		REQUIRE(unis[0].blockOffset == 0);
+		REQUIRE(unis[1].type == render::E_ParamType::Float);
+		REQUIRE(unis[1].blockOffset == 64);
+		REQUIRE(unis[2].name == "camPos");
+		REQUIRE(unis[2].blockOffset == 80);
+	}
+
+	SECTION("loose uniforms")
+	{
+		// 3 block members, the model matrix, 2 members for each cascade, the weight array and 2 ints
+		int32 const count = context.GetUniformCount(program);
+		REQUIRE(count == 3 + 1 + 4 + 1 + 2);
+
+		std::vector<render::UniformDescriptor> unis;
+		for (int32 index = 0; index < count; ++index)
+		{
+			context.GetActiveUniforms(program, static_cast<uint32>(index), unis);
+		}
+
+		// arrays of basic types expand into an element each
+		REQUIRE(unis.size() == 3u + 1u + 4u + 5u + 2u);
+
+		auto const findUniform = [&unis](std::string const& name) -> render::UniformDescriptor const*
+			{
+				auto const foundIt = std::find_if(unis.cbegin(), unis.cend(), [&name](render::UniformDescriptor const& uni)
+					{
+						return (uni.name == name);
+					});
+
+				return (foundIt != unis.cend()) ? &*foundIt : nullptr;
+			};
+
+		render::UniformDescriptor const* const model = findUniform("model");
+		REQUIRE(model != nullptr);
+		REQUIRE(model->type == render::E_ParamType::Matrix4x4);
+		REQUIRE(model->location >= 0);
+		REQUIRE(model->blockOffset == -1);
+
+		render::UniformDescriptor const* const shadowMap = findUniform("cascades[1].ShadowMap");
+		REQUIRE(shadowMap != nullptr);
+		REQUIRE(shadowMap->type == render::E_ParamType::TextureShadow);
+
+		render::UniformDescriptor const* const firstWeight = findUniform("weight[0]");
+		render::UniformDescriptor const* const lastWeight = findUniform("weight[4]");
+		REQUIRE(firstWeight != nullptr);
+		REQUIRE(lastWeight != nullptr);
+		REQUIRE(lastWeight->location == firstWeight->location + 4);
+
+		// loose uniforms don't share locations
+		std::unordered_set<render::T_UniformLoc> locations;
+		for (render::UniformDescriptor const& uni : unis)
+		{
+			if (uni.location >= 0)
+			{
+				REQUIRE(locations.insert(uni.location).second);
+			}
+		}
+
+		REQUIRE(locations.size() == 1u + 4u + 5u + 2u);
+
+		// initializers are the values before anything is uploaded
+		render::UniformDescriptor const* const pcfSamples = findUniform("PcfSamples");
+		REQUIRE(pcfSamples != nullptr);
+
+		int32 value = 0;
+		context.PopulateUniform(program, pcfSamples->location, render::E_ParamType::Int, &value);
+		REQUIRE(value == 3);
+
+		value = 7;
+		context.PopulateUniform(program, findUniform("Unset")->location, render::E_ParamType::Int, &value);
+		REQUIRE(value == 0);
+	}
+
+	SECTION("attributes")
+	{
+		REQUIRE(context.GetAttributeCount(program) == 3);
+
+		render::AttributeDescriptor info;
+		context.GetActiveAttribute(program, 1u, info);
+		REQUIRE(info.name == "texCoord");
+		REQUIRE(info.dataType == render::E_DataType::Float);
+		REQUIRE(info.dataCount == 2u);
+
+		context.GetActiveAttribute(program, 2u, info);
+		REQUIRE(info.dataCount == 16u);
+
+		// explicit locations are kept, the matrix goes to the first 4 consecutive free ones
+		REQUIRE(context.GetAttributeLocation(program, "pos") == 0);
+		REQUIRE(context.GetAttributeLocation(program, "texCoord") == 4);
+		REQUIRE(context.GetAttributeLocation(program, "instanceModel") == 5);
+		REQUIRE(context.GetAttributeLocation(program, "missing") == -1);
+	}
+
+	context.DeleteProgram(program);
+	REQUIRE(context.GetLiveShaderCount() == 0u);
+}
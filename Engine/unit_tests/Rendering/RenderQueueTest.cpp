@@ -0,0 +1,114 @@
+#include <EtRendering/stdafx.h>
+
+#include <random>
+
+#include <catch2/catch.hpp>
+
+#include <EtRendering/SceneRendering/RenderQueue.h>
+
+
+using namespace et;
+
+
+TEST_CASE("render queue keys", "[rendering]")
+{
+	using E_Pass = render::RenderQueue::E_Pass;
+
+	SECTION("opaque items group by state before depth")
+	{
+		REQUIRE(render::RenderQueue::MakeKey(E_Pass::Opaque, 0u, 0u, 0u, 0.9f) < render::RenderQueue::MakeKey(E_Pass::Opaque, 0u, 0u, 1u, 0.1f));
+		REQUIRE(render::RenderQueue::MakeKey(E_Pass::Opaque, 0u, 1u, 0u, 0.f) < render::RenderQueue::MakeKey(E_Pass::Opaque, 1u, 0u, 0u, 0.f));
+		REQUIRE(render::RenderQueue::MakeKey(E_Pass::Opaque, 0u, 0u, 0u, 0.1f) < render::RenderQueue::MakeKey(E_Pass::Opaque, 0u, 0u, 0u, 0.9f));
+	}
+
+	SECTION("forward items sort back to front before state")
+	{
+		REQUIRE(render::RenderQueue::MakeKey(E_Pass::Forward, 0u, 0u, 0u, 0.9f) < render::RenderQueue::MakeKey(E_Pass::Forward, 0u, 0u, 0u, 0.1f));
+		REQUIRE(render::RenderQueue::MakeKey(E_Pass::Forward, 5u, 3u, 2u, 0.9f) < render::RenderQueue::MakeKey(E_Pass::Forward, 0u, 0u, 0u, 0.1f));
+	}
+
+	SECTION("passes don't overlap")
+	{
+		REQUIRE(render::RenderQueue::MakeKey(E_Pass::Opaque, 4095u, 65535u, 65535u, 1.f) < render::RenderQueue::MakeKey(E_Pass::Forward, 0u, 0u, 0u, 1.f));
+	}
+
+	SECTION("fields at their limit don't overflow into their neighbours")
+	{
+		uint32 const maxShader = render::RenderQueue::s_MaxShaders - 1u;
+		uint32 const maxMaterial = render::RenderQueue::s_MaxMaterials - 1u;
+		uint32 const maxMesh = render::RenderQueue::s_MaxMeshes - 1u;
+
+		uint64 const maxMeshKey = render::RenderQueue::MakeKey(E_Pass::Opaque, 0u, 0u, maxMesh, 0.f);
+		uint64 const maxMaterialKey = render::RenderQueue::MakeKey(E_Pass::Opaque, 0u, maxMaterial, 0u, 0.f);
+		uint64 const maxShaderKey = render::RenderQueue::MakeKey(E_Pass::Opaque, maxShader, 0u, 0u, 0.f);
+
+		// each field only occupies its own bits
+		REQUIRE((maxMeshKey & maxMaterialKey) == 0u);
+		REQUIRE((maxMaterialKey & maxShaderKey) == 0u);
+		REQUIRE((maxShaderKey & render::RenderQueue::MakeKey(E_Pass::Forward, 0u, 0u, 0u, 1.f)) == 0u);
+		REQUIRE(render::RenderQueue::MakeKey(E_Pass::Opaque, maxShader, maxMaterial, maxMesh, 0.f) == (maxShaderKey | maxMaterialKey | maxMeshKey));
+
+		// the last index of a field still sorts below the next index of the field above it
+		REQUIRE(render::RenderQueue::MakeKey(E_Pass::Opaque, 0u, 0u, maxMesh, 1.f) < render::RenderQueue::MakeKey(E_Pass::Opaque, 0u, 1u, 0u, 0.f));
+		REQUIRE(render::RenderQueue::MakeKey(E_Pass::Opaque, 0u, maxMaterial, maxMesh, 1.f) < render::RenderQueue::MakeKey(E_Pass::Opaque, 1u, 0u, 0u, 0.f));
+		REQUIRE(render::RenderQueue::MakeKey(E_Pass::Forward, maxShader, maxMaterial, maxMesh, 0.5f) < render::RenderQueue::MakeKey(E_Pass::Forward, 0u, 0u, 0u, 0.4f));
+	}
+
+	SECTION("depth is clamped")
+	{
+		REQUIRE(render::RenderQueue::MakeKey(E_Pass::Opaque, 0u, 0u, 0u, -4.f) == render::RenderQueue::MakeKey(E_Pass::Opaque, 0u, 0u, 0u, 0.f));
+		REQUIRE(render::RenderQueue::MakeKey(E_Pass::Opaque, 0u, 0u, 0u, 4.f) == render::RenderQueue::MakeKey(E_Pass::Opaque, 0u, 0u, 0u, 1.f));
+	}
+}
+
+TEST_CASE("render queue sort", "[rendering]")
+{
+	std::mt19937_64 rng(1234u);
+
+	auto const checkSorted = [](std::vector<render::RenderQueue::DrawItem> items)
+		{
+			std::vector<render::RenderQueue::DrawItem> expected = items;
+			std::stable_sort(expected.begin(), expected.end(), [](render::RenderQueue::DrawItem const& lhs, render::RenderQueue::DrawItem const& rhs)
+				{
+					return lhs.key < rhs.key;
+				});
+
+			std::vector<render::RenderQueue::DrawItem> scratch;
+			render::RenderQueue::SortItems(items, scratch);
+
+			REQUIRE(items.size() == expected.size());
+			for (size_t idx = 0u; idx < items.size(); ++idx)
+			{
+				REQUIRE(items[idx].key == expected[idx].key);
+				REQUIRE(items[idx].node == expected[idx].node); // the sort is stable
+			}
+		};
+
+	SECTION("empty and single")
+	{
+		checkSorted(std::vector<render::RenderQueue::DrawItem>());
+		checkSorted(std::vector<render::RenderQueue::DrawItem>{ render::RenderQueue::DrawItem{ 5u, nullptr, 0u, 0u } });
+	}
+
+	SECTION("random keys")
+	{
+		std::vector<render::RenderQueue::DrawItem> items;
+		for (uint32 idx = 0u; idx < 5000u; ++idx)
+		{
+			items.push_back(render::RenderQueue::DrawItem{ rng(), nullptr, idx, 0u });
+		}
+
+		checkSorted(items);
+	}
+
+	SECTION("few distinct digits")
+	{
+		std::vector<render::RenderQueue::DrawItem> items;
+		for (uint32 idx = 0u; idx < 5000u; ++idx)
+		{
+			items.push_back(render::RenderQueue::DrawItem{ rng() & 0x0000FF00000F00FFull, nullptr, idx, 0u });
+		}
+
+		checkSorted(items);
+	}
+}
@@ -0,0 +1,138 @@
+#include <EtRendering/stdafx.h>
+
+#include <catch2/catch.hpp>
+
+#include <EtRendering/GraphicsContext/ContextHolder.h>
+#include <EtRendering/GraphicsContext/HeadlessRenderWindow.h>
+#include <EtRendering/GraphicsTypes/StreamingBuffer.h>
+
+
+using namespace et;
+
+
+TEST_CASE("streaming buffer", "[rendering]")
+{
+	render::HeadlessRenderWindow window(ivec2(16, 16));
+	render::ContextHolder::Instance().CreateMainRenderContext(&window);
+	render::RecordingContext& context = window.GetContext();
+
+	size_t const initialBufferCount = context.GetLiveBufferCount();
+
+	render::StreamingBuffer stream;
+	stream.Init(256u);
+
+	REQUIRE(stream.GetBuffer() != 0u);
+	REQUIRE(stream.GetFrameSize() == 256u);
+
+	SECTION("allocations are aligned from the start of the buffer")
+	{
+		REQUIRE(stream.Allocate(100u, 4u) == 0u);
+		REQUIRE(stream.Allocate(10u, 16u) == 112u);
+		REQUIRE(stream.GetFrameUsage() == 122u);
+	}
+
+	SECTION("writes go to mapped memory without uploads")
+	{
+		context.Reset();
+
+		uint32 const data[4] = { 1u, 2u, 3u, 4u };
+		size_t const offset = stream.Allocate(sizeof(data), sizeof(uint32));
+		stream.Write(offset, data, sizeof(data));
+
+		REQUIRE(context.GetStats().bufferUploads == 0u);
+		REQUIRE(context.GetStats().bufferMaps == 0u);
+	}
+
+	SECTION("frames cycle through fenced regions")
+	{
+		context.Reset();
+
+		REQUIRE(stream.Allocate(8u, 4u) == 0u);
+		stream.EndFrame();
+		REQUIRE(stream.GetFrameUsage() == 0u);
+		REQUIRE(stream.Allocate(8u, 4u) == 256u);
+		stream.EndFrame();
+		REQUIRE(stream.Allocate(8u, 4u) == 512u);
+
+		// no region has been reused yet
+		REQUIRE(context.GetStats().fenceWaits == 0u);
+		REQUIRE(context.GetLiveFenceCount() == 2u);
+
+		// returning to the first region waits for the GPU to be done with it
+		stream.EndFrame();
+		REQUIRE(context.GetStats().fenceWaits == 1u);
+		REQUIRE(context.GetLiveFenceCount() == 2u);
+		REQUIRE(stream.Allocate(8u, 4u) == 0u);
+	}
+
+	SECTION("empty frames are not fenced")
+	{
+		stream.EndFrame();
+		REQUIRE(context.GetLiveFenceCount() == 0u);
+		REQUIRE(stream.Allocate(8u, 4u) == 0u);
+	}
+
+	SECTION("frames that don't fit grow the buffer")
+	{
+		render::T_BufferLoc const oldBuffer = stream.GetBuffer();
+
+		stream.Allocate(200u, 4u);
+		stream.EndFrame();
+		REQUIRE(stream.Allocate(200u, 4u) == 256u);
+		REQUIRE(stream.Allocate(100u, 4u) == 0u);
+
+		REQUIRE(stream.GetBuffer() != oldBuffer);
+		REQUIRE(stream.GetFrameSize() == 512u);
+		REQUIRE(stream.GetFrameUsage() == 100u);
+
+		// the fences of the old storage are released right away, the storage itself once the frame ends
+		REQUIRE(context.GetLiveFenceCount() == 0u);
+		REQUIRE(context.GetLiveBufferCount() == initialBufferCount + 2u);
+
+		stream.EndFrame();
+		REQUIRE(context.GetLiveBufferCount() == initialBufferCount + 1u);
+	}
+
+	SECTION("growing keeps earlier allocations of the frame alive")
+	{
+		context.Reset();
+
+		// a draw linked to the first buffer hasn't been issued yet when the second allocation grows the buffer
+		render::T_BufferLoc const firstBuffer = stream.GetBuffer();
+		uint32 const data[4] = { 1u, 2u, 3u, 4u };
+		size_t const firstOffset = stream.Allocate(sizeof(data), sizeof(uint32));
+		stream.Write(firstOffset, data, sizeof(data));
+
+		size_t const secondOffset = stream.Allocate(300u, 4u);
+		REQUIRE(secondOffset == 0u);
+		REQUIRE(stream.GetBuffer() != firstBuffer);
+
+		// the first buffer can still be drawn from, and nothing waited for the GPU
+		auto const isFirstBufferDeleted = [&context, firstBuffer]()
+			{
+				for (render::RecordingContext::Command const& command : context.GetCommands())
+				{
+					if ((command.type == render::RecordingContext::E_Command::DeleteObject) && (command.value == firstBuffer))
+					{
+						return true;
+					}
+				}
+
+				return false;
+			};
+
+		REQUIRE(!isFirstBufferDeleted());
+		REQUIRE(context.GetLiveBufferCount() == initialBufferCount + 2u);
+		REQUIRE(context.GetStats().fenceWaits == 0u);
+
+		// the end of the frame releases it
+		stream.EndFrame();
+		REQUIRE(isFirstBufferDeleted());
+		REQUIRE(context.GetLiveBufferCount() == initialBufferCount + 1u);
+		REQUIRE(context.GetLiveFenceCount() == 1u);
+		REQUIRE(stream.Allocate(8u, 4u) == stream.GetFrameSize());
+	}
+
+	stream.Deinit();
+	REQUIRE(stream.GetBuffer() == 0u);
+}
@@ -8,15 +8,15 @@
 	out vec3 Position;
 	out vec3 Normal;
 
-	uniform mat4 model;
+	in mat4 instanceModel; // per instance transform
 
 	void main()
 	{
-		mat3 normMat = inverse(mat3(model));
+		mat3 normMat = inverse(mat3(instanceModel));
 		normMat = transpose(normMat);
 		Normal = normalize(normMat*normal);
 
-		vec4 pos = model*vec4(position, 1.0);
+		vec4 pos = instanceModel*vec4(position, 1.0);
 		Position = pos.xyz;
 		gl_Position = viewProjection*pos;
 	}
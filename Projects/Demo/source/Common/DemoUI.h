@@ -28,7 +28,7 @@ struct CanvasView final : public fw::ComponentView
 class DemoUISystem final : public fw::System<DemoUISystem, CanvasView>
 {
 public:
-	DemoUISystem() = default; // no dependencies
+	DemoUISystem() { DeclareExclusive(); } // toggling canvases modifies the GUI context
 
 	void Process(fw::ComponentRange<CanvasView>& range) override;
 };
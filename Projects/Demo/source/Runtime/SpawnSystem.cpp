@@ -23,6 +23,7 @@ namespace demo {
 SpawnSystem::SpawnSystem()
 {
 	DeclareDependents<fw::RigidBodySystem>(); // update before rigid bodies so bullet simulates our spheres as soon as they are added
+	DeclareExclusive(); // entities are created immediately by the command buffer
 }
 
 //------------------------------